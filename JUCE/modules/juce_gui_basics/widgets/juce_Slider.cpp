@@ -198,7 +198,7 @@ public:
                 currentValue = newValue;
 
             updateText();
-            owner.repaint();
+            owner.repaintAfterValueChange();
             updatePopupDisplay (newValue);
 
             triggerChangeMessage (notification);
@@ -232,7 +232,7 @@ public:
         {
             lastValueMin = newValue;
             valueMin = newValue;
-            owner.repaint();
+            owner.repaintAfterValueChange();
             updatePopupDisplay (newValue);
 
             triggerChangeMessage (notification);
@@ -266,7 +266,7 @@ public:
         {
             lastValueMax = newValue;
             valueMax = newValue;
-            owner.repaint();
+            owner.repaintAfterValueChange();
             updatePopupDisplay (valueMax.getValue());
 
             triggerChangeMessage (notification);
@@ -291,7 +291,7 @@ public:
             lastValueMin = newMinValue;
             valueMin = newMinValue;
             valueMax = newMaxValue;
-            owner.repaint();
+            owner.repaintAfterValueChange();
 
             triggerChangeMessage (notification);
         }
@@ -1645,6 +1645,7 @@ int Slider::getThumbBeingDragged() const noexcept           { return pimpl->slid
 void Slider::startedDragging() {}
 void Slider::stoppedDragging() {}
 void Slider::valueChanged() {}
+void Slider::repaintAfterValueChange()   { repaint(); }
 
 //==============================================================================
 void Slider::setPopupMenuEnabled (bool menuEnabled)         { pimpl->menuEnabled = menuEnabled; }
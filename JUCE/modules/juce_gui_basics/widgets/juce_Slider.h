@@ -727,6 +727,13 @@ public:
     */
     virtual void valueChanged();
 
+    /** Called when one of the values has changed and the slider needs to be repainted.
+
+        The default implementation just calls repaint(), but subclasses can override this
+        to collect the repaints of multiple sliders.
+    */
+    virtual void repaintAfterValueChange();
+
     //==============================================================================
     /** Subclasses can override this to convert a text string to a value.
 
@@ -1084,8 +1084,15 @@ struct ToolkitPopup : public Component,
 
 		const double ramUsage = (double)bytes / 1024.0 / 1024.0;
 
+		auto& frameStats = mc->getGlobalUIUpdater()->getFrameStatistics();
+
 		String stats = "CPU: ";
 		stats << String(cpuUsage) << "%, RAM: " << String(ramUsage, 1) << "MB , Voices: " << String(voiceAmount);
+		stats << ", UI: " << String(frameStats.getAverageFrameDuration(), 1) << "ms";
+
+		if (frameStats.numBudgetOverruns > 0)
+			stats << " (" << String(frameStats.numBudgetOverruns) << " slow frames)";
+
 		return stats;
 	}
 
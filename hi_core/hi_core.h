@@ -429,6 +429,27 @@ some weird side effects in the streaming engine).
 #define HISE_MAX_PROCESSING_BLOCKSIZE 512
 #endif
 
+/** Config: HISE_NUM_AUDIO_RENDER_THREADS
+
+The number of additional threads that help the audio thread with rendering the voices of a sound generator. If this is
+zero (the default), the voices are rendered one after another on the audio thread. The output is identical in both modes,
+but spreading the work across multiple cores lowers the time spent in the audio callback if many voices are playing.
+*/
+#ifndef HISE_NUM_AUDIO_RENDER_THREADS
+#define HISE_NUM_AUDIO_RENDER_THREADS 0
+#endif
+
+/** Config: HISE_USE_VOICE_BATCHED_ENVELOPES
+
+If this is enabled, envelopes that support it (the AHDSR and the simple envelope) calculate all active voices at once
+before the voice rendering, using one SIMD lane per voice. Voices that change their envelope stage within the block are
+calculated with the per-voice code, so the output matches the default mode (except for floating point contraction
+differences on some compilers). This helps if many voices share the same envelope.
+*/
+#ifndef HISE_USE_VOICE_BATCHED_ENVELOPES
+#define HISE_USE_VOICE_BATCHED_ENVELOPES 0
+#endif
+
 /** Config: ENABLE_CPU_MEASUREMENT
 
 Set this to 0 to deactivate the CPU peak meter.
@@ -0,0 +1,166 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise {
+using namespace juce;
+
+AudioRenderThreadPool::Worker::Worker(AudioRenderThreadPool& parent_, int threadIndex_) :
+	Thread("Audio Render Thread " + String(threadIndex_)),
+	parent(parent_),
+	threadIndex(threadIndex_)
+{}
+
+void AudioRenderThreadPool::Worker::run()
+{
+	// The tasks are executed on behalf of the audio thread, so the lock checks must treat them like one.
+	parent.mc->getKillStateHandler().addThreadIdToAudioThreadList();
+
+	// The workers keep spinning a little while after a batch so that consecutive
+	// calls within the same audio callback don't have to wake them up again.
+	static constexpr int NumSpinsBeforeSleep = 1000;
+
+	int numSpins = 0;
+
+	while (!threadShouldExit())
+	{
+		auto g = (uint32)(parent.state.load() >> 32);
+
+		if (g != lastGeneration)
+		{
+			lastGeneration = g;
+			parent.processItems(g, threadIndex);
+			numSpins = 0;
+			continue;
+		}
+
+		if (++numSpins < NumSpinsBeforeSleep)
+		{
+			Thread::yield();
+			continue;
+		}
+
+		sleeping.store(true);
+
+		// check again after setting the flag so that we can't miss a batch that was started in between
+		if ((uint32)(parent.state.load() >> 32) == lastGeneration)
+			wait(100);
+
+		sleeping.store(false);
+		numSpins = 0;
+	}
+
+	parent.mc->getKillStateHandler().removeThreadIdFromAudioThreadList();
+}
+
+AudioRenderThreadPool::AudioRenderThreadPool(MainController* mc_, int numWorkerThreads) :
+	mc(mc_)
+{
+	for (int i = 0; i < numWorkerThreads; i++)
+	{
+		workers.add(new Worker(*this, i + 1));
+		workers.getLast()->startThread(10);
+	}
+}
+
+AudioRenderThreadPool::~AudioRenderThreadPool()
+{
+	for (auto w : workers)
+		w->signalThreadShouldExit();
+
+	for (auto w : workers)
+	{
+		w->notify();
+		w->stopThread(1000);
+	}
+}
+
+void AudioRenderThreadPool::runParallel(Task& t, int numItems)
+{
+	if (numItems <= 0)
+		return;
+
+	bool expected = false;
+
+	if (workers.isEmpty() || numItems == 1 || !busy.compare_exchange_strong(expected, true))
+	{
+		for (int i = 0; i < numItems; i++)
+			t.run(i, 0);
+
+		return;
+	}
+
+	const auto nextGeneration = (uint32)(state.load() >> 32) + 1;
+
+	currentTask.store(&t);
+	numItemsInBatch.store(numItems);
+	numPendingItems.store(numItems);
+	state.store((uint64)nextGeneration << 32);
+
+	for (auto w : workers)
+	{
+		if (w->sleeping.load())
+			w->notify();
+	}
+
+	processItems(nextGeneration, 0);
+
+	while (numPendingItems.load(std::memory_order_acquire) > 0)
+		;
+
+	currentTask.store(nullptr);
+	busy.store(false);
+}
+
+void AudioRenderThreadPool::processItems(uint32 generation, int threadIndex)
+{
+	auto v = state.load();
+
+	while ((uint32)(v >> 32) == generation)
+	{
+		auto itemIndex = (int)(v & IndexMask);
+
+		// If the generation changes in between, the compare_exchange below will fail, so it's
+		// not a problem if this value belongs to the next batch
+		if (itemIndex >= numItemsInBatch.load())
+			break;
+
+		if (state.compare_exchange_weak(v, v + 1))
+		{
+			// The batch can't finish before we have processed our item, so the task is still valid
+			currentTask.load()->run(itemIndex, threadIndex);
+			numPendingItems.fetch_sub(1, std::memory_order_release);
+			v = state.load();
+		}
+	}
+}
+
+}
@@ -0,0 +1,117 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef AUDIORENDERTHREADPOOL_H_INCLUDED
+#define AUDIORENDERTHREADPOOL_H_INCLUDED
+
+namespace hise {
+using namespace juce;
+
+class MainController;
+
+/** A fork-join pool that distributes rendering work of the audio callback across multiple threads.
+*
+*	The audio thread calls runParallel() with a Task object and the number of work items. The work items
+*	are picked up by the worker threads and the audio thread itself, and the call returns when every item
+*	has been processed. The audio thread doesn't acquire any lock or allocate memory while doing so, it just
+*	wakes up the workers that went to sleep since the last call and spins until the last item is finished.
+*
+*	Every task gets the index of the thread that executes it (the calling thread is always zero), so you can
+*	use this to assign per-thread scratch buffers without any synchronisation.
+*
+*	The pool is not reentrant: if runParallel() is called while another call is pending (eg. from within a task),
+*	the items will be processed serially on the calling thread.
+*
+*	Set HISE_NUM_AUDIO_RENDER_THREADS to a non-zero value in order to create a pool for each MainController.
+*/
+class AudioRenderThreadPool
+{
+public:
+
+	/** Subclass this and pass it to runParallel(). */
+	struct Task
+	{
+		virtual ~Task() {};
+
+		/** Processes the item with the given index. This will be called from multiple threads at the same time. */
+		virtual void run(int itemIndex, int threadIndex) = 0;
+	};
+
+	AudioRenderThreadPool(MainController* mc, int numWorkerThreads);
+
+	~AudioRenderThreadPool();
+
+	/** Processes all items of the given task and returns when they are done. The calling thread will also process items. */
+	void runParallel(Task& t, int numItems);
+
+	/** Returns the number of threads that can execute a task (the worker threads + the calling thread). */
+	int getNumThreads() const noexcept { return workers.size() + 1; }
+
+private:
+
+	struct Worker : public Thread
+	{
+		Worker(AudioRenderThreadPool& parent_, int threadIndex_);
+
+		void run() override;
+
+		AudioRenderThreadPool& parent;
+		const int threadIndex;
+
+		uint32 lastGeneration = 0;
+		std::atomic<bool> sleeping = { false };
+	};
+
+	static constexpr uint64 IndexMask = 0xFFFFFFFF;
+
+	/** Claims and processes items until the batch of the given generation is exhausted. */
+	void processItems(uint32 generation, int threadIndex);
+
+	MainController* mc;
+
+	// the upper 32 bits contain the generation, the lower 32 bits the next item index
+	std::atomic<uint64> state = { 0 };
+
+	std::atomic<Task*> currentTask = { nullptr };
+	std::atomic<int> numItemsInBatch = { 0 };
+	std::atomic<int> numPendingItems = { 0 };
+
+	std::atomic<bool> busy = { false };
+
+	OwnedArray<Worker> workers;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioRenderThreadPool);
+};
+
+}
+
+#endif
@@ -646,6 +646,16 @@ void SliderWithShiftTextBox::textEditorEscapeKeyPressed(TextEditor&)
 	updateValueFromLabel(false);
 }
 
+void HiSlider::repaintAfterValueChange()
+{
+	// value changes from the script or the automation are painted with the next
+	// frame of the UI updater, but the slider should follow the mouse without delay
+	if (!isMouseButtonDown() && getProcessor() != nullptr)
+		getProcessor()->getMainController()->getGlobalUIUpdater()->repaintPooled(this);
+	else
+		repaint();
+}
+
 void HiSlider::sliderValueChanged(Slider *s)
 {
 	jassert(s == this);
@@ -691,6 +691,9 @@ public:
 
 	void sliderValueChanged(Slider *s) override;
 
+	/** Collects the repaint in the global UI updater unless the user is dragging the slider. */
+	void repaintAfterValueChange() override;
+
 	void sliderDragStarted(Slider* s) override;
 
 	void sliderDragEnded(Slider* s) override;
@@ -161,6 +161,10 @@ bool MainController::unitTestMode = false;
 
 	javascriptThreadPool->startThread(8);
 	getKillStateHandler().setScriptingThreadId(javascriptThreadPool->getThreadId());
+
+#if HISE_NUM_AUDIO_RENDER_THREADS > 0
+	audioRenderThreadPool = new AudioRenderThreadPool(this, HISE_NUM_AUDIO_RENDER_THREADS);
+#endif
 };
 
 
@@ -175,6 +179,8 @@ MainController::~MainController()
 	javascriptThreadPool->cancelAllJobs();
 	sampleManager->cancelAllJobs();
 
+	audioRenderThreadPool = nullptr;
+
 	Logger::setCurrentLogger(nullptr);
 	logger = nullptr;
 	masterReference.clear();
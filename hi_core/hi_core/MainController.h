@@ -1514,6 +1514,9 @@ public:
 	JavascriptThreadPool& getJavascriptThreadPool() noexcept { return *javascriptThreadPool.get(); }
 	const JavascriptThreadPool& getJavascriptThreadPool() const noexcept { return *javascriptThreadPool.get(); }
 
+	/** Returns the pool for parallel voice rendering or nullptr if HISE_NUM_AUDIO_RENDER_THREADS is zero. */
+	AudioRenderThreadPool* getAudioRenderThreadPool() noexcept { return audioRenderThreadPool.get(); }
+
 	PooledUIUpdater* getGlobalUIUpdater() { return &globalUIUpdater; }
 	const PooledUIUpdater* getGlobalUIUpdater() const { return &globalUIUpdater; }
 
@@ -2157,6 +2160,8 @@ private:
 
 	ScopedPointer<JavascriptThreadPool> javascriptThreadPool;
 
+	ScopedPointer<AudioRenderThreadPool> audioRenderThreadPool;
+
 	friend class UserPresetHandler;
     friend class PresetLoadingThread;
 	friend class DelayedRenderer;
@@ -577,6 +577,9 @@ void DrawActions::ActionBase::setCachedImage(Image& actionImage_, Image& mainIma
 void DrawActions::ActionBase::setScaleFactor(float sf)
 { scaleFactor = sf; }
 
+bool DrawActions::ActionBase::isEqual(const ActionBase& other) const
+{ return false; }
+
 DrawActions::MarkdownAction::MarkdownAction(const MarkdownLayout::StringWidthFunction& f):
 	renderer("", f)
 {}
@@ -597,7 +600,7 @@ bool DrawActions::ActionLayer::wantsCachedImage() const
 	if(postActions.size() > 0)
 		return true;
 
-	for (auto a : internalActions)
+	for (auto a : list.actions)
 	{
 		if (a->wantsCachedImage())
 			return true;
@@ -614,7 +617,7 @@ void DrawActions::ActionLayer::setCachedImage(Image& actionImage_, Image& mainIm
 	ActionBase::setCachedImage(actionImage_, mainImage_);
 
 	// do not propagate the main image
-	for (auto a : internalActions)
+	for (auto a : list.actions)
 		a->setCachedImage(actionImage_, actionImage_);
 }
 
@@ -622,36 +625,63 @@ void DrawActions::ActionLayer::setScaleFactor(float sf)
 { 
 	ActionBase::setScaleFactor(sf);
 
-	for (auto a : internalActions)
+	for (auto a : list.actions)
 		a->setScaleFactor(sf);
 }
 
 void DrawActions::ActionLayer::perform(Graphics& g)
 {
-	for (auto action : internalActions)
-		action->perform(g);
+	list.perform(g);
 			
 	if (postActions.size() > 0)
 	{
-		PostGraphicsRenderer r(stack, actionImage, scaleFactor);
-		int numDataRequired = 0;
+		// The layer is rendered again if the component is repainted without new draw calls,
+		// so we can skip the effects. The cache is only filled when the layer is rendered for
+		// the second time, so that animated layers don't have to copy the image every frame.
+		const bool useCache = performedBefore;
+		performedBefore = true;
+
+		if (useCache && postCache.restore(actionImage))
+			return;
+
+		if (useCache)
+			postCache.setInput(actionImage);
 
-		for (auto p : postActions)
 		{
-			if (p->needsStackData())
-				numDataRequired++;
+			PostGraphicsRenderer r(stack, actionImage, scaleFactor, &workerPool.getObject());
+			int numDataRequired = 0;
+
+			for (auto p : postActions)
+			{
+				if (p->needsStackData())
+					numDataRequired++;
+			}
+
+			r.reserveStackOperations(numDataRequired);
+
+			for (auto p : postActions)
+				p->perform(r);
 		}
-				
-		r.reserveStackOperations(numDataRequired);
 
-		for (auto p : postActions)
-			p->perform(r);
+		if (useCache)
+			postCache.setOutput(actionImage);
 	}
 }
 
+bool DrawActions::ActionLayer::isEqual(const ActionBase& other) const
+{
+	// The post actions can't be compared
+	if (auto o = dynamic_cast<const ActionLayer*>(&other))
+		return getDispatchId() == o->getDispatchId() && drawOnParent == o->drawOnParent && postActions.isEmpty() && o->postActions.isEmpty() && list.isEqual(o->list);
+
+	return false;
+}
+
 void DrawActions::ActionLayer::addDrawAction(ActionBase* a)
 {
-	internalActions.add(a);
+	auto c = Command::create(Command::Type::Action);
+	c.handle = list.addAction(a);
+	list.commands.add(c);
 }
 
 void DrawActions::ActionLayer::addPostAction(PostActionBase* a)
@@ -670,6 +700,345 @@ DrawActions::BlendingLayer::BlendingLayer(gin::BlendMode m, float alpha_):
 bool DrawActions::BlendingLayer::wantsCachedImage() const
 { return true; }
 
+bool DrawActions::BlendingLayer::isEqual(const ActionBase& other) const
+{
+	if (auto o = dynamic_cast<const BlendingLayer*>(&other))
+		return alpha == o->alpha && blendMode == o->blendMode && ActionLayer::isEqual(other);
+
+	return false;
+}
+
+DrawActions::Command DrawActions::Command::create(Type t)
+{
+	static_assert(std::is_trivially_copyable<Command>::value && sizeof(Command) == 40, "Command must stay a tightly packed POD");
+
+	Command c;
+	memset(&c, 0, sizeof(Command));
+	c.type = t;
+	return c;
+}
+
+DrawActions::Command DrawActions::Command::fillAll(Colour col)
+{
+	auto c = create(Type::fillAll);
+	c.argb = col.getARGB();
+	return c;
+}
+
+DrawActions::Command DrawActions::Command::setColour(Colour col)
+{
+	auto c = create(Type::setColour);
+	c.argb = col.getARGB();
+	return c;
+}
+
+DrawActions::Command DrawActions::Command::setOpacity(float alpha)
+{
+	auto c = create(Type::setOpacity);
+	c.v[0] = alpha;
+	return c;
+}
+
+DrawActions::Command DrawActions::Command::fillRect(Rectangle<float> area)
+{
+	auto c = create(Type::fillRect);
+	c.v[0] = area.getX(); c.v[1] = area.getY(); c.v[2] = area.getWidth(); c.v[3] = area.getHeight();
+	return c;
+}
+
+DrawActions::Command DrawActions::Command::drawRect(Rectangle<float> area, float borderSize)
+{
+	auto c = fillRect(area);
+	c.type = Type::drawRect;
+	c.v[4] = borderSize;
+	return c;
+}
+
+DrawActions::Command DrawActions::Command::fillEllipse(Rectangle<float> area)
+{
+	auto c = fillRect(area);
+	c.type = Type::fillEllipse;
+	return c;
+}
+
+DrawActions::Command DrawActions::Command::drawEllipse(Rectangle<float> area, float lineThickness)
+{
+	auto c = fillRect(area);
+	c.type = Type::drawEllipse;
+	c.v[4] = lineThickness;
+	return c;
+}
+
+DrawActions::Command DrawActions::Command::fillRoundedRect(Rectangle<float> area, float cornerSize, int corners)
+{
+	auto c = fillRect(area);
+	c.type = Type::fillRoundedRect;
+	c.flags[0] = (uint8)corners;
+	c.v[4] = cornerSize;
+	return c;
+}
+
+DrawActions::Command DrawActions::Command::drawRoundedRect(Rectangle<float> area, float cornerSize, float borderSize, int corners)
+{
+	auto c = fillRoundedRect(area, cornerSize, corners);
+	c.type = Type::drawRoundedRect;
+	c.v[5] = borderSize;
+	return c;
+}
+
+DrawActions::Command DrawActions::Command::drawLine(float x1, float y1, float x2, float y2, float lineThickness)
+{
+	auto c = create(Type::drawLine);
+	c.v[0] = x1; c.v[1] = y1; c.v[2] = x2; c.v[3] = y2; c.v[4] = lineThickness;
+	return c;
+}
+
+DrawActions::Command DrawActions::Command::drawHorizontalLine(int y, float x1, float x2)
+{
+	auto c = create(Type::drawHorizontalLine);
+	c.extra = y;
+	c.v[0] = x1; c.v[1] = x2;
+	return c;
+}
+
+DrawActions::Command DrawActions::Command::drawVerticalLine(int x, float y1, float y2)
+{
+	auto c = drawHorizontalLine(x, y1, y2);
+	c.type = Type::drawVerticalLine;
+	return c;
+}
+
+DrawActions::Command DrawActions::Command::addTransform(const AffineTransform& a)
+{
+	auto c = create(Type::addTransform);
+	c.v[0] = a.mat00; c.v[1] = a.mat01; c.v[2] = a.mat02;
+	c.v[3] = a.mat10; c.v[4] = a.mat11; c.v[5] = a.mat12;
+	return c;
+}
+
+DrawActions::Command DrawActions::Command::fillPath()
+{ return create(Type::fillPath); }
+
+DrawActions::Command DrawActions::Command::strokePath(const PathStrokeType& s)
+{
+	auto c = create(Type::strokePath);
+	c.flags[0] = (uint8)s.getJointStyle();
+	c.flags[1] = (uint8)s.getEndStyle();
+	c.v[0] = s.getStrokeThickness();
+	return c;
+}
+
+DrawActions::Command DrawActions::Command::setFont()
+{ return create(Type::setFont); }
+
+DrawActions::Command DrawActions::Command::drawText(Rectangle<float> area, Justification j)
+{
+	auto c = fillRect(area);
+	c.type = Type::drawText;
+	c.extra = j.getFlags();
+	return c;
+}
+
+dispatch::HashedCharPtr DrawActions::Command::getDispatchId(Type t)
+{
+	switch (t)
+	{
+	case Type::Action:				return dispatch::HashedCharPtr("action");
+	case Type::fillAll:				return dispatch::HashedCharPtr("fillAll");
+	case Type::setColour:			return dispatch::HashedCharPtr("setColour");
+	case Type::setOpacity:			return dispatch::HashedCharPtr("setOpacity");
+	case Type::fillRect:			return dispatch::HashedCharPtr("fillRect");
+	case Type::drawRect:			return dispatch::HashedCharPtr("drawRect");
+	case Type::fillEllipse:			return dispatch::HashedCharPtr("fillEllipse");
+	case Type::drawEllipse:			return dispatch::HashedCharPtr("drawEllipse");
+	case Type::fillRoundedRect:		return dispatch::HashedCharPtr("fillRoundedRect");
+	case Type::drawRoundedRect:		return dispatch::HashedCharPtr("drawRoundedRectangle");
+	case Type::drawLine:			return dispatch::HashedCharPtr("drawLine");
+	case Type::drawHorizontalLine:	return dispatch::HashedCharPtr("drawHorizontalLine");
+	case Type::drawVerticalLine:	return dispatch::HashedCharPtr("drawVerticalLine");
+	case Type::addTransform:		return dispatch::HashedCharPtr("addTransform");
+	case Type::fillPath:			return dispatch::HashedCharPtr("fillPath");
+	case Type::strokePath:			return dispatch::HashedCharPtr("drawPath");
+	case Type::setFont:				return dispatch::HashedCharPtr("setFont");
+	case Type::drawText:			return dispatch::HashedCharPtr("drawText");
+	default:						return dispatch::HashedCharPtr("unknown");
+	}
+}
+
+void DrawActions::DisplayList::clear()
+{
+	commands.clearQuick();
+	actions.clearQuick();
+
+	numPaths = 0;
+	numTexts = 0;
+	numFonts = 0;
+}
+
+bool DrawActions::DisplayList::isEqual(const DisplayList& other) const
+{
+	if (commands.size() != other.commands.size() ||
+		actions.size() != other.actions.size() ||
+		numPaths != other.numPaths ||
+		numTexts != other.numTexts ||
+		numFonts != other.numFonts)
+		return false;
+
+	if (memcmp(commands.begin(), other.commands.begin(), sizeof(Command) * commands.size()) != 0)
+		return false;
+
+	for (int i = 0; i < actions.size(); i++)
+	{
+		auto a = actions.getObjectPointerUnchecked(i);
+		auto b = other.actions.getObjectPointerUnchecked(i);
+
+		if (a != b && !a->isEqual(*b))
+			return false;
+	}
+
+	for (int i = 0; i < numPaths; i++)
+	{
+		if (paths.getReference(i) != other.paths.getReference(i))
+			return false;
+	}
+
+	for (int i = 0; i < numTexts; i++)
+	{
+		if (texts.getReference(i) != other.texts.getReference(i))
+			return false;
+	}
+
+	for (int i = 0; i < numFonts; i++)
+	{
+		if (fonts.getReference(i) != other.fonts.getReference(i))
+			return false;
+	}
+
+	return true;
+}
+
+int DrawActions::DisplayList::addPath(const Path& p)
+{
+	if (numPaths == paths.size())
+		paths.add(p);
+	else
+	{
+		// Path::operator= would reallocate the point data
+		auto& target = paths.getReference(numPaths);
+		target.clear();
+		target.addPath(p);
+		target.setUsingNonZeroWinding(p.isUsingNonZeroWinding());
+	}
+
+	return numPaths++;
+}
+
+int DrawActions::DisplayList::addText(const String& t)
+{
+	if (numTexts == texts.size())
+		texts.add(t);
+	else
+		texts.getReference(numTexts) = t;
+
+	return numTexts++;
+}
+
+int DrawActions::DisplayList::addFont(const Font& f)
+{
+	if (numFonts == fonts.size())
+		fonts.add(f);
+	else
+		fonts.getReference(numFonts) = f;
+
+	return numFonts++;
+}
+
+int DrawActions::DisplayList::addAction(ActionBase* a)
+{
+	actions.add(a);
+	return actions.size() - 1;
+}
+
+void DrawActions::DisplayList::perform(Graphics& g, const Command& c) const
+{
+	auto area = [&c]() { return Rectangle<float>(c.v[0], c.v[1], c.v[2], c.v[3]); };
+
+	switch (c.type)
+	{
+	case Command::Type::Action:		actions.getObjectPointerUnchecked(c.handle)->perform(g); break;
+	case Command::Type::fillAll:	g.fillAll(Colour(c.argb)); break;
+	case Command::Type::setColour:	g.setColour(Colour(c.argb)); break;
+	case Command::Type::setOpacity: g.setOpacity(c.v[0]); break;
+	case Command::Type::fillRect:	g.fillRect(area()); break;
+	case Command::Type::drawRect:	g.drawRect(area(), c.v[4]); break;
+	case Command::Type::fillEllipse: g.fillEllipse(area()); break;
+	case Command::Type::drawEllipse: g.drawEllipse(area(), c.v[4]); break;
+	case Command::Type::fillRoundedRect:
+	case Command::Type::drawRoundedRect:
+	{
+		auto isFilled = c.type == Command::Type::fillRoundedRect;
+		auto corners = c.flags[0];
+
+		if (corners == Command::AllCorners)
+		{
+			if (isFilled)
+				g.fillRoundedRectangle(area(), c.v[4]);
+			else
+				g.drawRoundedRectangle(area(), c.v[4], c.v[5]);
+		}
+		else if (corners == 0)
+		{
+			if (isFilled)
+				g.fillRect(area());
+			else
+				g.drawRect(area(), c.v[5]);
+		}
+		else
+		{
+			Path p;
+			p.addRoundedRectangle(c.v[0], c.v[1], c.v[2], c.v[3], c.v[4], c.v[4],
+								  (corners & Command::TopLeft) != 0, (corners & Command::TopRight) != 0,
+								  (corners & Command::BottomLeft) != 0, (corners & Command::BottomRight) != 0);
+
+			if (isFilled)
+				g.fillPath(p);
+			else
+				g.strokePath(p, PathStrokeType(c.v[5]));
+		}
+
+		break;
+	}
+	case Command::Type::drawLine:			g.drawLine(c.v[0], c.v[1], c.v[2], c.v[3], c.v[4]); break;
+	case Command::Type::drawHorizontalLine: g.drawHorizontalLine(c.extra, c.v[0], c.v[1]); break;
+	case Command::Type::drawVerticalLine:	g.drawVerticalLine(c.extra, c.v[0], c.v[1]); break;
+	case Command::Type::addTransform:		g.addTransform(AffineTransform(c.v[0], c.v[1], c.v[2], c.v[3], c.v[4], c.v[5])); break;
+	case Command::Type::fillPath:			g.fillPath(paths.getReference(c.handle)); break;
+	case Command::Type::strokePath:
+	{
+		PathStrokeType s(c.v[0], (PathStrokeType::JointStyle)c.flags[0], (PathStrokeType::EndCapStyle)c.flags[1]);
+		g.strokePath(paths.getReference(c.handle), s);
+		break;
+	}
+	case Command::Type::setFont:	g.setFont(fonts.getReference(c.handle)); break;
+	case Command::Type::drawText:	g.drawText(texts.getReference(c.handle), area(), Justification(c.extra)); break;
+	default:						jassertfalse; break;
+	}
+}
+
+void DrawActions::DisplayList::perform(Graphics& g) const
+{
+	for (const auto& c : commands)
+	{
+#if PERFETTO
+		dispatch::StringBuilder b;
+		b << "g." << (c.type == Command::Type::Action ? actions[c.handle]->getDispatchId() : Command::getDispatchId(c.type)) << "()";
+		TRACE_EVENT("drawactions", DYNAMIC_STRING_BUILDER(b));
+#endif
+
+		perform(g, c);
+	}
+}
+
 void DrawActions::NoiseMapManager::drawNoiseMap(Graphics& g, Rectangle<int> area, float alpha, bool monochrom,
 	float scale)
 {
@@ -724,39 +1093,41 @@ DrawActions::Handler::Iterator::Iterator(Handler* handler_):
 {
 	if (handler != nullptr)
 	{
-		actionsInIterator.ensureStorageAllocated(handler->nextActions.size());
 		SpinLock::ScopedLockType sl(handler->lock);
-
-		actionsInIterator.addArray(handler->nextActions);
+		list = handler->nextList;
 	}
 }
 
-DrawActions::ActionBase::Ptr DrawActions::Handler::Iterator::getNextAction()
-{
-	if (index < actionsInIterator.size())
-		return actionsInIterator[index++];
-
-	return nullptr;
-}
-
 bool DrawActions::Handler::Iterator::wantsCachedImage() const
 {
-	for (auto action : actionsInIterator)
-		if (action != nullptr && action->wantsCachedImage())
-			return true;
+	if (list != nullptr)
+	{
+		for (auto action : list->actions)
+			if (action != nullptr && action->wantsCachedImage())
+				return true;
+	}
 
 	return false;
 }
 
 bool DrawActions::Handler::Iterator::wantsToDrawOnParent() const
 {
-	for (auto action : actionsInIterator)
-		if (action != nullptr && action->wantsToDrawOnParent())
-			return true;
+	if (list != nullptr)
+	{
+		for (auto action : list->actions)
+			if (action != nullptr && action->wantsToDrawOnParent())
+				return true;
+	}
 
 	return false;
 }
 
+void DrawActions::Handler::Iterator::perform(Graphics& g)
+{
+	if (list != nullptr)
+		list->perform(g);
+}
+
 DrawActions::Handler::Listener::~Listener()
 {}
 
@@ -767,7 +1138,7 @@ DrawActions::Handler::~Handler()
 
 void DrawActions::Handler::beginDrawing()
 {
-	currentActions.clear();
+	currentList->clear();
 }
 
 void DrawActions::Handler::beginLayer(bool drawOnParent)
@@ -790,22 +1161,76 @@ void DrawActions::Handler::endLayer()
 
 void DrawActions::Handler::addDrawAction(ActionBase* newDrawAction)
 {
-	if (layerStack.getLast() != nullptr)
-		layerStack.getLast()->addDrawAction(newDrawAction);
-	else
-		currentActions.add(newDrawAction);
+	auto& l = getCommandTarget();
+	auto c = Command::create(Command::Type::Action);
+	c.handle = l.addAction(newDrawAction);
+	l.commands.add(c);
+}
+
+DrawActions::DisplayList& DrawActions::Handler::getCommandTarget()
+{
+	if (auto l = layerStack.getLast())
+		return l->getDisplayList();
+
+	return *currentList;
+}
+
+void DrawActions::Handler::addCommand(const Command& c)
+{
+	jassert(c.type != Command::Type::Action);
+	getCommandTarget().commands.add(c);
+}
+
+void DrawActions::Handler::addCommand(Command c, const Path& p)
+{
+	jassert(c.type == Command::Type::fillPath || c.type == Command::Type::strokePath);
+
+	auto& l = getCommandTarget();
+	c.handle = l.addPath(p);
+	l.commands.add(c);
+}
+
+void DrawActions::Handler::addCommand(Command c, const String& text)
+{
+	jassert(c.type == Command::Type::drawText);
+
+	auto& l = getCommandTarget();
+	c.handle = l.addText(text);
+	l.commands.add(c);
+}
+
+void DrawActions::Handler::addCommand(Command c, const Font& f)
+{
+	jassert(c.type == Command::Type::setFont);
+
+	auto& l = getCommandTarget();
+	c.handle = l.addFont(f);
+	l.commands.add(c);
 }
 
 void DrawActions::Handler::flush(uint64_t perfettoTrackId)
 {
+	// The next list is only written from this method, so we can compare it without the lock
+	auto unchanged = nextList != nullptr && currentList->isEqual(*nextList);
+
 	{
 		SpinLock::ScopedLockType sl(lock);
 
-		nextActions.swapWith(currentActions);
-		currentActions.clear();
 		layerStack.clear();
+
+		if (!unchanged)
+			std::swap(nextList, currentList);
 	}
 
+	// Reuse the storage of the previous list unless it is still being rendered
+	if (currentList == nullptr || currentList->getReferenceCount() > 1)
+		currentList = new DisplayList();
+	else
+		currentList->clear();
+
+	if (unchanged)
+		return;
+
 	if(perfettoTrackId != 0)
 		flowManager.continueFlow(perfettoTrackId, "flush draw handler");
 
@@ -1405,7 +1830,7 @@ void DrawActions::BlendingLayer::perform(Graphics& g)
 
 	blendSource = Image(Image::ARGB, actionImage.getWidth(), actionImage.getHeight(), true);
 
-	for (auto a : internalActions)
+	for (auto a : list.actions)
 	{
 		if (a->wantsCachedImage())
 			a->setCachedImage(blendSource, actionImage);
@@ -1416,12 +1841,12 @@ void DrawActions::BlendingLayer::perform(Graphics& g)
     g2.addTransform(AffineTransform::scale(scaleFactor));
 
 	ActionLayer::perform(g2);
-	gin::applyBlend(imageToBlendOn, blendSource, blendMode, alpha);
+	gin::applyBlend(imageToBlendOn, blendSource, blendMode, alpha, {}, &workerPool.getObject());
 }
 
 void DrawActions::Handler::Iterator::render(Graphics& g, Component* c)
 {
-	if (handler->recursion)
+	if (handler->recursion || list == nullptr)
 		return;
 
 	UnblurryGraphics ug(g, *c);
@@ -1461,8 +1886,16 @@ void DrawActions::Handler::Iterator::render(Graphics& g, Component* c)
 		Graphics g2(cachedImg);
 		g2.addTransform(st);
 
-		while (auto action = getNextAction())
+		for (const auto& command : list->commands)
 		{
+			if (command.type != Command::Type::Action)
+			{
+				list->perform(g2, command);
+				continue;
+			}
+
+			auto action = list->actions.getObjectPointerUnchecked(command.handle);
+
 #if PERFETTO
 			dispatch::StringBuilder b;
 			b << "g." << action->getDispatchId() << "()";
@@ -1500,17 +1933,7 @@ void DrawActions::Handler::Iterator::render(Graphics& g, Component* c)
 	}
 	else
 	{
-		while (auto action = getNextAction())
-		{
-#if PERFETTO
-			dispatch::StringBuilder b;
-			b << "g." << action->getDispatchId() << "()";
-			TRACE_EVENT("drawactions", DYNAMIC_STRING_BUILDER(b));
-#endif
-
-			action->perform(g);
-		}
-			
+		list->perform(g);
 	}
 }
 
@@ -324,6 +324,13 @@ struct DrawActions
 		virtual void setCachedImage(Image& actionImage_, Image& mainImage_);
 		virtual void setScaleFactor(float sf);
 
+		/** Checks whether the other action will produce the same output.
+
+			Actions are recreated in every paint routine, so override this in actions that only store
+			values in order to let the handler skip the repaint if nothing has changed.
+		*/
+		virtual bool isEqual(const ActionBase& other) const;
+
 	protected:
 
 		Image actionImage;
@@ -352,6 +359,124 @@ struct DrawActions
 		Rectangle<float> area;
 	};
 
+	/** A compact record of a simple draw call.
+
+		Most calls in a paint routine just set a colour or fill a rectangle, so instead of allocating an
+		ActionBase object for each of them, they are stored as plain data in the DisplayList. Anything that
+		needs heap data (paths, texts, fonts) is stored in a pool of the list and referenced by its handle.
+
+		The record is zero-initialised on creation so that two lists can be compared with memcmp.
+	*/
+	struct Command
+	{
+		enum class Type: uint8
+		{
+			Action,				// an ActionBase object, the handle is the index in the action list
+			fillAll,
+			setColour,
+			setOpacity,
+			fillRect,
+			drawRect,
+			fillEllipse,
+			drawEllipse,
+			fillRoundedRect,
+			drawRoundedRect,
+			drawLine,
+			drawHorizontalLine,
+			drawVerticalLine,
+			addTransform,
+			fillPath,			// the handle is the index in the path pool
+			strokePath,			// the handle is the index in the path pool
+			setFont,			// the handle is the index in the font pool
+			drawText,			// the handle is the index in the text pool
+			numTypes
+		};
+
+		/** The corner flags for the rounded rectangle commands. */
+		enum Corners
+		{
+			TopLeft = 1,
+			TopRight = 2,
+			BottomLeft = 4,
+			BottomRight = 8,
+			AllCorners = 15
+		};
+
+		static Command fillAll(Colour c);
+		static Command setColour(Colour c);
+		static Command setOpacity(float alpha);
+		static Command fillRect(Rectangle<float> area);
+		static Command drawRect(Rectangle<float> area, float borderSize);
+		static Command fillEllipse(Rectangle<float> area);
+		static Command drawEllipse(Rectangle<float> area, float lineThickness);
+		static Command fillRoundedRect(Rectangle<float> area, float cornerSize, int corners=AllCorners);
+		static Command drawRoundedRect(Rectangle<float> area, float cornerSize, float borderSize, int corners = AllCorners);
+		static Command drawLine(float x1, float y1, float x2, float y2, float lineThickness);
+		static Command drawHorizontalLine(int y, float x1, float x2);
+		static Command drawVerticalLine(int x, float y1, float y2);
+		static Command addTransform(const AffineTransform& a);
+		static Command fillPath();
+		static Command strokePath(const PathStrokeType& s);
+		static Command setFont();
+		static Command drawText(Rectangle<float> area, Justification j);
+
+		/** Creates an empty record of the given type. */
+		static Command create(Type t);
+
+		static dispatch::HashedCharPtr getDispatchId(Type t);
+
+		Type type;
+		uint8 flags[3];		// the corners of rounded rectangles or the joint / end cap style of a stroke
+		uint32 argb;
+		int32 handle;
+		int32 extra;
+		float v[6];
+	};
+
+	/** A list of draw calls for one frame.
+
+		The storage is kept when the list is cleared, so once a few frames have been rendered, a paint
+		routine that only uses the simple commands doesn't allocate anymore. The handler keeps the last
+		list around in order to skip the repaint if a paint routine creates exactly the same output.
+	*/
+	struct DisplayList : public ReferenceCountedObject
+	{
+		using Ptr = ReferenceCountedObjectPtr<DisplayList>;
+
+		/** Resets the list but keeps the allocated storage. */
+		void clear();
+
+		/** Checks whether the two lists will produce the same output. */
+		bool isEqual(const DisplayList& other) const;
+
+		bool isEmpty() const { return commands.isEmpty(); }
+
+		int addPath(const Path& p);
+		int addText(const String& t);
+		int addFont(const Font& f);
+		int addAction(ActionBase* a);
+
+		/** Performs a single command. */
+		void perform(Graphics& g, const Command& c) const;
+
+		/** Performs all commands of this list. */
+		void perform(Graphics& g) const;
+
+		Array<Command> commands;
+		ReferenceCountedArray<ActionBase> actions;
+
+	private:
+
+		int numPaths = 0;
+		Array<Path> paths;
+
+		int numTexts = 0;
+		Array<String> texts;
+
+		int numFonts = 0;
+		Array<Font> fonts;
+	};
+
 	class ActionLayer : public ActionBase
 	{
 	public:
@@ -372,17 +497,25 @@ struct DrawActions
 
 		void perform(Graphics& g);
 
+		bool isEqual(const ActionBase& other) const override;
+
 		void addDrawAction(ActionBase* a);
 
 		void addPostAction(PostActionBase* a);
 
+		/** The draw calls of this layer. */
+		DisplayList& getDisplayList() { return list; }
+
 	protected:
 
 		bool drawOnParent = false;
 
-		OwnedArray<ActionBase> internalActions;
+		DisplayList list;
 		OwnedArray<PostActionBase> postActions;
 		PostGraphicsRenderer::DataStack stack;
+		PostGraphicsRenderer::ResultCache postCache;
+		bool performedBefore = false;
+		SharedResourcePointer<PostGraphicsRenderer::WorkerPool> workerPool;
 	};
 
 	class BlendingLayer : public ActionLayer
@@ -395,6 +528,8 @@ struct DrawActions
 
 		bool wantsCachedImage() const override;
 
+		bool isEqual(const ActionBase& other) const override;
+
 		void perform(Graphics& g) override;
 
 		float alpha;
@@ -438,16 +573,16 @@ struct DrawActions
 		{
 			Iterator(Handler* handler_);
 
-			ActionBase::Ptr getNextAction();
-
 			bool wantsCachedImage() const;
 
 			bool wantsToDrawOnParent() const;
 
 			void render(Graphics& g, Component* c);
 
-			int index = 0;
-			ReferenceCountedArray<ActionBase> actionsInIterator;
+			/** Performs all draw calls directly on the given context without the cached image. */
+			void perform(Graphics& g);
+
+			DisplayList::Ptr list;
 			Handler* handler;
 		};
 
@@ -473,6 +608,23 @@ struct DrawActions
 
 		void addDrawAction(ActionBase* newDrawAction);
 
+		/** Adds a draw call that doesn't need any heap data. */
+		void addCommand(const Command& c);
+
+		/** Adds a fillPath or strokePath command. The path is copied into the path pool of the list. */
+		void addCommand(Command c, const Path& p);
+
+		/** Adds a drawText command. */
+		void addCommand(Command c, const String& text);
+
+		/** Adds a setFont command. */
+		void addCommand(Command c, const Font& f);
+
+		/** Publishes the draw calls that were added since the last flush.
+
+			If they are exactly the same as the ones that are currently displayed, the listeners will not be
+			notified so that the panel can skip the repaint.
+		*/
 		void flush(uint64_t perfettoTrackId);
 
 		void logError(const String& message);
@@ -499,6 +651,9 @@ struct DrawActions
 
 		SharedResourcePointer<NoiseMapManager> noiseManager;
 
+		// keeps the worker pool of the layers alive between frames
+		SharedResourcePointer<PostGraphicsRenderer::WorkerPool> workerPool;
+
 		Rectangle<int> globalBounds;
 		Rectangle<int> topLevelBounds;
 		float scaleFactor = 1.0f;
@@ -511,8 +666,10 @@ struct DrawActions
 
 		ReferenceCountedArray<ActionLayer> layerStack;
 
-		ReferenceCountedArray<ActionBase> nextActions;
-		ReferenceCountedArray<ActionBase> currentActions;
+		DisplayList& getCommandTarget();
+
+		DisplayList::Ptr nextList;
+		DisplayList::Ptr currentList = new DisplayList();
 
 		JUCE_DECLARE_WEAK_REFERENCEABLE(Handler);
 	};
@@ -839,8 +839,12 @@ void Chain::Handler::removePostEventListener(Listener* l)
 	postEventlisteners.removeAllInstancesOf(l);
 }
 
+std::atomic<int> Chain::Handler::structureVersion = { 0 };
+
 void Chain::Handler::notifyListeners(Listener::EventType t, Processor* p)
 {
+	structureVersion.fetch_add(1);
+
 	ScopedLock sl(listeners.getLock());
 
 	for (auto l : listeners)
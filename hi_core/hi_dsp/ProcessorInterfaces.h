@@ -482,8 +482,16 @@ public:
 
 		void notifyPostEventListeners(Listener::EventType t, Processor* p);
 
+		/** Returns a counter that is incremented whenever a processor is added to or removed from any chain.
+		*
+		*	You can use this on the audio thread to check whether data that depends on the processor tree needs to be updated.
+		*/
+		static int getStructureVersion() noexcept { return structureVersion.load(); }
+
 	private:
 
+		static std::atomic<int> structureVersion;
+
 		
 
 		Array<WeakReference<Listener>, CriticalSection> listeners;
@@ -321,6 +321,30 @@ juce::MidiMessage* HiseMidiSequence::getNextEvent(Range<double> rangeToLookForTi
 	return nullptr;
 }
 
+int HiseMidiSequence::getUpcomingNoteOns(Range<double> rangeToLookForTicks, const MidiMessage** notes, int maxNumNotes) const
+{
+	SimpleReadWriteLock::ScopedReadLock sl(swapLock);
+
+	int numFound = 0;
+
+	if (auto seq = getReadPointer(currentTrackIndex))
+	{
+		for (int i = jmax(0, lastPlayedIndex + 1); i < seq->getNumEvents() && numFound < maxNumNotes; i++)
+		{
+			const auto& m = seq->getEventPointer(i)->message;
+			auto ts = m.getTimeStamp();
+
+			if (ts >= rangeToLookForTicks.getEnd())
+				break;
+
+			if (m.isNoteOn() && rangeToLookForTicks.contains(ts))
+				notes[numFound++] = &m;
+		}
+	}
+
+	return numFound;
+}
+
 juce::MidiMessage* HiseMidiSequence::getMatchingNoteOffForCurrentEvent()
 {
 	if (auto noteOff = getReadPointer(currentTrackIndex)->getEventPointer(lastPlayedIndex)->noteOffObject)
@@ -1584,6 +1608,9 @@ void MidiPlayer::preprocessBuffer(HiseEventBuffer& buffer, int numSamples)
 			currentPosition += delta;
 			ticksSincePlaybackStart += tickThisTime;
 
+			if (!isBypassed() && !isRecording())
+				addPredictedNoteOns(*seq, currentRange.getEnd());
+
 			if (isRecording() && overdubMode)
 			{
 				overdubUpdater.setDirty();
@@ -2466,6 +2493,40 @@ void MidiPlayer::updatePositionInCurrentSequence(bool ignorePlaybackspeed)
 	}
 }
 
+void MidiPlayer::addPredictedNoteOns(const HiseMidiSequence& seq, double positionInTicks)
+{
+#if HISE_SAMPLE_PREFETCH_MILLISECONDS > 0
+	auto ticksPerSample = getTicksPerSample();
+
+	if (ticksPerSample <= 0.0)
+		return;
+
+	auto lookaheadSamples = MidiPlayerHelpers::secondsToSamples((double)HISE_SAMPLE_PREFETCH_MILLISECONDS * 0.001, getSampleRate());
+	Range<double> lookaheadRange(positionInTicks, positionInTicks + lookaheadSamples * ticksPerSample);
+
+	const MidiMessage* upcoming[32];
+	auto numUpcoming = seq.getUpcomingNoteOns(lookaheadRange, upcoming, 32);
+
+	auto midiChain = getOwnerSynth()->midiProcessorChain.get();
+
+	for (int i = 0; i < numUpcoming; i++)
+	{
+		auto& m = *upcoming[i];
+
+		// the position is the end of this block, so the timestamp is already relative to the next block
+		auto timestamp = roundToInt((m.getTimeStamp() - positionInTicks) / ticksPerSample);
+
+		HiseEvent e(HiseEvent::Type::NoteOn, (uint8)m.getNoteNumber(), m.getVelocity(), (uint8)(currentTrackIndex + 1));
+		e.setTimeStamp(jmax(0, timestamp));
+		e.setArtificial();
+
+		midiChain->addPredictedEvent(e);
+	}
+#else
+	ignoreUnused(seq, positionInTicks);
+#endif
+}
+
 void MidiPlayer::addNoteOffsToPendingNoteOns()
 {
 	auto midiChain = getOwnerSynth()->midiProcessorChain.get();
@@ -128,6 +128,13 @@ public:
 	/** Returns the MIDI note off message for the current note on message. */
 	MidiMessage* getMatchingNoteOffForCurrentEvent();
 
+	/** Writes the note on messages of the current track in the given range into the array without advancing the playback pointer. 
+	
+		This only looks at the events after the current playback position and doesn't wrap around the loop. Returns the number 
+		of found messages.
+	*/
+	int getUpcomingNoteOns(Range<double> rangeToLookForTicks, const MidiMessage** notes, int maxNumNotes) const;
+
 	/** Returns the length in ticks (as defined with TicksPerQuarter). */
 	double getLength() const;
 
@@ -705,6 +712,9 @@ private:
 
 	void addNoteOffsToPendingNoteOns();
 
+	/** Tells the owner synth about the notes that will be played within the prefetch time. */
+	void addPredictedNoteOns(const HiseMidiSequence& seq, double positionInTicks);
+
 	bool flushRecordedEvents = true;
 	double currentPosition = -1.0;
 	int currentSequenceIndex = -1;
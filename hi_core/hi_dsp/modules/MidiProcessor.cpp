@@ -817,8 +817,16 @@ bool MidiProcessorChain::setArtificialTimestamp(uint16 eventId, int newTimestamp
 	return false;
 }
 
+void MidiProcessorChain::addPredictedEvent(const HiseEvent& e)
+{
+	if (predictedEvents.getNumUsed() < HISE_EVENT_BUFFER_SIZE)
+		predictedEvents.addEvent(e);
+}
+
 void MidiProcessorChain::renderNextHiseEventBuffer(HiseEventBuffer &buffer, int numSamples)
 {
+	predictedEvents.clear();
+
 	if (allNotesOffAtNextBuffer)
 	{
 		buffer.clear();
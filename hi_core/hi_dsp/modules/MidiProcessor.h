@@ -180,6 +180,22 @@ public:
 
 	bool setArtificialTimestamp(uint16 eventId, int newTimestamp);
 
+	/** Returns the events that are scheduled for one of the next blocks. 
+	
+		After renderNextHiseEventBuffer() the timestamps are relative to the start of the next block.
+	*/
+	const HiseEventBuffer& getArtificialEvents() const noexcept { return artificialEvents; }
+
+	/** Adds a note that is expected to arrive within the next blocks without scheduling it.
+	
+		This is used by the MIDI player to tell the samplers which samples they should prefetch. 
+		The timestamp must be relative to the start of the next block.
+	*/
+	void addPredictedEvent(const HiseEvent& e);
+
+	/** Returns the predicted events of the current block. */
+	const HiseEventBuffer& getPredictedEvents() const noexcept { return predictedEvents; }
+
 	void sendAllNoteOffEvent();;
 
 	void renderNextHiseEventBuffer(HiseEventBuffer &buffer, int numSamples);
@@ -340,6 +356,7 @@ private:
 	Array<WeakReference<MidiProcessor>> wholeBufferProcessors;
 
 	HiseEventBuffer artificialEvents;
+	HiseEventBuffer predictedEvents;
 };
 
 class HardcodedScriptFactoryType;
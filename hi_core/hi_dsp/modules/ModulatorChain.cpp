@@ -693,6 +693,33 @@ void ModulatorChain::ModChainWithBuffer::calculateModulationValuesForCurrentVoic
 	c->polyManager.clearCurrentVoice();
 }
 
+void ModulatorChain::ModChainWithBuffer::calculateVoiceBatch(const int* voiceIndexes, int numVoices, int startSample, int numSamples)
+{
+	if (c->isVoiceStartChain || !c->hasActivePolyEnvelopes())
+		return;
+
+	jassert(startSample % HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR == 0);
+
+	const int startSample_cr = startSample / HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
+	const int numSamples_cr = numSamples / HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
+
+	ModIterator<EnvelopeModulator> iter(c);
+
+	while (auto mod = iter.next())
+		mod->calculateVoiceBatch(voiceIndexes, numVoices, startSample_cr, numSamples_cr);
+}
+
+void ModulatorChain::ModChainWithBuffer::clearVoiceBatch()
+{
+	if (c->isVoiceStartChain)
+		return;
+
+	ModIterator<EnvelopeModulator> iter(c);
+
+	while (auto mod = iter.next())
+		mod->clearVoiceBatch();
+}
+
 void ModulatorChain::ModChainWithBuffer::applyMonophonicModulationValues(AudioSampleBuffer& b, int startSample, int numSamples)
 {
 	if (c->hasMonophonicTimeModulationMods())
@@ -790,6 +817,58 @@ void ModulatorChain::ModChainWithBuffer::setIncludeMonophonicValuesInVoiceRender
 }
 
 
+void ModulatorChain::ModChainWithBuffer::setNumVoiceSnapshots(int numSnapshots, int samplesPerBlock)
+{
+	if (type != Type::Normal || numSnapshots <= 0)
+	{
+		voiceSnapshots.free();
+		voiceSnapshotData.free();
+		numVoiceSnapshots = 0;
+		return;
+	}
+
+	const int snapshotSize = samplesPerBlock + dsp::SIMDRegister<float>::SIMDRegisterSize;
+
+	voiceSnapshots.calloc(numSnapshots);
+	voiceSnapshotData.calloc(numSnapshots * snapshotSize);
+
+	for (int i = 0; i < numSnapshots; i++)
+		voiceSnapshots[i].data = dsp::SIMDRegister<float>::getNextSIMDAlignedPtr(voiceSnapshotData + i * snapshotSize);
+
+	numVoiceSnapshots = numSnapshots;
+}
+
+void ModulatorChain::ModChainWithBuffer::storeVoiceSnapshot(int snapshotIndex, int startSample, int numSamples, const float* overrideData)
+{
+	jassert(isPositiveAndBelow(snapshotIndex, numVoiceSnapshots));
+
+	auto& s = voiceSnapshots[snapshotIndex];
+	auto source = overrideData != nullptr ? overrideData : currentVoiceData;
+
+	s.constantValue = currentConstantValue;
+	s.hasData = source != nullptr;
+	s.expanded = polyExpandChecker;
+
+	if (s.hasData)
+	{
+		// Copy everything from the control rate offset to the end of the audio rate range, so it doesn't 
+		// matter if the values were expanded or not
+		const int start = startSample / HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
+		FloatVectorOperations::copy(s.data + start, source + start, startSample + numSamples - start);
+	}
+}
+
+void ModulatorChain::ModChainWithBuffer::restoreVoiceSnapshot(int snapshotIndex)
+{
+	jassert(isPositiveAndBelow(snapshotIndex, numVoiceSnapshots));
+
+	const auto& s = voiceSnapshots[snapshotIndex];
+
+	currentConstantValue = s.constantValue;
+	currentVoiceData = s.hasData ? s.data : nullptr;
+	polyExpandChecker = s.expanded;
+}
+
 void ModulatorChain::ModChainWithBuffer::clear()
 {
 	currentVoiceData = nullptr;
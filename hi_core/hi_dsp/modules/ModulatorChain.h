@@ -164,6 +164,15 @@ public:
 		*/
 		void calculateModulationValuesForCurrentVoice(int voiceIndex, int startSample, int numSamples);
 
+		/** Calculates the envelopes of all given voices at once (if they support it).
+		*
+		*	The values are picked up by the next calculateModulationValuesForCurrentVoice() call of each voice.
+		*	The startSample / numSamples arguments are supposed to be at audio rate. Call clearVoiceBatch() after 
+		*	the voices were rendered. */
+		void calculateVoiceBatch(const int* voiceIndexes, int numVoices, int startSample, int numSamples);
+
+		void clearVoiceBatch();
+
 		/** This multiplies the modulation values with the given AudioSampleBuffer. 
 		*
 		*	Make sure you've expanded the values before using this.
@@ -273,8 +282,36 @@ public:
 
 		void setScratchBufferFunction(const std::function<void(int, Modulator* m, float*, int, int)>& f);
 
+		/** Allocates the memory for the given amount of voice snapshots. 
+		*
+		*	A voice snapshot stores the modulation state of a voice after calculateModulationValuesForCurrentVoice() so that
+		*	it can be restored later in the same sub block. This is used by the parallel voice rendering which needs to 
+		*	calculate the modulation values of all voices before rendering them. */
+		void setNumVoiceSnapshots(int numSnapshots, int samplesPerBlock);
+
+		int getNumVoiceSnapshots() const noexcept { return numVoiceSnapshots; }
+
+		/** Copies the current voice values into the given snapshot slot. 
+		*
+		*	If overrideData is not nullptr, it will be stored instead of the voice values (this is used for pitch values that
+		*	are calculated into the scratch buffer). */
+		void storeVoiceSnapshot(int snapshotIndex, int startSample, int numSamples, const float* overrideData=nullptr);
+
+		/** Restores the state that was stored with storeVoiceSnapshot().
+		*
+		*	After this call, the voice values point to the snapshot memory, so they stay valid until the slot is overwritten. */
+		void restoreVoiceSnapshot(int snapshotIndex);
+
 	private:
 
+		struct VoiceSnapshot
+		{
+			float* data = nullptr;
+			float constantValue = 1.0f;
+			bool hasData = false;
+			bool expanded = false;
+		};
+
 		std::function<void(int, Modulator* m, float*, int, int)> scratchBufferFunction;
 
 		void applyMonophonicValuesToVoiceInternal(float* voiceBuffer, float* monoBuffer, int numSamples);
@@ -308,6 +345,10 @@ public:
 		float currentMonophonicRampValue;
 		float const* currentVoiceData = nullptr;
 
+		HeapBlock<VoiceSnapshot> voiceSnapshots;
+		HeapBlock<float> voiceSnapshotData;
+		int numVoiceSnapshots = 0;
+
 		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ModChainWithBuffer);
 	};
 
@@ -631,18 +631,150 @@ void ModulatorSynth::renderVoice(int startSample, int numThisTime)
     
 	clearPendingRemoveVoices();
 
-	for (auto v : activeVoices)
+#if HISE_USE_VOICE_BATCHED_ENVELOPES
+	calculateVoiceBatches(startSample, numThisTime);
+#endif
+
+	if (shouldRenderVoicesInParallel())
 	{
-		jassert(!v->isInactive());
+		renderVoicesInParallel(startSample, numThisTime);
+	}
+	else
+	{
+		for (auto v : activeVoices)
+		{
+			jassert(!v->isInactive());
 
-		calculateModulationValuesForVoice(v, startSample, numThisTime);
+			calculateModulationValuesForVoice(v, startSample, numThisTime);
 
-		v->renderNextBlock(internalBuffer, startSample, numThisTime);
+			v->renderNextBlock(internalBuffer, startSample, numThisTime);
+		}
 	}
 
+#if HISE_USE_VOICE_BATCHED_ENVELOPES
+	clearVoiceBatches();
+#endif
+
 	clearPendingRemoveVoices();
 };
 
+void ModulatorSynth::calculateVoiceBatches(int startSample, int numThisTime)
+{
+	// Below this amount there are not enough voices to fill the SIMD lanes
+	static constexpr int MinNumVoicesForBatching = 4;
+
+	const int numVoices = jmin(activeVoices.size(), NUM_POLYPHONIC_VOICES);
+
+	if (numVoices < MinNumVoicesForBatching)
+		return;
+
+	int voiceIndexes[NUM_POLYPHONIC_VOICES];
+
+	for (int i = 0; i < numVoices; i++)
+		voiceIndexes[i] = activeVoices[i]->getVoiceIndex();
+
+	for (auto& mb : modChains)
+		mb.calculateVoiceBatch(voiceIndexes, numVoices, startSample, numThisTime);
+}
+
+void ModulatorSynth::clearVoiceBatches()
+{
+	for (auto& mb : modChains)
+		mb.clearVoiceBatch();
+}
+
+struct ModulatorSynth::ParallelVoiceRenderTask : public AudioRenderThreadPool::Task
+{
+	ParallelVoiceRenderTask(ModulatorSynth& s_, int startSample_, int numSamples_) :
+		s(s_),
+		startSample(startSample_),
+		numSamples(numSamples_)
+	{}
+
+	void run(int itemIndex, int threadIndex) override
+	{
+		auto v = s.activeVoices[itemIndex];
+
+		if (!v->isInactive())
+			v->renderParallel(startSample, numSamples, threadIndex);
+	}
+
+	ModulatorSynth& s;
+	const int startSample;
+	const int numSamples;
+};
+
+bool ModulatorSynth::shouldRenderVoicesInParallel() const
+{
+	// Below this amount the overhead of waking up the workers eats up the gain
+	static constexpr int MinNumVoicesForParallelRendering = 4;
+
+	const int numVoicesToRender = activeVoices.size();
+
+	return numVoicesToRender >= MinNumVoicesForParallelRendering &&
+		   numVoicesToRender <= numVoiceSnapshots &&
+		   !getMainController()->getDebugLogger().isLogging() &&
+		   canRenderVoicesInParallel();
+}
+
+void ModulatorSynth::renderVoicesInParallel(int startSample, int numThisTime)
+{
+	auto pool = getMainController()->getAudioRenderThreadPool();
+
+	jassert(pool != nullptr);
+
+	const int numVoicesToRender = activeVoices.size();
+	auto& pitchChain = modChains[BasicChains::PitchChain];
+
+	for (int i = 0; i < numVoicesToRender; i++)
+	{
+		auto v = activeVoices[i];
+
+		jassert(!v->isInactive());
+
+		calculateModulationValuesForVoice(v, startSample, numThisTime);
+
+		auto pitchValues = useScratchBufferForArtificialPitch ? pitchChain.getScratchBuffer() : nullptr;
+
+		for (auto& mb : modChains)
+		{
+			if (mb.getNumVoiceSnapshots() > 0)
+			{
+				mb.storeVoiceSnapshot(i, startSample, numThisTime, &mb == &pitchChain ? pitchValues : nullptr);
+				mb.restoreVoiceSnapshot(i);
+			}
+		}
+
+		// the artificial pitch values are now stored in the snapshot of the pitch chain
+		useScratchBufferForArtificialPitch = false;
+
+		if (!v->isInactive())
+			v->prepareParallelRendering(startSample, numThisTime);
+	}
+
+	ParallelVoiceRenderTask task(*this, startSample, numThisTime);
+	pool->runParallel(task, numVoicesToRender);
+
+	for (int i = 0; i < numVoicesToRender; i++)
+	{
+		auto v = activeVoices[i];
+
+		for (auto& mb : modChains)
+		{
+			if (mb.getNumVoiceSnapshots() > 0)
+				mb.restoreVoiceSnapshot(i);
+		}
+
+		useScratchBufferForArtificialPitch = false;
+
+		if (!v->isInactive())
+		{
+			v->finishParallelRendering(startSample, numThisTime);
+			v->addVoiceBufferToOutput(internalBuffer, startSample, numThisTime);
+		}
+	}
+}
+
 	
 void ModulatorSynth::calculateModulationValuesForVoice(ModulatorSynthVoice * v, int startSample, int numThisTime)
 {
@@ -999,6 +1131,14 @@ void ModulatorSynth::prepareToPlay(double newSampleRate, int samplesPerBlock)
 		for (auto& mb : modChains)
 			mb.prepareToPlay(newSampleRate, samplesPerBlock);
 
+		numVoiceSnapshots = 0;
+
+		if (getMainController()->getAudioRenderThreadPool() != nullptr && supportsParallelVoiceRendering())
+			numVoiceSnapshots = getNumVoices();
+
+		for (auto& mb : modChains)
+			mb.setNumVoiceSnapshots(numVoiceSnapshots, samplesPerBlock);
+
 		CHECK_COPY_AND_RETURN_12(effectChain);
 
 		effectChain->prepareToPlay(newSampleRate, samplesPerBlock);
@@ -2166,32 +2306,35 @@ void ModulatorSynthVoice::renderNextBlock (AudioSampleBuffer& outputBuffer, int
 	if (isActive)
     { 
 		calculateBlock(startSample, numSamples);
+		addVoiceBufferToOutput(outputBuffer, startSample, numSamples);
+    }
+}
 
-		if (gainFader.isSmoothing())
-		{
-			applyEventVolumeFade(startSample, numSamples);
-		}
-		else if (eventGainFactor != 1.0f)
-		{
-			applyEventVolumeFactor(startSample, numSamples);
-		}
-
-		if(killThisVoice)
-		{
-			applyKillFadeout(startSample, numSamples);
-		}
+void ModulatorSynthVoice::addVoiceBufferToOutput(AudioSampleBuffer& outputBuffer, int startSample, int numSamples)
+{
+	if (gainFader.isSmoothing())
+	{
+		applyEventVolumeFade(startSample, numSamples);
+	}
+	else if (eventGainFactor != 1.0f)
+	{
+		applyEventVolumeFactor(startSample, numSamples);
+	}
 
-		const int maxChannelAmount = jmin<int>(voiceBuffer.getNumChannels(), outputBuffer.getNumChannels());
+	if(killThisVoice)
+	{
+		applyKillFadeout(startSample, numSamples);
+	}
 
-		for (int i = 0; i < maxChannelAmount; i++)
-		{
-			FloatVectorOperations::add(outputBuffer.getWritePointer(i, startSample), voiceBuffer.getReadPointer(i, startSample), numSamples);
-		}
+	const int maxChannelAmount = jmin<int>(voiceBuffer.getNumChannels(), outputBuffer.getNumChannels());
 
+	for (int i = 0; i < maxChannelAmount; i++)
+	{
+		FloatVectorOperations::add(outputBuffer.getWritePointer(i, startSample), voiceBuffer.getReadPointer(i, startSample), numSamples);
+	}
 
-		// checks if any envelopes are active and in their release state and calls stopNote until they are finished.
-		checkRelease();
-    }
+	// checks if any envelopes are active and in their release state and calls stopNote until they are finished.
+	checkRelease();
 }
 
 void ModulatorSynthVoice::setCurrentHiseEvent(const HiseEvent &m)
@@ -218,6 +218,16 @@ public:
 
 	void calculateModulationValuesForVoice(ModulatorSynthVoice * v, int startSample, int numThisTime);;
 
+	/** Override this and return true if the voices implement the parallel rendering callbacks of ModulatorSynthVoice.
+	*
+	*	This will be checked in prepareToPlay() in order to allocate the modulation snapshots, so the return value must not change. */
+	virtual bool supportsParallelVoiceRendering() const { return false; }
+
+	/** Override this and return false if the current state of the synth requires the voices to be rendered one after another.
+	*
+	*	This is called in the audio thread before each sub block and will only be checked if supportsParallelVoiceRendering() returns true. */
+	virtual bool canRenderVoicesInParallel() const { return true; }
+
 	void clearPendingRemoveVoices();
 
 	/** This method is called to handle all modulatorchains after the voice rendering and handles the GUI metering. It assumes stereo mode.
@@ -519,6 +529,22 @@ protected:
 
 private:
 
+	struct ParallelVoiceRenderTask;
+
+	/** Renders the voices using the AudioRenderThreadPool of the MainController. 
+	
+		The modulation values are calculated for every voice and stored in the snapshots of the mod chains, then the heavy
+		part of the voice rendering is done in parallel and finally each voice is added to the internal buffer in the same
+		order as the serial rendering so the output is bit-identical. */
+	void renderVoicesInParallel(int startSample, int numThisTime);
+
+	bool shouldRenderVoicesInParallel() const;
+
+	void calculateVoiceBatches(int startSample, int numThisTime);
+	void clearVoiceBatches();
+
+	int numVoiceSnapshots = 0;
+
     void updateShouldHaveEnvelope();
 	
 	bool shouldHaveEnvelope = true;
@@ -606,6 +632,26 @@ public:
 
 
 	virtual void calculateBlock(int startSample, int numSamples) = 0;
+
+	/** Applies the event gain fades and the kill fade to the voice buffer and adds it to the output buffer. */
+	void addVoiceBufferToOutput(AudioSampleBuffer& outputBuffer, int startSample, int numSamples);
+
+	/** The parallel voice rendering splits up calculateBlock() into three steps. 
+	*
+	*	This will be called on the audio thread after the modulation values for this voice were calculated, and
+	*	it must prepare everything that renderParallel() needs. Don't access any modulation values of the owner synth
+	*	in renderParallel(), but store the pointers here (they will point to voice specific memory). */
+	virtual void prepareParallelRendering(int startSample, int numSamples) {}
+
+	/** This will be called on one of the threads of the AudioRenderThreadPool and must only touch the state of this voice.
+	*
+	*	The thread index can be used to pick a scratch buffer that is not used by another thread at the same time. */
+	virtual void renderParallel(int startSample, int numSamples, int threadIndex) {}
+
+	/** This will be called on the audio thread after all voices were rendered, with the modulation values restored to the state of this voice.
+	*
+	*	The default implementation just calls calculateBlock(), so every voice works in this mode (but without any performance gain). */
+	virtual void finishParallelRendering(int startSample, int numSamples) { calculateBlock(startSample, numSamples); }
 	
 	bool isPitchFadeActive() const noexcept;
 
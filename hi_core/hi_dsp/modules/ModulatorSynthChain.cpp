@@ -170,6 +170,8 @@ void ModulatorSynthChain::prepareToPlay(double newSampleRate, int samplesPerBloc
 	for (auto s: synths)
 		s->prepareToPlay(newSampleRate, samplesPerBlock);
 
+	prepareChildRenderBuffers();
+
 	if (ownedUniformVoiceHandler != nullptr)
         ownedUniformVoiceHandler->rebuildChildSynthList();
 }
@@ -193,7 +195,7 @@ void ModulatorSynthChain::numSourceChannelsChanged()
 
 	ModulatorSynth::numSourceChannelsChanged();
 
-	
+	prepareChildRenderBuffers();
 }
 
 void ModulatorSynthChain::numDestinationChannelsChanged()
@@ -250,6 +252,184 @@ void ModulatorSynthChain::compileAllScripts()
 	}
 }
 
+namespace ChildRenderFlags
+{
+	enum Flags
+	{
+		ModulationSource = 1,
+		Coupled = 2
+	};
+
+	static int getFlags(const Processor* p)
+	{
+		int flags = 0;
+
+		if (dynamic_cast<const GlobalModulatorContainer*>(p) != nullptr ||
+			dynamic_cast<const MacroModulationSource*>(p) != nullptr)
+			flags |= ModulationSource;
+
+		// Scripts might access other processors or global data and the send effects write into the buffer of their container
+		if (dynamic_cast<const ProcessorWithScriptingContent*>(p) != nullptr ||
+			dynamic_cast<const scriptnode::DspNetwork::Holder*>(p) != nullptr ||
+			dynamic_cast<const SendContainer*>(p) != nullptr ||
+			dynamic_cast<const SendEffect*>(p) != nullptr)
+			flags |= Coupled;
+
+		if (auto s = dynamic_cast<const ModulatorSynth*>(p))
+		{
+			if (s->getUniformVoiceHandler() != nullptr)
+				flags |= Coupled;
+		}
+
+		for (int i = 0; i < p->getNumChildProcessors(); i++)
+		{
+			if (auto c = p->getChildProcessor(i))
+				flags |= getFlags(c);
+		}
+
+		return flags;
+	}
+}
+
+struct ModulatorSynthChain::ParallelChildRenderTask : public AudioRenderThreadPool::Task
+{
+	ParallelChildRenderTask(ModulatorSynthChain& c_, int numSamples_) :
+		c(c_),
+		numSamples(numSamples_)
+	{}
+
+	void run(int laneIndex, int /*threadIndex*/) override
+	{
+		const int numChannels = c.internalBuffer.getNumChannels();
+
+		for (int i = 0; i < c.synths.size(); i++)
+		{
+			if (c.childRenderLanes[i] != laneIndex)
+				continue;
+
+			auto s = c.synths[i];
+
+			AudioSampleBuffer childBuffer(c.childRenderBuffer.getArrayOfWritePointers() + i * numChannels, numChannels, numSamples);
+			childBuffer.clear();
+
+			ScopedAnalyser sa(c.getMainController(), s, childBuffer, numSamples);
+
+			if (!s->isSoftBypassed())
+				s->renderNextBlockWithModulators(childBuffer, c.eventBuffer);
+		}
+	}
+
+	ModulatorSynthChain& c;
+	const int numSamples;
+};
+
+void ModulatorSynthChain::prepareChildRenderBuffers()
+{
+	if (getMainController()->getAudioRenderThreadPool() == nullptr || getLargestBlockSize() <= 0)
+		return;
+
+	const int numChannels = getMatrix().getNumSourceChannels() * synths.size();
+
+	childRenderBuffer.setSize(jmax(1, numChannels), getLargestBlockSize());
+	childRenderLanes.ensureStorageAllocated(synths.size());
+	childRenderLaneSynths.ensureStorageAllocated(synths.size());
+
+	// force a rebuild on the next callback
+	childRenderLaneVersion = -1;
+}
+
+void ModulatorSynthChain::rebuildChildRenderLanes()
+{
+	numChildRenderLanes = 0;
+
+	// We don't want to allocate on the audio thread so just render serially until the arrays are resized
+	if (childRenderLanes.getNumAllocated() < synths.size() ||
+		childRenderLaneSynths.getNumAllocated() < synths.size())
+		return;
+
+	childRenderLaneVersion = Chain::Handler::getStructureVersion();
+
+	childRenderLanes.clearQuick();
+	childRenderLaneSynths.clearQuick();
+
+	int lastModulationSource = -1;
+
+	for (int i = 0; i < synths.size(); i++)
+	{
+		auto flags = ChildRenderFlags::getFlags(synths[i]);
+
+		if (flags & ChildRenderFlags::ModulationSource)
+			lastModulationSource = i;
+
+		childRenderLanes.add(flags);
+		childRenderLaneSynths.add(synths[i]);
+	}
+
+	for (int i = 0; i < synths.size(); i++)
+	{
+		auto& lane = childRenderLanes.getReference(i);
+
+		// Coupled children access their siblings or the send buses, so they must not run at the same time as the other lanes
+		if (i <= lastModulationSource || (lane & ChildRenderFlags::Coupled))
+			lane = -1;
+		else
+			lane = numChildRenderLanes++;
+	}
+}
+
+bool ModulatorSynthChain::shouldRenderChildSynthsInParallel(int numSamples)
+{
+	if (getMainController()->getAudioRenderThreadPool() == nullptr ||
+		ownedUniformVoiceHandler != nullptr ||
+		getMainController()->getDebugLogger().isLogging())
+		return false;
+
+	bool lanesChanged = childRenderLaneVersion != Chain::Handler::getStructureVersion() ||
+						childRenderLaneSynths.size() != synths.size();
+
+	for (int i = 0; !lanesChanged && i < synths.size(); i++)
+		lanesChanged = childRenderLaneSynths[i] != synths[i];
+
+	if (lanesChanged)
+		rebuildChildRenderLanes();
+
+	return numChildRenderLanes > 1 &&
+		   childRenderBuffer.getNumChannels() >= internalBuffer.getNumChannels() * synths.size() &&
+		   childRenderBuffer.getNumSamples() >= numSamples;
+}
+
+void ModulatorSynthChain::renderChildSynthsInParallel(int numSamples)
+{
+	// Render the modulation sources and the coupled children on this thread first (in their original order)
+	// so that the global modulators pick up the values of this block
+	for (int i = 0; i < synths.size(); i++)
+	{
+		if (childRenderLanes[i] != -1)
+			continue;
+
+		ScopedAnalyser sa(getMainController(), synths[i], internalBuffer, internalBuffer.getNumSamples());
+
+		if (!synths[i]->isSoftBypassed())
+			synths[i]->renderNextBlockWithModulators(internalBuffer, eventBuffer);
+	}
+
+	ParallelChildRenderTask task(*this, numSamples);
+	getMainController()->getAudioRenderThreadPool()->runParallel(task, numChildRenderLanes);
+
+	// The child buffers are added after the serial children, so the result is not bit-identical 
+	// to the serial path because the partial sums are added in a different order
+	const int numChannels = internalBuffer.getNumChannels();
+
+	for (int i = 0; i < synths.size(); i++)
+	{
+		if (childRenderLanes[i] == -1 || synths[i]->isSoftBypassed())
+			continue;
+
+		for (int c = 0; c < numChannels; c++)
+			internalBuffer.addFrom(c, 0, childRenderBuffer, i * numChannels + c, 0, numSamples);
+	}
+}
+
 void ModulatorSynthChain::renderNextBlockWithModulators(AudioSampleBuffer &buffer, const HiseEventBuffer &inputMidiBuffer)
 {
 	jassert(isOnAir());
@@ -337,13 +517,20 @@ void ModulatorSynthChain::renderNextBlockWithModulators(AudioSampleBuffer &buffe
 	ScopedAnalyser sa(getMainController(), this, internalBuffer, buffer.getNumSamples());
 
 	// Process the Synths and add store their output in the internal buffer
-	for (int i = 0; i < synths.size(); i++)
-    {
-		ScopedAnalyser sa(getMainController(), synths[i], internalBuffer, internalBuffer.getNumSamples());
+	if (shouldRenderChildSynthsInParallel(numSamples))
+	{
+		renderChildSynthsInParallel(numSamples);
+	}
+	else
+	{
+		for (int i = 0; i < synths.size(); i++)
+		{
+			ScopedAnalyser sa(getMainController(), synths[i], internalBuffer, internalBuffer.getNumSamples());
 
-        if (!synths[i]->isSoftBypassed())
-            synths[i]->renderNextBlockWithModulators(internalBuffer, eventBuffer);
-    }
+			if (!synths[i]->isSoftBypassed())
+				synths[i]->renderNextBlockWithModulators(internalBuffer, eventBuffer);
+		}
+	}
 
 	HiseEventBuffer::Iterator eventIterator(eventBuffer);
 
@@ -714,6 +901,9 @@ void ModulatorSynthChain::ModulatorSynthChainHandler::add(Processor *newProcesso
 		LOCK_PROCESSING_CHAIN(synth);
 		ms->setIsOnAir(synth->isOnAir());
 		synth->synths.insert(index, ms);
+
+		if (bs > 0)
+			synth->prepareChildRenderBuffers();
 	}
 
 	notifyListeners(Listener::ProcessorAdded, newProcessor);
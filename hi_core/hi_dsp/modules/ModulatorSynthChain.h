@@ -82,10 +82,11 @@ private:
 
 
 
-/** A ModulatorSynthChain processes multiple independent ModulatorSynth instances serially.
+/** A ModulatorSynthChain processes multiple independent ModulatorSynth instances.
 	@ingroup synthTypes
 *
 *	This class is supposed to be a wrapper for ModulatorSynths which are processed individually with their own MidiProcessors, Modulators and Effects.
+*	If the MainController has an AudioRenderThreadPool, child synths that don't depend on each other are rendered in parallel.
 *	You can add some MidiProcessors which will be applied to all chains as well as non polyphonic gain Modulators (like a LfoModulator) which will be applied to the
 *	sum of the chain. However, midi messages are not recognized by those modulators (because they are not evaluated on the ModulatorSynthChain level), so don't expect too much.
 *
@@ -164,7 +165,7 @@ public:
     /** This renders the child synths:
 	*
 	*	- processes the MidiBuffer of the ModulatorSynthChain
-	*	- calls the renderNextBlockWithModulators on the child synths
+	*	- calls the renderNextBlockWithModulators on the child synths (in parallel if possible)
 	*	- applies the time-variant gain modulators (no midi support!)
 	*	- applies the gain of the chain.
 	*/
@@ -223,6 +224,33 @@ public:
 	
 private:
 
+	struct ParallelChildRenderTask;
+
+	/** Assigns the child synths to render lanes that can be processed in parallel.
+	*
+	*	Child synths that contain a GlobalModulatorContainer or a MacroModulationSource must be rendered before the others, 
+	*	so every child synth up to the last of them is rendered serially. All child synths that contain scripts, take part 
+	*	in the send routing or use a uniform voice handler are rendered serially too (in their original order) because they
+	*	might access their siblings. Every other child synth gets its own lane.
+	*
+	*	This is called on the audio thread whenever the processor tree changes and doesn't allocate.
+	*/
+	void rebuildChildRenderLanes();
+
+	/** Allocates the buffers for the parallel rendering of the child synths. */
+	void prepareChildRenderBuffers();
+
+	bool shouldRenderChildSynthsInParallel(int numSamples);
+
+	/** Renders the serial child synths on the calling thread, then every other child synth into its own buffer on the pool and adds them to the internal buffer. */
+	void renderChildSynthsInParallel(int numSamples);
+
+	AudioSampleBuffer childRenderBuffer;
+	Array<int> childRenderLanes;
+	Array<const ModulatorSynth*> childRenderLaneSynths;
+	int numChildRenderLanes = 0;
+	int childRenderLaneVersion = -1;
+
 	ScopedPointer<UniformVoiceHandler> ownedUniformVoiceHandler;
 
 	HiseEvent::ChannelFilterData activeChannels;
@@ -1152,6 +1152,11 @@ void EnvelopeModulator::prepareToPlay(double sampleRate, int samplesPerBlock)
 		
 	// Deactivate smoothing for envelopes
 	smoothedIntensity.reset(sampleRate, 0.0);
+
+#if HISE_USE_VOICE_BATCHED_ENVELOPES
+	if (supportsVoiceBatching())
+		voiceBatch.prepare(polyManager.getVoiceAmount(), samplesPerBlock / HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR + 1);
+#endif
 }
 
 bool EnvelopeModulator::isInMonophonicMode() const
@@ -1178,7 +1183,10 @@ void EnvelopeModulator::render(int voiceIndex, float* voiceBuffer, float* scratc
 	polyManager.setCurrentVoice(voiceIndex);
 
 	setScratchBuffer(scratchBuffer, startSample + numSamples);
-	calculateBlock(startSample, numSamples);
+
+	if (!voiceBatch.renderLane(*this, voiceIndex, internalBuffer.getWritePointer(0, startSample), startSample, numSamples))
+		calculateBlock(startSample, numSamples);
+
 	applyTimeModulation(voiceBuffer, startSample, numSamples);
 
 #if ENABLE_ALL_PEAK_METERS
@@ -1194,6 +1202,164 @@ void EnvelopeModulator::render(int voiceIndex, float* voiceBuffer, float* scratc
 	polyManager.clearCurrentVoice();
 }
 
+void EnvelopeModulator::calculateVoiceBatch(const int* voiceIndexes, int numVoices, int startSample, int numSamples)
+{
+	if (isMonophonic || !supportsVoiceBatching())
+		return;
+
+	voiceBatch.calculate(*this, voiceIndexes, numVoices, startSample, numSamples);
+}
+
+void EnvelopeModulator::clearVoiceBatch()
+{
+	voiceBatch.clear();
+}
+
+void EnvelopeModulator::VoiceBatch::prepare(int numVoices, int maxNumSamples)
+{
+	const int numLanesPadded = getNumPaddedLanes(numVoices);
+
+	if (numVoices == numVoicesAllocated && numLanesPadded == numLanesAllocated && maxNumSamples <= maxSamples)
+		return;
+
+	clear();
+
+	numVoicesAllocated = numVoices;
+	numLanesAllocated = numLanesPadded;
+	maxSamples = maxNumSamples;
+
+	// 5 segment arrays + the interleaved values
+	const int numFloats = numLanesAllocated * (5 + maxSamples) + (int)SIMDType::SIMDNumElements;
+
+	data.calloc(numFloats);
+
+	values = SIMDType::getNextSIMDAlignedPtr(data.get());
+	bases = values + numLanesAllocated;
+	coefs = bases + numLanesAllocated;
+	los = coefs + numLanesAllocated;
+	his = los + numLanesAllocated;
+	interleaved = his + numLanesAllocated;
+
+	laneIndexes.malloc(numVoicesAllocated);
+	laneVoices.malloc(numLanesAllocated);
+	laneIsValid.calloc(numLanesAllocated);
+
+	for (int i = 0; i < numVoicesAllocated; i++)
+		laneIndexes[i] = -1;
+}
+
+void EnvelopeModulator::VoiceBatch::calculate(EnvelopeModulator& m, const int* voiceIndexes, int numVoices, int startSample, int numSamples)
+{
+	clear();
+
+	if (numLanesAllocated == 0 || numSamples <= 0 || numSamples > maxSamples)
+		return;
+
+	int n = 0;
+
+	for (int i = 0; i < numVoices; i++)
+	{
+		const int voiceIndex = voiceIndexes[i];
+
+		if (!isPositiveAndBelow(voiceIndex, numVoicesAllocated))
+			continue;
+
+		Segment s;
+
+		if (m.getBatchSegment(voiceIndex, s))
+		{
+			values[n] = s.value;
+			bases[n] = s.base;
+			coefs[n] = s.coef;
+			los[n] = s.lo;
+			his[n] = s.hi;
+
+			laneIndexes[voiceIndex] = n;
+			laneVoices[n] = voiceIndex;
+			n++;
+		}
+	}
+
+	if (n == 0)
+		return;
+
+	numLanes = n;
+	numLanesUsed = getNumPaddedLanes(n);
+
+	for (int i = n; i < numLanesUsed; i++)
+	{
+		Segment unused;
+		values[i] = unused.value;
+		bases[i] = unused.base;
+		coefs[i] = unused.coef;
+		los[i] = unused.lo;
+		his[i] = unused.hi;
+	}
+
+	for (int l = 0; l < numLanesUsed; l += (int)SIMDType::SIMDNumElements)
+	{
+		auto v = SIMDType::fromRawArray(values + l);
+		const auto b = SIMDType::fromRawArray(bases + l);
+		const auto c = SIMDType::fromRawArray(coefs + l);
+		const auto lo = SIMDType::fromRawArray(los + l);
+		const auto hi = SIMDType::fromRawArray(his + l);
+
+		auto outOfRange = SIMDType::vMaskType::expand(0);
+
+		float* dst = interleaved + l;
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			v = b + v * c;
+			outOfRange = outOfRange | SIMDType::greaterThanOrEqual(v, hi) | SIMDType::lessThanOrEqual(v, lo);
+			v.copyToRawArray(dst);
+			dst += numLanesUsed;
+		}
+
+		for (int j = 0; j < (int)SIMDType::SIMDNumElements; j++)
+			laneIsValid[l + j] = outOfRange.get((size_t)j) == 0;
+	}
+
+	batchStart = startSample;
+	batchLength = numSamples;
+}
+
+bool EnvelopeModulator::VoiceBatch::renderLane(EnvelopeModulator& m, int voiceIndex, float* destination, int startSample, int numSamples)
+{
+	if (numLanes == 0 || !isPositiveAndBelow(voiceIndex, numVoicesAllocated))
+		return false;
+
+	const int lane = laneIndexes[voiceIndex];
+
+	if (lane == -1)
+		return false;
+
+	// A lane can only be used once, otherwise the state would be advanced twice
+	laneIndexes[voiceIndex] = -1;
+
+	if (!laneIsValid[lane] || startSample != batchStart || numSamples != batchLength)
+		return false;
+
+	const float* src = interleaved + lane;
+
+	for (int i = 0; i < numSamples; i++)
+		destination[i] = src[i * numLanesUsed];
+
+	m.finishBatchSegment(voiceIndex, destination[numSamples - 1], numSamples);
+	return true;
+}
+
+void EnvelopeModulator::VoiceBatch::clear()
+{
+	for (int i = 0; i < numLanes; i++)
+		laneIndexes[laneVoices[i]] = -1;
+
+	numLanes = 0;
+	numLanesUsed = 0;
+	batchStart = -1;
+	batchLength = 0;
+}
+
 int EnvelopeModulator::getNumPressedKeys() const
 {
 	jassert(isMonophonic);
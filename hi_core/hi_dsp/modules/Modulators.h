@@ -620,8 +620,89 @@ public:
 
 	void render(int voiceIndex, float* voiceBuffer, float* scratchBuffer, int startSample, int numSamples);
 
+	/** Calculates the envelope values for all given voices at once.
+	*
+	*	This is called before the voice rendering and the values will be picked up by the render() call
+	*	of each voice. The startSample / numSamples arguments are supposed to be at control rate. */
+	void calculateVoiceBatch(const int* voiceIndexes, int numVoices, int startSample, int numSamples);
+
+	/** Discards the values of the last calculateVoiceBatch() call. */
+	void clearVoiceBatch();
+
+	/** Returns true if the envelope implements getBatchSegment(). */
+	virtual bool supportsVoiceBatching() const { return false; }
+
+	/** Calculates the envelope of multiple voices with one SIMD lane per voice.
+	*
+	*	An envelope that supports this describes the current segment of a voice as the recursion 
+	*	v = base + v * coef which is valid as long as v stays inside ]lo, hi[. The values are stored 
+	*	interleaved (the voices are the innermost dimension). Any voice that leaves its segment within 
+	*	the block is discarded and calculated with calculateBlock() instead, so the result is the same. 
+	*/
+	class VoiceBatch
+	{
+	public:
+
+		struct Segment
+		{
+			float value = 0.0f;
+			float base = 0.0f;
+			float coef = 1.0f;
+			float lo = -std::numeric_limits<float>::max();
+			float hi = std::numeric_limits<float>::max();
+		};
+
+		void prepare(int numVoices, int maxNumSamples);
+
+		void calculate(EnvelopeModulator& m, const int* voiceIndexes, int numVoices, int startSample, int numSamples);
+
+		/** Copies the values of the voice and calls finishBatchSegment(). Returns false if the voice wasn't calculated. */
+		bool renderLane(EnvelopeModulator& m, int voiceIndex, float* destination, int startSample, int numSamples);
+
+		void clear();
+
+	private:
+
+		using SIMDType = dsp::SIMDRegister<float>;
+
+		static int getNumPaddedLanes(int numVoices)
+		{
+			constexpr int N = (int)SIMDType::SIMDNumElements;
+			return ((numVoices + N - 1) / N) * N;
+		}
+
+		HeapBlock<float> data;
+		float* values = nullptr;
+		float* bases = nullptr;
+		float* coefs = nullptr;
+		float* los = nullptr;
+		float* his = nullptr;
+		float* interleaved = nullptr;
+
+		HeapBlock<int> laneIndexes;
+		HeapBlock<int> laneVoices;
+		HeapBlock<uint8> laneIsValid;
+
+		int numVoicesAllocated = 0;
+		int numLanesAllocated = 0;
+		int maxSamples = 0;
+
+		int numLanes = 0;
+		int numLanesUsed = 0;
+		int batchStart = -1;
+		int batchLength = 0;
+	};
+
 protected:
 
+	/** Override this and fill the segment for the given voice. Return false if the voice can't be batched
+	*	(eg. because it's in a state that is not a simple recursion). Don't change the state here. */
+	virtual bool getBatchSegment(int /*voiceIndex*/, VoiceBatch::Segment& /*s*/) { return false; }
+
+	/** This is called when render() picks up the batched values for the voice. Update the state so
+	*	that it matches the state after calculateBlock() with the last calculated value. */
+	virtual void finishBatchSegment(int /*voiceIndex*/, float /*lastValue*/, int /*numSamples*/) {}
+
 	int getNumPressedKeys() const;
 
 
@@ -670,6 +751,8 @@ protected:
 
 private:
 
+	VoiceBatch voiceBatch;
+
 	struct MidiBitmap
 	{
 		MidiBitmap();
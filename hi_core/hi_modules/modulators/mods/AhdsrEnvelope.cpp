@@ -441,6 +441,72 @@ EnvelopeModulator::ModulatorState * AhdsrEnvelope::createSubclassedState(int voi
 	return new AhdsrEnvelopeState(voiceIndex, this);
 }
 
+bool AhdsrEnvelope::getBatchSegment(int voiceIndex, VoiceBatch::Segment& s)
+{
+	// The last started voice updates the UI position in calculateBlock()
+	if (voiceIndex == polyManager.getLastStartedVoice())
+		return false;
+
+	// The stages that end with FloatSanitizers::isSilence() leave the batch a bit earlier
+	// and are finished by the scalar code.
+	static const float silenceMargin = 2.0f * Decibels::decibelsToGain(-(float)HISE_SILENCE_THRESHOLD_DB, -1000.0f);
+
+	auto st = static_cast<AhdsrEnvelopeState*>(states[voiceIndex]);
+	const float thisSustain = sustain * st->modValues[SustainLevelChain];
+
+	s.value = st->current_value;
+
+	switch (st->current_state)
+	{
+	case AhdsrEnvelopeState::SUSTAIN:
+		
+		// calculateBlock() ramps to a changed sustain level
+		if (FloatSanitizers::isNotSilence(thisSustain - st->lastSustainValue))
+			return false;
+
+		s.value = thisSustain;
+		return true;
+	case AhdsrEnvelopeState::ATTACK:
+		if (attack == 0.0f)
+			return false;
+
+		s.base = st->attackBase;
+		s.coef = st->attackCoef;
+		s.hi = st->attackLevel > thisSustain ? st->attackLevel : thisSustain;
+		return true;
+	case AhdsrEnvelopeState::DECAY:
+		if (decay == 0.0f)
+			return false;
+
+		s.base = st->decayBase;
+		s.coef = st->decayCoef;
+		s.lo = thisSustain + silenceMargin;
+		return true;
+	case AhdsrEnvelopeState::RELEASE:
+		if (release == 0.0f)
+			return false;
+
+		s.base = st->releaseBase;
+		s.coef = st->releaseCoef;
+		s.lo = silenceMargin;
+		return true;
+	default:
+		return false;
+	}
+}
+
+void AhdsrEnvelope::finishBatchSegment(int voiceIndex, float lastValue, int /*numSamples*/)
+{
+	auto st = static_cast<AhdsrEnvelopeState*>(states[voiceIndex]);
+
+	st->current_value = lastValue;
+
+	if (st->current_state == AhdsrEnvelopeState::SUSTAIN)
+		st->lastSustainValue = lastValue;
+	else
+		st->active = true;
+}
+
 float AhdsrEnvelope::calculateNewValue(int /*voiceIndex*/)
 {
 	return state->tick();
@@ -112,6 +112,8 @@ public:
 
 	void calculateBlock(int startSample, int numSamples);;
 
+	bool supportsVoiceBatching() const override { return true; }
+
 	void handleHiseEvent(const HiseEvent &e) override;
 
 	ProcessorEditorBody *createEditor(ProcessorEditor* parentEditor) override;
@@ -172,6 +174,11 @@ public:
 		void fillModuleList(StringArray& moduleList) override;
 	};
 
+protected:
+
+	bool getBatchSegment(int voiceIndex, VoiceBatch::Segment& s) override;
+	void finishBatchSegment(int voiceIndex, float lastValue, int numSamples) override;
+
 private:
 
 	hise::ExecutionLimiter<DummyCriticalSection> ballUpdater;
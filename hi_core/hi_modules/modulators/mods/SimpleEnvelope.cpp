@@ -329,6 +329,43 @@ void SimpleEnvelope::calculateBlock(int startSample, int numSamples)
 	}
 }
 
+bool SimpleEnvelope::getBatchSegment(int voiceIndex, VoiceBatch::Segment& s)
+{
+	auto st = static_cast<SimpleEnvelopeState*>(states[voiceIndex]);
+
+	switch (st->current_state)
+	{
+	case SimpleEnvelopeState::SUSTAIN:
+		s.value = 1.0f;
+		return true;
+	case SimpleEnvelopeState::IDLE:
+		s.value = 0.0f;
+		return true;
+	case SimpleEnvelopeState::ATTACK:
+		s.value = st->current_value;
+		s.base = linearMode ? st->attackDelta : st->expAttackBase;
+		s.coef = linearMode ? 1.0f : st->expAttackCoef;
+		s.hi = 1.0f;
+		return true;
+	case SimpleEnvelopeState::RELEASE:
+		s.value = st->current_value;
+		s.base = linearMode ? -release_delta : expReleaseBase;
+		s.coef = linearMode ? 1.0f : expReleaseCoef;
+		s.lo = linearMode ? 0.0f : 0.0001f;
+		return true;
+	default:
+		return false;
+	}
+}
+
+void SimpleEnvelope::finishBatchSegment(int voiceIndex, float lastValue, int /*numSamples*/)
+{
+	auto st = static_cast<SimpleEnvelopeState*>(states[voiceIndex]);
+
+	if (st->current_state == SimpleEnvelopeState::ATTACK || st->current_state == SimpleEnvelopeState::RELEASE)
+		st->current_value = lastValue;
+}
+
 void SimpleEnvelope::handleHiseEvent(const HiseEvent &m)
 {
 	EnvelopeModulator::handleHiseEvent(m);
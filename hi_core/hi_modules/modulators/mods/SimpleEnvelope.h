@@ -102,6 +102,8 @@ public:
 	void prepareToPlay(double sampleRate, int samplesPerBlock) override;
 	void calculateBlock(int startSample, int numSamples) override;
 	void handleHiseEvent(const HiseEvent& m) override;
+
+	bool supportsVoiceBatching() const override { return true; }
 	
 	ProcessorEditorBody *createEditor(ProcessorEditor *parentEditor)  override;
 
@@ -147,6 +149,11 @@ public:
 
 	ModulatorState *createSubclassedState(int voiceIndex) const override {return new SimpleEnvelopeState(voiceIndex); };
 
+protected:
+
+	bool getBatchSegment(int voiceIndex, VoiceBatch::Segment& s) override;
+	void finishBatchSegment(int voiceIndex, float lastValue, int numSamples) override;
+
 private:
 
 	float calcCoefficient(float time, float targetRatio=1.0f) const;
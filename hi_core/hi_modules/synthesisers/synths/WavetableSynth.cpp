@@ -104,6 +104,28 @@ float WavetableSynth::getTotalTableModValue(int offset)
 	return mv * (1.0f - reversed) + (1.0f - mv) * reversed;
 }
 
+void WavetableSynth::calculateTableModValues(float* destination, int startSample, int numSamples)
+{
+	auto& gainMod = modChains[ChainIndex::TableIndex];
+	auto& bipolarMod = modChains[ChainIndex::TableIndexBipolar];
+
+	const float bipolarGain = (float)bipolarMod.getChain()->shouldBeProcessedAtAll();
+
+	for (int i = 0; i < numSamples; i++)
+	{
+		const int offset = (startSample + i) / HISE_EVENT_RASTER;
+
+		const float bipolarValue = bipolarMod.getModValueForVoiceWithOffset(offset) * bipolarGain;
+		destination[i] = (tableIndexKnobValue.advance() + bipolarValue) * gainMod.getModValueForVoiceWithOffset(offset);
+	}
+
+	FloatVectorOperations::clip(destination, destination, 0.0f, 1.0f, numSamples);
+
+	// mv * (1 - reversed) + (1 - mv) * reversed
+	FloatVectorOperations::multiply(destination, 1.0f - 2.0f * reversed, numSamples);
+	FloatVectorOperations::add(destination, reversed, numSamples);
+}
+
 ProcessorEditorBody* WavetableSynth::createEditor(ProcessorEditor *parentEditor)
 {
 #if USE_BACKEND
@@ -138,6 +160,18 @@ juce::File WavetableSynth::getWavetableMonolith() const
 	return factoryData;
 }
 
+juce::File WavetableSynth::getMipmapCacheFile() const
+{
+	// Don't put this into the samples folder or it will end up in the exported sample archives.
+	// The entries are identified by the wavetable data, so all projects can share the file.
+	auto dir = NativeFileHandler::getAppDataDirectory(nullptr);
+
+	if (!dir.isDirectory())
+		return {};
+
+	return dir.getChildFile("WavetableMipmaps.cache");
+}
+
 juce::StringArray WavetableSynth::getWavetableList() const
 {
 	auto monolithFile = getWavetableMonolith();
@@ -358,9 +392,18 @@ void WavetableSynthVoice::calculateBlock(int startSample, int numSamples)
 	auto stereoMode = currentSound->isStereo();
 	auto owner = static_cast<WavetableSynth*>(getOwnerSynth());
 	
-	WavetableSound::RenderData r(voiceBuffer, startSample, numSamples, uptimeDelta, voicePitchValues, hqMode);
+	constexpr int BlockSize = WavetableSound::RenderData::BlockSize;
+	float tableIndexValues[BlockSize];
+
+	for (int offset = 0; offset < numSamples; offset += BlockSize)
+	{
+		const int numThisTime = jmin(BlockSize, numSamples - offset);
+
+		owner->calculateTableModValues(tableIndexValues, startSample + offset, numThisTime);
 
-	r.render(currentSound, voiceUptime, [owner](int startSample) { return owner->getTotalTableModValue(startSample); });
+		WavetableSound::RenderData r(voiceBuffer, startSample + offset, numThisTime, uptimeDelta, voicePitchValues, hqMode);
+		r.render(currentSound, voiceUptime, tableIndexValues);
+	}
 
 	if (refreshMipmap)
 	{
@@ -448,7 +491,7 @@ static MemoryBlock getMemoryBlockFromWavetableData(const ValueTree& v, int chann
 	}
 };
 
-WavetableSound::WavetableSound(const ValueTree &wavetableData, Processor* parent)
+WavetableSound::WavetableSound(const ValueTree &wavetableData, Processor* parent, WavetableMipmapCache* mipmapCache)
 {
 	jassert(wavetableData.getType() == Identifier("wavetable"));
 
@@ -521,6 +564,11 @@ WavetableSound::WavetableSound(const ValueTree &wavetableData, Processor* parent
 
 	normalizeTables();
 
+	createMipmaps(mipmapCache);
+
+	for (auto m : mipmaps)
+		memoryUsage += m->getNumChannels() * m->getNumSamples() * sizeof(float);
+
 	pitchRatio = 1.0;
     
     auto lowDelta = MidiMessage::getMidiNoteInHertz(midiNotes.findNextSetBit(0));
@@ -539,6 +587,91 @@ const float * WavetableSound::getWaveTableData(int channelIndex, int wavetableIn
 	return wavetables.getReadPointer(channelIndex, wavetableIndex * wavetableSize);
 }
 
+const float* WavetableSound::getWaveTableData(int channelIndex, int wavetableIndex, int mipmapLevel) const
+{
+	if (mipmapLevel == 0)
+		return getWaveTableData(channelIndex, wavetableIndex);
+
+	jassert(isPositiveAndNotGreaterThan(mipmapLevel, mipmaps.size()));
+	jassert(isPositiveAndBelow(wavetableIndex, wavetableAmount));
+	jassert(channelIndex == 0 || isStereo());
+
+	return mipmaps[mipmapLevel - 1]->getReadPointer(channelIndex, wavetableIndex * getTableSize(mipmapLevel));
+}
+
+void WavetableSound::createMipmaps(WavetableMipmapCache* cache)
+{
+	// The smallest level should still contain a few harmonics
+	static constexpr int MinMipmapTableSize = 32;
+
+	if (wavetableAmount <= 0 || !isPowerOfTwo(wavetableSize) || wavetableSize < 2 * MinMipmapTableSize)
+		return;
+
+	const int numChannels = wavetables.getNumChannels();
+
+	for (int size = wavetableSize / 2; size >= MinMipmapTableSize; size /= 2)
+		mipmaps.add(new AudioSampleBuffer(numChannels, size * wavetableAmount));
+
+	String cacheKey;
+
+	if (cache != nullptr)
+	{
+		cacheKey = getMipmapCacheKey();
+
+		if (cache->restore(cacheKey, mipmaps))
+			return;
+	}
+
+	juce::dsp::FFT fft(log2(wavetableSize));
+
+	HeapBlock<float> spectrum, work;
+	spectrum.calloc(2 * wavetableSize);
+	work.calloc(2 * wavetableSize);
+
+	for (int c = 0; c < numChannels; c++)
+	{
+		for (int t = 0; t < wavetableAmount; t++)
+		{
+			FloatVectorOperations::clear(spectrum, 2 * wavetableSize);
+			FloatVectorOperations::copy(spectrum, getWaveTableData(c, t), wavetableSize);
+			fft.performRealOnlyForwardTransform(spectrum);
+
+			for (int l = 0; l < mipmaps.size(); l++)
+			{
+				const int levelSize = getTableSize(l + 1);
+				const int stride = 1 << (l + 1);
+
+				// Remove all harmonics from the nyquist frequency of the smaller table
+				FloatVectorOperations::copy(work, spectrum, levelSize);
+				FloatVectorOperations::clear(work + levelSize, 2 * wavetableSize - levelSize);
+
+				fft.performRealOnlyInverseTransform(work);
+
+				// The table is band-limited now so we can just pick every nth sample
+				auto dst = mipmaps[l]->getWritePointer(c, t * levelSize);
+
+				for (int i = 0; i < levelSize; i++)
+					dst[i] = work[i * stride];
+			}
+		}
+	}
+
+	if (cache != nullptr)
+		cache->store(cacheKey, mipmaps);
+}
+
+String WavetableSound::getMipmapCacheKey() const
+{
+	String key;
+
+	for (int c = 0; c < wavetables.getNumChannels(); c++)
+		key << MD5(wavetables.getReadPointer(c), sizeof(float) * (size_t)wavetables.getNumSamples()).toHexString();
+
+	key << "_" << String(wavetableAmount);
+
+	return key;
+}
+
 void WavetableSound::calculatePitchRatio(double playBackSampleRate_)
 {
     playbackSampleRate = playBackSampleRate_;
@@ -587,6 +720,7 @@ String WavetableSound::getMarkdownDescription() const
 	printProperty("RootNote", MidiMessage::getMidiNoteName(getRootNote(), true, true, 3));
 	printProperty("Max Level", String(Decibels::gainToDecibels(getUnnormalizedMaximum()), 2) + " dB");
 	printProperty("Stereo", isStereo());
+	printProperty("Mipmap Levels", getNumMipmapLevels());
 	printProperty("Reversed", (bool)(int)isReversed());
 	printProperty("Storage Size", String(storageSize / 1024) + " kB");
 	printProperty("Memory Usage", String(memoryUsage / 1024) + " kB");
@@ -594,113 +728,198 @@ String WavetableSound::getMarkdownDescription() const
 	return s;
 }
 
+struct WavetableSound::RenderData::Block
+{
+	using SIMDType = dsp::SIMDRegister<float>;
+
+	static constexpr int getNumPaddedSamples(int numSamples)
+	{
+		return ((numSamples + (int)SIMDType::SIMDNumElements - 1) / (int)SIMDType::SIMDNumElements) * (int)SIMDType::SIMDNumElements;
+	}
+
+	int numSamples = 0;
+	double phases[BlockSize];
+	int lowerTables[BlockSize];
+	int upperTables[BlockSize];
+	alignas(SIMDType::SIMDRegisterSize) float tableAlphas[BlockSize];
+};
+
 void WavetableSound::RenderData::render(WavetableSound* currentSound, double& voiceUptime, const TableIndexFunction& tf)
 {
-	auto numTables = currentSound->getWavetableAmount();
-	auto stereoMode = currentSound->isStereo();
-	auto tableSize = currentSound->getTableSize();
+	float tableIndexValues[BlockSize];
 
-	dynamicPhase = currentSound->dynamicPhase;
+	const int start = startSample;
+	const int num = numSamples;
 
-	while (--numSamples >= 0)
+	for (int offset = 0; offset < num; offset += BlockSize)
 	{
-		int index = (int)voiceUptime;
+		const int numThisTime = jmin(BlockSize, num - offset);
 
-		span<int, 4> i;
+		for (int i = 0; i < numThisTime; i++)
+			tableIndexValues[i] = tf(start + offset + i);
 
-#if USE_MOD2_WAVETABLESIZE
-		i[0] = (index + tableSize - 1) & (tableSize - 1);
-		i[1] = index & (tableSize - 1);
-		i[2] = (index + 1) & (tableSize - 1);
-		i[3] = (index + 2) & (tableSize - 1);
-#else
-		i[1] = index % (tableSize);
-		i[2] = i[1] + 1;
-		i[0] = i[1] - 1;
-		i[3] = i[1] + 2;
+		RenderData r(b, start + offset, numThisTime, uptimeDelta, voicePitchValues, hqMode);
+		r.render(currentSound, voiceUptime, tableIndexValues);
+	}
+}
 
-		if (i[1] == 0)         i[0] = tableSize - 1;
-		if (i[2] >= tableSize) i[2] = 0;
-		if (i[3] >= tableSize) i[3] = 0;
+void WavetableSound::RenderData::render(WavetableSound* currentSound, double& voiceUptime, const float* tableIndexValues)
+{
+	using SIMDType = Block::SIMDType;
 
-#endif
+	auto numTables = currentSound->getWavetableAmount();
+	auto numChannels = currentSound->isStereo() ? 2 : 1;
 
-		const float tableModValue = tf(startSample);
-		const float tableValue = tableModValue * (float)(numTables - 1);
+	dynamicPhase = currentSound->dynamicPhase;
 
-		const int lowerTableIndex = (int)(tableValue);
+	Block block;
 
-		const float tableDelta = tableValue - (float)lowerTableIndex;
-		jassert(0.0f <= tableDelta && tableDelta <= 1.0f);
+	alignas(SIMDType::SIMDRegisterSize) float lowerLevelValues[BlockSize];
+	alignas(SIMDType::SIMDRegisterSize) float upperLevelValues[BlockSize];
 
-		const int upperTableIndex = jmin(numTables - 1, lowerTableIndex + 1);
+	while (numSamples > 0)
+	{
+		block.numSamples = jmin(BlockSize, numSamples);
 
-		auto lowerTable = currentSound->getWaveTableData(0, lowerTableIndex);
-		auto upperTable = currentSound->getWaveTableData(0, upperTableIndex);
-		const float alpha = float(voiceUptime) - (float)index;
+		double maxDelta = 0.0;
 
-		auto l = calculateSample(lowerTable, upperTable, i, alpha, tableDelta);
+		for (int i = 0; i < block.numSamples; i++)
+		{
+			const float tableValue = tableIndexValues[i] * (float)(numTables - 1);
+			const int lowerTableIndex = (int)(tableValue);
+			const float tableDelta = tableValue - (float)lowerTableIndex;
+			jassert(0.0f <= tableDelta && tableDelta <= 1.0f);
 
-		// Stereo mode assumed
-		b.setSample(0, startSample, l);
+			block.lowerTables[i] = lowerTableIndex;
+			block.upperTables[i] = jmin(numTables - 1, lowerTableIndex + 1);
+			block.tableAlphas[i] = tableDelta;
+			block.phases[i] = voiceUptime;
 
-		if (stereoMode)
-		{
-			auto lowerTableR = currentSound->getWaveTableData(1, lowerTableIndex);
-			auto upperTableR = currentSound->getWaveTableData(1, upperTableIndex);
+			jassert(voicePitchValues == nullptr || voicePitchValues[startSample + i] > 0.0f);
+
+			const double delta = (uptimeDelta * (voicePitchValues == nullptr ? 1.0 : voicePitchValues[startSample + i]));
 
-			auto r = calculateSample(lowerTableR, upperTableR, i, alpha, tableDelta);
-			b.setSample(1, startSample, r);
+			maxDelta = jmax(maxDelta, delta);
+			voiceUptime += delta;
 		}
 
-		jassert(voicePitchValues == nullptr || voicePitchValues[startSample] > 0.0f);
+		for (int i = block.numSamples; i < Block::getNumPaddedSamples(block.numSamples); i++)
+			block.tableAlphas[i] = 0.0f;
+
+		// Use the band-limited tables for the highest pitch in this block and
+		// crossfade between two levels so that pitch changes don't cause jumps
+		const auto mipmapLevel = currentSound->getMipmapLevelForDelta(maxDelta);
+		const auto lowerLevel = (int)mipmapLevel;
+		const auto levelAlpha = mipmapLevel - (float)lowerLevel;
 
-		const double delta = (uptimeDelta * (voicePitchValues == nullptr ? 1.0 : voicePitchValues[startSample]));
+		for (int c = 0; c < numChannels; c++)
+		{
+			renderMipmapLevel(currentSound, block, c, lowerLevel, lowerLevelValues);
 
-		voiceUptime += delta;
+			if (levelAlpha > 0.0f)
+			{
+				renderMipmapLevel(currentSound, block, c, lowerLevel + 1, upperLevelValues);
 
-		++startSample;
+				FloatVectorOperations::multiply(lowerLevelValues, 1.0f - levelAlpha, block.numSamples);
+				FloatVectorOperations::addWithMultiply(lowerLevelValues, upperLevelValues, levelAlpha, block.numSamples);
+			}
+
+			FloatVectorOperations::copy(b.getWritePointer(c, startSample), lowerLevelValues, block.numSamples);
+		}
+
+		tableIndexValues += block.numSamples;
+		startSample += block.numSamples;
+		numSamples -= block.numSamples;
 	}
 }
 
-float WavetableSound::RenderData::calculateSample(const float* lowerTable, const float* upperTable, const span<int, 4>& i, float alpha, float tableAlpha) const
+void WavetableSound::RenderData::renderMipmapLevel(WavetableSound* currentSound, const Block& block, int channelIndex, int mipmapLevel, float* destination) const
 {
-	float l0 = lowerTable[i[0]];
-	float l1 = lowerTable[i[1]];
-	float l2 = lowerTable[i[2]];
-	float l3 = lowerTable[i[3]];
+	using SIMDType = Block::SIMDType;
 
-	float sample;
+	const int tableSize = currentSound->getTableSize(mipmapLevel);
+	const double phaseFactor = 1.0 / (double)(1 << mipmapLevel);
+	const float* tableData = currentSound->getWaveTableData(channelIndex, 0, mipmapLevel);
 
-	if (lowerTable != upperTable)
+	alignas(SIMDType::SIMDRegisterSize) float alphas[BlockSize];
+	alignas(SIMDType::SIMDRegisterSize) float lower[4][BlockSize];
+	alignas(SIMDType::SIMDRegisterSize) float upper[4][BlockSize];
+
+	// Gather the interpolation points. This can't be vectorised, but it keeps
+	// the interpolation below free of branches.
+	for (int i = 0; i < block.numSamples; i++)
 	{
-		float u0 = upperTable[i[0]];
-		float u1 = upperTable[i[1]];
-		float u2 = upperTable[i[2]];
-		float u3 = upperTable[i[3]];
+		const double phase = block.phases[i] * phaseFactor;
+		const int index = (int)phase;
+
+		span<int, 4> idx;
 
-		float upperSample, lowerSample;
+#if USE_MOD2_WAVETABLESIZE
+		idx[1] = index & (tableSize - 1);
+#else
+		idx[1] = index % tableSize;
+#endif
+
+		idx[0] = idx[1] == 0 ? tableSize - 1 : idx[1] - 1;
+		idx[2] = idx[1] + 1 == tableSize ? 0 : idx[1] + 1;
+		idx[3] = idx[2] + 1 == tableSize ? 0 : idx[2] + 1;
+
+		alphas[i] = float(phase) - (float)index;
+
+		auto lowerTable = tableData + block.lowerTables[i] * tableSize;
+		auto upperTable = tableData + block.upperTables[i] * tableSize;
 
-		if (hqMode)
+		for (int j = 0; j < 4; j++)
 		{
-			upperSample = Interpolator::interpolateCubic(u0, u1, u2, u3, alpha);
-			lowerSample = Interpolator::interpolateCubic(l0, l1, l2, l3, alpha);
+			lower[j][i] = lowerTable[idx[j]];
+			upper[j][i] = upperTable[idx[j]];
 		}
-		else
+	}
+
+	const int numPadded = Block::getNumPaddedSamples(block.numSamples);
+
+	for (int i = block.numSamples; i < numPadded; i++)
+	{
+		alphas[i] = 0.0f;
+
+		for (int j = 0; j < 4; j++)
 		{
-			upperSample = Interpolator::interpolateLinear(u1, u2, alpha);
-			lowerSample = Interpolator::interpolateLinear(l1, l2, alpha);
+			lower[j][i] = 0.0f;
+			upper[j][i] = 0.0f;
 		}
-
-		sample = Interpolator::interpolateLinear(lowerSample, upperSample, tableAlpha);
 	}
-	else
+
+	// Same formulas as Interpolator::interpolateCubic() / Interpolator::interpolateLinear()
+	auto interpolate = [this](const float* x0, const float* x1, const float* x2, const float* x3, SIMDType alpha)
 	{
-		sample = hqMode ? Interpolator::interpolateCubic(l0, l1, l2, l3, alpha) :
-			Interpolator::interpolateLinear(l1, l2, alpha);
-	}
+		const auto v1 = SIMDType::fromRawArray(x1);
+		const auto v2 = SIMDType::fromRawArray(x2);
+
+		if (!hqMode)
+			return v1 * (SIMDType::expand(1.0f) - alpha) + v2 * alpha;
+
+		const auto v0 = SIMDType::fromRawArray(x0);
+		const auto v3 = SIMDType::fromRawArray(x3);
+
+		const auto ca = (((v1 - v2) * 3.0f) - v0 + v3) * 0.5f;
+		const auto cb = v2 + v2 + v0 - (v1 * 5.0f + v3) * 0.5f;
+		const auto cc = (v2 - v0) * 0.5f;
+
+		return ((ca * alpha + cb) * alpha + cc) * alpha + v1;
+	};
+
+	for (int i = 0; i < numPadded; i += (int)SIMDType::SIMDNumElements)
+	{
+		const auto alpha = SIMDType::fromRawArray(alphas + i);
+		const auto tableAlpha = SIMDType::fromRawArray(block.tableAlphas + i);
+
+		const auto lowerSample = interpolate(lower[0] + i, lower[1] + i, lower[2] + i, lower[3] + i, alpha);
+		const auto upperSample = interpolate(upper[0] + i, upper[1] + i, upper[2] + i, upper[3] + i, alpha);
 
-	return sample;
+		const auto sample = lowerSample * (SIMDType::expand(1.0f) - tableAlpha) + upperSample * tableAlpha;
+
+		sample.copyToRawArray(destination + i);
+	}
 }
 
 void WavetableMonolithHeader::writeProjectInfo(OutputStream& output, const String& projectName, const String& encryptionKey)
@@ -790,4 +1009,563 @@ Array<hise::WavetableMonolithHeader> WavetableMonolithHeader::readHeader(InputSt
 	return headers;
 }
 
+WavetableMipmapCache::WavetableMipmapCache(const File& cacheFile, int64 maxSize_) :
+	file(cacheFile),
+	maxSize(maxSize_),
+	processLock("HISE_WavetableMipmaps_" + String::toHexString(cacheFile.getFullPathName().hashCode64()))
+{
+	if (file == File())
+		return;
+
+	const ScopedLock sl(getFileLock());
+	InterProcessLock::ScopedLockType ipl(processLock);
+
+	readIndex();
+}
+
+WavetableMipmapCache::~WavetableMipmapCache()
+{
+	flush();
+}
+
+CriticalSection& WavetableMipmapCache::getFileLock()
+{
+	// The inter process lock doesn't exclude other threads of the same process
+	static CriticalSection lock;
+	return lock;
+}
+
+int64 WavetableMipmapCache::readIndex()
+{
+	entries.clearQuick();
+
+	if (!file.existsAsFile())
+		return 0;
+
+	FileInputStream fis(file);
+
+	if (!fis.openedOk() || fis.readString() != getFormatTag())
+		return 0;
+
+	const auto totalLength = fis.getTotalLength();
+	auto validEnd = fis.getPosition();
+
+	while (validEnd < totalLength)
+	{
+		Entry e;
+		e.key = fis.readString();
+		e.length = fis.readInt64();
+		e.dataOffset = validEnd + getRecordHeaderSize(e.key);
+
+		// Stop at the remains of an interrupted write
+		if (e.key.isEmpty() || e.length <= 0 || fis.getPosition() != e.dataOffset || e.dataOffset + e.length > totalLength)
+			break;
+
+		entries.add(e);
+		validEnd = e.dataOffset + e.length;
+
+		if (!fis.setPosition(validEnd))
+			break;
+	}
+
+	return validEnd;
+}
+
+bool WavetableMipmapCache::readEntry(const Entry& e, OwnedArray<AudioSampleBuffer>& levels)
+{
+	FileInputStream fis(file);
+
+	// Make sure that the file wasn't rewritten by another cache since the index was read
+	if (!fis.openedOk() || !fis.setPosition(e.dataOffset - getRecordHeaderSize(e.key)))
+		return false;
+
+	if (fis.readString() != e.key || fis.readInt64() != e.length)
+		return false;
+
+	for (auto l : levels)
+	{
+		for (int c = 0; c < l->getNumChannels(); c++)
+		{
+			const auto numChannelBytes = (int)(sizeof(float) * l->getNumSamples());
+
+			if (fis.read(l->getWritePointer(c), numChannelBytes) != numChannelBytes)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+bool WavetableMipmapCache::restore(const String& key, OwnedArray<AudioSampleBuffer>& levels)
+{
+	if (file == File())
+		return false;
+
+	int64 numBytes = 0;
+
+	for (auto l : levels)
+		numBytes += (int64)(sizeof(float) * l->getNumChannels() * l->getNumSamples());
+
+	const ScopedLock sl(getFileLock());
+	InterProcessLock::ScopedLockType ipl(processLock);
+
+	for (int attempt = 0; attempt < 2; attempt++)
+	{
+		for (const auto& e : entries)
+		{
+			if (e.key != key)
+				continue;
+
+			if (e.length != numBytes)
+				return false;
+
+			if (readEntry(e, levels))
+			{
+				usedKeys.addIfNotAlreadyThere(key);
+				return true;
+			}
+
+			// The offsets are outdated, so read the index again and try once more
+			readIndex();
+			break;
+		}
+	}
+
+	return false;
+}
+
+void WavetableMipmapCache::store(const String& key, const OwnedArray<AudioSampleBuffer>& levels)
+{
+	if (file == File())
+		return;
+
+	auto mb = new MemoryBlock();
+	MemoryOutputStream mos(*mb, false);
+
+	for (auto l : levels)
+	{
+		for (int c = 0; c < l->getNumChannels(); c++)
+			mos.write(l->getReadPointer(c), sizeof(float) * l->getNumSamples());
+	}
+
+	mos.flush();
+
+	newKeys.add(key);
+	newData.add(mb);
+	usedKeys.addIfNotAlreadyThere(key);
+}
+
+void WavetableMipmapCache::flush()
+{
+	if (newKeys.isEmpty() || file == File())
+		return;
+
+	const ScopedLock sl(getFileLock());
+	InterProcessLock::ScopedLockType ipl(processLock);
+
+	// Another cache might have written to the file in the meantime
+	const auto validEnd = readIndex();
+
+	int64 numNewBytes = 0;
+
+	for (int i = 0; i < newKeys.size(); i++)
+	{
+		auto exists = std::any_of(entries.begin(), entries.end(), [&](const Entry& e) { return e.key == newKeys[i]; });
+
+		if (exists || newKeys.indexOf(newKeys[i]) != i)
+		{
+			newKeys.remove(i);
+			newData.remove(i--);
+			continue;
+		}
+
+		numNewBytes += getRecordHeaderSize(newKeys[i]) + (int64)newData[i]->getSize();
+	}
+
+	if (!newKeys.isEmpty())
+	{
+		if (validEnd > 0 && validEnd + numNewBytes <= maxSize)
+			append(validEnd);
+		else
+			rewrite();
+	}
+
+	newKeys.clear();
+	newData.clear();
+}
+
+void WavetableMipmapCache::append(int64 validEnd)
+{
+	FileOutputStream fos(file);
+
+	if (!fos.openedOk())
+		return;
+
+	// Remove the remains of an interrupted write so that the new records can be found
+	if (fos.getPosition() != validEnd)
+	{
+		fos.setPosition(validEnd);
+		fos.truncate();
+	}
+
+	for (int i = 0; i < newKeys.size(); i++)
+	{
+		fos.writeString(newKeys[i]);
+		fos.writeInt64((int64)newData[i]->getSize());
+		fos.write(newData[i]->getData(), newData[i]->getSize());
+	}
+
+	fos.flush();
+}
+
+void WavetableMipmapCache::rewrite()
+{
+	int64 numBytes = (int64)getFormatTag().getNumBytesAsUTF8() + 1;
+
+	for (int i = 0; i < newKeys.size(); i++)
+		numBytes += getRecordHeaderSize(newKeys[i]) + (int64)newData[i]->getSize();
+
+	// Keep the entries that were used by this cache and then the most recent ones until the file is full
+	Array<bool> keep;
+	keep.insertMultiple(0, false, entries.size());
+
+	auto addIfFits = [&](int index)
+	{
+		auto size = getRecordHeaderSize(entries[index].key) + entries[index].length;
+
+		if (!keep[index] && numBytes + size <= maxSize)
+		{
+			keep.set(index, true);
+			numBytes += size;
+		}
+	};
+
+	for (int i = 0; i < entries.size(); i++)
+	{
+		if (usedKeys.contains(entries[i].key))
+			addIfFits(i);
+	}
+
+	for (int i = entries.size() - 1; i >= 0; i--)
+		addIfFits(i);
+
+	TemporaryFile tempFile(file);
+
+	{
+		FileOutputStream fos(tempFile.getFile());
+
+		if (!fos.openedOk())
+			return;
+
+		fos.writeString(getFormatTag());
+
+		FileInputStream fis(file);
+
+		for (int i = 0; i < entries.size(); i++)
+		{
+			MemoryBlock mb;
+
+			if (keep[i] && fis.openedOk() && fis.setPosition(entries[i].dataOffset) &&
+				fis.readIntoMemoryBlock(mb, (ssize_t)entries[i].length) == (size_t)entries[i].length)
+			{
+				fos.writeString(entries[i].key);
+				fos.writeInt64(entries[i].length);
+				fos.write(mb.getData(), mb.getSize());
+			}
+		}
+
+		for (int i = 0; i < newKeys.size(); i++)
+		{
+			fos.writeString(newKeys[i]);
+			fos.writeInt64((int64)newData[i]->getSize());
+			fos.write(newData[i]->getData(), newData[i]->getSize());
+		}
+
+		fos.flush();
+
+		if (fos.getStatus().failed())
+			return;
+	}
+
+	tempFile.overwriteTargetFileWithTemporary();
+
+	readIndex();
+}
+
+#if HI_RUN_UNIT_TESTS
+
+class WavetableMipmapCacheTest : public UnitTest
+{
+public:
+
+	WavetableMipmapCacheTest() :
+		UnitTest("Testing the wavetable mipmap cache", "wavetable")
+	{}
+
+	void runTest() override
+	{
+		testRoundTrip();
+		testAppend();
+		testEviction();
+		testInterruptedWrite();
+		testConcurrentWriters();
+		testMipmapLevels();
+	}
+
+private:
+
+	static constexpr int NumLevels = 3;
+
+	void createLevels(OwnedArray<AudioSampleBuffer>& levels, int seed)
+	{
+		levels.clear();
+		Random r(seed);
+
+		for (int i = 0; i < NumLevels; i++)
+		{
+			auto l = levels.add(new AudioSampleBuffer(2, 256 >> i));
+
+			for (int c = 0; c < l->getNumChannels(); c++)
+				for (int s = 0; s < l->getNumSamples(); s++)
+					l->setSample(c, s, r.nextFloat() * 2.0f - 1.0f);
+		}
+	}
+
+	bool restoreAndCompare(WavetableMipmapCache& cache, int seed)
+	{
+		OwnedArray<AudioSampleBuffer> expected, restored;
+		createLevels(expected, seed);
+		createLevels(restored, seed + 1);
+
+		if (!cache.restore(getKey(seed), restored))
+			return false;
+
+		for (int i = 0; i < NumLevels; i++)
+		{
+			for (int c = 0; c < 2; c++)
+			{
+				if (memcmp(expected[i]->getReadPointer(c), restored[i]->getReadPointer(c), sizeof(float) * expected[i]->getNumSamples()) != 0)
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	void storeLevels(WavetableMipmapCache& cache, int seed)
+	{
+		OwnedArray<AudioSampleBuffer> levels;
+		createLevels(levels, seed);
+		cache.store(getKey(seed), levels);
+	}
+
+	static String getKey(int seed) { return "table" + String(seed); }
+
+	static int64 getEntrySize() { return 2 * (256 + 128 + 64) * (int64)sizeof(float) + 16; }
+
+	void testRoundTrip()
+	{
+		beginTest("Testing round trip");
+
+		TemporaryFile f(".hwm");
+
+		{
+			WavetableMipmapCache cache(f.getFile());
+			expect(!restoreAndCompare(cache, 1), "empty cache returns data");
+			storeLevels(cache, 1);
+			storeLevels(cache, 2);
+		}
+
+		WavetableMipmapCache cache(f.getFile());
+		expect(restoreAndCompare(cache, 1), "first entry can't be restored");
+		expect(restoreAndCompare(cache, 2), "second entry can't be restored");
+		expect(!restoreAndCompare(cache, 3), "unknown key returns data");
+
+		OwnedArray<AudioSampleBuffer> wrongSize;
+		wrongSize.add(new AudioSampleBuffer(2, 512));
+		expect(!cache.restore(getKey(1), wrongSize), "entry with wrong size was restored");
+	}
+
+	void testAppend()
+	{
+		beginTest("Testing that new entries are appended");
+
+		TemporaryFile f(".hwm");
+
+		{
+			WavetableMipmapCache cache(f.getFile());
+			storeLevels(cache, 1);
+		}
+
+		MemoryBlock before;
+		f.getFile().loadFileAsData(before);
+
+		{
+			WavetableMipmapCache cache(f.getFile());
+			expect(restoreAndCompare(cache, 1));
+			storeLevels(cache, 2);
+		}
+
+		MemoryBlock after;
+		f.getFile().loadFileAsData(after);
+
+		expect(after.getSize() > before.getSize(), "file didn't grow");
+		expect(memcmp(before.getData(), after.getData(), before.getSize()) == 0, "existing data was changed");
+
+		{
+			// Storing an existing key must not add a duplicate record
+			WavetableMipmapCache cache(f.getFile());
+			storeLevels(cache, 2);
+		}
+
+		expectEquals(f.getFile().getSize(), (int64)after.getSize(), "duplicate entry was written");
+	}
+
+	void testEviction()
+	{
+		beginTest("Testing eviction");
+
+		TemporaryFile f(".hwm");
+		const auto maxSize = 3 * getEntrySize() + 64;
+
+		for (int i = 0; i < 3; i++)
+		{
+			WavetableMipmapCache cache(f.getFile(), maxSize);
+			storeLevels(cache, i);
+		}
+
+		{
+			WavetableMipmapCache cache(f.getFile(), maxSize);
+			expect(restoreAndCompare(cache, 0), "used entry was not found");
+			storeLevels(cache, 3);
+			storeLevels(cache, 4);
+		}
+
+		expect(f.getFile().getSize() <= maxSize, "cache file exceeds the maximum size");
+
+		WavetableMipmapCache cache(f.getFile(), maxSize);
+		expect(restoreAndCompare(cache, 0), "used entry was evicted");
+		expect(restoreAndCompare(cache, 3), "new entry was evicted");
+		expect(restoreAndCompare(cache, 4), "new entry was evicted");
+		expect(!restoreAndCompare(cache, 1), "oldest entry was not evicted");
+		expect(!restoreAndCompare(cache, 2), "old entry was not evicted");
+	}
+
+	void testInterruptedWrite()
+	{
+		beginTest("Testing recovery from an interrupted write");
+
+		TemporaryFile f(".hwm");
+
+		{
+			WavetableMipmapCache cache(f.getFile());
+			storeLevels(cache, 1);
+			storeLevels(cache, 2);
+		}
+
+		{
+			// Cut off the last record in the middle of its data
+			FileOutputStream fos(f.getFile());
+			fos.setPosition(fos.getPosition() - 100);
+			fos.truncate();
+		}
+
+		{
+			WavetableMipmapCache cache(f.getFile());
+			expect(restoreAndCompare(cache, 1), "complete entry was lost");
+			expect(!restoreAndCompare(cache, 2), "truncated entry was restored");
+			storeLevels(cache, 3);
+		}
+
+		WavetableMipmapCache cache(f.getFile());
+		expect(restoreAndCompare(cache, 1), "complete entry was lost");
+		expect(restoreAndCompare(cache, 3), "entry after truncated data can't be found");
+
+		f.getFile().replaceWithText("not a mipmap cache");
+
+		{
+			WavetableMipmapCache invalid(f.getFile());
+			expect(!restoreAndCompare(invalid, 1));
+			storeLevels(invalid, 1);
+		}
+
+		WavetableMipmapCache replaced(f.getFile());
+		expect(restoreAndCompare(replaced, 1), "invalid file wasn't replaced");
+	}
+
+	void testConcurrentWriters()
+	{
+		beginTest("Testing concurrent writers");
+
+		TemporaryFile f(".hwm");
+		static constexpr int NumThreads = 4;
+		static constexpr int NumEntriesPerThread = 5;
+
+		struct Writer : public Thread
+		{
+			Writer(WavetableMipmapCacheTest& parent_, const File& f_, int index_) :
+				Thread("Mipmap writer"),
+				parent(parent_),
+				f(f_),
+				index(index_)
+			{}
+
+			void run() override
+			{
+				for (int i = 0; i < NumEntriesPerThread; i++)
+				{
+					WavetableMipmapCache cache(f);
+					parent.storeLevels(cache, index * NumEntriesPerThread + i);
+				}
+			}
+
+			WavetableMipmapCacheTest& parent;
+			File f;
+			int index;
+		};
+
+		OwnedArray<Writer> writers;
+
+		for (int i = 0; i < NumThreads; i++)
+			writers.add(new Writer(*this, f.getFile(), i))->startThread();
+
+		for (auto w : writers)
+			w->waitForThreadToExit(10000);
+
+		WavetableMipmapCache cache(f.getFile());
+
+		for (int i = 0; i < NumThreads * NumEntriesPerThread; i++)
+			expect(restoreAndCompare(cache, i), "entry " + String(i) + " is missing");
+	}
+
+	void testMipmapLevels()
+	{
+		beginTest("Testing the mipmap level selection");
+
+		static constexpr int NumMipmaps = 5;
+
+		expectEquals(WavetableSound::getMipmapLevelForDelta(2.0, 0), 0.0f, "level without mipmaps");
+		expectEquals(WavetableSound::getMipmapLevelForDelta(0.25, NumMipmaps), 0.0f, "low notes don't use the original table");
+		expectEquals(WavetableSound::getMipmapLevelForDelta(1000.0, NumMipmaps), (float)NumMipmaps, "level is not limited");
+
+		auto lastLevel = 0.0f;
+
+		for (double delta = 0.1; delta <= (double)(1 << NumMipmaps); delta *= 1.01)
+		{
+			const auto level = WavetableSound::getMipmapLevelForDelta(delta, NumMipmaps);
+			const auto lowerLevel = (int)level;
+
+			// Both levels of the crossfade must be played back slow enough
+			expect(delta <= (double)(1 << lowerLevel) * 1.0001, "level " + String(lowerLevel) + " aliases at delta " + String(delta));
+			expect(level >= lastLevel && level - lastLevel < 0.02f, "level selection is not continuous");
+
+			lastLevel = level;
+		}
+	}
+};
+
+static WavetableMipmapCacheTest wavetableMipmapCacheTest;
+
+#endif
+
 } // namespace hise
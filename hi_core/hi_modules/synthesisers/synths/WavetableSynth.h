@@ -61,6 +61,69 @@ struct WavetableMonolithHeader
 	int64 length;
 };
 
+/** A file that stores the band-limited mipmaps of wavetables so that they don't have to be calculated on each load.
+
+	The file is a list of records (key, size, data) and each entry is identified with a hash of the wavetable data,
+	so a changed wavetable will never pick up stale data. New entries are appended to the file when the cache goes out
+	of scope. If the file would exceed the maximum size, it is rewritten to a temporary file (keeping the entries that
+	were used by this cache and the most recent ones) which then replaces the old file.
+
+	All file access is guarded by a lock that is shared between all caches and processes that use the same file.
+*/
+class WavetableMipmapCache
+{
+public:
+
+	static constexpr int64 DefaultMaxSize = 64 * 1024 * 1024;
+
+	WavetableMipmapCache(const File& cacheFile, int64 maxSize=DefaultMaxSize);
+	~WavetableMipmapCache();
+
+	/** Reads the mipmap levels with the given key into the (already allocated) buffers. */
+	bool restore(const String& key, OwnedArray<AudioSampleBuffer>& levels);
+
+	/** Adds the mipmap levels to the cache. */
+	void store(const String& key, const OwnedArray<AudioSampleBuffer>& levels);
+
+	/** Writes the new entries to the file. This is called automatically in the destructor. */
+	void flush();
+
+private:
+
+	struct Entry
+	{
+		String key;
+		int64 dataOffset;
+		int64 length;
+	};
+
+	static String getFormatTag() { return "HISE Wavetable Mipmaps v2"; }
+
+	static int64 getRecordHeaderSize(const String& key) { return (int64)key.getNumBytesAsUTF8() + 1 + (int64)sizeof(int64); }
+
+	static CriticalSection& getFileLock();
+
+	/** Reads the list of entries and returns the end of the last complete record (or 0 if the file is not a valid cache). */
+	int64 readIndex();
+
+	bool readEntry(const Entry& e, OwnedArray<AudioSampleBuffer>& levels);
+
+	void append(int64 validEnd);
+	void rewrite();
+
+	File file;
+	const int64 maxSize;
+	InterProcessLock processLock;
+
+	Array<Entry> entries;
+	StringArray usedKeys;
+
+	StringArray newKeys;
+	OwnedArray<MemoryBlock> newData;
+
+	JUCE_DECLARE_NON_COPYABLE(WavetableMipmapCache);
+};
+
 class WavetableSound: public ModulatorSynthSound
 {
 public:
@@ -74,8 +137,10 @@ public:
 	*	- 'noteNumber' the noteNumber
 	*	- 'sampleRate' the sample rate
 	*
+	*	If the table size is a power of two, it also creates the band-limited mipmaps. Pass in a cache
+	*	if you want to reuse mipmaps that were calculated before.
 	*/
-	WavetableSound(const ValueTree &wavetableData, Processor* parent);;
+	WavetableSound(const ValueTree &wavetableData, Processor* parent, WavetableMipmapCache* mipmapCache=nullptr);;
 
 	bool appliesToNote (int midiNoteNumber) override   { return midiNotes[midiNoteNumber]; }
     bool appliesToChannel (int /*midiChannel*/) override   { return true; }
@@ -87,6 +152,36 @@ public:
 	*/
 	const float *getWaveTableData(int channelIndex, int wavetableIndex) const;
 
+	/** Returns a read pointer to the wavetable in the given mipmap level. Level 0 is the original wavetable. */
+	const float *getWaveTableData(int channelIndex, int wavetableIndex, int mipmapLevel) const;
+
+	/** Returns the number of mipmap levels including the original wavetable.
+	*
+	*	Each level halves the table size and contains only the harmonics that fit into the smaller table,
+	*	so level n can be played back without aliasing as long as it advances at most 2^n table samples
+	*	per output sample.
+	*/
+	int getNumMipmapLevels() const { return mipmaps.size() + 1; }
+
+	int getTableSize(int mipmapLevel) const { return wavetableSize >> mipmapLevel; }
+
+	/** Returns the (fractional) mipmap level for the given amount of table samples per output sample. */
+	float getMipmapLevelForDelta(double delta) const { return getMipmapLevelForDelta(delta, mipmaps.size()); }
+
+	/** Returns the (fractional) mipmap level for the given delta and number of mipmaps.
+	*
+	*	The renderer crossfades between the level below and above this value, so the level below must
+	*	already be free of aliasing. This is why the result is one octave above log2(delta): the original
+	*	table is used on its own up to a delta of 0.5 and is faded out until a delta of 1.0.
+	*/
+	static float getMipmapLevelForDelta(double delta, int numMipmaps)
+	{
+		if (delta <= 0.0 || numMipmaps == 0)
+			return 0.0f;
+
+		return jlimit(0.0f, (float)numMipmaps, (float)std::log2(delta) + 1.0f);
+	}
+
 	float getUnnormalizedMaximum() const
 	{
 		return unnormalizedMaximum;
@@ -143,6 +238,9 @@ public:
 
 	struct RenderData
 	{
+		/** The amount of samples that are processed at once. */
+		static constexpr int BlockSize = 32;
+
 		using TableIndexFunction = std::function<float(int)>;
 		RenderData(AudioSampleBuffer& b_, int startSample_, int numSamples_, double uptimeDelta_, const float* voicePitchValues_, bool hqMode_) :
 			b(b_),
@@ -161,13 +259,25 @@ public:
 		const bool hqMode;
 		bool dynamicPhase = false;
 
+		/** Renders the voice with a function that returns the table index for each sample. */
 		void render(WavetableSound* currentSound, double& voiceUptime, const TableIndexFunction& tf);
 
-		float calculateSample(const float* lowerTable, const float* upperTable, const span<int, 4>& i, float alpha, float tableAlpha) const;
+		/** Renders the voice with the table index values (0...1) for each sample starting at startSample. */
+		void render(WavetableSound* currentSound, double& voiceUptime, const float* tableIndexValues);
+
+	private:
+
+		struct Block;
+
+		void renderMipmapLevel(WavetableSound* currentSound, const Block& block, int channelIndex, int mipmapLevel, float* destination) const;
 	};
 
 private:
 
+	void createMipmaps(WavetableMipmapCache* cache);
+
+	String getMipmapCacheKey() const;
+
 	float reversed = 0.0f;
 	bool stereo = false;
 
@@ -184,6 +294,7 @@ private:
 	int noteNumber;
 
 	AudioSampleBuffer wavetables;
+	OwnedArray<AudioSampleBuffer> mipmaps;
 	AudioSampleBuffer emptyBuffer;
 
 	double sampleRate;
@@ -294,10 +405,12 @@ public:
 		clearSounds();
         
 		jassert(v.isValid());
+
+		WavetableMipmapCache mipmapCache(getMipmapCacheFile());
         
 		for(int i = 0; i < v.getNumChildren(); i++)
 		{
-			auto s = new WavetableSound(v.getChild(i), this);
+			auto s = new WavetableSound(v.getChild(i), this, &mipmapCache);
 
 			s->calculatePitchRatio(getSampleRate());
 
@@ -388,6 +501,9 @@ public:
 
 	float getTotalTableModValue(int offset);
 
+	/** Calculates the table index values of the current voice for the given range (using the same logic as getTotalTableModValue()). */
+	void calculateTableModValues(float* destination, int startSample, int numSamples);
+
 	float getDefaultValue(int parameterIndex) const override
 	{
 		if (parameterIndex < ModulatorSynth::numModulatorSynthParameters) return ModulatorSynth::getDefaultValue(parameterIndex);
@@ -472,6 +588,9 @@ public:
 
 	File getWavetableMonolith() const;
 
+	/** Returns the file that stores the precalculated mipmaps (in the app data directory). */
+	File getMipmapCacheFile() const;
+
 	StringArray getWavetableList() const;
 
 	void loadWavetableFromIndex(int index);
@@ -121,6 +121,16 @@ syncVoiceHandler(false)
 	sampleEditHandler = new SampleEditHandler(this);
 #endif
 
+	if (auto pool = mc->getAudioRenderThreadPool())
+	{
+		for (int i = 1; i < pool->getNumThreads(); i++)
+			threadTemporaryVoiceBuffers.add(new hlac::HiseSampleBuffer(DEFAULT_BUFFER_TYPE_IS_FLOAT, 2, 0));
+	}
+
+#if HISE_SAMPLE_PREFETCH_MILLISECONDS > 0
+	prefetcher = new Prefetcher(*this);
+#endif
+
 	modChains += {this, "Sample Start", ModulatorChain::ModulationType::VoiceStartOnly, Modulation::GainMode};
 	modChains += {this, "Group Fade"};
 
@@ -183,11 +193,16 @@ syncVoiceHandler(false)
 	PrepareSpecs ps;
 	ps.voiceIndex = &syncVoiceHandler;
 	syncer.state.prepare(ps);
+
+#if HISE_SAMPLER_USE_NOTE_INDEX
+	soundCollector = new NoteIndexCollector(this);
+#endif
 }
 
 
 ModulatorSampler::~ModulatorSampler()
 {
+	prefetcher = nullptr;
 	soundCollector = nullptr;
 	sampleMap = nullptr;
 	abortIteration = true;
@@ -722,6 +737,11 @@ void ModulatorSampler::prepareToPlay(double newSampleRate, int samplesPerBlock)
 	}
 }
 
+bool ModulatorSampler::canRenderVoicesInParallel() const
+{
+	return getNumMicPositions() == 1 && !currentTimestretchOptions;
+}
+
 ProcessorEditorBody* ModulatorSampler::createEditor(ProcessorEditor *parentEditor)
 {
 #if USE_BACKEND
@@ -883,12 +903,18 @@ void ModulatorSampler::refreshMemoryUsage(bool fastMode)
 		{
 			temporaryVoiceBuffer = hlac::HiseSampleBuffer(temporaryBufferShouldBeFloatingPoint, 2, 0);
 
+			for (auto b : threadTemporaryVoiceBuffers)
+				*b = hlac::HiseSampleBuffer(temporaryBufferShouldBeFloatingPoint, 2, 0);
+
 			for (auto i = 0; i < getNumVoices(); i++)
 				static_cast<ModulatorSamplerVoice*>(getVoice(i))->setStreamingBufferDataType(temporaryBufferShouldBeFloatingPoint);
 		}
 
 		StreamingSamplerVoice::initTemporaryVoiceBuffer(&temporaryVoiceBuffer, getLargestBlockSize(), (double)MAX_SAMPLER_PITCH);
 
+		for (auto b : threadTemporaryVoiceBuffers)
+			StreamingSamplerVoice::initTemporaryVoiceBuffer(b, getLargestBlockSize(), (double)MAX_SAMPLER_PITCH);
+
 		PrepareSpecs ps;
 		ps.blockSize = getLargestBlockSize() * MAX_SAMPLER_PITCH;
 		ps.numChannels = 2;
@@ -918,6 +944,9 @@ void ModulatorSampler::refreshMemoryUsage(bool fastMode)
         if(!fastMode && maxPitch > (double)MAX_SAMPLER_PITCH)
         {
             StreamingSamplerVoice::initTemporaryVoiceBuffer(&temporaryVoiceBuffer, getLargestBlockSize(), maxPitch * 1.2); // give it a little more to be safe...
+
+			for (auto b : threadTemporaryVoiceBuffers)
+				StreamingSamplerVoice::initTemporaryVoiceBuffer(b, getLargestBlockSize(), maxPitch * 1.2);
         }
 	}
 
@@ -1037,14 +1066,20 @@ void ModulatorSampler::setDisplayedGroup(int index, bool shouldBeVisible, Modifi
 
 void ModulatorSampler::setSortByGroup(bool shouldSortByGroup)
 {
-	if (shouldSortByGroup != (soundCollector != nullptr))
+	auto isSortedByGroup = dynamic_cast<GroupedRoundRobinCollector*>(soundCollector.get()) != nullptr;
+
+	if (shouldSortByGroup != isSortedByGroup)
 	{
 		LockHelpers::SafeLock sl(getMainController(), LockHelpers::Type::AudioLock);
 
 		if (shouldSortByGroup)
 			soundCollector = new GroupedRoundRobinCollector(this);
 		else
+#if HISE_SAMPLER_USE_NOTE_INDEX
+			soundCollector = new NoteIndexCollector(this);
+#else
 			soundCollector = nullptr;
+#endif
 	}
 }
 
@@ -1177,6 +1212,152 @@ void ModulatorSampler::AsyncPurger::handleAsyncUpdate()
 	sampler->refreshChannelsForSounds();
 }
 
+ModulatorSampler::Prefetcher::Prefetcher(ModulatorSampler& parent_) :
+	SampleThreadPool::Job("Sample Prefetcher"),
+	parent(parent_),
+	pendingNotes(128)
+{
+	recentNotes.fill({ {}, 0 });
+	recentSounds.fill({ nullptr, 0 });
+}
+
+ModulatorSampler::Prefetcher::~Prefetcher()
+{
+	signalJobShouldExit();
+
+	// the job accesses the sounds of the sampler, so we need to wait until it's finished
+	while (isRunning())
+		Thread::yield();
+}
+
+void ModulatorSampler::Prefetcher::addPrediction(const HiseEvent& e, int rrGroup, int samplesUntilNoteOn)
+{
+	PredictedNote n;
+	n.noteNumber = (int8)jlimit(0, 127, e.getNoteNumber() + e.getTransposeAmount());
+	n.velocity = e.getVelocity();
+	n.rrGroup = (int8)rrGroup;
+
+	if (pendingNotes.try_enqueue(n))
+		earliestNoteOn = jmin(earliestNoteOn, samplesUntilNoteOn);
+}
+
+void ModulatorSampler::Prefetcher::flush()
+{
+	if (earliestNoteOn == std::numeric_limits<int>::max())
+		return;
+
+	if (!isQueued())
+	{
+		setDeadlineInSamples((double)earliestNoteOn, parent.getSampleRate());
+		parent.getBackgroundThreadPool()->addJob(this, false);
+	}
+
+	earliestNoteOn = std::numeric_limits<int>::max();
+}
+
+template <typename T, size_t N> bool ModulatorSampler::Prefetcher::wasUsedRecently(std::array<std::pair<T, uint32>, N>& recentItems, int& index, const T& item, uint32 now)
+{
+	for (const auto& r : recentItems)
+	{
+		if (r.first == item && (now - r.second) < (uint32)HISE_SAMPLE_PREFETCH_MILLISECONDS)
+			return true;
+	}
+
+	recentItems[index] = { item, now };
+	index = (index + 1) % (int)N;
+	return false;
+}
+
+SampleThreadPool::Job::JobStatus ModulatorSampler::Prefetcher::runJob()
+{
+	PredictedNote n;
+
+	// The sounds can't be removed as long as we hold this lock. If it's
+	// locked by the loading thread, the predictions are just discarded.
+	const ScopedTryLock sl(parent.getMainController()->getSampleManager().getSampleLock());
+
+	if (!sl.isLocked())
+	{
+		while (pendingNotes.try_dequeue(n))
+			;
+
+		return SampleThreadPool::Job::jobHasFinished;
+	}
+
+	// This is the amount that a voice will request with its first disk read
+	const int numSamplesToPrefetch = parent.bufferSize * parent.preloadScaleFactor;
+	const bool ignoreGroups = parent.crossfadeGroups;
+
+	while (pendingNotes.try_dequeue(n))
+	{
+		if (shouldExit())
+			break;
+
+		const auto now = Time::getMillisecondCounter();
+
+		if (wasUsedRecently(recentNotes, recentNoteIndex, n, now))
+			continue;
+
+		for (int i = 0; i < parent.getNumSounds(); i++)
+		{
+			auto s = static_cast<ModulatorSamplerSound*>(parent.getSound(i));
+
+			if (s == nullptr || s->isPurged() || !s->appliesToNote(n.noteNumber) || !s->appliesToVelocity(n.velocity))
+				continue;
+
+			if (!ignoreGroups && n.rrGroup > 0 && !s->appliesToRRGroup(n.rrGroup))
+				continue;
+
+			for (int m = 0; m < s->getNumMultiMicSamples(); m++)
+			{
+				if (auto ss = s->getReferenceToSound(m))
+				{
+					if (!wasUsedRecently(recentSounds, recentSoundIndex, static_cast<const StreamingSamplerSound*>(ss.get()), now))
+						ss->prefetch(numSamplesToPrefetch);
+				}
+			}
+		}
+	}
+
+	return SampleThreadPool::Job::jobHasFinished;
+}
+
+void ModulatorSampler::addPredictedNotesToPrefetcher()
+{
+	const int lookaheadSamples = roundToInt((double)HISE_SAMPLE_PREFETCH_MILLISECONDS * 0.001 * getSampleRate());
+
+	// Predict the round robin group that the upcoming notes will use
+	int rrGroup = multiRRGroupState.getSingleGroupIndex();
+
+	auto addUpcomingNotes = [&](const HiseEventBuffer& b)
+	{
+		for (const auto& e : b)
+		{
+			if (e.getTimeStamp() > lookaheadSamples)
+				break;
+
+			if (!e.isNoteOn() || e.isIgnored())
+				continue;
+
+			if (useRoundRobinCycleLogic && !crossfadeGroups)
+			{
+				if (++rrGroup > rrGroupAmount)
+					rrGroup = 1;
+			}
+
+			prefetcher->addPrediction(e, useRoundRobinCycleLogic ? rrGroup : -1, e.getTimeStamp());
+		}
+	};
+
+	for (auto s = dynamic_cast<ModulatorSynth*>(this); s != nullptr; s = dynamic_cast<ModulatorSynth*>(s->getParentProcessor(true, false)))
+	{
+		addUpcomingNotes(s->midiProcessorChain->getArtificialEvents());
+		addUpcomingNotes(s->midiProcessorChain->getPredictedEvents());
+	}
+
+	prefetcher->flush();
+}
+
 void ModulatorSampler::setPreloadSize(int newPreloadSize)
 {
 	if (newPreloadSize != 0 && newPreloadSize != preloadSize)
@@ -1240,6 +1421,9 @@ void ModulatorSampler::renderNextBlockWithModulators(AudioSampleBuffer& outputAu
 
 	ModulatorSynth::renderNextBlockWithModulators(outputAudio, inputMidi);
 
+	if (prefetcher != nullptr && !getMainController()->getSampleManager().isNonRealtime())
+		addPredictedNotesToPrefetcher();
+
 	if(!eventIdsForGroupIndexes.isEmpty())
 	{
 		// Copy over the last state from the queue (this makes it effectively the same as calling
@@ -1917,13 +2101,12 @@ bool ModulatorSampler::preloadAllSamples()
 	ModulatorSampler::SoundIterator sIter(this);
 	jassert(sIter.canIterate());
 
-	const int numToLoad = jmax<int>(1, sounds.size() * getNumMicPositions());
-	int currentIndex = 0;
-
 	auto& progress = getMainController()->getSampleManager().getPreloadProgress();
 
 	auto threadPool = getMainController()->getSampleManager().getGlobalSampleThreadPool();
 
+	ParallelPreloader preloader;
+
 	while (auto sound = sIter.getNextSound())
 	{
 		if (threadPool->threadShouldExit())
@@ -1933,12 +2116,7 @@ bool ModulatorSampler::preloadAllSamples()
 
 		if (getNumMicPositions() == 1)
 		{
-			auto s = sound->getReferenceToSound().get();
-
-			progress = (double)currentIndex++ / (double)numToLoad;
-
-			if (!preloadSample(s, preloadSizeToUse))
-				return false;
+			preloader.addSound(sound->getReferenceToSound().get(), preloadSizeToUse);
 		}
 		else
 		{
@@ -1946,24 +2124,30 @@ bool ModulatorSampler::preloadAllSamples()
 			{
 				const bool isEnabled = getChannelData(j).enabled;
 
-				progress = (double)currentIndex++ / (double)numToLoad;
-
 				if (auto s = sound->getReferenceToSound(j))
 				{
 					if (isEnabled)
-					{
-						if (!preloadSample(s.get(), preloadSizeToUse))
-							return false;
-					}
+						preloader.addSound(s.get(), preloadSizeToUse);
 					else
 						s->setPurged(true);
 				}
 			}
 		}
+	}
 
-		sound->setReversed(isReversed);
+	if (!preloader.run([threadPool]() { return threadPool->threadShouldExit(); }, progress))
+	{
+		if (auto e = preloader.getFirstError())
+			logPreloadError(*e);
+
+		return false;
 	}
 
+	sIter.reset();
+
+	while (auto sound = sIter.getNextSound())
+		sound->setReversed(isReversed);
+
 	refreshReleaseStartFlag();
 	refreshMemoryUsage();
 	setShouldUpdateUI(true);
@@ -1988,18 +2172,22 @@ bool ModulatorSampler::preloadSample(StreamingSamplerSound * s, const int preloa
 	}
 	catch (StreamingSamplerSound::LoadingError l)
 	{
-		String x;
-		x << "Error at preloading sample " << l.fileName << ": " << l.errorDescription;
-		getMainController()->getDebugLogger().logMessage(x);
+		logPreloadError(l);
+		return false;
+	}
+}
+
+void ModulatorSampler::logPreloadError(const StreamingSamplerSound::LoadingError& l)
+{
+	String x;
+	x << "Error at preloading sample " << l.fileName << ": " << l.errorDescription;
+	getMainController()->getDebugLogger().logMessage(x);
 
 #if USE_FRONTEND
-		getMainController()->sendOverlayMessage(DeactiveOverlay::State::CustomErrorMessage, x);
+	getMainController()->sendOverlayMessage(DeactiveOverlay::State::CustomErrorMessage, x);
 #else
-		debugError(this, x);
+	debugError(this, x);
 #endif
-
-		return false;
-	}
 }
 
 ModulatorSampler::ScopedUpdateDelayer::ScopedUpdateDelayer(ModulatorSampler* s) :
@@ -2094,4 +2282,158 @@ void ModulatorSampler::GroupedRoundRobinCollector::handleAsyncUpdate()
 	ready.store(true);
 }
 
+ModulatorSampler::NoteIndexCollector::NoteIndexCollector(ModulatorSampler* s):
+	sampler(s),
+	ready(false),
+	version(0)
+{
+	sampler->getSampleMap()->addListener(this);
+	triggerAsyncUpdate();
+}
+
+ModulatorSampler::NoteIndexCollector::~NoteIndexCollector()
+{
+	if (sampler != nullptr)
+		sampler->getSampleMap()->removeListener(this);
+}
+
+void ModulatorSampler::NoteIndexCollector::collectSounds(const HiseEvent& m, UnorderedStack<ModulatorSynthSound *>& soundsToBeStarted)
+{
+	const int midiChannel = m.getChannel();
+	const int noteNumber = m.getNoteNumber() + m.getTransposeAmount();
+	const float velocity = m.getFloatVelocity();
+
+	SimpleReadWriteLock::ScopedReadLock sl(rebuildLock);
+
+	if (!ready || index.numSounds != sampler->getNumSounds())
+	{
+		// The index is outdated, so we need to check every sound...
+		for (auto s : sampler->sounds)
+		{
+			auto sound = static_cast<ModulatorSynthSound*>(s);
+
+			if (sampler->soundCanBePlayed(sound, midiChannel, noteNumber, velocity))
+				soundsToBeStarted.insertWithoutSearch(sound);
+		}
+
+		return;
+	}
+
+	if (!isPositiveAndBelow(noteNumber, 128))
+		return;
+
+	Range<int> range;
+
+	if (!sampler->multiRRGroupState && !sampler->crossfadeGroups)
+	{
+		// Only one group is active, so we can skip the sounds of all other groups
+		auto groupIndex = sampler->multiRRGroupState.getSingleGroupIndex();
+
+		if (groupIndex <= 0)
+			range = index.getRange(noteNumber, 0);
+		else if (groupIndex < index.numGroupSlots)
+			range = index.getRange(noteNumber, groupIndex);
+		else
+			return;
+	}
+	else
+	{
+		range = index.getRange(noteNumber);
+	}
+
+	for (int i = range.getStart(); i < range.getEnd(); i++)
+	{
+		auto sound = index.sounds.getUnchecked(i);
+
+		if (sampler->soundCanBePlayed(sound, midiChannel, noteNumber, velocity))
+			soundsToBeStarted.insertWithoutSearch(sound);
+	}
+}
+
+void ModulatorSampler::NoteIndexCollector::handleAsyncUpdate()
+{
+	if (sampler == nullptr)
+		return;
+
+	const int startVersion = version.load();
+
+	struct Entry
+	{
+		ModulatorSamplerSound* sound;
+		int loKey;
+		int hiKey;
+		int group;
+	};
+
+	Array<Entry> entries;
+	int maxGroup = 0;
+
+	{
+		ModulatorSampler::SoundIterator it(sampler);
+
+		if (!it.canIterate())
+		{
+			triggerAsyncUpdate();
+			return;
+		}
+
+		entries.ensureStorageAllocated(it.size());
+
+		while (auto s = it.getNextSound())
+		{
+			Entry e;
+			e.sound = s.get();
+			e.loKey = jlimit(0, 127, (int)s->getSampleProperty(SampleIds::LoKey));
+			e.hiKey = jlimit(0, 127, (int)s->getSampleProperty(SampleIds::HiKey));
+			e.group = jmax(0, s->getRRGroup());
+
+			maxGroup = jmax(maxGroup, e.group);
+			entries.add(e);
+		}
+
+		if (!it.canIterate())
+		{
+			// the iteration was aborted, try again later
+			triggerAsyncUpdate();
+			return;
+		}
+	}
+
+	Index newIndex;
+	newIndex.numGroupSlots = maxGroup + 1;
+	newIndex.numSounds = entries.size();
+
+	const int numBuckets = 128 * newIndex.numGroupSlots;
+
+	newIndex.offsets.insertMultiple(0, 0, numBuckets + 1);
+
+	for (const auto& e : entries)
+	{
+		for (int n = e.loKey; n <= e.hiKey; n++)
+			newIndex.offsets.getReference(n * newIndex.numGroupSlots + e.group + 1)++;
+	}
+
+	for (int i = 0; i < numBuckets; i++)
+		newIndex.offsets.getReference(i + 1) += newIndex.offsets[i];
+
+	newIndex.sounds.insertMultiple(0, nullptr, newIndex.offsets[numBuckets]);
+
+	Array<int> writePositions(newIndex.offsets);
+
+	for (const auto& e : entries)
+	{
+		for (int n = e.loKey; n <= e.hiKey; n++)
+		{
+			auto& pos = writePositions.getReference(n * newIndex.numGroupSlots + e.group);
+			newIndex.sounds.set(pos++, e.sound);
+		}
+
+		newIndex.ownedSounds.add(e.sound);
+	}
+
+	SimpleReadWriteLock::ScopedWriteLock sl(rebuildLock);
+	std::swap(index, newIndex);
+	ready.store(version.load() == startVersion);
+}
+
 } // namespace hise
@@ -129,6 +129,95 @@ public:
 		Array<ReferenceCountedArray<ModulatorSynthSound>> groups;
 	};
 
+	/** The default sound collector that looks up the sounds for a note on in a precomputed index.
+	*
+	*	The index stores all sounds in a flat array that is sorted by MIDI note and RR group, so a note on
+	*	only has to check the sounds that are mapped to its key (and if only one RR group is active, only the
+	*	sounds of this group). The remaining conditions are checked with soundCanBePlayed() as before.
+	*
+	*	The index is rebuilt on the message thread whenever the key range or the RR group of a sample changes.
+	*	Until then it falls back to checking every sound.
+	*/
+	class NoteIndexCollector : public ModulatorSynth::SoundCollectorBase,
+							   public SampleMap::Listener,
+							   public AsyncUpdater
+	{
+	public:
+
+		NoteIndexCollector(ModulatorSampler* s);
+
+		~NoteIndexCollector();
+
+		void collectSounds(const HiseEvent& m, UnorderedStack<ModulatorSynthSound *>& soundsToBeStarted) override;
+
+		void sampleMapWasChanged(PoolReference ) override
+		{
+			invalidate();
+		}
+
+		void samplePropertyWasChanged(ModulatorSamplerSound* , const Identifier& sampleId, const var& ) override
+		{
+			if (sampleId == SampleIds::RRGroup || sampleId == SampleIds::LoKey || sampleId == SampleIds::HiKey)
+				invalidate();
+		};
+
+		void sampleAmountChanged() override
+		{
+			invalidate();
+		};
+
+		void sampleMapCleared() override
+		{
+			invalidate();
+		};
+
+	private:
+
+		struct Index
+		{
+			/** Returns the range of the sounds array with the sounds for the given note and group slot. */
+			Range<int> getRange(int noteNumber, int groupSlot) const
+			{
+				auto i = noteNumber * numGroupSlots + groupSlot;
+				return { offsets[i], offsets[i + 1] };
+			}
+
+			/** Returns the range of the sounds array with all sounds for the given note. */
+			Range<int> getRange(int noteNumber) const
+			{
+				return { offsets[noteNumber * numGroupSlots], offsets[(noteNumber + 1) * numGroupSlots] };
+			}
+
+			/** Slot 0 contains the sounds without a valid RR group. */
+			int numGroupSlots = 1;
+			int numSounds = 0;
+
+			Array<int> offsets;
+			Array<ModulatorSynthSound*> sounds;
+
+			// keeps the sounds in the index alive until it is rebuilt
+			ReferenceCountedArray<ModulatorSynthSound> ownedSounds;
+		};
+
+		void invalidate()
+		{
+			ready.store(false);
+			version++;
+			triggerAsyncUpdate();
+		}
+
+		void handleAsyncUpdate() override;
+
+		SimpleReadWriteLock rebuildLock;
+
+		WeakReference<ModulatorSampler> sampler;
+
+		std::atomic<bool> ready;
+		std::atomic<int> version;
+
+		Index index;
+	};
+
 	/** A small helper tool that iterates over the sound array in a thread-safe way.
 	*
 	*/
@@ -363,6 +452,11 @@ public:
 
 	void prepareToPlay(double sampleRate, int samplesPerBlock) override;;
 
+	bool supportsParallelVoiceRendering() const override { return true; }
+
+	/** The timestretching and the multimic voices need to be rendered serially. */
+	bool canRenderVoicesInParallel() const override;
+
 	ProcessorEditorBody* createEditor(ProcessorEditor *parentEditor) override;
 
 	void loadCacheFromFile(File &f);;
@@ -486,6 +580,8 @@ public:
 
 	bool preloadSample(StreamingSamplerSound * s, const int preloadSizeToUse);
 
+	void logPreloadError(const StreamingSamplerSound::LoadingError& l);
+
 	bool saveSampleMap() const;
 
 	bool saveSampleMapAsReference() const;
@@ -683,6 +779,12 @@ public:
 
 	hlac::HiseSampleBuffer* getTemporaryVoiceBuffer() { return &temporaryVoiceBuffer; }
 
+	/** Returns the temporary voice buffer for the given thread of the AudioRenderThreadPool. */
+	hlac::HiseSampleBuffer* getTemporaryVoiceBuffer(int threadIndex)
+	{
+		return threadIndex == 0 ? &temporaryVoiceBuffer : threadTemporaryVoiceBuffers[threadIndex - 1];
+	}
+
 	bool checkAndLogIsSoftBypassed(DebugLogger::Location location) const;
 
 	void setHasPendingSampleLoad(bool hasSamplesPending)
@@ -803,6 +905,62 @@ private:
 		ModulatorSampler *sampler;
 	};
 
+	/** Loads the data of the samples that will be started by upcoming notes into the page cache.
+	
+		The audio thread passes the notes it expects within the next HISE_SAMPLE_PREFETCH_MILLISECONDS
+		(delayed events and the predicted notes of a MIDI player) to this job, which then looks up the
+		matching sounds on a streaming thread and touches the data that the voice will read after the 
+		preload buffer, so the first disk request of the voice will be served from memory.
+	*/
+	class Prefetcher : public SampleThreadPool::Job
+	{
+	public:
+
+		Prefetcher(ModulatorSampler& parent_);
+		~Prefetcher();
+
+		/** Adds a note that is expected to start in the given amount of samples. Call this from the audio thread. */
+		void addPrediction(const HiseEvent& e, int rrGroup, int samplesUntilNoteOn);
+
+		/** Starts the prefetching of all predictions that were added since the last call. */
+		void flush();
+
+		JobStatus runJob() override;
+
+		bool canRunOnWorkerThread() const override { return true; }
+
+	private:
+
+		struct PredictedNote
+		{
+			bool operator==(const PredictedNote& other) const noexcept
+			{
+				return noteNumber == other.noteNumber && velocity == other.velocity && rrGroup == other.rrGroup;
+			}
+
+			int8 noteNumber = -1;
+			uint8 velocity = 0;
+			int8 rrGroup = -1;
+		};
+
+		/** Returns true if the item was used within the prefetch time (and stores it otherwise). */
+		template <typename T, size_t N> static bool wasUsedRecently(std::array<std::pair<T, uint32>, N>& recentItems, int& index, const T& item, uint32 now);
+
+		ModulatorSampler& parent;
+
+		moodycamel::ReaderWriterQueue<PredictedNote> pendingNotes;
+		int earliestNoteOn = std::numeric_limits<int>::max();
+
+		std::array<std::pair<PredictedNote, uint32>, 64> recentNotes;
+		std::array<std::pair<const StreamingSamplerSound*, uint32>, 256> recentSounds;
+		int recentNoteIndex = 0;
+		int recentSoundIndex = 0;
+
+		JUCE_DECLARE_NON_COPYABLE(Prefetcher);
+	};
+
+	/** Passes the upcoming note ons of this sampler and its parent synths to the prefetcher. */
+	void addPredictedNotesToPrefetcher();
 	
     /** Sets the streaming buffer and preload buffer sizes. */
     void setPreloadSize(int newPreloadSize);
@@ -811,6 +969,8 @@ private:
 
 	AsyncPurger asyncPurger;
 
+	ScopedPointer<Prefetcher> prefetcher;
+
 	void refreshCrossfadeTables();
 
 	RoundRobinMap roundRobinMap;
@@ -915,6 +1075,9 @@ private:
 	hlac::HiseSampleBuffer temporaryVoiceBuffer;
 	AudioSampleBuffer stretchBuffer;
 
+	// one buffer for every worker of the AudioRenderThreadPool
+	OwnedArray<hlac::HiseSampleBuffer> threadTemporaryVoiceBuffers;
+
 	bool delayUpdate = false;
 	int lowPassOrder = 0;
 
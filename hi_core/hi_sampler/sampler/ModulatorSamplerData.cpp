@@ -370,15 +370,35 @@ void SampleMap::parseValueTree(const ValueTree &v)
 
 	ScopedNotificationDelayer dnd(*this);
 
+	// The sounds are created first and their preload buffers are filled
+	// afterwards by multiple threads (so each part gets half of the progress bar).
+	ParallelPreloader preloader;
+
 	try
 	{
-		for (auto c : data)
 		{
-			progress = sampleIndex / numSamples;
-			sampleIndex += 1.0;
+			ScopedValueSetter<ParallelPreloader*> svs(currentPreloader, &preloader);
+
+			for (auto c : data)
+			{
+				progress = 0.5 * sampleIndex / numSamples;
+				sampleIndex += 1.0;
 
-			valueTreeChildAdded(data, c);
+				valueTreeChildAdded(data, c);
+			}
 		}
+
+		auto threadPool = sampler->getMainController()->getSampleManager().getGlobalSampleThreadPool();
+
+		preloader.run([threadPool]() { return threadPool->threadShouldExit(); }, progress, { 0.5, 1.0 });
+
+		const bool isReversed = sampler->getAttribute(ModulatorSampler::Reversed) > 0.5f;
+
+		for (int i = 0; i < sampler->getNumSounds(); i++)
+			static_cast<ModulatorSamplerSound*>(sampler->getSound(i))->setReversed(isReversed);
+
+		if (auto e = preloader.getFirstError())
+			throw *e;
 	}
 	catch (String& s)
 	{
@@ -563,14 +583,21 @@ void SampleMap::addSampleFromValueTree(ValueTree childWhichHasBeenAdded)
 		sampler->addSound(newSound);
 	}
 
-	if (!sampler->shouldPlayFromPurge())
-		dynamic_cast<ModulatorSamplerSound*>(newSound)->initPreloadBuffer((int)sampler->getAttribute(ModulatorSampler::PreloadSize));
-	else
-		dynamic_cast<ModulatorSamplerSound*>(newSound)->checkFileReference();
+	auto preloadSize = (int)sampler->getAttribute(ModulatorSampler::PreloadSize);
 
-	const bool isReversed = sampler->getAttribute(ModulatorSampler::Reversed) > 0.5f;
+	if (sampler->shouldPlayFromPurge())
+		newSound->checkFileReference();
+	else if (currentPreloader != nullptr)
+		newSound->addToPreloader(*currentPreloader, preloadSize);
+	else
+		newSound->initPreloadBuffer(preloadSize);
 
-	newSound->setReversed(isReversed);
+	// if the sound is preloaded later, this will be set after the preloading
+	if (currentPreloader == nullptr)
+	{
+		const bool isReversed = sampler->getAttribute(ModulatorSampler::Reversed) > 0.5f;
+		newSound->setReversed(isReversed);
+	}
 
 	sendSampleAddedMessage();
 	return;
@@ -1271,10 +1298,7 @@ juce::AudioFormatWriter* MonolithExporter::createWriter(hlac::HiseLosslessAudioF
 
 	FileOutputStream* hlacOutput = new FileOutputStream(outputFile);
 
-	auto options = hlac::HlacEncoder::CompressorOptions::getPreset(hlac::HlacEncoder::CompressorOptions::Presets::Diff);
-
-	options.applyDithering = false;
-	options.normalisationMode = (uint8)getComboBoxComponent("normalise")->getSelectedItemIndex();
+	auto options = getCompressorOptions();
 
 	StringPairArray empty;
 
@@ -1289,6 +1313,16 @@ juce::AudioFormatWriter* MonolithExporter::createWriter(hlac::HiseLosslessAudioF
 	return writer.release();
 }
 
+hlac::HlacEncoder::CompressorOptions MonolithExporter::getCompressorOptions()
+{
+	auto options = hlac::HlacEncoder::CompressorOptions::getPreset(hlac::HlacEncoder::CompressorOptions::Presets::Diff);
+
+	options.applyDithering = false;
+	options.normalisationMode = (uint8)getComboBoxComponent("normalise")->getSelectedItemIndex();
+
+	return options;
+}
+
 int64 MonolithExporter::getNumBytesForSplitSize() const
 {
 	auto mb = getComboBoxComponent("splitsize")->getText().getIntValue();
@@ -1424,6 +1458,10 @@ void MonolithExporter::writeFiles(int channelIndex, bool overwriteExistingData)
 
 		int64 numBytesWritten = 0;
 
+		// Decodes and encodes the files on multiple threads, the writer below
+		// appends the blocks in the same order as writeFromAudioReader()
+		hlac::HlacParallelEncoder parallelEncoder(afm, *channelList, isMono ? 1 : 2, getCompressorOptions());
+
 		for (int i = 0; i < channelList->size(); i++)
 		{
 			auto s = channelList->getUnchecked(i);
@@ -1435,20 +1473,19 @@ void MonolithExporter::writeFiles(int channelIndex, bool overwriteExistingData)
             if(threadShouldExit())
                 return;
             
-			ScopedPointer<AudioFormatReader> reader = afm.createReaderFor(s);
+			auto hWriter = dynamic_cast<hlac::HiseLosslessAudioFormatWriter*>(writer.get());
 
-			if (reader != nullptr)
+			jassert(hWriter != nullptr);
+
+			auto r = parallelEncoder.writeFile(i, *hWriter);
+
+			if (r.wasOk())
 			{
-				writer->writeFromAudioReader(*reader, 0, -1);
-				
-				if (auto hWriter = dynamic_cast<hlac::HiseLosslessAudioFormatWriter*>(writer.get()))
-				{
-					numBytesWritten = hWriter->getNumBytesWritten();
-				}
+				numBytesWritten = hWriter->getNumBytesWritten();
 			}
 			else
 			{
-				error = "Could not read the source file " + s.getFullPathName();
+				error = r.getErrorMessage();
 				writer->flush();
 				writer = nullptr;
 
@@ -333,6 +333,9 @@ private:
 	
 	bool syncEditMode = false;
 
+	// the preloader that collects the sounds while the sample map is parsed (nullptr otherwise)
+	ParallelPreloader* currentPreloader = nullptr;
+
 	valuetree::PropertyListener crossfadeListener;
 
 	struct Notifier: public Dispatchable
@@ -559,6 +562,8 @@ private:
 
 	AudioFormatWriter* createWriter(hlac::HiseLosslessAudioFormat& hlaf, const File& f, bool isMono);
 
+	hlac::HlacEncoder::CompressorOptions getCompressorOptions();
+
 	/** The max monolith size is 2GB - 60MB (to guarantee to stay below 2GB for FAT32. */
 	//constexpr static int maxMonolithSize = 2084569088;
 
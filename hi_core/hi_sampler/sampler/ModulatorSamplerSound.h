@@ -416,6 +416,18 @@ public:
 		FOR_EVERY_SOUND(setPreloadSize(preloadSize, true));
 	}
 
+	/** Same as initPreloadBuffer(), but adds the sounds to the preloader instead of loading them directly. */
+	void addToPreloader(ParallelPreloader& preloader, int preloadSize)
+	{
+		checkFileReference();
+
+		if (noteRangeExceedsMaxPitch())
+			preloadSize = -1;
+
+		for (auto s : soundArray)
+			preloader.addSound(s, preloadSize);
+	}
+
 	bool noteRangeExceedsMaxPitch() const;
 
     double getMaxPitchRatio() const;
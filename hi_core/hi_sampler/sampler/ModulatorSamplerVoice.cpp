@@ -130,20 +130,26 @@ void ModulatorSamplerVoice::stopNote(float velocity, bool allowTailoff)
 
 void ModulatorSamplerVoice::calculateBlock(int startSample, int numSamples)
 {
-	if (waitForPlayFromPurge.load() || wrappedVoice.isWaitingForTimestretchSeek())
-	{
-		voiceBuffer.clear(startSample, numSamples);
+	ADD_GLITCH_DETECTOR(getOwnerSynth(), DebugLogger::Location::SampleRendering);
+
+	prepareParallelRendering(startSample, numSamples);
+	renderParallel(startSample, numSamples, 0);
+	finishParallelRendering(startSample, numSamples);
+}
+
+void ModulatorSamplerVoice::prepareParallelRendering(int startSample, int numSamples)
+{
+	skipRendering = waitForPlayFromPurge.load() || wrappedVoice.isWaitingForTimestretchSeek();
+
+	if (skipRendering)
 		return;
-	}
 
-    const StreamingSamplerSound *sound = wrappedVoice.getLoadedSound();
+    soundForCurrentBlock = wrappedVoice.getLoadedSound();
     
 	// In a synthgroup it might be possible that the wrapped sound is null
-	jassert(sound != nullptr || getOwnerSynth()->isInGroup());
+	jassert(soundForCurrentBlock != nullptr || getOwnerSynth()->isInGroup());
  
-	CHECK_AND_LOG_ASSERTION(getOwnerSynth(), DebugLogger::Location::SampleRendering, sound != nullptr, 1);
-
-	ADD_GLITCH_DETECTOR(getOwnerSynth(), DebugLogger::Location::SampleRendering);
+	CHECK_AND_LOG_ASSERTION(getOwnerSynth(), DebugLogger::Location::SampleRendering, soundForCurrentBlock != nullptr, 1);
 
 	auto owner = static_cast<ModulatorSampler*>(getOwnerSynth());
 
@@ -154,16 +160,11 @@ void ModulatorSamplerVoice::calculateBlock(int startSample, int numSamples)
 		wrappedVoice.setTimestretchRatio(owner->getCurrentTimestretchRatio());
 	}
 
-	ignoreUnused(sound);
-
-	const int startIndex = startSample;
-	const int samplesInBlock = numSamples;
-
 	auto voicePitchValues = getOwnerSynth()->getPitchValuesForVoice();
 
 	double propertyPitch = currentlyPlayingSamplerSound->getPropertyPitch();
 	
-	auto oldUptime = voiceUptime;
+	uptimeBeforeCurrentBlock = voiceUptime;
 
 	if (auto env = currentlyPlayingSamplerSound->getEnvelope(Modulation::Mode::PitchMode))
 	{
@@ -182,10 +183,27 @@ void ModulatorSamplerVoice::calculateBlock(int startSample, int numSamples)
 	wrappedVoice.uptimeDelta = uptimeDelta;
 
 	voiceBuffer.clear();
+}
 
-	
+void ModulatorSamplerVoice::renderParallel(int startSample, int numSamples, int threadIndex)
+{
+	if (skipRendering)
+		return;
 
+	wrappedVoice.setTemporaryVoiceBuffer(sampler->getTemporaryVoiceBuffer(threadIndex), sampler->getTemporaryStretchBuffer());
 	wrappedVoice.renderNextBlock(voiceBuffer, startSample, numSamples);
+}
+
+void ModulatorSamplerVoice::finishParallelRendering(int startSample, int numSamples)
+{
+	if (skipRendering)
+	{
+		voiceBuffer.clear(startSample, numSamples);
+		return;
+	}
+
+	const int startIndex = startSample;
+	const int samplesInBlock = numSamples;
 
 	CHECK_AND_LOG_BUFFER_DATA(getOwnerSynth(), DebugLogger::Location::SampleRendering, voiceBuffer.getReadPointer(0, startSample), true, samplesInBlock);
 	CHECK_AND_LOG_BUFFER_DATA(getOwnerSynth(), DebugLogger::Location::SampleRendering, voiceBuffer.getReadPointer(1, startSample), false, samplesInBlock);
@@ -259,7 +277,7 @@ void ModulatorSamplerVoice::calculateBlock(int startSample, int numSamples)
 	{
 		if (auto env = static_cast<ModulatorSampler*>(getOwnerSynth())->getEnvelopeFilter())
 		{
-			auto fValue = fEnv->getUptimeValue(oldUptime);
+			auto fValue = fEnv->getUptimeValue(uptimeBeforeCurrentBlock);
 			snex::Types::PolyHandler::ScopedVoiceSetter svs(env->polyManager, getVoiceIndex());
 			env->process(fValue, voiceBuffer, startIndex, samplesInBlock);
 		}
@@ -273,7 +291,7 @@ void ModulatorSamplerVoice::calculateBlock(int startSample, int numSamples)
 
 	if (sampler->isLastStartedVoice(this))
 	{
-		handlePlaybackPosition(sound);
+		handlePlaybackPosition(soundForCurrentBlock);
 	}
 }
 
@@ -63,6 +63,10 @@ public:
 	void calculateBlock(int startSample, int numSamples) override;
 	void resetVoice() override;
 
+	void prepareParallelRendering(int startSample, int numSamples) override;
+	void renderParallel(int startSample, int numSamples, int threadIndex) override;
+	void finishParallelRendering(int startSample, int numSamples) override;
+
 #if HISE_SAMPLER_ALLOW_RELEASE_START
 	virtual void jumpToRelease()
 	{
@@ -187,6 +191,10 @@ private:
 
 	bool nonRealtime = false;
 	
+	// the state of the current block that is passed between the parallel rendering steps
+	bool skipRendering = false;
+	const StreamingSamplerSound* soundForCurrentBlock = nullptr;
+	double uptimeBeforeCurrentBlock = 0.0;
 
 	StreamingSamplerVoice wrappedVoice;
 
@@ -101,6 +101,141 @@ void GainSmoother::processBlock(float** data, int numChannels, int numSamples)
 	}
 }
 
+MultithreadedConvolver::WorkerPool::WorkerPool()
+{
+	// leave some cores for the audio thread and the sample streaming
+	auto numWorkers = jlimit(1, 8, SystemStats::getNumCpus() / 2);
+
+	for (int i = 0; i < numWorkers; i++)
+		workers.add(new Worker(*this, i));
+}
+
+void MultithreadedConvolver::WorkerPool::startWorkers()
+{
+	ScopedLock sl(startLock);
+
+	if (!workersStarted)
+	{
+		workersStarted = true;
+
+		for (auto w : workers)
+			w->startThread(10);
+	}
+}
+
+void MultithreadedConvolver::WorkerPool::createProducerTokens(ProducerTokens& tokens)
+{
+	for (auto w : workers)
+	{
+		auto t = tokens.add(new moodycamel::ProducerToken(w->queue));
+
+		// Let the producer grab a block now so that try_enqueue() doesn't run
+		// out of preallocated blocks when there are many convolution effects.
+		// The producer keeps the block and reuses it once it's empty.
+		MultithreadedConvolver::Ptr dummy;
+		w->queue.enqueue(*t, nullptr);
+		w->queue.try_dequeue_from_producer(*t, dummy);
+	}
+}
+
+MultithreadedConvolver::WorkerPool::~WorkerPool()
+{
+	for (auto w : workers)
+		w->signalThreadShouldExit();
+
+	for (auto w : workers)
+	{
+		w->notify();
+		w->stopThread(1000);
+	}
+
+	soonToBeDeleted.clear();
+	workers.clear();
+}
+
+void MultithreadedConvolver::WorkerPool::addJob(const ProducerTokens& tokens, MultithreadedConvolver* c, int numSegments)
+{
+	auto numJobs = jlimit(1, workers.size(), numSegments);
+
+	for (int i = 0; i < numJobs; i++)
+	{
+		auto workerIndex = (int)(nextWorker.fetch_add(1) % (uint32)workers.size());
+		auto w = workers[workerIndex];
+
+		if (w->queue.try_enqueue(*tokens[workerIndex], MultithreadedConvolver::Ptr(c)))
+			w->notify();
+	}
+}
+
+void MultithreadedConvolver::WorkerPool::addConvolverToBeDeleted(MultithreadedConvolver::Ptr c)
+{
+	SpinLock::ScopedLockType sl(deleteLock);
+	soonToBeDeleted.add(c);
+}
+
+bool MultithreadedConvolver::WorkerPool::getNextJob(int workerIndex, MultithreadedConvolver::Ptr& job)
+{
+	if (workers[workerIndex]->queue.try_dequeue(job))
+		return true;
+
+	// steal a job from the other workers
+	for (int i = 1; i < workers.size(); i++)
+	{
+		if (workers[(workerIndex + i) % workers.size()]->queue.try_dequeue(job))
+			return true;
+	}
+
+	return false;
+}
+
+void MultithreadedConvolver::WorkerPool::clearDeletedConvolvers()
+{
+	ReferenceCountedArray<MultithreadedConvolver> copy;
+
+	if (!soonToBeDeleted.isEmpty())
+	{
+		SpinLock::ScopedLockType sl(deleteLock);
+		copy.swapWith(soonToBeDeleted);
+	}
+
+	copy.clear();
+}
+
+MultithreadedConvolver::WorkerPool::Worker::Worker(WorkerPool& parent_, int index_) :
+	Thread("Convolution Worker " + String(index_ + 1)),
+	parent(parent_),
+	index(index_),
+	queue(512)
+{}
+
+void MultithreadedConvolver::WorkerPool::Worker::run()
+{
+	while (!threadShouldExit())
+	{
+		MultithreadedConvolver::Ptr job;
+
+		while (!threadShouldExit() && parent.getNextJob(index, job))
+		{
+			// skip the dummy items from createProducerTokens()
+			if (job != nullptr)
+				job->processPendingSegments();
+
+			job = nullptr;
+		}
+
+		if (index == 0)
+			parent.clearDeletedConvolvers();
+
+		wait(500);
+	}
+
+	// release the convolvers that are still in the queue
+	MultithreadedConvolver::Ptr job;
+
+	while (queue.try_dequeue(job))
+		job = nullptr;
+}
+
 bool MultithreadedConvolver::prepareImpulseResponse(const AudioSampleBuffer& originalBuffer, AudioSampleBuffer& buffer, bool* abortFlag, Range<int> range, double resampleRatio)
 {
 	AudioSampleBuffer copyBuffer(2, originalBuffer.getNumSamples());
@@ -565,6 +700,37 @@ void ConvolutionEffectBase::processBase(ProcessDataDyn& d)
 	}
 }
 
+int ConvolutionEffectBase::getNumDeadlineMisses() const
+{
+	int numMisses = numDeadlineMissesOfOldConvolvers.load();
+
+	for (auto c : { convolverL.get(), convolverR.get(), fadeOutConvolverL.get(), fadeOutConvolverR.get() })
+	{
+		if (c != nullptr)
+			numMisses += c->getNumDeadlineMisses();
+	}
+
+	return numMisses;
+}
+
+void ConvolutionEffectBase::waitForBackgroundProcessing()
+{
+	auto isProcessing = [](MultithreadedConvolver::Ptr c)
+	{
+		return c != nullptr && c->isProcessingInBackground();
+	};
+
+	while (isProcessing(convolverL) || isProcessing(convolverR))
+	{
+		auto currentThread = Thread::getCurrentThread();
+
+		if (currentThread != nullptr)
+			currentThread->wait(10);
+		else
+			Thread::sleep(10);
+	}
+}
+
 bool ConvolutionEffectBase::reloadInternal()
 {
 	if (convolverL == nullptr)
@@ -574,8 +740,7 @@ bool ConvolutionEffectBase::reloadInternal()
 		getImpulseBufferBase().getBuffer().getNumChannels() == 0|| 
 		getImpulseBufferBase().getBuffer().getNumSamples() == 0 )
 	{
-		while(backgroundThread.isBusy())
-            Thread::getCurrentThread()->wait(10);
+		waitForBackgroundProcessing();
 
 		SimpleReadWriteLock::ScopedMultiWriteLock sl(swapLock);
 
@@ -649,13 +814,7 @@ bool ConvolutionEffectBase::reloadInternal()
     
     
 	{
-		while (backgroundThread.isBusy())
-		{
-			auto currentThread = Thread::getCurrentThread();
-			
-			if(currentThread != nullptr)
-				currentThread->wait(10);
-		}
+		waitForBackgroundProcessing();
 
 		SimpleReadWriteLock::ScopedMultiWriteLock sl(swapLock);
         
@@ -666,6 +825,8 @@ bool ConvolutionEffectBase::reloadInternal()
         
         if(convolverL != nullptr)
         {
+            numDeadlineMissesOfOldConvolvers += convolverL->getNumDeadlineMisses() + convolverR->getNumDeadlineMisses();
+
             backgroundThread.addConvolverToBeDeleted(convolverL);
             backgroundThread.addConvolverToBeDeleted(convolverR);
         }
@@ -678,4 +839,175 @@ bool ConvolutionEffectBase::reloadInternal()
 }
 
 
+#if HI_RUN_UNIT_TESTS
+
+struct ConvolutionEngineTest : public UnitTest
+{
+	ConvolutionEngineTest() :
+		UnitTest("Testing the convolution engine", "dsp")
+	{}
+
+	void runTest() override
+	{
+		testFFTImplementations();
+		testSimdKernels();
+		testSegmentedTail();
+	}
+
+	void testFFTImplementations()
+	{
+		beginTest("Testing FFT implementations against Ooura");
+
+		Random r;
+
+		for (int t = 0; t < (int)audiofft::ImplementationType::numImplementationTypes; t++)
+		{
+			auto fftType = (audiofft::ImplementationType)t;
+
+			if (fftType == audiofft::ImplementationType::Ooura || !audiofft::AudioFFT::isAvailable(fftType))
+				continue;
+
+			// 16 is below the smallest size that pffft supports and checks the fallback
+			for (int size = 16; size <= 8192; size *= 2)
+			{
+				const int complexSize = (int)audiofft::AudioFFT::ComplexSize(size);
+
+				HeapBlock<float> input(size), output(size);
+				HeapBlock<float> reExpected(complexSize), imExpected(complexSize);
+				HeapBlock<float> reActual(complexSize), imActual(complexSize);
+
+				for (int i = 0; i < size; i++)
+					input[i] = r.nextFloat() * 2.0f - 1.0f;
+
+				audiofft::AudioFFT reference(audiofft::ImplementationType::Ooura);
+				audiofft::AudioFFT fft(fftType);
+
+				reference.init(size);
+				fft.init(size);
+
+				reference.fft(input, reExpected, imExpected);
+				fft.fft(input, reActual, imActual);
+
+				float maxError = 0.0f;
+
+				for (int i = 0; i < complexSize; i++)
+				{
+					maxError = jmax(maxError, std::abs(reExpected[i] - reActual[i]));
+					maxError = jmax(maxError, std::abs(imExpected[i] - imActual[i]));
+				}
+
+				fft.ifft(output, reActual, imActual);
+
+				for (int i = 0; i < size; i++)
+					maxError = jmax(maxError, std::abs(input[i] - output[i]));
+
+				expect(maxError < 0.001f, "FFT type " + String(t) + " with size " + String(size) + " doesn't match: " + String(maxError));
+			}
+		}
+	}
+
+	void testSimdKernels()
+	{
+		beginTest("Testing SIMD kernels against the scalar kernel");
+
+		using namespace fftconvolver;
+
+		Random r;
+
+		for (int len : { 1, 3, 7, 8, 9, 16, 65, 257, 1025 })
+		{
+			SplitComplex a(len), b(len), expected(len), actual(len);
+
+			for (int i = 0; i < len; i++)
+			{
+				a.re()[i] = r.nextFloat() * 2.0f - 1.0f;
+				a.im()[i] = r.nextFloat() * 2.0f - 1.0f;
+				b.re()[i] = r.nextFloat() * 2.0f - 1.0f;
+				b.im()[i] = r.nextFloat() * 2.0f - 1.0f;
+			}
+
+			expected.setZero();
+			ComplexMultiplyAccumulate(expected, a, b, SimdKernel::Scalar);
+
+			for (int k = 1; k < (int)SimdKernel::numSimdKernels; k++)
+			{
+				if (!isSimdKernelSupported((SimdKernel)k))
+					continue;
+
+				actual.setZero();
+				ComplexMultiplyAccumulate(actual, a, b, (SimdKernel)k);
+
+				float maxError = 0.0f;
+
+				for (int i = 0; i < len; i++)
+				{
+					maxError = jmax(maxError, std::abs(expected.re()[i] - actual.re()[i]));
+					maxError = jmax(maxError, std::abs(expected.im()[i] - actual.im()[i]));
+				}
+
+				expect(maxError < 0.0001f, "SIMD kernel " + String(k) + " with length " + String(len) + " doesn't match: " + String(maxError));
+			}
+		}
+	}
+
+	void testSegmentedTail()
+	{
+		beginTest("Testing segmented tail on worker threads");
+
+		constexpr int BlockSize = 512;
+		constexpr int IRLength = 96000;
+		constexpr int NumSamples = BlockSize * 400;
+
+		Random r;
+
+		HeapBlock<float> ir(IRLength);
+		HeapBlock<float> input(NumSamples);
+
+		for (int i = 0; i < IRLength; i++)
+			ir[i] = (r.nextFloat() * 2.0f - 1.0f) * std::exp(-4.0f * (float)i / (float)IRLength);
+
+		for (int i = 0; i < NumSamples; i++)
+			input[i] = r.nextFloat() * 2.0f - 1.0f;
+
+		auto fftType = audiofft::ImplementationType::BestAvailable;
+
+		// The reference renders the tail in a single segment on the calling thread
+		MultithreadedConvolver::Ptr reference = new MultithreadedConvolver(fftType);
+		reference->init(BlockSize, 4096, ir, IRLength);
+		expectEquals((int)reference->getNumTailSegments(), 1, "reference tail segments");
+
+		MultithreadedConvolver::BackgroundThread handle;
+		MultithreadedConvolver::Ptr multithreaded = new MultithreadedConvolver(fftType);
+		multithreaded->setUseBackgroundThread(&handle);
+
+		// use more segments than workers so that the audio thread has to render some of them
+		multithreaded->setMaxNumTailSegments(handle.getNumWorkers() + 2);
+		multithreaded->init(BlockSize, 4096, ir, IRLength);
+		expect(multithreaded->getNumTailSegments() > 1, "tail wasn't split into segments");
+
+		HeapBlock<float> expected(NumSamples);
+		HeapBlock<float> actual(NumSamples);
+
+		for (int i = 0; i < NumSamples; i += BlockSize)
+		{
+			reference->process(input + i, expected + i, BlockSize);
+			multithreaded->process(input + i, actual + i, BlockSize);
+		}
+
+		float maxError = 0.0f;
+
+		for (int i = 0; i < NumSamples; i++)
+			maxError = jmax(maxError, std::abs(expected[i] - actual[i]));
+
+		expect(maxError < 0.001f, "segmented tail doesn't match: " + String(maxError));
+
+		multithreaded->waitForBackgroundProcessing();
+		multithreaded->setUseBackgroundThread(nullptr);
+	}
+};
+
+static ConvolutionEngineTest convolutionEngineTest;
+
+#endif
+
 }
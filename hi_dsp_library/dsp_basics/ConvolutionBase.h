@@ -112,81 +112,114 @@ class MultithreadedConvolver : public fftconvolver::TwoStageFFTConvolver,
 public:
     
     using Ptr = ReferenceCountedObjectPtr<MultithreadedConvolver>;
-    
-	class BackgroundThread : public Thread
+
+	/** A pool of worker threads that is shared between all convolution instances.
+	
+		The tail of each convolver is split into independent segments. When a tail block is due,
+		the convolver pushes a job to the queues of multiple workers and each worker that picks up the
+		job processes the segments that haven't been claimed yet. Idle workers steal jobs from the
+		queues of the other workers so the load is spread across the pool even if one convolver
+		has a much longer impulse response than the others.
+
+		The worker threads are only started when the first convolution effect enables the
+		background processing.
+	*/
+	class WorkerPool
 	{
 	public:
 
-		BackgroundThread() :
-          Thread("Convolution Background Thread"),
-          queue(512)
-		{}
+		using ProducerTokens = OwnedArray<moodycamel::ProducerToken>;
 
-        ~BackgroundThread()
-        {
-            soonToBeDeleted.clear();
-            jassert(numRegisteredConvolvers == 0);
-            
-            stopThread(1000);
-            queue.callForEveryElementInQueue({});
-            
-        }
-        
-		void run() override
+		WorkerPool();
+		~WorkerPool();
+
+		/** Starts the worker threads if they are not running yet. */
+		void startWorkers();
+
+		/** Creates a producer token for the queue of each worker.
+		
+			Enqueuing with an explicit producer token doesn't allocate a new producer, so
+			call this once on the message thread and use the tokens on the audio thread.
+		*/
+		void createProducerTokens(ProducerTokens& tokens);
+
+		/** Pushes a job for the given convolver to the queues of up to numSegments workers. 
+		
+			If a queue is full, the job is skipped and the audio thread renders the segments
+			that nobody picked up in waitForBackgroundProcessing().
+		*/
+		void addJob(const ProducerTokens& tokens, MultithreadedConvolver* c, int numSegments);
+
+		void addConvolverToBeDeleted(MultithreadedConvolver::Ptr c);
+
+		int getNumWorkers() const { return workers.size(); }
+
+	private:
+
+		struct Worker : public Thread
+		{
+			Worker(WorkerPool& parent_, int index_);
+
+			void run() override;
+
+			WorkerPool& parent;
+			const int index;
+
+			moodycamel::ConcurrentQueue<MultithreadedConvolver::Ptr> queue;
+		};
+
+		bool getNextJob(int workerIndex, MultithreadedConvolver::Ptr& job);
+
+		void clearDeletedConvolvers();
+
+		OwnedArray<Worker> workers;
+		std::atomic<uint32> nextWorker = { 0 };
+
+		CriticalSection startLock;
+		bool workersStarted = false;
+
+		SpinLock deleteLock;
+		ReferenceCountedArray<MultithreadedConvolver> soonToBeDeleted;
+	};
+
+	/** The handle that is used by each convolution effect to access the shared worker pool. 
+	
+		All convolvers of an effect are processed on the same thread, so they can share the
+		producer tokens of the handle.
+	*/
+	class BackgroundThread
+	{
+	public:
+
+		/** Starts the worker pool and creates the producer tokens. Call this before a convolver uses this handle. */
+		void prepare()
 		{
-			while (!threadShouldExit())
+			if (tokens.isEmpty())
 			{
-                {
-                    ScopedValueSetter<bool> svs(currentlyRendering, true);
-                    
-                    queue.callForEveryElementInQueue([this](MultithreadedConvolver::Ptr c)
-                    {
-                        if (threadShouldExit())
-                            return false;
-                        
-                        c->doBackgroundProcessing();
-                        c->pending.store(false);
-                        
-                        return true;
-                    });
-                }
-                
-                ReferenceCountedArray<MultithreadedConvolver> copy;
-                
-                if(!soonToBeDeleted.isEmpty())
-                {
-                    SpinLock::ScopedLockType sl(deleteLock);
-                    copy.swapWith(soonToBeDeleted);
-                }
-                
-                copy.clear();
-                
-				wait(500);
+				pool->startWorkers();
+				pool->createProducerTokens(tokens);
 			}
-		};
+		}
 
-        void addConvolverJob(MultithreadedConvolver::Ptr c)
-        {
-            queue.push(c);
-            notify();
-        }
-        
-        void addConvolverToBeDeleted(MultithreadedConvolver::Ptr c)
-        {
-            SpinLock::ScopedLockType sl(deleteLock);
-            soonToBeDeleted.add(c);
-        }
-        
-		bool isBusy() const { return currentlyRendering; }
-		bool currentlyRendering = false;
-		
-        int numRegisteredConvolvers = 0;
-        
-        hise::LockfreeQueue<MultithreadedConvolver::Ptr> queue;
+		void addConvolverJob(MultithreadedConvolver* c, int numSegments)
+		{
+			jassert(!tokens.isEmpty());
+			pool->addJob(tokens, c, numSegments);
+		}
         
-        SpinLock deleteLock;
+		void addConvolverToBeDeleted(MultithreadedConvolver::Ptr c)
+		{
+			pool->addConvolverToBeDeleted(c);
+		}
         
-        ReferenceCountedArray<MultithreadedConvolver> soonToBeDeleted;
+		int getNumWorkers() const { return pool->getNumWorkers(); }
+
+	private:
+
+		SharedResourcePointer<WorkerPool> pool;
+
+		// must be destroyed before the pool
+		WorkerPool::ProducerTokens tokens;
 	};
 
 
@@ -199,33 +232,60 @@ public:
 
 	virtual ~MultithreadedConvolver()
 	{
-        jassert(!pending);
-        
-        if(backgroundThread != nullptr)
-            backgroundThread->numRegisteredConvolvers--;
+        jassert(pendingSegments.load() == 0);
 	};
 
 	void startBackgroundProcessing() override
 	{
-        pending.store(true);
+        auto numSegments = (int)getNumTailSegments();
+
+        // set the counters before releasing the segments to the workers
+        segmentsDone.reset();
+        numSegmentsToProcess.store(numSegments);
+        pendingSegments.store(numSegments);
+        nextSegment.store(0);
         
 		if (backgroundThread != nullptr)
-		{
-            backgroundThread->addConvolverJob(this);
-		}
+			backgroundThread->addConvolverJob(this, numSegments);
 		else
-		{
-			doBackgroundProcessing();
-            pending.store(false);
-		}
+			processPendingSegments();
 	}
 
 	void waitForBackgroundProcessing() override
 	{
-        while (pending.load())
-            jassertfalse;
+        if (pendingSegments.load() > 0)
+        {
+            // The workers didn't make it in time, so we render the
+            // remaining segments on this thread to avoid a dropout
+            numDeadlineMisses.fetch_add(1);
+            processPendingSegments();
+
+            // wait for the segments that are currently rendered by the workers
+            while (pendingSegments.load() > 0)
+                segmentsDone.wait(1);
+        }
 	}
 
+	/** Processes all tail segments that haven't been claimed by another thread yet. */
+	void processPendingSegments()
+	{
+		auto numSegments = numSegmentsToProcess.load();
+
+		for (int i = nextSegment.fetch_add(1); i < numSegments; i = nextSegment.fetch_add(1))
+		{
+			doBackgroundProcessing((size_t)i);
+
+			if (pendingSegments.fetch_sub(1) == 1)
+				segmentsDone.signal();
+		}
+	}
+
+	/** Returns true if there are tail segments that are not yet rendered. */
+	bool isProcessingInBackground() const { return pendingSegments.load() > 0; }
+
+	/** Returns the number of tail blocks that weren't rendered by the worker threads in time. */
+	int getNumDeadlineMisses() const { return numDeadlineMisses.load(); }
+
 	static bool prepareImpulseResponse(const AudioSampleBuffer& originalBuffer, AudioSampleBuffer& buffer, bool* abortFlag, Range<int> range, double resampleRatio);
 
 	static double getResampleFactor(double sampleRate, double impulseSampleRate);
@@ -234,16 +294,13 @@ public:
 	{
 		if (backgroundThread != newThreadToUse || forceUpdate)
         {
-            if(backgroundThread != nullptr)
-                backgroundThread->numRegisteredConvolvers--;
-            
+            if (newThreadToUse != nullptr)
+                newThreadToUse->prepare();
+
             backgroundThread = newThreadToUse;
-            
-            if(backgroundThread != nullptr)
-                backgroundThread->numRegisteredConvolvers++;
-            
-            if (backgroundThread != nullptr && !backgroundThread->isThreadRunning())
-                backgroundThread->startThread(10);
+
+            // this only has an effect on the next call to init()
+            setMaxNumTailSegments(backgroundThread != nullptr ? (size_t)backgroundThread->getNumWorkers() : 1);
         }
 	}
 
@@ -254,7 +311,11 @@ public:
 
 private:
 
-    std::atomic<bool> pending = { false };
+    std::atomic<int> numSegmentsToProcess = { 0 };
+    std::atomic<int> pendingSegments = { 0 };
+    std::atomic<int> nextSegment = { 0 };
+    std::atomic<int> numDeadlineMisses = { 0 };
+    WaitableEvent segmentsDone;
     
     BackgroundThread* backgroundThread = nullptr;
 };
@@ -287,6 +348,9 @@ struct ConvolutionEffectBase : public AsyncUpdater,
 	virtual MultiChannelAudioBuffer& getImpulseBufferBase() = 0;
 	virtual const MultiChannelAudioBuffer& getImpulseBufferBase() const = 0;
 
+	/** Returns the number of tail blocks that were not rendered by the worker threads in time since this effect was created. */
+	int getNumDeadlineMisses() const;
+
 protected:
 
     MultithreadedConvolver::BackgroundThread backgroundThread;
@@ -301,6 +365,9 @@ protected:
 
 	bool reloadInternal();
 
+	/** Waits until the worker threads are done with the current convolvers. */
+	void waitForBackgroundProcessing();
+
 	bool useBackgroundThread = false;
 	bool nonRealtime = false;
 	bool processingEnabled = true;
@@ -354,6 +421,9 @@ protected:
 
     MultithreadedConvolver::Ptr fadeOutConvolverL;
     MultithreadedConvolver::Ptr fadeOutConvolverR;
+
+	// the deadline misses of the convolvers that were replaced by a reload
+	std::atomic<int> numDeadlineMissesOfOldConvolvers = { 0 };
     
 	double cutoffFrequency = 20000.0;
 
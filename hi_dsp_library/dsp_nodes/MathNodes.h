@@ -837,6 +837,16 @@ public:
 
             thisNetwork = originalNetwork->clone(numClones);
 
+            // stateless networks process all samples of a channel in a single batch,
+            // all others process the block layer by layer
+            thisNetwork->prepareBatch(jmax(ps.blockSize, numClones));
+            thisNetwork->prepareBlock(ps.blockSize);
+
+            auto isMonoSignal = thisNetwork->getNumInputs() == 1 && thisNetwork->getNumOutputs() == 1;
+
+            processSamplesAsBatch = isMonoSignal && thisNetwork->isStateless();
+            processSamplesAsBlock = isMonoSignal && !processSamplesAsBatch;
+
             voiceIndexOffsets.prepare(ps);
 
             int idx = 0;
@@ -895,8 +905,19 @@ public:
             {
                 auto bl = data.toChannelData(ch);
 
-                for(auto& s: bl)
-                    currentNetwork->process(offset + c, &s, &s);
+                if(processSamplesAsBatch)
+                {
+                    currentNetwork->processBatch(offset + c, data.getNumSamples(), bl.begin(), bl.begin());
+                }
+                else if(processSamplesAsBlock)
+                {
+                    currentNetwork->processBlock(offset + c, bl.begin(), bl.begin(), data.getNumSamples());
+                }
+                else
+                {
+                    for(auto& s: bl)
+                        currentNetwork->process(offset + c, &s, &s);
+                }
 
                 c++;
             }
@@ -910,9 +931,8 @@ public:
         {
             auto offset = voiceIndexOffsets.get();
 
-            int c = 0;
-            for(auto& s: data)
-                currentNetwork->process(offset + c++, &s, &s);
+            // all channels of the frame are processed with a single call
+            currentNetwork->processBatch(offset, data.size(), data.begin(), data.begin());
         }
     }
 
@@ -922,6 +942,9 @@ public:
     }
     
     NeuralNetwork::Ptr thisNetwork;
+
+    bool processSamplesAsBatch = false;
+    bool processSamplesAsBlock = false;
     
     PrepareSpecs lastSpecs;
 };
@@ -50,14 +50,46 @@
 #elif defined (AUDIOFFT_FFTW3)
   #define AUDIOFFT_FFTW3_USED
   #include <fftw3.h>
-#else
-  #if !defined(AUDIOFFT_OOURA)
-    #define AUDIOFFT_OOURA
-  #endif
-  #define AUDIOFFT_OOURA_USED
-  #include <vector>
 #endif
 
+// Ooura is always compiled so that it can be selected explicitly (and is used as
+// fallback if the requested implementation is not available on this platform).
+#if !defined(AUDIOFFT_OOURA)
+  #define AUDIOFFT_OOURA
+#endif
+#define AUDIOFFT_OOURA_USED
+#include <vector>
+
+// pffft (BSD licensed, SSE / NEON with a scalar fallback) is always compiled as well.
+// It's the default on every platform without Accelerate, IPP or FFTW3.
+#define AUDIOFFT_PFFFT_USED
+#include "pffft/pffft.h"
+#include "pffft/pffft.c"
+
+// pffft.c uses a few generic macro names, don't leak them into the rest of the unity build.
+#undef COMPILER_GCC
+#undef COMPILER_MSVC
+#undef ALWAYS_INLINE
+#undef NEVER_INLINE
+#undef RESTRICT
+#undef VLA_ARRAY_ON_STACK
+#undef SIMD_SZ
+#undef VZERO
+#undef VMUL
+#undef VADD
+#undef VMADD
+#undef VSUB
+#undef LD_PS1
+#undef INTERLEAVE2
+#undef UNINTERLEAVE2
+#undef VTRANSPOSE4
+#undef VSWAPHL
+#undef VALIGNED
+#undef VCPLXMUL
+#undef VCPLXMULCONJ
+#undef SVMUL
+#undef MALLOC_V4SF_ALIGNMENT
+
 
 namespace audiofft
 {
@@ -1082,6 +1114,144 @@ namespace audiofft
 #endif // AUDIOFFT_FFTW3_USED
 
 
+  // ================================================================
+
+
+#ifdef AUDIOFFT_PFFFT_USED
+
+
+  /**
+   * @internal
+   * @class PffftFFT
+   * @brief FFT implementation using pffft (SSE / NEON) by Julien Pommier
+   *
+   * The SIMD version of pffft needs real transforms of at least 32 samples, so
+   * smaller sizes are forwarded to the Ooura implementation.
+   */
+  class PffftFFT : public detail::AudioFFTImpl
+  {
+  public:
+    PffftFFT() :
+      detail::AudioFFTImpl(),
+      _size(0),
+      _setup(nullptr),
+      _buffer(nullptr),
+      _work(nullptr),
+      _fallback()
+    {
+    }
+
+    PffftFFT(const PffftFFT&) = delete;
+    PffftFFT& operator=(const PffftFFT&) = delete;
+
+    virtual ~PffftFFT()
+    {
+      init(0);
+    }
+
+    virtual void init(size_t size) override
+    {
+      if (_size != size)
+      {
+        if (_setup)
+        {
+          pffft_destroy_setup(_setup);
+          _setup = nullptr;
+        }
+
+        if (_buffer)
+        {
+          pffft_aligned_free(_buffer);
+          _buffer = nullptr;
+        }
+
+        if (_work)
+        {
+          pffft_aligned_free(_work);
+          _work = nullptr;
+        }
+
+        _fallback.reset();
+        _size = size;
+
+        if (size > 0)
+        {
+          _setup = pffft_new_setup(static_cast<int>(size), PFFFT_REAL);
+
+          if (_setup)
+          {
+            _buffer = reinterpret_cast<float*>(pffft_aligned_malloc(size * sizeof(float)));
+            _work = reinterpret_cast<float*>(pffft_aligned_malloc(size * sizeof(float)));
+          }
+          else
+          {
+            _fallback.reset(new OouraFFT());
+            _fallback->init(size);
+          }
+        }
+      }
+    }
+
+    virtual void fft(const float* data, float* re, float* im) override
+    {
+      if (_fallback)
+      {
+        _fallback->fft(data, re, im);
+        return;
+      }
+
+      ::memcpy(_buffer, data, _size * sizeof(float));
+      pffft_transform_ordered(_setup, _buffer, _buffer, _work, PFFFT_FORWARD);
+
+      // The ordered output is interleaved, with the real Nyquist bin packed into the imaginary
+      // slot of the DC bin.
+      const size_t size2 = _size / 2;
+      re[0] = _buffer[0];
+      im[0] = 0.0f;
+      re[size2] = _buffer[1];
+      im[size2] = 0.0f;
+
+      for (size_t i=1; i<size2; ++i)
+      {
+        re[i] = _buffer[2 * i];
+        im[i] = _buffer[2 * i + 1];
+      }
+    }
+
+    virtual void ifft(float* data, const float* re, const float* im) override
+    {
+      if (_fallback)
+      {
+        _fallback->ifft(data, re, im);
+        return;
+      }
+
+      const size_t size2 = _size / 2;
+      _buffer[0] = re[0];
+      _buffer[1] = re[size2];
+
+      for (size_t i=1; i<size2; ++i)
+      {
+        _buffer[2 * i] = re[i];
+        _buffer[2 * i + 1] = im[i];
+      }
+
+      pffft_transform_ordered(_setup, _buffer, _buffer, _work, PFFFT_BACKWARD);
+      detail::ScaleBuffer(data, _buffer, 1.0f / static_cast<float>(_size), _size);
+    }
+
+  private:
+    size_t _size;
+    PFFFT_Setup* _setup;
+    float* _buffer;
+    float* _work;
+    std::unique_ptr<OouraFFT> _fallback;
+  };
+
+
+#endif // AUDIOFFT_PFFFT_USED
+
+
   // =============================================================
 
 
@@ -1091,15 +1261,20 @@ namespace audiofft
 
 	  - if Apple's FFT should be used (iOS), use this.
 	  - if USE_IPP is set and the fftType is IPP, use this
-	  - if Ooura is chosen or all other implementations are not avalailable,
-	    use this (on all systems).
+	  - if AUDIOFFT_FFTW3 is defined and the fftType is FFTW3, use this
+	  - pffft is compiled on all systems and is used if the requested
+	    implementation is not available
+	  - Ooura is only used if it's chosen explicitly.
+
+	  BestAvailable picks the first one that is compiled in this order:
+	  Accelerate, IPP, FFTW3, PFFFT.
 	  */
 
 	  switch (fftType)
 	  {
 	  case ImplementationType::BestAvailable:
 	  case audiofft::ImplementationType::AppleAccelerate:
-#ifdef AUDIOFFT_APPLE_ACCELERATE
+#ifdef AUDIOFFT_APPLE_ACCELERATE_USED
 		  _impl.reset(new AppleAccelerateFFT());
 
 		  break;
@@ -1109,6 +1284,15 @@ namespace audiofft
 		  _impl.reset(new IPP_FFT());
 		  break;
 #endif
+	  case audiofft::ImplementationType::FFTW3:
+#ifdef AUDIOFFT_FFTW3_USED
+		  _impl.reset(new FFTW3FFT());
+		  break;
+#endif
+	  case audiofft::ImplementationType::PFFFT:
+		  _impl.reset(new PffftFFT());
+		  break;
+	  case audiofft::ImplementationType::Ooura:
 	  default:
 		  _impl.reset(new OouraFFT());
 		  break;
@@ -1116,6 +1300,38 @@ namespace audiofft
   }
 
 
+  bool AudioFFT::isAvailable(ImplementationType fftType)
+  {
+	  switch (fftType)
+	  {
+	  case ImplementationType::BestAvailable:
+	  case ImplementationType::Ooura:
+	  case ImplementationType::PFFFT:
+		  return true;
+	  case ImplementationType::AppleAccelerate:
+#ifdef AUDIOFFT_APPLE_ACCELERATE_USED
+		  return true;
+#else
+		  return false;
+#endif
+	  case ImplementationType::IPP:
+#if USE_IPP
+		  return true;
+#else
+		  return false;
+#endif
+	  case ImplementationType::FFTW3:
+#ifdef AUDIOFFT_FFTW3_USED
+		  return true;
+#else
+		  return false;
+#endif
+	  default:
+		  return false;
+	  }
+  }
+
+
   AudioFFT::~AudioFFT()
   {
   }
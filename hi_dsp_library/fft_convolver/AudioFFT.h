@@ -30,7 +30,7 @@
 *
 * - Real-complex FFT and complex-real inverse FFT for power-of-2-sized real data.
 *
-* - Uniform interface to different FFT implementations (currently Ooura, FFTW3 and Apple Accelerate).
+* - Uniform interface to different FFT implementations (currently Ooura, pffft, FFTW3, IPP and Apple Accelerate).
 *
 * - Complex data is handled in "split-complex" format, i.e. there are separate
 *   arrays for the real and imaginary parts which can be useful for SIMD optimizations
@@ -100,6 +100,7 @@ namespace audiofft
 		AppleAccelerate,
 		Ooura,
 		FFTW3,
+		PFFFT,
 		numImplementationTypes
 	};
 
@@ -125,6 +126,12 @@ namespace audiofft
      */
     AudioFFT(ImplementationType fftType);
 
+    /**
+     * @brief Returns whether the given implementation is compiled on this platform
+     *        (otherwise the constructor falls back to pffft).
+     */
+    static bool isAvailable(ImplementationType fftType);
+
     AudioFFT(const AudioFFT&) = delete;
     AudioFFT& operator=(const AudioFFT&) = delete;
 
@@ -41,7 +41,9 @@ TwoStageFFTConvolver::TwoStageFFTConvolver(audiofft::ImplementationType fftType)
   _tailInput(),
   _tailInputFill(0),
   _precalculatedPos(0),
-  _backgroundProcessingInput()
+  _backgroundProcessingInput(),
+  _fftType(fftType),
+  _maxNumTailSegments(1)
 {
 }
 
@@ -68,6 +70,7 @@ void TwoStageFFTConvolver::reset()
   _tailInputFill = 0;
   _precalculatedPos = 0;
   _backgroundProcessingInput.clear();
+  _tailSegments.clear();
 }
 
   
@@ -86,6 +89,19 @@ void TwoStageFFTConvolver::cleanPipeline()
 
 	_tailConvolver.resetInput();
 	_headConvolver.resetInput();
+
+	for (auto& s : _tailSegments)
+		s->cleanPipeline();
+}
+
+void TwoStageFFTConvolver::setMaxNumTailSegments(size_t maxNumSegments)
+{
+	_maxNumTailSegments = jmax(size_t(1), maxNumSegments);
+}
+
+size_t TwoStageFFTConvolver::getNumTailSegments() const
+{
+	return _tailPrecalculated.size() > 0 ? _tailSegments.size() + 1 : 0;
 }
 
 bool TwoStageFFTConvolver::init(size_t headBlockSize,
@@ -135,7 +151,22 @@ bool TwoStageFFTConvolver::init(size_t headBlockSize,
   if (irLen > 2 * _tailBlockSize)
   {
     const size_t tailIrLen = irLen - (2*_tailBlockSize);
-    _tailConvolver.init(_tailBlockSize, ir+(2*_tailBlockSize), tailIrLen);
+
+    // Each segment should contain a few partitions so that the additional FFT of the input
+    // doesn't eat up the gain of processing the segments in parallel
+    const size_t minPartitionsPerSegment = 4;
+    const size_t numPartitions = (tailIrLen + _tailBlockSize - 1) / _tailBlockSize;
+    const size_t numSegments = jlimit(size_t(1), _maxNumTailSegments, numPartitions / minPartitionsPerSegment);
+    const size_t segmentLength = ((numPartitions + numSegments - 1) / numSegments) * _tailBlockSize;
+
+    _tailConvolver.init(_tailBlockSize, ir+(2*_tailBlockSize), jmin(tailIrLen, segmentLength));
+
+    for (size_t offset = segmentLength; offset < tailIrLen; offset += segmentLength)
+    {
+      _tailSegments.push_back(std::make_unique<TailSegment>(_fftType, _tailBlockSize, offset / _tailBlockSize));
+      _tailSegments.back()->convolver.init(_tailBlockSize, ir + (2*_tailBlockSize) + offset, jmin(tailIrLen - offset, segmentLength));
+    }
+
     _tailOutput.resize(_tailBlockSize);
     _tailPrecalculated.resize(_tailBlockSize);
     _backgroundProcessingInput.resize(_tailBlockSize);
@@ -221,6 +252,10 @@ void TwoStageFFTConvolver::process(const Sample* input, Sample* output, size_t l
           _tailOutput.size() == _tailBlockSize)
       {
         waitForBackgroundProcessing();
+
+        for (auto& s : _tailSegments)
+          FloatVectorOperations::add(_tailOutput.data(), s->output.data(), (int)_tailBlockSize);
+
         SampleBuffer::Swap(_tailPrecalculated, _tailOutput);
         _backgroundProcessingInput.copyFrom(_tailInput);
         startBackgroundProcessing();
@@ -251,7 +286,50 @@ void TwoStageFFTConvolver::waitForBackgroundProcessing()
 
 void TwoStageFFTConvolver::doBackgroundProcessing()
 {
-  _tailConvolver.process(_backgroundProcessingInput.data(), _tailOutput.data(), _tailBlockSize);
+  for (size_t i = 0; i < getNumTailSegments(); i++)
+    doBackgroundProcessing(i);
+}
+
+
+void TwoStageFFTConvolver::doBackgroundProcessing(size_t segmentIndex)
+{
+  if (segmentIndex == 0)
+    _tailConvolver.process(_backgroundProcessingInput.data(), _tailOutput.data(), _tailBlockSize);
+  else
+    _tailSegments[segmentIndex - 1]->process(_backgroundProcessingInput);
+}
+
+
+TwoStageFFTConvolver::TailSegment::TailSegment(audiofft::ImplementationType fftType, size_t blockSize_, size_t numDelayBlocks_) :
+  convolver(fftType),
+  output(blockSize_),
+  delayedInput((numDelayBlocks_ + 1) * blockSize_),
+  blockSize(blockSize_),
+  numDelayBlocks(numDelayBlocks_),
+  writeIndex(0)
+{
+}
+
+
+void TwoStageFFTConvolver::TailSegment::process(const SampleBuffer& input)
+{
+  const size_t numSlots = numDelayBlocks + 1;
+
+  ::memcpy(delayedInput.data() + writeIndex * blockSize, input.data(), blockSize * sizeof(Sample));
+
+  // the oldest block in the ring buffer is the one after the current write position
+  writeIndex = (writeIndex + 1) % numSlots;
+
+  convolver.process(delayedInput.data() + writeIndex * blockSize, output.data(), blockSize);
+}
+
+
+void TwoStageFFTConvolver::TailSegment::cleanPipeline()
+{
+  convolver.resetInput();
+  output.setZero();
+  delayedInput.setZero();
+  writeIndex = 0;
 }
     
 } // End of namespace fftconvolver
@@ -25,6 +25,9 @@
 #include "FFTConvolver.h"
 #include "Utilities.h"
 
+#include <memory>
+#include <vector>
+
 
 namespace fftconvolver
 { 
@@ -84,6 +87,18 @@ public:
   /** Clears the internal buffers so that it resets the convolution pipeline. */
   void cleanPipeline();
 
+  /**
+  * @brief Sets the maximum number of segments for the background tail convolution
+  *
+  * The tail after the second tail block is split into independent segments that can be
+  * processed in parallel (see doBackgroundProcessing(size_t)). The segments are only created
+  * if the impulse response is long enough, so call this before init().
+  */
+  void setMaxNumTailSegments(size_t maxNumSegments);
+
+  /** @brief Returns the number of segments that need to be processed for each tail block */
+  size_t getNumTailSegments() const;
+
 protected:
   /**
   * @brief Method called by the convolver if work for background processing is available
@@ -107,6 +122,13 @@ protected:
   */
   void doBackgroundProcessing();
 
+  /**
+  * @brief Performs the background processing work of a single tail segment
+  *
+  * The segments are independent of each other so they can be processed on different threads.
+  */
+  void doBackgroundProcessing(size_t segmentIndex);
+
 private:
   size_t _headBlockSize;
   size_t _tailBlockSize;
@@ -122,6 +144,28 @@ private:
   size_t _precalculatedPos;
   SampleBuffer _backgroundProcessingInput;
 
+  // A part of the tail that starts later in the impulse response. It convolves
+  // the input of numDelayBlocks tail blocks ago with its part of the impulse response.
+  struct TailSegment
+  {
+    TailSegment(audiofft::ImplementationType fftType, size_t blockSize, size_t numDelayBlocks);
+
+    void process(const SampleBuffer& input);
+    void cleanPipeline();
+
+    FFTConvolver convolver;
+    SampleBuffer output;
+    SampleBuffer delayedInput;
+    const size_t blockSize;
+    const size_t numDelayBlocks;
+    size_t writeIndex;
+  };
+
+  // The additional tail segments (the first segment is _tailConvolver)
+  audiofft::ImplementationType _fftType;
+  size_t _maxNumTailSegments;
+  std::vector<std::unique_ptr<TailSegment>> _tailSegments;
+
   // Prevent uncontrolled usage
   TwoStageFFTConvolver(const TwoStageFFTConvolver&);
   TwoStageFFTConvolver& operator=(const TwoStageFFTConvolver&);
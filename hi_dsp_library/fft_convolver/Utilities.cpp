@@ -75,24 +75,45 @@ void ComplexMultiplyAccumulate(SplitComplex& result, const SplitComplex& a, cons
 }
 
 
-void ComplexMultiplyAccumulate(Sample* FFTCONVOLVER_RESTRICT re, 
-                               Sample* FFTCONVOLVER_RESTRICT im,
-                               const Sample* FFTCONVOLVER_RESTRICT reA,
-                               const Sample* FFTCONVOLVER_RESTRICT imA,
-                               const Sample* FFTCONVOLVER_RESTRICT reB,
-                               const Sample* FFTCONVOLVER_RESTRICT imB,
-                               const size_t len)
+namespace kernels
 {
 
-#if USE_JUCE_SSE
-
-	FloatVectorOperations::addWithMultiply(re, reA, reB, len);
-	FloatVectorOperations::subtractWithMultiply(re, imA, imB, len);
-
-	FloatVectorOperations::addWithMultiply(im, reA, imB, len);
-	FloatVectorOperations::subtractWithMultiply(im, imA, reB, len);
+static void scalarMAC(Sample* FFTCONVOLVER_RESTRICT re, 
+                      Sample* FFTCONVOLVER_RESTRICT im,
+                      const Sample* FFTCONVOLVER_RESTRICT reA,
+                      const Sample* FFTCONVOLVER_RESTRICT imA,
+                      const Sample* FFTCONVOLVER_RESTRICT reB,
+                      const Sample* FFTCONVOLVER_RESTRICT imB,
+                      const size_t len)
+{
+  const size_t end4 = 4 * (len / 4);
+  for (size_t i=0; i<end4; i+=4)
+  {
+    re[i+0] += reA[i+0] * reB[i+0] - imA[i+0] * imB[i+0];
+    re[i+1] += reA[i+1] * reB[i+1] - imA[i+1] * imB[i+1];
+    re[i+2] += reA[i+2] * reB[i+2] - imA[i+2] * imB[i+2];
+    re[i+3] += reA[i+3] * reB[i+3] - imA[i+3] * imB[i+3];
+    im[i+0] += reA[i+0] * imB[i+0] + imA[i+0] * reB[i+0];
+    im[i+1] += reA[i+1] * imB[i+1] + imA[i+1] * reB[i+1];
+    im[i+2] += reA[i+2] * imB[i+2] + imA[i+2] * reB[i+2];
+    im[i+3] += reA[i+3] * imB[i+3] + imA[i+3] * reB[i+3];
+  }
+  for (size_t i=end4; i<len; ++i)
+  {
+    re[i] += reA[i] * reB[i] - imA[i] * imB[i];
+    im[i] += reA[i] * imB[i] + imA[i] * reB[i];
+  }
+}
 
-#elif FFTCONVOLVER_USE_SSE && !HI_ENABLE_LEGACY_CPU_SUPPORT
+#if FFTCONVOLVER_USE_SSE && JUCE_INTEL && !HI_ENABLE_LEGACY_CPU_SUPPORT
+static void sseMAC(Sample* FFTCONVOLVER_RESTRICT re, 
+                   Sample* FFTCONVOLVER_RESTRICT im,
+                   const Sample* FFTCONVOLVER_RESTRICT reA,
+                   const Sample* FFTCONVOLVER_RESTRICT imA,
+                   const Sample* FFTCONVOLVER_RESTRICT reB,
+                   const Sample* FFTCONVOLVER_RESTRICT imB,
+                   const size_t len)
+{
   const size_t end4 = 4 * (len / 4);
   for (size_t i=0; i<end4; i+=4)
   {
@@ -114,24 +135,160 @@ void ComplexMultiplyAccumulate(Sample* FFTCONVOLVER_RESTRICT re,
     re[i] += reA[i] * reB[i] - imA[i] * imB[i];
     im[i] += reA[i] * imB[i] + imA[i] * reB[i];
   }
+}
+#endif
+
+#if FFTCONVOLVER_USE_AVX
+
+#if defined(__GNUC__)
+#define FFTCONVOLVER_AVX_TARGET __attribute__((target("avx2,fma")))
 #else
-  const size_t end4 = 4 * (len / 4);
-  for (size_t i=0; i<end4; i+=4)
+#define FFTCONVOLVER_AVX_TARGET
+#endif
+
+// The buffers are only guaranteed to be 16-byte aligned, so this uses unaligned loads
+// (which are free on aligned data on every AVX2 capable CPU). Two vectors are processed
+// per iteration to hide the FMA latency.
+FFTCONVOLVER_AVX_TARGET static void avxMAC(Sample* FFTCONVOLVER_RESTRICT re, 
+                                           Sample* FFTCONVOLVER_RESTRICT im,
+                                           const Sample* FFTCONVOLVER_RESTRICT reA,
+                                           const Sample* FFTCONVOLVER_RESTRICT imA,
+                                           const Sample* FFTCONVOLVER_RESTRICT reB,
+                                           const Sample* FFTCONVOLVER_RESTRICT imB,
+                                           const size_t len)
+{
+  const size_t end16 = 16 * (len / 16);
+  size_t i = 0;
+
+  for (; i<end16; i+=16)
   {
-    re[i+0] += reA[i+0] * reB[i+0] - imA[i+0] * imB[i+0];
-    re[i+1] += reA[i+1] * reB[i+1] - imA[i+1] * imB[i+1];
-    re[i+2] += reA[i+2] * reB[i+2] - imA[i+2] * imB[i+2];
-    re[i+3] += reA[i+3] * reB[i+3] - imA[i+3] * imB[i+3];
-    im[i+0] += reA[i+0] * imB[i+0] + imA[i+0] * reB[i+0];
-    im[i+1] += reA[i+1] * imB[i+1] + imA[i+1] * reB[i+1];
-    im[i+2] += reA[i+2] * imB[i+2] + imA[i+2] * reB[i+2];
-    im[i+3] += reA[i+3] * imB[i+3] + imA[i+3] * reB[i+3];
+    const __m256 ra0 = _mm256_loadu_ps(reA + i);
+    const __m256 ra1 = _mm256_loadu_ps(reA + i + 8);
+    const __m256 ia0 = _mm256_loadu_ps(imA + i);
+    const __m256 ia1 = _mm256_loadu_ps(imA + i + 8);
+    const __m256 rb0 = _mm256_loadu_ps(reB + i);
+    const __m256 rb1 = _mm256_loadu_ps(reB + i + 8);
+    const __m256 ib0 = _mm256_loadu_ps(imB + i);
+    const __m256 ib1 = _mm256_loadu_ps(imB + i + 8);
+
+    __m256 real0 = _mm256_loadu_ps(re + i);
+    __m256 real1 = _mm256_loadu_ps(re + i + 8);
+    __m256 imag0 = _mm256_loadu_ps(im + i);
+    __m256 imag1 = _mm256_loadu_ps(im + i + 8);
+
+    real0 = _mm256_fnmadd_ps(ia0, ib0, _mm256_fmadd_ps(ra0, rb0, real0));
+    real1 = _mm256_fnmadd_ps(ia1, ib1, _mm256_fmadd_ps(ra1, rb1, real1));
+    imag0 = _mm256_fmadd_ps(ia0, rb0, _mm256_fmadd_ps(ra0, ib0, imag0));
+    imag1 = _mm256_fmadd_ps(ia1, rb1, _mm256_fmadd_ps(ra1, ib1, imag1));
+
+    _mm256_storeu_ps(re + i, real0);
+    _mm256_storeu_ps(re + i + 8, real1);
+    _mm256_storeu_ps(im + i, imag0);
+    _mm256_storeu_ps(im + i + 8, imag1);
   }
-  for (size_t i=end4; i<len; ++i)
+
+  for (; i<len; ++i)
   {
     re[i] += reA[i] * reB[i] - imA[i] * imB[i];
     im[i] += reA[i] * imB[i] + imA[i] * reB[i];
   }
+}
+
+#undef FFTCONVOLVER_AVX_TARGET
+#endif
+
+using Function = void(*)(Sample*, Sample*, const Sample*, const Sample*, const Sample*, const Sample*, const size_t);
+
+static bool isSupported(SimdKernel k)
+{
+  switch (k)
+  {
+  case SimdKernel::Scalar: return true;
+#if FFTCONVOLVER_USE_SSE && JUCE_INTEL && !HI_ENABLE_LEGACY_CPU_SUPPORT
+  case SimdKernel::SSE: return true;
+#endif
+#if FFTCONVOLVER_USE_AVX
+  case SimdKernel::AVX2: return SystemStats::hasAVX2() && SystemStats::hasFMA3();
+#endif
+  default: return false;
+  }
+}
+
+static Function getFunction(SimdKernel k)
+{
+  switch (k)
+  {
+#if FFTCONVOLVER_USE_SSE && JUCE_INTEL && !HI_ENABLE_LEGACY_CPU_SUPPORT
+  case SimdKernel::SSE: return sseMAC;
+#endif
+#if FFTCONVOLVER_USE_AVX
+  case SimdKernel::AVX2: return avxMAC;
+#endif
+  default: return scalarMAC;
+  }
+}
+
+static Function getBestFunction()
+{
+  static const Function f = getFunction(getBestSimdKernel());
+  return f;
+}
+
+} // namespace kernels
+
+
+SimdKernel getBestSimdKernel()
+{
+  static const SimdKernel best = []()
+  {
+    for (int i = (int)SimdKernel::numSimdKernels - 1; i > 0; --i)
+    {
+      if (kernels::isSupported((SimdKernel)i))
+        return (SimdKernel)i;
+    }
+
+    return SimdKernel::Scalar;
+  }();
+
+  return best;
+}
+
+
+bool isSimdKernelSupported(SimdKernel k)
+{
+  return kernels::isSupported(k);
+}
+
+
+void ComplexMultiplyAccumulate(SplitComplex& result, const SplitComplex& a, const SplitComplex& b, SimdKernel kernel)
+{
+  assert(result.size() == a.size());
+  assert(result.size() == b.size());
+
+  auto f = kernels::getFunction(kernels::isSupported(kernel) ? kernel : SimdKernel::Scalar);
+  f(result.re(), result.im(), a.re(), a.im(), b.re(), b.im(), result.size());
+}
+
+
+void ComplexMultiplyAccumulate(Sample* FFTCONVOLVER_RESTRICT re, 
+                               Sample* FFTCONVOLVER_RESTRICT im,
+                               const Sample* FFTCONVOLVER_RESTRICT reA,
+                               const Sample* FFTCONVOLVER_RESTRICT imA,
+                               const Sample* FFTCONVOLVER_RESTRICT reB,
+                               const Sample* FFTCONVOLVER_RESTRICT imB,
+                               const size_t len)
+{
+
+#if USE_JUCE_SSE
+
+	FloatVectorOperations::addWithMultiply(re, reA, reB, len);
+	FloatVectorOperations::subtractWithMultiply(re, imA, imB, len);
+
+	FloatVectorOperations::addWithMultiply(im, reA, imB, len);
+	FloatVectorOperations::subtractWithMultiply(im, imA, reB, len);
+
+#else
+  kernels::getBestFunction()(re, im, reA, imA, reB, imB, len);
 #endif
 }
 
@@ -29,9 +29,6 @@
 #include <new>
 
 
-namespace fftconvolver
-{
-
 #if HISE_IOS
 #define FFTCONVOLVER_USE_SSE 0
 #else
@@ -43,6 +40,20 @@ namespace fftconvolver
   #include <xmmintrin.h>
 #endif
 
+// The AVX2 kernel is compiled with a function target attribute and only selected
+// if the CPU reports AVX2 + FMA support at runtime, so the rest of the code base
+// can still be compiled for the baseline instruction set.
+#if FFTCONVOLVER_USE_SSE && JUCE_INTEL && !HI_ENABLE_LEGACY_CPU_SUPPORT && (defined(__GNUC__) || defined(_MSC_VER))
+  #define FFTCONVOLVER_USE_AVX 1
+  #include <immintrin.h>
+#else
+  #define FFTCONVOLVER_USE_AVX 0
+#endif
+
+
+namespace fftconvolver
+{
+
 
 #if defined(__GNUC__)
   #define FFTCONVOLVER_RESTRICT __restrict__
@@ -58,6 +69,30 @@ namespace fftconvolver
 bool SSEEnabled();
 
 
+/**
+* @brief The kernels that are available for ComplexMultiplyAccumulate()
+*/
+enum class SimdKernel
+{
+  Scalar,
+  SSE,
+  AVX2,
+  numSimdKernels
+};
+
+
+/**
+* @brief Returns the fastest kernel that is supported by the CPU (checked once at runtime)
+*/
+SimdKernel getBestSimdKernel();
+
+
+/**
+* @brief Returns whether the CPU supports the given kernel
+*/
+bool isSimdKernelSupported(SimdKernel k);
+
+
 /**
 * @class Buffer
 * @brief Simple buffer implementation (uses 16-byte alignment if SSE optimization is enabled)
@@ -339,6 +374,15 @@ void CopyAndPad(Buffer<T>& dest, const T* src, size_t srcSize)
 void ComplexMultiplyAccumulate(SplitComplex& result, const SplitComplex& a, const SplitComplex& b);
 
 
+/**
+* @brief Same as ComplexMultiplyAccumulate(), but uses the given kernel instead of the best one
+*
+* This is used by the tests and the benchmark to compare the kernels. If the CPU doesn't
+* support the kernel, the scalar kernel will be used.
+*/
+void ComplexMultiplyAccumulate(SplitComplex& result, const SplitComplex& a, const SplitComplex& b, SimdKernel kernel);
+
+
 /**
 * @brief Adds the complex product of two split-complex arrays to a result array
 * @param re The real part of the result buffer
@@ -0,0 +1,188 @@
+// ==================================================================================
+// Copyright (c) 2017 HiFi-LoFi
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is furnished
+// to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// ==================================================================================
+
+// Micro-benchmark for the convolution engine. It's compiled with the unit tests
+// (HI_RUN_UNIT_TESTS) but uses the convolution_benchmark category so that it's
+// not part of the regular test run. Use the run_benchmarks command line option
+// of a release build of HISE to run it.
+//
+// It measures:
+//   - the split-complex multiply-accumulate with every SIMD kernel the CPU supports
+//   - the TwoStageFFTConvolver with every compiled FFT backend for IR lengths from
+//     1024 samples up to 10 seconds (44.1kHz), reported as realtime factor.
+
+#include <chrono>
+#include <vector>
+
+namespace hise
+{
+using namespace juce;
+
+class ConvolutionBenchmark : public UnitTest
+{
+public:
+
+  using Clock = std::chrono::high_resolution_clock;
+  using Sample = fftconvolver::Sample;
+  using SimdKernel = fftconvolver::SimdKernel;
+
+  ConvolutionBenchmark() : UnitTest("Convolution benchmark", "convolution_benchmark") {}
+
+  void runTest() override
+  {
+    beginTest("Benchmarking the complex multiply-accumulate kernels");
+
+    logMessage("Best SIMD kernel: " + String(getKernelName(fftconvolver::getBestSimdKernel())));
+
+    for (size_t len : { 65, 257, 1025, 4097 })
+      benchmarkComplexMultiplyAccumulate(len, 4 * 1024 * 1024 / len * 64);
+
+    beginTest("Benchmarking the FFT backends");
+
+    const size_t irLengths[] = { 1024, 8192, 44100, 4 * 44100, 10 * 44100 };
+
+    for (int t = 1; t < (int)audiofft::ImplementationType::numImplementationTypes; ++t)
+    {
+      auto fftType = (audiofft::ImplementationType)t;
+
+      if (!audiofft::AudioFFT::isAvailable(fftType))
+      {
+        logMessage(String::formatted("TwoStage %-13s => not available", getFFTName(fftType)));
+        continue;
+      }
+
+      for (auto irLen : irLengths)
+        benchmarkTwoStageConvolver(fftType, irLen, 512);
+    }
+  }
+
+private:
+
+  static const char* getKernelName(SimdKernel k)
+  {
+    switch (k)
+    {
+    case SimdKernel::Scalar: return "Scalar";
+    case SimdKernel::SSE:    return "SSE";
+    case SimdKernel::AVX2:   return "AVX2/FMA";
+    default:                 return "Unknown";
+    }
+  }
+
+  static const char* getFFTName(audiofft::ImplementationType t)
+  {
+    switch (t)
+    {
+    case audiofft::ImplementationType::BestAvailable:   return "BestAvailable";
+    case audiofft::ImplementationType::IPP:             return "IPP";
+    case audiofft::ImplementationType::AppleAccelerate: return "Accelerate";
+    case audiofft::ImplementationType::Ooura:           return "Ooura";
+    case audiofft::ImplementationType::FFTW3:           return "FFTW3";
+    case audiofft::ImplementationType::PFFFT:           return "PFFFT";
+    default:                                            return "Unknown";
+    }
+  }
+
+  static void fillWithNoise(std::vector<Sample>& data, Random& r)
+  {
+    for (auto& s : data)
+      s = r.nextFloat() * 2.0f - 1.0f;
+  }
+
+  void benchmarkComplexMultiplyAccumulate(size_t len, size_t numIterations)
+  {
+    fftconvolver::SplitComplex result(len), a(len), b(len);
+
+    Random r(0x1234);
+
+    for (size_t i = 0; i < len; ++i)
+    {
+      a.re()[i] = r.nextFloat();
+      a.im()[i] = r.nextFloat();
+      b.re()[i] = r.nextFloat();
+      b.im()[i] = r.nextFloat();
+    }
+
+    double scalarTime = 0.0;
+
+    for (int i = 0; i < (int)SimdKernel::numSimdKernels; ++i)
+    {
+      auto k = (SimdKernel)i;
+
+      if (!fftconvolver::isSimdKernelSupported(k))
+      {
+        logMessage(String::formatted("MAC %-9s (len %6d) => not supported", getKernelName(k), static_cast<int>(len)));
+        continue;
+      }
+
+      result.setZero();
+
+      auto start = Clock::now();
+
+      for (size_t n = 0; n < numIterations; ++n)
+        fftconvolver::ComplexMultiplyAccumulate(result, a, b, k);
+
+      const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+      if (k == SimdKernel::Scalar)
+        scalarTime = seconds;
+
+      logMessage(String::formatted("MAC %-9s (len %6d) => %8.3f ms (%.2fx)", getKernelName(k), static_cast<int>(len), seconds * 1000.0, scalarTime / seconds));
+    }
+  }
+
+  void benchmarkTwoStageConvolver(audiofft::ImplementationType fftType, size_t irLen, size_t blockSize)
+  {
+    const double sampleRate = 44100.0;
+    const size_t inputLen = static_cast<size_t>(sampleRate) * 10;
+
+    Random r(0x5678);
+
+    std::vector<Sample> ir(irLen), in(inputLen), out(inputLen);
+    fillWithNoise(ir, r);
+    fillWithNoise(in, r);
+
+    fftconvolver::TwoStageFFTConvolver convolver(fftType);
+
+    auto start = Clock::now();
+    convolver.init(blockSize, 4096, ir.data(), ir.size());
+    const double initTime = std::chrono::duration<double>(Clock::now() - start).count();
+
+    start = Clock::now();
+
+    for (size_t pos = 0; pos < inputLen; pos += blockSize)
+    {
+      const size_t numThisTime = jmin(blockSize, inputLen - pos);
+      convolver.process(in.data() + pos, out.data() + pos, numThisTime);
+    }
+
+    const double processTime = std::chrono::duration<double>(Clock::now() - start).count();
+    const double audioTime = static_cast<double>(inputLen) / sampleRate;
+
+    logMessage(String::formatted("TwoStage %-13s (IR %7d, block %4d) => init %8.3f ms, process %8.3f ms (%6.1fx realtime)",
+                                 getFFTName(fftType), static_cast<int>(irLen), static_cast<int>(blockSize),
+                                 initTime * 1000.0, processTime * 1000.0, audioTime / processTime));
+  }
+};
+
+static ConvolutionBenchmark convolutionBenchmark;
+
+} // namespace hise
@@ -100,7 +100,7 @@ static bool TestConvolver(size_t inputSize,
   // FFT convolver
   std::vector<fftconvolver::Sample> out(in.size() + ir.size() - 1, fftconvolver::Sample(0.0));
   {
-    fftconvolver::FFTConvolver convolver;
+    fftconvolver::FFTConvolver convolver(audiofft::ImplementationType::BestAvailable);
     convolver.init(blockSizeConvolver, &ir[0], ir.size());
     std::vector<fftconvolver::Sample> inBuf(blockSizeMax);
     size_t processedOut = 0;
@@ -189,7 +189,7 @@ static bool TestTwoStageConvolver(size_t inputSize,
   // FFT convolver
   std::vector<fftconvolver::Sample> out(in.size() + ir.size() - 1, fftconvolver::Sample(0.0));
   {
-    fftconvolver::TwoStageFFTConvolver convolver;
+    fftconvolver::TwoStageFFTConvolver convolver(audiofft::ImplementationType::BestAvailable);
     convolver.init(blockSizeHead, blockSizeTail, &ir[0], ir.size());
     std::vector<fftconvolver::Sample> inBuf(blockSizeMax);
     size_t processedOut = 0;
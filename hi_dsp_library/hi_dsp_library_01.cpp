@@ -80,6 +80,7 @@
 #include "unit_test/wrapper_tests.cpp"
 #include "unit_test/node_tests.cpp"
 #include "unit_test/container_tests.cpp"
+#include "fft_convolver/test/Benchmark.cpp"
 #endif
 
 #include "dsp_nodes/CoreNodes.cpp"
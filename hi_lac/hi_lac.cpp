@@ -32,12 +32,18 @@
 
 #include "hi_lac.h"
 
+#if JUCE_LINUX || JUCE_MAC
+#include <sys/mman.h>
+#endif
+
 #include "hlac/BitCompressors.cpp"
+#include "hlac/BitCompressorsSIMD.cpp"
 #include "hlac/CompressionHelpers.cpp"
 #include "hlac/SampleBuffer.cpp"
 #include "hlac/HlacEncoder.cpp"
 #include "hlac/HlacDecoder.cpp"
 #include "hlac/HlacAudioFormatWriter.cpp"
+#include "hlac/HlacParallelEncoder.cpp"
 #include "hlac/HlacAudioFormatReader.cpp"
 #include "hlac/HiseLosslessAudioFormat.cpp"
 
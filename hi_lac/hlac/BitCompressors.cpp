@@ -148,6 +148,18 @@ void unpackArrayOfInt16(int16* d, int /*numValues*/, uint8 bitDepth)
 }
 
 
+/** Unpacks as many values as possible with the vectorized routines and advances the pointers to the remaining values. */
+static void unpackWithSIMD(int bitRate, int16*& destination, const uint8*& data, int& numValues)
+{
+	// Every block of 8 values uses exactly bitRate bytes
+	const int numBytesAvailable = (numValues / 8) * bitRate;
+	const int numUnpacked = BitCompressors::SIMD::unpack(bitRate, destination, data, numValues, numBytesAvailable);
+
+	destination += numUnpacked;
+	data += numUnpacked * bitRate / 8;
+	numValues -= numUnpacked;
+}
+
 int BitCompressors::ZeroBit::getAllowedBitRange() const
 {
 	return 0;
@@ -223,6 +235,8 @@ bool BitCompressors::OneBit::compress(uint8* destination, const int16* data, int
 
 bool BitCompressors::OneBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	unpackWithSIMD(1, destination, data, numValuesToDecompress);
+
 	const uint8 masks[8] = { 0b00000001, 0b00000010, 0b00000100, 0b00001000,
 		0b00010000, 0b00100000, 0b01000000, 0b10000000 };
 
@@ -318,6 +332,8 @@ bool BitCompressors::TwoBit::compress(uint8* destination, const int16* data, int
 
 bool BitCompressors::TwoBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	unpackWithSIMD(2, destination, data, numValuesToDecompress);
+
 	const uint8 signMasks[4] =  { 0b00000010, 0b00001000, 0b00100000, 0b10000000 };
 	const uint8 valueMasks[4] = { 0b00000001, 0b00000100, 0b00010000, 0b01000000 };
 
@@ -431,7 +447,7 @@ bool BitCompressors::FourBit::compress(uint8* destination, const int16* data, in
 
 bool BitCompressors::FourBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
-	
+	unpackWithSIMD(4, destination, data, numValuesToDecompress);
 
 	const uint8 signMasks[2] =  { 0b00001000, 0b10000000 };
 	const uint8 valueMasks[2] = { 0b00000111, 0b01110000 };
@@ -543,6 +559,8 @@ bool BitCompressors::SixBit::compress(uint8* destination, const int16* data, int
 
 bool BitCompressors::SixBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	unpackWithSIMD(6, destination, data, numValuesToDecompress);
+
 #if JUCE_IOS
 	while (numValuesToDecompress >= 8)
 	{
@@ -703,7 +721,9 @@ bool BitCompressors::EightBit::compress(uint8* destination, const int16* data, i
 
 bool BitCompressors::EightBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
-    while (--numValuesToDecompress >= 0)
+	unpackWithSIMD(8, destination, data, numValuesToDecompress);
+
+	while (--numValuesToDecompress >= 0)
 	{
 		const int8 value = *reinterpret_cast<const int8*>(data++);
 		*destination++ = (int16)value;
@@ -790,6 +810,8 @@ bool BitCompressors::TenBit::compress(uint8* destination, const int16* data, int
 
 bool BitCompressors::TenBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	unpackWithSIMD(10, destination, data, numValuesToDecompress);
+
 	while (numValuesToDecompress >= 8)
 	{
 		decompress10Bit(reinterpret_cast<uint16*>(destination), (void*)data);
@@ -848,6 +870,8 @@ bool BitCompressors::TwelveBit::compress(uint8* destination, const int16* data,
 
 bool BitCompressors::TwelveBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	unpackWithSIMD(12, destination, data, numValuesToDecompress);
+
 #if USE_SSE
 
 	const int numInBlockProcessing = numValuesToDecompress - (numValuesToDecompress % 4);
@@ -1002,6 +1026,8 @@ bool BitCompressors::FourteenBit::compress(uint8* destination, const int16* data
 
 bool BitCompressors::FourteenBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	unpackWithSIMD(14, destination, data, numValuesToDecompress);
+
 	while (numValuesToDecompress >= 8)
 	{
 		decompress14Bit(destination, data);
@@ -206,6 +206,48 @@ struct BitCompressors
 		int getByteAmount(int numValuesToCompress) override;
 	};
 
+	/** Vectorized unpacking routines for the decoder.
+	*
+	*	The best instruction set is picked at runtime (AVX2, SSE4.1 or NEON), but you can override it for testing and 
+	*	benchmarking. The results are bit-identical to the scalar implementation, which is still used for the remaining
+	*	values at the end of each buffer.
+	*/
+	struct SIMD
+	{
+		enum class InstructionSet
+		{
+			Scalar,
+			SSE41,
+			AVX2,
+			NEON,
+			numInstructionSets
+		};
+
+		/** Returns the instruction set that is used by the decompressors. */
+		static InstructionSet getInstructionSet();
+
+		/** Overrides the instruction set. Pass in numInstructionSets to go back to the best available one. */
+		static void setInstructionSet(InstructionSet s);
+
+		/** Checks whether the given instruction set can be used on this machine. */
+		static bool isSupported(InstructionSet s);
+
+		static String getName(InstructionSet s);
+
+		/** Unpacks as many values with the given bit rate as possible and returns the number of unpacked values.
+		*
+		*	This will always be a multiple of 8, so the data pointer has to be advanced by numUnpacked * bitRate / 8.
+		*	It will never read beyond data + numBytesAvailable.
+		*/
+		static int unpack(int bitRate, int16* destination, const uint8* data, int numValues, int numBytesAvailable);
+
+		/** Converts the int16 values to floats (scaled by 1 / 0x7fff). */
+		static void int16ToFloat(const int16* source, float* destination, int numSamples);
+
+		/** Converts the int16 values to floats and divides them by the given value. */
+		static void int16ToFloatWithDivisor(const int16* source, float* destination, int numSamples, float divisor);
+	};
+
 	struct UnitTests;
 };
 
@@ -0,0 +1,610 @@
+/*  ===========================================================================
+ *
+ *   This file is part of HISE.
+ *   Copyright 2016 Christoph Hart
+ *
+ *   HISE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   HISE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Commercial licenses for using HISE in an closed source project are
+ *   available on request. Please visit the project's website to get more
+ *   information about commercial licensing:
+ *
+ *   http://www.hise.audio/
+ *
+ *   HISE is based on the JUCE library,
+ *   which must be separately licensed for closed source applications:
+ *
+ *   http://www.juce.com
+ *
+ *   ===========================================================================
+ */
+
+#if !HI_ENABLE_LEGACY_CPU_SUPPORT && JUCE_INTEL
+#define HLAC_SIMD_INTEL 1
+#include <immintrin.h>
+#else
+#define HLAC_SIMD_INTEL 0
+#endif
+
+#if !HI_ENABLE_LEGACY_CPU_SUPPORT && JUCE_ARM && (defined(__aarch64__) || defined(_M_ARM64))
+#define HLAC_SIMD_NEON 1
+#include <arm_neon.h>
+#else
+#define HLAC_SIMD_NEON 0
+#endif
+
+// GCC and clang need the target attribute in order to use the intrinsics without compiling the whole module with -mavx2
+#if HLAC_SIMD_INTEL && (JUCE_GCC || JUCE_CLANG)
+#define HLAC_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define HLAC_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define HLAC_TARGET_SSE41
+#define HLAC_TARGET_AVX2
+#endif
+
+namespace hlac { using namespace juce; 
+
+namespace SIMDHelpers
+{
+
+/** The shuffle masks for the 6, 10, 12 and 14 bit formats.
+*
+*	These formats store the values as a continuous bit stream in 16 bit words (MSB first). Every value is
+*	extracted by moving the two words that contain it into a 32 bit lane, shifting the value to the top and
+*	then back down to the lowest bits.
+*/
+struct PackedLayout
+{
+	uint8 shuffle[32];
+	int32 shift[8];
+	uint32 multiplier[8];
+};
+
+/** The shuffle masks for the 1, 2 and 4 bit formats.
+*
+*	The byte that contains the value is moved into the upper byte of a 16 bit lane and then shifted
+*	down so that the value starts at the lowest bit. The highest bit of the 2 and 4 bit formats is the sign.
+*/
+struct SmallLayout
+{
+	uint8 shuffle[16];
+	uint16 multiplier[8];
+	int16 shift[8];
+};
+
+static PackedLayout createPackedLayout(int bitDepth)
+{
+	PackedLayout l;
+
+	for (int i = 0; i < 8; i++)
+	{
+		const int bitPosition = i * bitDepth;
+		const int wordIndex = bitPosition / 16;
+		const int bitOffset = bitPosition % 16;
+
+		// The words are little endian, so the lane is (word[wordIndex] << 16) | word[wordIndex + 1]
+		l.shuffle[i * 4 + 0] = (uint8)(2 * wordIndex + 2);
+		l.shuffle[i * 4 + 1] = (uint8)(2 * wordIndex + 3);
+		l.shuffle[i * 4 + 2] = (uint8)(2 * wordIndex);
+		l.shuffle[i * 4 + 3] = (uint8)(2 * wordIndex + 1);
+
+		l.shift[i] = bitOffset;
+		l.multiplier[i] = 1u << bitOffset;
+	}
+
+	return l;
+}
+
+static SmallLayout createSmallLayout(int bitDepth)
+{
+	SmallLayout l;
+
+	for (int i = 0; i < 8; i++)
+	{
+		const int bitPosition = i * bitDepth;
+		const int bitOffset = bitPosition % 8;
+
+		// an index with the highest bit set clears the byte
+		l.shuffle[i * 2] = 0x80;
+		l.shuffle[i * 2 + 1] = (uint8)(bitPosition / 8);
+
+		// (x << 8) * 2^(8 - offset) >> 16 == x >> offset
+		l.multiplier[i] = (uint16)(1 << (8 - bitOffset));
+		l.shift[i] = (int16)(-8 - bitOffset);
+	}
+
+	return l;
+}
+
+static const PackedLayout& getPackedLayout(int bitDepth)
+{
+	static const PackedLayout layouts[4] = { createPackedLayout(6), createPackedLayout(10), createPackedLayout(12), createPackedLayout(14) };
+
+	jassert(bitDepth == 6 || bitDepth == 10 || bitDepth == 12 || bitDepth == 14);
+	return layouts[bitDepth == 6 ? 0 : bitDepth / 2 - 4];
+}
+
+static const SmallLayout& getSmallLayout(int bitDepth)
+{
+	static const SmallLayout layouts[3] = { createSmallLayout(1), createSmallLayout(2), createSmallLayout(4) };
+
+	jassert(bitDepth == 1 || bitDepth == 2 || bitDepth == 4);
+	return layouts[bitDepth == 4 ? 2 : bitDepth - 1];
+}
+
+static constexpr int16 getOffset(int bitDepth) { return (int16)((1 << (bitDepth - 1)) - 1); }
+
+static constexpr uint16 getMagnitudeMask(int bitDepth) { return bitDepth == 1 ? 1 : (uint16)((1 << (bitDepth - 1)) - 1); }
+
+static constexpr uint16 getSignMask(int bitDepth) { return bitDepth == 1 ? 0 : (uint16)(1 << (bitDepth - 1)); }
+
+static BitCompressors::SIMD::InstructionSet getBestInstructionSet()
+{
+	using IS = BitCompressors::SIMD::InstructionSet;
+
+#if HLAC_SIMD_INTEL
+	if (SystemStats::hasAVX2())
+		return IS::AVX2;
+
+	if (SystemStats::hasSSE41())
+		return IS::SSE41;
+#elif HLAC_SIMD_NEON
+	return IS::NEON;
+#endif
+
+	return IS::Scalar;
+}
+
+static std::atomic<int> forcedInstructionSet = { (int)BitCompressors::SIMD::InstructionSet::numInstructionSets };
+
+#if HLAC_SIMD_INTEL
+
+template <int BitDepth> HLAC_TARGET_SSE41 static int unpackPackedSSE41(int16* destination, const uint8* data, int numValues, int numBytesAvailable)
+{
+	auto& l = getPackedLayout(BitDepth);
+
+	const __m128i shuffleLo = _mm_loadu_si128((const __m128i*)l.shuffle);
+	const __m128i shuffleHi = _mm_loadu_si128((const __m128i*)(l.shuffle + 16));
+	const __m128i multiplierLo = _mm_loadu_si128((const __m128i*)l.multiplier);
+	const __m128i multiplierHi = _mm_loadu_si128((const __m128i*)(l.multiplier + 4));
+	const __m128i offset = _mm_set1_epi16(getOffset(BitDepth));
+
+	int numUnpacked = 0;
+	int byteOffset = 0;
+
+	while (numValues - numUnpacked >= 8 && byteOffset + 16 <= numBytesAvailable)
+	{
+		const __m128i d = _mm_loadu_si128((const __m128i*)(data + byteOffset));
+
+		__m128i lo = _mm_shuffle_epi8(d, shuffleLo);
+		__m128i hi = _mm_shuffle_epi8(d, shuffleHi);
+
+		lo = _mm_srli_epi32(_mm_mullo_epi32(lo, multiplierLo), 32 - BitDepth);
+		hi = _mm_srli_epi32(_mm_mullo_epi32(hi, multiplierHi), 32 - BitDepth);
+
+		const __m128i v = _mm_sub_epi16(_mm_packus_epi32(lo, hi), offset);
+
+		_mm_storeu_si128((__m128i*)(destination + numUnpacked), v);
+
+		numUnpacked += 8;
+		byteOffset += BitDepth;
+	}
+
+	return numUnpacked;
+}
+
+template <int BitDepth> HLAC_TARGET_SSE41 static int unpackSmallSSE41(int16* destination, const uint8* data, int numValues)
+{
+	auto& l = getSmallLayout(BitDepth);
+
+	const __m128i shuffle = _mm_loadu_si128((const __m128i*)l.shuffle);
+	const __m128i multiplier = _mm_loadu_si128((const __m128i*)l.multiplier);
+	const __m128i magnitudeMask = _mm_set1_epi16((int16)getMagnitudeMask(BitDepth));
+	const __m128i signMask = _mm_set1_epi16((int16)getSignMask(BitDepth));
+
+	int numUnpacked = 0;
+
+	while (numValues - numUnpacked >= 8)
+	{
+		// 8 values need exactly BitDepth bytes
+		int32 packed = 0;
+		memcpy(&packed, data + numUnpacked * BitDepth / 8, BitDepth);
+
+		const __m128i x = _mm_mulhi_epu16(_mm_shuffle_epi8(_mm_cvtsi32_si128(packed), shuffle), multiplier);
+
+		__m128i v = _mm_and_si128(x, magnitudeMask);
+
+		if (BitDepth > 1)
+		{
+			const __m128i isNegative = _mm_cmpeq_epi16(_mm_and_si128(x, signMask), signMask);
+			v = _mm_sub_epi16(_mm_xor_si128(v, isNegative), isNegative);
+		}
+
+		_mm_storeu_si128((__m128i*)(destination + numUnpacked), v);
+
+		numUnpacked += 8;
+	}
+
+	return numUnpacked;
+}
+
+HLAC_TARGET_SSE41 static int unpackEightBitSSE41(int16* destination, const uint8* data, int numValues)
+{
+	int numUnpacked = 0;
+
+	while (numValues - numUnpacked >= 8)
+	{
+		const __m128i v = _mm_cvtepi8_epi16(_mm_loadl_epi64((const __m128i*)(data + numUnpacked)));
+		_mm_storeu_si128((__m128i*)(destination + numUnpacked), v);
+		numUnpacked += 8;
+	}
+
+	return numUnpacked;
+}
+
+HLAC_TARGET_SSE41 static int unpackSSE41(int bitRate, int16* destination, const uint8* data, int numValues, int numBytesAvailable)
+{
+	switch (bitRate)
+	{
+	case 1:  return unpackSmallSSE41<1>(destination, data, numValues);
+	case 2:  return unpackSmallSSE41<2>(destination, data, numValues);
+	case 4:  return unpackSmallSSE41<4>(destination, data, numValues);
+	case 6:  return unpackPackedSSE41<6>(destination, data, numValues, numBytesAvailable);
+	case 8:  return unpackEightBitSSE41(destination, data, numValues);
+	case 10: return unpackPackedSSE41<10>(destination, data, numValues, numBytesAvailable);
+	case 12: return unpackPackedSSE41<12>(destination, data, numValues, numBytesAvailable);
+	case 14: return unpackPackedSSE41<14>(destination, data, numValues, numBytesAvailable);
+	default: return 0;
+	}
+}
+
+template <int BitDepth> HLAC_TARGET_AVX2 static int unpackPackedAVX2(int16* destination, const uint8* data, int numValues, int numBytesAvailable)
+{
+	auto& l = getPackedLayout(BitDepth);
+
+	// The lower lane creates the first four values, the upper lane the last four
+	const __m256i shuffle = _mm256_loadu_si256((const __m256i*)l.shuffle);
+	const __m256i shift = _mm256_loadu_si256((const __m256i*)l.shift);
+	const __m128i offset = _mm_set1_epi16(getOffset(BitDepth));
+
+	int numUnpacked = 0;
+	int byteOffset = 0;
+
+	while (numValues - numUnpacked >= 8 && byteOffset + 16 <= numBytesAvailable)
+	{
+		const __m256i d = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(data + byteOffset)));
+
+		__m256i v = _mm256_shuffle_epi8(d, shuffle);
+		v = _mm256_srli_epi32(_mm256_sllv_epi32(v, shift), 32 - BitDepth);
+		v = _mm256_packus_epi32(v, v);
+		v = _mm256_permute4x64_epi64(v, _MM_SHUFFLE(3, 1, 2, 0));
+
+		const __m128i result = _mm_sub_epi16(_mm256_castsi256_si128(v), offset);
+
+		_mm_storeu_si128((__m128i*)(destination + numUnpacked), result);
+
+		numUnpacked += 8;
+		byteOffset += BitDepth;
+	}
+
+	return numUnpacked;
+}
+
+HLAC_TARGET_AVX2 static int unpackEightBitAVX2(int16* destination, const uint8* data, int numValues)
+{
+	int numUnpacked = 0;
+
+	while (numValues - numUnpacked >= 16)
+	{
+		const __m256i v = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(data + numUnpacked)));
+		_mm256_storeu_si256((__m256i*)(destination + numUnpacked), v);
+		numUnpacked += 16;
+	}
+
+	return numUnpacked + unpackEightBitSSE41(destination + numUnpacked, data + numUnpacked, numValues - numUnpacked);
+}
+
+HLAC_TARGET_AVX2 static int unpackAVX2(int bitRate, int16* destination, const uint8* data, int numValues, int numBytesAvailable)
+{
+	switch (bitRate)
+	{
+	case 6:  return unpackPackedAVX2<6>(destination, data, numValues, numBytesAvailable);
+	case 8:  return unpackEightBitAVX2(destination, data, numValues);
+	case 10: return unpackPackedAVX2<10>(destination, data, numValues, numBytesAvailable);
+	case 12: return unpackPackedAVX2<12>(destination, data, numValues, numBytesAvailable);
+	case 14: return unpackPackedAVX2<14>(destination, data, numValues, numBytesAvailable);
+	default: return unpackSSE41(bitRate, destination, data, numValues, numBytesAvailable); // a 256 bit register is too wide for these
+	}
+}
+
+template <bool Divide> HLAC_TARGET_SSE41 static void int16ToFloatSSE41(const int16* source, float* destination, int numSamples, float factor)
+{
+	const __m128 f = _mm_set1_ps(factor);
+
+	int i = 0;
+
+	for (; i + 8 <= numSamples; i += 8)
+	{
+		const __m128i v = _mm_loadu_si128((const __m128i*)(source + i));
+
+		__m128 lo = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(v));
+		__m128 hi = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(_mm_srli_si128(v, 8)));
+
+		lo = Divide ? _mm_div_ps(lo, f) : _mm_mul_ps(lo, f);
+		hi = Divide ? _mm_div_ps(hi, f) : _mm_mul_ps(hi, f);
+
+		_mm_storeu_ps(destination + i, lo);
+		_mm_storeu_ps(destination + i + 4, hi);
+	}
+
+	for (; i < numSamples; i++)
+		destination[i] = Divide ? (float)source[i] / factor : factor * (float)source[i];
+}
+
+template <bool Divide> HLAC_TARGET_AVX2 static void int16ToFloatAVX2(const int16* source, float* destination, int numSamples, float factor)
+{
+	const __m256 f = _mm256_set1_ps(factor);
+
+	int i = 0;
+
+	for (; i + 16 <= numSamples; i += 16)
+	{
+		__m256 lo = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(source + i))));
+		__m256 hi = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(source + i + 8))));
+
+		lo = Divide ? _mm256_div_ps(lo, f) : _mm256_mul_ps(lo, f);
+		hi = Divide ? _mm256_div_ps(hi, f) : _mm256_mul_ps(hi, f);
+
+		_mm256_storeu_ps(destination + i, lo);
+		_mm256_storeu_ps(destination + i + 8, hi);
+	}
+
+	int16ToFloatSSE41<Divide>(source + i, destination + i, numSamples - i, factor);
+}
+
+#endif
+
+#if HLAC_SIMD_NEON
+
+template <int BitDepth> static int unpackPackedNEON(int16* destination, const uint8* data, int numValues, int numBytesAvailable)
+{
+	auto& l = getPackedLayout(BitDepth);
+
+	const uint8x16_t shuffleLo = vld1q_u8(l.shuffle);
+	const uint8x16_t shuffleHi = vld1q_u8(l.shuffle + 16);
+	const int32x4_t shiftLo = vld1q_s32(l.shift);
+	const int32x4_t shiftHi = vld1q_s32(l.shift + 4);
+	const int16x8_t offset = vdupq_n_s16(getOffset(BitDepth));
+
+	int numUnpacked = 0;
+	int byteOffset = 0;
+
+	while (numValues - numUnpacked >= 8 && byteOffset + 16 <= numBytesAvailable)
+	{
+		const uint8x16_t d = vld1q_u8(data + byteOffset);
+
+		uint32x4_t lo = vreinterpretq_u32_u8(vqtbl1q_u8(d, shuffleLo));
+		uint32x4_t hi = vreinterpretq_u32_u8(vqtbl1q_u8(d, shuffleHi));
+
+		lo = vshrq_n_u32(vshlq_u32(lo, shiftLo), 32 - BitDepth);
+		hi = vshrq_n_u32(vshlq_u32(hi, shiftHi), 32 - BitDepth);
+
+		const int16x8_t v = vreinterpretq_s16_u16(vcombine_u16(vmovn_u32(lo), vmovn_u32(hi)));
+
+		vst1q_s16(destination + numUnpacked, vsubq_s16(v, offset));
+
+		numUnpacked += 8;
+		byteOffset += BitDepth;
+	}
+
+	return numUnpacked;
+}
+
+template <int BitDepth> static int unpackSmallNEON(int16* destination, const uint8* data, int numValues)
+{
+	auto& l = getSmallLayout(BitDepth);
+
+	const uint8x16_t shuffle = vld1q_u8(l.shuffle);
+	const int16x8_t shift = vld1q_s16(l.shift);
+	const uint16x8_t magnitudeMask = vdupq_n_u16(getMagnitudeMask(BitDepth));
+	const uint16x8_t signMask = vdupq_n_u16(getSignMask(BitDepth));
+
+	int numUnpacked = 0;
+
+	while (numValues - numUnpacked >= 8)
+	{
+		uint32 packed = 0;
+		memcpy(&packed, data + numUnpacked * BitDepth / 8, BitDepth);
+
+		const uint8x16_t bytes = vreinterpretq_u8_u32(vdupq_n_u32(packed));
+		const uint16x8_t x = vshlq_u16(vreinterpretq_u16_u8(vqtbl1q_u8(bytes, shuffle)), shift);
+
+		int16x8_t v = vreinterpretq_s16_u16(vandq_u16(x, magnitudeMask));
+
+		if (BitDepth > 1)
+		{
+			const int16x8_t isNegative = vreinterpretq_s16_u16(vceqq_u16(vandq_u16(x, signMask), signMask));
+			v = vsubq_s16(veorq_s16(v, isNegative), isNegative);
+		}
+
+		vst1q_s16(destination + numUnpacked, v);
+
+		numUnpacked += 8;
+	}
+
+	return numUnpacked;
+}
+
+static int unpackEightBitNEON(int16* destination, const uint8* data, int numValues)
+{
+	int numUnpacked = 0;
+
+	while (numValues - numUnpacked >= 8)
+	{
+		vst1q_s16(destination + numUnpacked, vmovl_s8(vld1_s8(reinterpret_cast<const int8_t*>(data + numUnpacked))));
+		numUnpacked += 8;
+	}
+
+	return numUnpacked;
+}
+
+static int unpackNEON(int bitRate, int16* destination, const uint8* data, int numValues, int numBytesAvailable)
+{
+	switch (bitRate)
+	{
+	case 1:  return unpackSmallNEON<1>(destination, data, numValues);
+	case 2:  return unpackSmallNEON<2>(destination, data, numValues);
+	case 4:  return unpackSmallNEON<4>(destination, data, numValues);
+	case 6:  return unpackPackedNEON<6>(destination, data, numValues, numBytesAvailable);
+	case 8:  return unpackEightBitNEON(destination, data, numValues);
+	case 10: return unpackPackedNEON<10>(destination, data, numValues, numBytesAvailable);
+	case 12: return unpackPackedNEON<12>(destination, data, numValues, numBytesAvailable);
+	case 14: return unpackPackedNEON<14>(destination, data, numValues, numBytesAvailable);
+	default: return 0;
+	}
+}
+
+template <bool Divide> static void int16ToFloatNEON(const int16* source, float* destination, int numSamples, float factor)
+{
+	const float32x4_t f = vdupq_n_f32(factor);
+
+	int i = 0;
+
+	for (; i + 8 <= numSamples; i += 8)
+	{
+		const int16x8_t v = vld1q_s16(source + i);
+
+		float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(v)));
+		float32x4_t hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(v)));
+
+		lo = Divide ? vdivq_f32(lo, f) : vmulq_f32(lo, f);
+		hi = Divide ? vdivq_f32(hi, f) : vmulq_f32(hi, f);
+
+		vst1q_f32(destination + i, lo);
+		vst1q_f32(destination + i + 4, hi);
+	}
+
+	for (; i < numSamples; i++)
+		destination[i] = Divide ? (float)source[i] / factor : factor * (float)source[i];
+}
+
+#endif
+
+} // namespace SIMDHelpers
+
+BitCompressors::SIMD::InstructionSet BitCompressors::SIMD::getInstructionSet()
+{
+	static const InstructionSet best = SIMDHelpers::getBestInstructionSet();
+
+	auto forced = (InstructionSet)SIMDHelpers::forcedInstructionSet.load();
+
+	return forced != InstructionSet::numInstructionSets ? forced : best;
+}
+
+void BitCompressors::SIMD::setInstructionSet(InstructionSet s)
+{
+	jassert(s == InstructionSet::numInstructionSets || isSupported(s));
+
+	SIMDHelpers::forcedInstructionSet.store((int)s);
+}
+
+bool BitCompressors::SIMD::isSupported(InstructionSet s)
+{
+	switch (s)
+	{
+	case InstructionSet::Scalar: return true;
+#if HLAC_SIMD_INTEL
+	case InstructionSet::SSE41:	 return SystemStats::hasSSE41();
+	case InstructionSet::AVX2:	 return SystemStats::hasAVX2();
+#endif
+#if HLAC_SIMD_NEON
+	case InstructionSet::NEON:	 return true;
+#endif
+	default:					 return false;
+	}
+}
+
+String BitCompressors::SIMD::getName(InstructionSet s)
+{
+	switch (s)
+	{
+	case InstructionSet::Scalar: return "Scalar";
+	case InstructionSet::SSE41:	 return "SSE4.1";
+	case InstructionSet::AVX2:	 return "AVX2";
+	case InstructionSet::NEON:	 return "NEON";
+	default:					 return {};
+	}
+}
+
+int BitCompressors::SIMD::unpack(int bitRate, int16* destination, const uint8* data, int numValues, int numBytesAvailable)
+{
+	ignoreUnused(bitRate, destination, data, numValues, numBytesAvailable);
+
+	switch (getInstructionSet())
+	{
+#if HLAC_SIMD_INTEL
+	case InstructionSet::AVX2:	return SIMDHelpers::unpackAVX2(bitRate, destination, data, numValues, numBytesAvailable);
+	case InstructionSet::SSE41: return SIMDHelpers::unpackSSE41(bitRate, destination, data, numValues, numBytesAvailable);
+#endif
+#if HLAC_SIMD_NEON
+	case InstructionSet::NEON:	return SIMDHelpers::unpackNEON(bitRate, destination, data, numValues, numBytesAvailable);
+#endif
+	default:					return 0;
+	}
+}
+
+void BitCompressors::SIMD::int16ToFloat(const int16* source, float* destination, int numSamples)
+{
+	const float scale = 1.0f / 0x7fff;
+
+	switch (getInstructionSet())
+	{
+#if HLAC_SIMD_INTEL
+	case InstructionSet::AVX2:	SIMDHelpers::int16ToFloatAVX2<false>(source, destination, numSamples, scale); break;
+	case InstructionSet::SSE41: SIMDHelpers::int16ToFloatSSE41<false>(source, destination, numSamples, scale); break;
+#endif
+#if HLAC_SIMD_NEON
+	case InstructionSet::NEON:	SIMDHelpers::int16ToFloatNEON<false>(source, destination, numSamples, scale); break;
+#endif
+	default:					AudioDataConverters::convertInt16LEToFloat(source, destination, numSamples); break;
+	}
+}
+
+void BitCompressors::SIMD::int16ToFloatWithDivisor(const int16* source, float* destination, int numSamples, float divisor)
+{
+	switch (getInstructionSet())
+	{
+#if HLAC_SIMD_INTEL
+	case InstructionSet::AVX2:	SIMDHelpers::int16ToFloatAVX2<true>(source, destination, numSamples, divisor); break;
+	case InstructionSet::SSE41: SIMDHelpers::int16ToFloatSSE41<true>(source, destination, numSamples, divisor); break;
+#endif
+#if HLAC_SIMD_NEON
+	case InstructionSet::NEON:	SIMDHelpers::int16ToFloatNEON<true>(source, destination, numSamples, divisor); break;
+#endif
+	default:
+	{
+		for (int i = 0; i < numSamples; i++)
+			destination[i] = (float)source[i] / divisor;
+
+		break;
+	}
+	}
+}
+
+} // namespace hlac
+
+#undef HLAC_SIMD_INTEL
+#undef HLAC_SIMD_NEON
+#undef HLAC_TARGET_SSE41
+#undef HLAC_TARGET_AVX2
@@ -532,52 +532,7 @@ void CompressionHelpers::dump(const AudioSampleBuffer& b, String fileName, doubl
 
 void CompressionHelpers::fastInt16ToFloat(const void* source, float* dest, int numSamples)
 {
-#if HI_ENABLE_LEGACY_CPU_SUPPORT || !JUCE_WINDOWS
-
-	AudioDataConverters::convertInt16LEToFloat(source, dest, numSamples);
-
-#else
-
-	if (SystemStats::hasSSE41())
-	{
-		uint64 alignOffsetFloat = reinterpret_cast<uint64>(dest) % 16;
-		uint64 alignOffsetInt = reinterpret_cast<uint64>(source) % 16;
-
-		if (alignOffsetFloat == 0 && alignOffsetInt == 0)
-		{
-			const int16* intData = static_cast<const int16*> (source);
-			const float scale = 1.0f / 0x7fff;
-
-			__m128 s = _mm_set1_ps(scale);
-
-			const int numSingle = (numSamples % 4);
-			const int numSSE = numSamples - numSingle;
-
-			for (int i = 0; i < numSSE; i += 4)
-			{
-				__m128i a = _mm_loadl_epi64((__m128i*)(intData + i));
-				a = _mm_cvtepi16_epi32(a);
-				__m128 a_f = _mm_cvtepi32_ps(a);
-				a_f = _mm_mul_ps(a_f, s);
-				_mm_store_ps(dest + i, a_f);
-			}
-
-			for (int i = 0; i < numSingle; i++)
-			{
-				dest[i + numSSE] = scale * intData[i + numSSE];
-			}
-		}
-		else
-		{
-			AudioDataConverters::convertInt16LEToFloat(source, dest, numSamples);
-		}
-	}
-	else
-	{
-		AudioDataConverters::convertInt16LEToFloat(source, dest, numSamples);
-	}
-    
-#endif
+	BitCompressors::SIMD::int16ToFloat(static_cast<const int16*>(source), dest, numSamples);
 }
 
 void CompressionHelpers::applyDithering(float* data, int numSamples)
@@ -1136,6 +1091,13 @@ uint32 CompressionHelpers::Misc::createChecksum()
 	r.setSeedRandomly();
 	r.setSeedRandomly();
 
+	return createChecksum((uint32)r.nextInt());
+}
+
+uint32 CompressionHelpers::Misc::createChecksum(uint32 seed)
+{
+	Random r((int64)seed);
+
 	uint16 randomNumber = (uint16)r.nextInt(Range<int>(2, UINT16_MAX));
 
 	uint8* d = reinterpret_cast<uint8*>(&randomNumber);
@@ -1835,10 +1797,7 @@ void CompressionHelpers::NormaliseMap::normalisedInt16ToFloat(float* destination
 		{
 			float gainFactor = (float)(1 << thisAmount);
 
-			for (int i = 0; i < numThisTime; i++)
-			{
-				w[i] = (float)r[i] / ((float)INT16_MAX * gainFactor);
-			}
+			BitCompressors::SIMD::int16ToFloatWithDivisor(r, w, numThisTime, (float)INT16_MAX * gainFactor);
 		}
 
 
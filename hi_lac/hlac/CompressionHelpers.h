@@ -298,6 +298,9 @@ struct CompressionHelpers
 
 		static uint32 createChecksum();
 
+		/** Creates a valid checksum from the given seed (so it's reproducible). */
+		static uint32 createChecksum(uint32 seed);
+
 		static bool validateChecksum(uint32 data);
 	};
 
@@ -296,7 +296,7 @@ bool HiseLosslessHeader::write(OutputStream* output)
 	if (headerByte1 < 2)
 		return true;
 
-	auto checkSum = CompressionHelpers::Misc::createChecksum();
+	auto checkSum = CompressionHelpers::Misc::createChecksum(((uint32)headerByte2 << 8) ^ (uint32)sampleDataByte ^ (blockAmount << 16));
 
 	output->writeInt((int)checkSum);
 
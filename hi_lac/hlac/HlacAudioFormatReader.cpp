@@ -189,6 +189,8 @@ bool HlacReaderCommon::internalHlacRead(int** destSamples, int numDestChannels,
 	ignoreUnused(startSampleInFile);
 	ignoreUnused(numDestChannels);
 
+	ScopedLock sl(decodeLock);
+
 	decoder.setHlacVersion(header.getVersion());
 
 	bool isStereo = destSamples[1] != nullptr;
@@ -273,6 +275,8 @@ bool HlacReaderCommon::fixedBufferRead(HiseSampleBuffer& buffer, int numDestChan
 {
 	bool isStereo = numDestChannels == 2;
 
+	ScopedLock sl(decodeLock);
+
 	if (startSampleInFile < 0)
 	{
 		auto silence = (int)jmin(-startSampleInFile, (int64)numSamples);
@@ -408,6 +412,80 @@ bool HlacMemoryMappedAudioFormatReader::readSamples(int** destSamples, int numDe
 }
 
 
+bool HlacMemoryMappedAudioFormatReader::touchSampleRange(int64 startSampleInFile, int numSamples)
+{
+	if (map == nullptr || numSamples <= 0)
+		return false;
+
+	Range<int64> byteRange;
+
+	if (isMonolith)
+		byteRange = { sampleToFilePos(startSampleInFile), sampleToFilePos(startSampleInFile + numSamples) };
+	else
+		byteRange = { (int64)internalReader.header.getOffsetForReadPosition(startSampleInFile, true),
+					  (int64)internalReader.header.getOffsetForNextBlock(startSampleInFile + numSamples, true) };
+
+	byteRange = byteRange.getIntersectionWith(map->getRange());
+
+	if (byteRange.isEmpty())
+		return false;
+
+	auto data = static_cast<const char*>(map->getData()) - map->getRange().getStart();
+	static constexpr int64 PageSize = 4096;
+
+#if JUCE_LINUX || JUCE_MAC
+	{
+		// madvise needs a page aligned address
+		auto alignedStart = jmax(map->getRange().getStart(), byteRange.getStart() - (byteRange.getStart() % PageSize));
+		auto alignedAddress = const_cast<char*>(data + alignedStart);
+
+		if ((reinterpret_cast<uintptr_t>(alignedAddress) % PageSize) == 0)
+			posix_madvise(alignedAddress, (size_t)(byteRange.getEnd() - alignedStart), POSIX_MADV_WILLNEED);
+	}
+#endif
+
+	int sum = 0;
+
+	for (auto i = byteRange.getStart(); i < byteRange.getEnd(); i += PageSize)
+		sum += data[i];
+
+	sum += data[byteRange.getEnd() - 1];
+
+	// used to force the compiler not to optimise-away the read operation
+	volatile int dummy = sum;
+	ignoreUnused(dummy);
+
+	return true;
+}
+
+const uint8* HlacMemoryMappedAudioFormatReader::getUncompressedData(int64 startSampleInFile, int64 numSamples) const
+{
+	if (!isMonolith || map == nullptr || startSampleInFile < 0 || numSamples < 0)
+		return nullptr;
+
+	Range<int64> byteRange(sampleToFilePos(startSampleInFile), sampleToFilePos(startSampleInFile + numSamples));
+
+	if (!map->getRange().contains(byteRange))
+		return nullptr;
+
+	return static_cast<const uint8*>(sampleToPointer(startSampleInFile));
+}
+
+void HlacMemoryMappedAudioFormatReader::readIntoFixedBuffer(HiseSampleBuffer& buffer, int startSample, int numSamples, int64 startSampleInFile)
+{
+	if (isMonolith)
+	{
+		copyFromMonolith(buffer, startSample, buffer.getNumChannels(), startSampleInFile, numChannels, numSamples);
+	}
+	else
+	{
+		internalReader.fixedBufferRead(buffer, numChannels, startSample, startSampleInFile, numSamples);
+
+		if (buffer.getNumChannels() == 1 || numChannels == 1)
+			buffer.setUseOneMap(true);
+	}
+}
+
 bool HlacMemoryMappedAudioFormatReader::mapSectionOfFile(Range<int64> samplesToMap)
 {
 	if (isMonolith)
@@ -555,6 +633,17 @@ bool HlacSubSectionReader::readSamples(int** destSamples, int numDestChannels, i
 		return normalReader->readSamples(destSamples, numDestChannels, startOffsetInDestBuffer, startSampleInFile + start, numSamples);
 }
 
+bool HlacSubSectionReader::touchSampleRange(int64 readerStartSample, int numSamples)
+{
+	readerStartSample = jmax((int64)0, readerStartSample);
+	numSamples = (int)jmax((int64)0, jmin((int64)numSamples, length - readerStartSample));
+
+	if (memoryReader != nullptr)
+		return memoryReader->touchSampleRange(readerStartSample + start, numSamples);
+
+	return false;
+}
+
 void HlacSubSectionReader::readMaxLevels(int64 startSampleInFile, int64 numSamples, Range<float>* results, int numChannelsToRead)
 {
 	startSampleInFile = jmax((int64)0, startSampleInFile);
@@ -121,6 +121,9 @@ private:
 
 	InputStream* input;
 
+	// The decoder keeps the read position, so multiple streaming threads must not decode at the same time
+	CriticalSection decodeLock;
+
 	HlacDecoder decoder;
 	HiseLosslessHeader header;
 
@@ -179,6 +182,27 @@ public:
 
 	bool mapSectionOfFile(Range<int64> samplesToMap) override;
 
+	/** Touches every memory page of the mapped data that is required to read the given range.
+	
+		This forces the OS to load the data into the page cache without decoding it (and on POSIX systems it also
+		sends a read-ahead hint for the range). Returns false if the range is not mapped.
+	*/
+	bool touchSampleRange(int64 startSampleInFile, int numSamples);
+
+	/** Returns a pointer to the interleaved 16 bit data of an uncompressed monolith at the given position.
+
+		This returns nullptr if the file is compressed or the given range is not mapped. The pointer stays valid as long
+		as this reader exists. The samples are little endian and might not be aligned to 2 bytes (the header size
+		of a monolith can be odd), so read them with ByteOrder::littleEndianShort() instead of casting the pointer.
+	*/
+	const uint8* getUncompressedData(int64 startSampleInFile, int64 numSamples) const;
+
+	/** Returns true if the file contains compressed HLAC data (and false if it's an uncompressed monolith). */
+	bool isCompressed() const noexcept { return !isMonolith; }
+
+	/** Decodes the given range into the fixed buffer. This can be called from multiple threads. */
+	void readIntoFixedBuffer(HiseSampleBuffer& buffer, int startSample, int numSamples, int64 startSampleInFile);
+
 	void getSample(int64 /*sampleIndex*/, float* result) const noexcept override
 	{
 		// this should never be used
@@ -215,6 +239,9 @@ public:
 
 	void readIntoFixedBuffer(HiseSampleBuffer& buffer, int startSample, int numSamples, int64 readerStartSample);
 
+	/** Loads the data for the given range into the page cache if the source is memory mapped. */
+	bool touchSampleRange(int64 readerStartSample, int numSamples);
+
 private:
 
 	bool isMonolith = false;
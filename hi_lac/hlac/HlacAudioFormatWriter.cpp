@@ -135,6 +135,19 @@ bool HiseLosslessAudioFormatWriter::write(const int** samplesToWrite, int numSam
 	return true;
 }
 
+bool HiseLosslessAudioFormatWriter::writeEncodedBlock(const HlacEncoder::EncodedBlock& block)
+{
+	// The uncompressed data doesn't use blocks...
+	jassert(options.useCompression);
+
+	tempWasFlushed = false;
+
+	auto ok = encoder.appendEncodedBlock(block, *tempOutputStream, blockOffsets);
+
+	numBytesWritten = tempOutputStream->getPosition();
+
+	return ok;
+}
 
 void HiseLosslessAudioFormatWriter::setTemporaryBufferType(bool shouldUseTemporaryFile)
 {
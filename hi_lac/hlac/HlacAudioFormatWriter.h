@@ -60,6 +60,11 @@ public:
 
 	bool write(const int** samplesToWrite, int numSamples) override;
 
+	/** Appends a block that was encoded with HlacEncoder::encodeSingleBlock() using the same options. */
+	bool writeEncodedBlock(const HlacEncoder::EncodedBlock& block);
+
+	const HlacEncoder::CompressorOptions& getOptions() const { return options; }
+
 	double getCompressionRatioForLastFile() { return encoder.getCompressionRatio(); }
 
 	/** You can use a temporary file instead of the memory buffer if you encode large files. */
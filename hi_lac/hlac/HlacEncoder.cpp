@@ -119,6 +119,41 @@ void HlacEncoder::compress(AudioSampleBuffer& source, OutputStream& output, uint
 	
 }
 
+void HlacEncoder::encodeSingleBlock(AudioSampleBuffer& block, EncodedBlock& result)
+{
+	jassert(block.getNumSamples() <= COMPRESSION_BLOCK_SIZE);
+
+	const bool isLastBlock = block.getNumSamples() < COMPRESSION_BLOCK_SIZE;
+	const auto uncompressedBefore = numBytesUncompressed;
+
+	{
+		MemoryOutputStream mos(result.data, false);
+
+		for (int i = 0; i < block.getNumChannels(); i++)
+		{
+			auto c = CompressionHelpers::getPart(block, i, 0, block.getNumSamples());
+
+			if (isLastBlock)
+				encodeLastBlock(c, mos);
+			else
+				encodeBlock(c, mos);
+		}
+	}
+
+	result.numBytesUncompressed = numBytesUncompressed - uncompressedBefore;
+}
+
+bool HlacEncoder::appendEncodedBlock(const EncodedBlock& block, OutputStream& output, uint32* blockOffsetData)
+{
+	blockOffsetData[blockIndex] = numBytesWritten;
+	++blockIndex;
+
+	numBytesWritten += (uint32)block.data.getSize();
+	numBytesUncompressed += block.numBytesUncompressed;
+
+	return output.write(block.data.getData(), block.data.getSize());
+}
+
 void HlacEncoder::reset()
 {
 	indexInBlock = 0;
@@ -165,7 +200,7 @@ bool HlacEncoder::encodeBlock(CompressionHelpers::AudioBufferInt16& block16, Out
 	auto compressedBlock = createCompressedBlock(block16);
 	auto thisBlockSize = compressedBlock.getSize();
 
-	writeChecksumBytesForBlock(output);
+	writeChecksumBytesForBlock(block16, output);
 	
 	if (thisBlockSize > 2 * COMPRESSION_BLOCK_SIZE)
 	{
@@ -332,10 +367,17 @@ uint8 HlacEncoder::getBitReductionAmountForMSEncoding(AudioSampleBuffer& block)
 }
 
 
-bool HlacEncoder::writeChecksumBytesForBlock(OutputStream& output)
+bool HlacEncoder::writeChecksumBytesForBlock(const CompressionHelpers::AudioBufferInt16& block, OutputStream& output)
 {
-	
-	auto checkSum = CompressionHelpers::Misc::createChecksum();
+	// The checksum is derived from the block content so that encoding the same 
+	// data always creates the same file (regardless of the block position).
+	uint32 seed = 2166136261u;
+	auto data = block.getReadPointer();
+
+	for (int i = 0; i < block.size; i++)
+		seed = (seed ^ (uint16)data[i]) * 16777619u;
+
+	auto checkSum = CompressionHelpers::Misc::createChecksum(seed);
 
 	if (!output.writeInt((int)checkSum))
 		return false;
@@ -445,7 +487,7 @@ bool HlacEncoder::encodeDiff(CompressionHelpers::AudioBufferInt16& cycle, Output
 	if (numBytesForFull > 0)
 	{
 		MemoryBlock mbFull;
-		mbFull.setSize(numBytesForFull);
+		mbFull.setSize(numBytesForFull, true);
 		compressorFull->compress((uint8*)mbFull.getData(), packedBuffer.getReadPointer(), numFullValues);
 
 		if (!output.write(mbFull.getData(), numBytesForFull))
@@ -457,7 +499,7 @@ bool HlacEncoder::encodeDiff(CompressionHelpers::AudioBufferInt16& cycle, Output
 	if (numBytesForError > 0)
 	{
 		MemoryBlock mbError;
-		mbError.setSize(numBytesForError);
+		mbError.setSize(numBytesForError, true);
 		compressorError->compress((uint8*)mbError.getData(), packedErrorBuffer.getReadPointer(), numErrorValues);
 
 		
@@ -538,7 +580,7 @@ void HlacEncoder::encodeLastBlock(AudioSampleBuffer& block, OutputStream& output
 	CompressionHelpers::AudioBufferInt16 a(block, 0, options.normalisationMode, options.normalisationThreshold);
 
 	normaliseBlockAndAddHeader(a, output);
-	writeChecksumBytesForBlock(output);
+	writeChecksumBytesForBlock(a, output);
 	
 	MemoryOutputStream lastTemp;
 
@@ -129,6 +129,24 @@ public:
 
 
 	void compress(AudioSampleBuffer& source, OutputStream& output, uint32* blockOffsetData);
+
+	/** A block of all channels that was encoded with encodeSingleBlock(). */
+	struct EncodedBlock
+	{
+		MemoryBlock data;
+		uint32 numBytesUncompressed = 0;
+	};
+
+	/** Encodes a single block and stores the bytes that compress() would write for it.
+	*
+	*	The block must contain COMPRESSION_BLOCK_SIZE samples (or less if it's the last block of a file). 
+	*	This only uses the scratch buffers of this encoder, so you can encode multiple blocks in parallel 
+	*	with one encoder per thread and append them in the correct order with appendEncodedBlock().
+	*/
+	void encodeSingleBlock(AudioSampleBuffer& block, EncodedBlock& result);
+
+	/** Writes a block that was encoded by encodeSingleBlock() and adds it to the block offset table. */
+	bool appendEncodedBlock(const EncodedBlock& block, OutputStream& output, uint32* blockOffsetData);
 	
 	void reset();
 
@@ -158,7 +176,7 @@ private:
 		return indexInBlock >= COMPRESSION_BLOCK_SIZE;
 	}
 
-	bool writeChecksumBytesForBlock(OutputStream& output);
+	bool writeChecksumBytesForBlock(const CompressionHelpers::AudioBufferInt16& block, OutputStream& output);
 
 	bool writeNormalisationAmount(OutputStream& output);
 
@@ -0,0 +1,294 @@
+/*  ===========================================================================
+ *
+ *   This file is part of HISE.
+ *   Copyright 2016 Christoph Hart
+ *
+ *   HISE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   HISE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Commercial licenses for using HISE in an closed source project are
+ *   available on request. Please visit the project's website to get more
+ *   information about commercial licensing:
+ *
+ *   http://www.hise.audio/
+ *
+ *   HISE is based on the JUCE library,
+ *   which must be separately licensed for closed source applications:
+ *
+ *   http://www.juce.com
+ *
+ *   ===========================================================================
+ */
+
+
+namespace hlac { using namespace juce; 
+
+HlacParallelEncoder::HlacParallelEncoder(AudioFormatManager& afm_, const Array<File>& filesToEncode, int numChannels_, 
+										 const HlacEncoder::CompressorOptions& options_, int numThreads) :
+	afm(afm_),
+	files(filesToEncode),
+	numChannels(numChannels_),
+	options(options_),
+	maxNumJobsInFlight(numThreads * 4),
+	pool(numThreads)
+{
+	// The uncompressed mode doesn't use blocks
+	jassert(options.useCompression);
+}
+
+HlacParallelEncoder::~HlacParallelEncoder()
+{
+	pool.removeAllJobs(true, 5000);
+	pendingJobs.clear();
+}
+
+Result HlacParallelEncoder::writeFile(int fileIndex, HiseLosslessAudioFormatWriter& writer)
+{
+	scheduleJobs();
+
+	while (!pendingJobs.empty() && pendingJobs.front()->fileIndex <= fileIndex)
+	{
+		std::unique_ptr<Job> job(pendingJobs.front().release());
+		pendingJobs.pop_front();
+
+		// Keep the pool busy while this thread is waiting
+		scheduleJobs();
+
+		pool.waitForJobToFinish(job.get(), -1);
+
+		if (job->fileIndex < fileIndex)
+		{
+			// You need to call this for every file
+			jassertfalse;
+			continue;
+		}
+
+		if (!job->ok)
+			return Result::fail("Could not read the source file " + files[fileIndex].getFullPathName());
+
+		for (const auto& b : job->blocks)
+		{
+			if (!writer.writeEncodedBlock(b))
+				return Result::fail("Could not write the encoded data");
+		}
+	}
+
+	return Result::ok();
+}
+
+void HlacParallelEncoder::scheduleJobs()
+{
+	while ((int)pendingJobs.size() < maxNumJobsInFlight)
+	{
+		if (nextSegmentStart >= scheduledFileLength)
+		{
+			if (nextFileToSchedule >= files.size())
+				return;
+
+			const int fileIndex = nextFileToSchedule++;
+
+			nextSegmentStart = 0;
+			scheduledFileLength = 0;
+
+			if (ScopedPointer<AudioFormatReader> reader = afm.createReaderFor(files[fileIndex]))
+				scheduledFileLength = reader->lengthInSamples;
+			else
+			{
+				// Add an empty job so that writeFile() reports the error at the right position
+				pendingJobs.emplace_back(new Job(*this, fileIndex, 0, -1));
+				pool.addJob(pendingJobs.back().get(), false);
+			}
+
+			continue;
+		}
+
+		const auto numThisTime = jmin<int64>(NumSamplesPerSegment, scheduledFileLength - nextSegmentStart);
+		pendingJobs.emplace_back(new Job(*this, nextFileToSchedule - 1, nextSegmentStart, numThisTime));
+		pool.addJob(pendingJobs.back().get(), false);
+
+		nextSegmentStart += numThisTime;
+	}
+}
+
+HlacParallelEncoder::Job::Job(HlacParallelEncoder& parent_, int fileIndex_, int64 startSample_, int64 numSamples_) :
+	ThreadPoolJob("HLAC Encoder"),
+	parent(parent_),
+	fileIndex(fileIndex_),
+	startSample(startSample_),
+	numSamples(numSamples_)
+{}
+
+ThreadPoolJob::JobStatus HlacParallelEncoder::Job::runJob()
+{
+	ScopedPointer<AudioFormatReader> reader = parent.afm.createReaderFor(parent.files[fileIndex]);
+
+	if (reader == nullptr || numSamples < 0)
+		return jobHasFinished;
+
+	HlacEncoder encoder;
+	auto optionsCopy = parent.options;
+	encoder.setOptions(optionsCopy);
+
+	// This replicates AudioFormatWriter::writeFromAudioReader() for a float writer
+	const int bufferSize = 16384;
+	AudioBuffer<float> tempBuffer(parent.numChannels, bufferSize);
+
+	int* buffers[128] = { nullptr };
+
+	for (int i = tempBuffer.getNumChannels(); --i >= 0;)
+		buffers[i] = reinterpret_cast<int*>(tempBuffer.getWritePointer(i, 0));
+
+	blocks.reserve((size_t)((numSamples + COMPRESSION_BLOCK_SIZE - 1) / COMPRESSION_BLOCK_SIZE));
+
+	int64 numSamplesToRead = numSamples;
+	int64 pos = startSample;
+
+	while (numSamplesToRead > 0)
+	{
+		if (shouldExit())
+			return jobHasFinished;
+
+		const int numToDo = (int)jmin(numSamplesToRead, (int64)bufferSize);
+
+		if (!reader->read(buffers, parent.numChannels, pos, numToDo, false))
+			return jobHasFinished;
+
+		if (!reader->usesFloatingPointData)
+		{
+			constexpr auto scaleFactor = 1.0f / static_cast<float> (0x7fffffff);
+
+			for (int i = 0; i < parent.numChannels; i++)
+				FloatVectorOperations::convertFixedToFloat((float*)buffers[i], (int*)buffers[i], scaleFactor, numToDo);
+		}
+
+		for (int offset = 0; offset < numToDo; offset += COMPRESSION_BLOCK_SIZE)
+		{
+			const int numInBlock = jmin(COMPRESSION_BLOCK_SIZE, numToDo - offset);
+
+			AudioSampleBuffer block(tempBuffer.getArrayOfWritePointers(), parent.numChannels, offset, numInBlock);
+
+			blocks.emplace_back();
+			encoder.encodeSingleBlock(block, blocks.back());
+		}
+
+		numSamplesToRead -= numToDo;
+		pos += numToDo;
+	}
+
+	ok = true;
+	return jobHasFinished;
+}
+
+#if HI_RUN_UNIT_TESTS
+
+struct HlacParallelEncoderTest : public UnitTest
+{
+	HlacParallelEncoderTest() :
+		UnitTest("Testing the parallel HLAC encoder", "hlac")
+	{}
+
+	void runTest() override
+	{
+		afm.registerBasicFormats();
+
+		auto dir = File::getSpecialLocation(File::tempDirectory).getNonexistentChildFile("hlac_encoder_test", "");
+		dir.createDirectory();
+
+		for (int numChannels = 1; numChannels <= 2; numChannels++)
+		{
+			beginTest("Compare serial and parallel encoding with " + String(numChannels) + " channels");
+
+			// The last file has more segments than the number of jobs in flight
+			const int64 lengths[] = { 44100, 1, 3 * HlacParallelEncoder::NumSamplesPerSegment, 100000, 
+									  9 * HlacParallelEncoder::NumSamplesPerSegment + 1234 };
+
+			Array<File> files;
+
+			for (auto l : lengths)
+				files.add(createTestFile(dir, numChannels, (int)l, files.size() % 2 == 0 ? 16 : 24));
+
+			auto serial = encode(files, numChannels, false);
+			auto parallel = encode(files, numChannels, true);
+
+			expect(serial.getSize() > 0, "nothing was written");
+			expect(serial == parallel, "parallel encoding doesn't match the serial encoding");
+		}
+
+		dir.deleteRecursively();
+	}
+
+	File createTestFile(const File& dir, int numChannels, int numSamples, int bitDepth)
+	{
+		AudioSampleBuffer b(numChannels, numSamples);
+
+		for (int c = 0; c < numChannels; c++)
+		{
+			for (int i = 0; i < numSamples; i++)
+				b.setSample(c, i, 0.5f * std::sin((float)i * 0.01f * (float)(c + 1)) + 0.01f * (r.nextFloat() - 0.5f));
+		}
+
+		auto f = dir.getNonexistentChildFile("test", ".wav");
+
+		WavAudioFormat wav;
+		ScopedPointer<AudioFormatWriter> w = wav.createWriterFor(new FileOutputStream(f), 44100.0, numChannels, bitDepth, {}, 0);
+		w->writeFromAudioSampleBuffer(b, 0, numSamples);
+
+		return f;
+	}
+
+	MemoryBlock encode(const Array<File>& files, int numChannels, bool useParallelEncoder)
+	{
+		MemoryBlock mb;
+
+		auto options = HlacEncoder::CompressorOptions::getPreset(HlacEncoder::CompressorOptions::Presets::Diff);
+		options.applyDithering = false;
+
+		HiseLosslessAudioFormat hlac;
+		StringPairArray empty;
+		ScopedPointer<AudioFormatWriter> w = hlac.createWriterFor(new MemoryOutputStream(mb, false), 44100.0, numChannels, 16, empty, 5);
+
+		auto hw = dynamic_cast<HiseLosslessAudioFormatWriter*>(w.get());
+		hw->setOptions(options);
+
+		if (useParallelEncoder)
+		{
+			// Use a small number of threads so that the jobs of a file are scheduled in multiple steps
+			HlacParallelEncoder pe(afm, files, numChannels, options, 2);
+
+			for (int i = 0; i < files.size(); i++)
+				expect(pe.writeFile(i, *hw).wasOk(), "error at file " + String(i));
+		}
+		else
+		{
+			for (auto f : files)
+			{
+				ScopedPointer<AudioFormatReader> reader = afm.createReaderFor(f);
+				w->writeFromAudioReader(*reader, 0, -1);
+			}
+		}
+
+		w->flush();
+		w = nullptr;
+
+		return mb;
+	}
+
+	AudioFormatManager afm;
+	Random r = Random(42);
+};
+
+static HlacParallelEncoderTest hlacParallelEncoderTest;
+
+#endif
+
+} // namespace hlac
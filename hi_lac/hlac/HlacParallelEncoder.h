@@ -0,0 +1,105 @@
+/*  ===========================================================================
+ *
+ *   This file is part of HISE.
+ *   Copyright 2016 Christoph Hart
+ *
+ *   HISE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   HISE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Commercial licenses for using HISE in an closed source project are
+ *   available on request. Please visit the project's website to get more
+ *   information about commercial licensing:
+ *
+ *   http://www.hise.audio/
+ *
+ *   HISE is based on the JUCE library,
+ *   which must be separately licensed for closed source applications:
+ *
+ *   http://www.juce.com
+ *
+ *   ===========================================================================
+ */
+
+
+#ifndef HLACPARALLELENCODER_H_INCLUDED
+#define HLACPARALLELENCODER_H_INCLUDED
+
+namespace hlac { using namespace juce; 
+
+/** Encodes a list of audio files into a HiseLosslessAudioFormatWriter using multiple threads.
+
+	The files are split into segments which are decoded and encoded block by block on a thread pool 
+	(each job uses its own HlacEncoder). writeFile() then appends the blocks to the writer in the original 
+	order, so the result is byte-identical to calling writeFromAudioReader() for each file one after another.
+	
+	The jobs are scheduled ahead of the file that is currently written, with a limit on the number of segments
+	that are kept in memory.
+*/
+class HlacParallelEncoder
+{
+public:
+
+	/** The number of samples per job. This must be a multiple of the buffer size of writeFromAudioReader() (16384)
+	    so that the files are read in exactly the same chunks. */
+	static constexpr int NumSamplesPerSegment = 16 * COMPRESSION_BLOCK_SIZE;
+
+	HlacParallelEncoder(AudioFormatManager& afm, const Array<File>& filesToEncode, int numChannels, 
+						const HlacEncoder::CompressorOptions& options, int numThreads = jmax(1, SystemStats::getNumCpus() - 1));
+
+	~HlacParallelEncoder();
+
+	/** Waits until all blocks of the file are encoded and writes them to the given writer. 
+	
+		You need to call this for every file in ascending order. */
+	Result writeFile(int fileIndex, HiseLosslessAudioFormatWriter& writer);
+
+private:
+
+	struct Job : public ThreadPoolJob
+	{
+		Job(HlacParallelEncoder& parent_, int fileIndex_, int64 startSample_, int64 numSamples_);
+
+		JobStatus runJob() override;
+
+		HlacParallelEncoder& parent;
+		const int fileIndex;
+		const int64 startSample;
+		const int64 numSamples;
+
+		std::vector<HlacEncoder::EncodedBlock> blocks;
+		bool ok = false;
+	};
+
+	void scheduleJobs();
+
+	AudioFormatManager& afm;
+	const Array<File> files;
+	const int numChannels;
+	const HlacEncoder::CompressorOptions options;
+	const int maxNumJobsInFlight;
+
+	ThreadPool pool;
+
+	int nextFileToSchedule = 0;
+
+	// The segments of a long file might be scheduled over multiple calls to scheduleJobs()
+	int64 nextSegmentStart = 0;
+	int64 scheduledFileLength = 0;
+	std::deque<std::unique_ptr<Job>> pendingJobs;
+
+	JUCE_DECLARE_NON_COPYABLE(HlacParallelEncoder);
+};
+
+} // namespace hlac
+
+#endif  // HLACPARALLELENCODER_H_INCLUDED
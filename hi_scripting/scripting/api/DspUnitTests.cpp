@@ -1941,5 +1941,94 @@ private:
 static CustomContainerTest unorderedStackTest;
 
 
+class ScriptEngineTests : public UnitTest
+{
+public:
+
+	ScriptEngineTests() :
+		UnitTest("Testing the script engine", "scripting")
+	{}
+
+	void runTest() override
+	{
+		ScopedPointer<BackendProcessor> bp = new BackendProcessor(nullptr, nullptr);
+
+		{
+			ScopedPointer<JavascriptMidiProcessor> jp = new JavascriptMidiProcessor(bp, "scripter");
+			ScopedPointer<DelayEffect> delay = new DelayEffect(bp, "delay");
+			ScopedPointer<SimpleReverbEffect> reverb = new SimpleReverbEffect(bp, "reverb");
+
+			{
+				HiseJavascriptEngine engine(jp, bp);
+
+				var delayHandle(new ScriptingObjects::ScriptingEffect(jp, delay));
+				var reverbHandle(new ScriptingObjects::ScriptingEffect(jp, reverb));
+
+				testInlineCacheWithInstanceConstants(engine, delayHandle, reverbHandle);
+				benchmarkDotOperator(engine, reverbHandle);
+			}
+		}
+
+		bp = nullptr;
+	}
+
+private:
+
+	void expectResult(Result r, String errorMessage)
+	{
+		expect(r.wasOk(), errorMessage + " - " + r.getErrorMessage());
+	}
+
+	var call(HiseJavascriptEngine& engine, const Identifier& f, var a1, var a2={})
+	{
+		var args[2] = { a1, a2 };
+		Result r = Result::ok();
+		auto rv = engine.callFunction(f, var::NativeFunctionArgs(var(), args, 2), &r);
+		expectResult(r, "Calling " + f.toString());
+		return rv;
+	}
+
+	void testInlineCacheWithInstanceConstants(HiseJavascriptEngine& engine, var delayHandle, var reverbHandle)
+	{
+		beginTest("Testing inline cache with different module handles");
+
+		// Both handles have the same C++ type but different parameter constants
+		expectResult(engine.execute("function getRoomSize(fx) { return fx.RoomSize; }\n"
+									"function getDelayTime(fx) { return fx.DelayTimeLeft; }"), "compile");
+
+		expect(call(engine, "getRoomSize", delayHandle).isUndefined(), "missing constant");
+		expectEquals<int>(call(engine, "getRoomSize", reverbHandle), SimpleReverbEffect::RoomSize, "constant after missing constant");
+		expect(call(engine, "getRoomSize", delayHandle).isUndefined(), "missing constant after constant");
+
+		expectEquals<int>(call(engine, "getDelayTime", delayHandle), DelayEffect::DelayTimeLeft, "constant");
+		expect(call(engine, "getDelayTime", reverbHandle).isUndefined(), "missing constant after constant");
+		expectEquals<int>(call(engine, "getDelayTime", delayHandle), DelayEffect::DelayTimeLeft, "constant after missing constant");
+	}
+
+	void benchmarkDotOperator(HiseJavascriptEngine& engine, var reverbHandle)
+	{
+		beginTest("Benchmarking dot operator lookups");
+
+		expectResult(engine.execute("const var obj = { a: 1, b: 2, c: 3, d: 4 };\n"
+									"function readConstant(fx, n) { var sum = 0; for(i = 0; i < n; i++) sum += fx.RoomSize; return sum; }\n"
+									"function readProperty(unused, n) { var sum = 0; for(i = 0; i < n; i++) sum += obj.d; return sum; }\n"
+									"function callMethod(fx, n) { var sum = 0; for(i = 0; i < n; i++) sum += fx.getAttribute(0); return sum; }"), "compile");
+
+		static constexpr int NumIterations = 100000;
+
+		for (auto f : { "readConstant", "readProperty", "callMethod" })
+		{
+			auto start = Time::getMillisecondCounterHiRes();
+			call(engine, f, reverbHandle, NumIterations);
+			auto delta = Time::getMillisecondCounterHiRes() - start;
+
+			logMessage(String(f) + ": " + String(delta * 1000000.0 / (double)NumIterations, 1) + " ns per iteration");
+		}
+	}
+};
+
+static ScriptEngineTests scriptEngineTests;
+
+
 
 #endif
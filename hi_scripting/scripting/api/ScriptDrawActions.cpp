@@ -220,55 +220,6 @@ struct ScriptedPostDrawActions
 
 namespace ScriptedDrawActions
 {
-	struct fillAll : public DrawActions::ActionBase
-	{
-		SET_ACTION_ID(fillAll);
-
-		fillAll(Colour c_) : c(c_) {};
-		void perform(Graphics& g) { g.fillAll(c); };
-		Colour c;
-	};
-
-	struct setColour : public DrawActions::ActionBase
-	{
-		SET_ACTION_ID(setColour);
-
-		setColour(Colour c_) : c(c_) {};
-		void perform(Graphics& g) { g.setColour(c); };
-		Colour c;
-	};
-
-	struct addTransform : public DrawActions::ActionBase
-	{
-		SET_ACTION_ID(addTransform);
-
-		addTransform(AffineTransform a_) : a(a_) {};
-		void perform(Graphics& g) override { g.addTransform(a); };
-		AffineTransform a;
-	};
-
-	struct fillPath : public DrawActions::ActionBase
-	{
-		SET_ACTION_ID(fillPath);
-
-		fillPath(const Path& p_) : p(p_) {};
-		void perform(Graphics& g) override { g.fillPath(p); };
-		Path p;
-	};
-
-	struct drawPath : public DrawActions::ActionBase
-	{
-		SET_ACTION_ID(drawPath);
-
-		drawPath(const Path& p_, PathStrokeType strokeType) : p(p_), s(strokeType) {};
-		void perform(Graphics& g) override
-		{
-			g.strokePath(p, s);
-		}
-		Path p;
-		PathStrokeType s;
-	};
-
 	struct drawRepaintMarker: public DrawActions::ActionBase
 	{
 		SET_ACTION_ID(drawRepaintMarker);
@@ -296,102 +247,6 @@ namespace ScriptedDrawActions
 		uint32 numRepaints = 0;
 	};
 
-	struct fillRect : public DrawActions::ActionBase
-	{
-		SET_ACTION_ID(fillRect);
-
-		fillRect(Rectangle<float> area_) : area(area_) {};
-		void perform(Graphics& g) { g.fillRect(area); };
-		Rectangle<float> area;
-	};
-
-	struct fillEllipse : public DrawActions::ActionBase
-	{
-		SET_ACTION_ID(fillEllipse);
-
-		fillEllipse(Rectangle<float> area_) : area(area_) {};
-		void perform(Graphics& g) { g.fillEllipse(area); };
-		Rectangle<float> area;
-	};
-
-	struct drawRect : public DrawActions::ActionBase
-	{
-		SET_ACTION_ID(drawRect);
-
-		drawRect(Rectangle<float> area_, float borderSize_) : area(area_), borderSize(borderSize_) {};
-		void perform(Graphics& g) { g.drawRect(area, borderSize); };
-		Rectangle<float> area;
-		float borderSize;
-	};
-
-	struct drawEllipse : public DrawActions::ActionBase
-	{
-		SET_ACTION_ID(drawEllipse);
-
-		drawEllipse(Rectangle<float> area_, float borderSize_) : area(area_), borderSize(borderSize_) {};
-		void perform(Graphics& g) { g.drawEllipse(area, borderSize); };
-		Rectangle<float> area;
-		float borderSize;
-	};
-
-	struct fillRoundedRect : public DrawActions::ActionBase
-	{
-		SET_ACTION_ID(fillRoundedRect);
-
-		fillRoundedRect(Rectangle<float> area_, float cornerSize_) :
-			area(area_), cornerSize(cornerSize_) {};
-		void perform(Graphics& g) 
-		{ 
-			if(allRounded)
-				g.fillRoundedRectangle(area, cornerSize); 
-			else if (!rounded[0] && !rounded[1] && !rounded[2] && !rounded[3])
-				g.fillRect(area);
-			else
-			{
-				Path p;
-				p.addRoundedRectangle(area.getX(), area.getY(), area.getWidth(), area.getHeight(), 
-									  cornerSize, cornerSize, 
-									  rounded[0], rounded[1], rounded[2], rounded[3]);
-
-				g.fillPath(p);
-			}
-		};
-		Rectangle<float> area;
-		float cornerSize;
-
-		bool allRounded = true;
-		bool rounded[4] = { true, true, true, true };
-	};
-
-	struct drawRoundedRectangle : public DrawActions::ActionBase
-	{
-		SET_ACTION_ID(drawRoundedRectangle);
-
-		drawRoundedRectangle(Rectangle<float> area_, float borderSize_, float cornerSize_) :
-			area(area_), borderSize(borderSize_), cornerSize(cornerSize_) {};
-		void perform(Graphics& g) 
-		{ 
-			if(allRounded)
-				g.drawRoundedRectangle(area, cornerSize, borderSize); 
-			else if (!rounded[0] && !rounded[1] && !rounded[2] && !rounded[3])
-				g.drawRect(area, borderSize);
-			else
-			{
-				Path p;
-				p.addRoundedRectangle(area.getX(), area.getY(), area.getWidth(), area.getHeight(),
-					cornerSize, cornerSize,
-					rounded[0], rounded[1], rounded[2], rounded[3]);
-
-				g.strokePath(p, PathStrokeType(borderSize));
-			}
-		};
-		Rectangle<float> area;
-		float cornerSize, borderSize;
-
-		bool allRounded = true;
-		bool rounded[4] = { true, true, true, true };
-	};
-
 	struct drawFFTSpectrum: public DrawActions::ActionBase
 	{
 		SET_ACTION_ID(drawFFTSpectrum);
@@ -450,73 +305,20 @@ namespace ScriptedDrawActions
 		int yOffset;
 	};
 
-	struct drawHorizontalLine : public DrawActions::ActionBase
-	{
-		SET_ACTION_ID(drawHorizontalLine);
-
-		drawHorizontalLine(int y_, float x1_, float x2_) :
-			y(y_), x1(x1_), x2(x2_) {};
-		void perform(Graphics& g) { g.drawHorizontalLine(y, x1, x2); };
-		int y; float x1; float x2;
-	};
-
-	struct drawVerticalLine : public DrawActions::ActionBase
-	{
-		SET_ACTION_ID(drawVerticalLine);
-
-		drawVerticalLine(int x_, float y1_, float y2_) :
-			x(x_), y1(y1_), y2(y2_) {};
-		void perform(Graphics& g) { g.drawVerticalLine(x, y1, y2); };
-		int x; float y1; float y2;
-	};
-
-	struct setOpacity : public DrawActions::ActionBase
-	{
-		SET_ACTION_ID(setOpacity);
-
-		setOpacity(float alpha_) :
-			alpha(alpha_) {};
-		void perform(Graphics& g) { g.setOpacity(alpha); };
-		float alpha;
-	};
-
-	struct drawLine : public DrawActions::ActionBase
-	{
-		SET_ACTION_ID(drawLine);
-
-		drawLine(float x1_, float x2_, float y1_, float y2_, float lineThickness_) :
-			x1(x1_), x2(x2_), y1(y1_), y2(y2_), lineThickness(lineThickness_) {};
-		void perform(Graphics& g) { g.drawLine(x1, x2, y1, y2, lineThickness); };
-		float x1, x2, y1, y2, lineThickness;
-	};
-
-	struct setFont : public DrawActions::ActionBase
-	{
-		SET_ACTION_ID(setFont);
-
-		setFont(Font f_) : f(f_) {};
-		void perform(Graphics& g) { g.setFont(f); };
-		Font f;
-	};
-
 	struct setGradientFill : public DrawActions::ActionBase
 	{
 		SET_ACTION_ID(setGradientFill);
 
 		setGradientFill(ColourGradient grad_) : grad(grad_) {};
 		void perform(Graphics& g) { g.setGradientFill(grad); };
-		ColourGradient grad;
-	};
 
-	struct drawText : public DrawActions::ActionBase
-	{
-		SET_ACTION_ID(drawText);
+		bool isEqual(const ActionBase& other) const override
+		{
+			auto o = dynamic_cast<const setGradientFill*>(&other);
+			return o != nullptr && o->grad == grad;
+		}
 
-		drawText(const String& text_, Rectangle<float> area_, Justification j_ = Justification::centred) : text(text_), area(area_), j(j_) {};
-		void perform(Graphics& g) override { g.drawText(text, area, j); };
-		String text;
-		Rectangle<float> area;
-		Justification j;
+		ColourGradient grad;
 	};
 
 	struct drawTextShadow : public DrawActions::ActionBase
@@ -580,6 +382,18 @@ namespace ScriptedDrawActions
 
 		drawDropShadow(Rectangle<int> r_, DropShadow& shadow_) : r(r_), shadow(shadow_) {};
 		void perform(Graphics& g) override { shadow.drawForRectangle(g, r); };
+
+		bool isEqual(const ActionBase& other) const override
+		{
+			auto o = dynamic_cast<const drawDropShadow*>(&other);
+			return o != nullptr && o->r == r && isSameShadow(o->shadow, shadow);
+		}
+
+		static bool isSameShadow(const DropShadow& a, const DropShadow& b)
+		{
+			return a.colour == b.colour && a.radius == b.radius && a.offset == b.offset;
+		}
+
 		Rectangle<int> r;
 		DropShadow shadow;
 	};
@@ -619,6 +433,12 @@ namespace ScriptedDrawActions
 			g.restoreState();
 		}
 
+		bool isEqual(const ActionBase& other) const override
+		{
+			auto o = dynamic_cast<const addDropShadowFromAlpha*>(&other);
+			return o != nullptr && drawDropShadow::isSameShadow(o->shadow, shadow);
+		}
+
 		DropShadow shadow;
 	};
 
@@ -659,6 +479,12 @@ namespace ScriptedDrawActions
 #endif
 		}
 
+		bool isEqual(const ActionBase& other) const override
+		{
+			auto o = dynamic_cast<const drawDropShadowFromPath*>(&other);
+			return o != nullptr && o->area == area && o->c == c && o->radius == radius && o->p == p;
+		}
+
         // Soon...
 		//melatonin::DropShadow shadow;
 
@@ -1858,47 +1858,49 @@ void ScriptingObjects::GraphicsObject::applyMask(var path, var area, bool invert
 void ScriptingObjects::GraphicsObject::fillAll(var colour)
 {
 	Colour c = ScriptingApi::Content::Helpers::getCleanedObjectColour(colour);
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::fillAll(c));
+	drawActionHandler.addCommand(DrawActions::Command::fillAll(c));
 }
 
 void ScriptingObjects::GraphicsObject::fillRect(var area)
 {
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::fillRect(getRectangleFromVar(area)));
+	drawActionHandler.addCommand(DrawActions::Command::fillRect(getRectangleFromVar(area)));
 }
 
 void ScriptingObjects::GraphicsObject::drawRect(var area, float borderSize)
 {
 	auto bs = (float)borderSize;
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::drawRect(getRectangleFromVar(area), SANITIZED(bs)));
+	drawActionHandler.addCommand(DrawActions::Command::drawRect(getRectangleFromVar(area), SANITIZED(bs)));
 }
 
-void ScriptingObjects::GraphicsObject::fillRoundedRectangle(var area, var cornerData)
+/** Returns the corner flags from the "Rounded" array of the corner data object. */
+static int getRoundedCorners(const var& cornerData)
 {
-	if (cornerData.isObject())
-	{
-		auto cs = (float)cornerData["CornerSize"];
-		cs = SANITIZED(cs);
+	using Command = DrawActions::Command;
 
-		auto newAction = new ScriptedDrawActions::fillRoundedRect(getRectangleFromVar(area), cs);
-		auto ra = cornerData["Rounded"];
+	auto ra = cornerData["Rounded"];
 
-		if (ra.isArray())
-		{
-			newAction->allRounded = false;
-			newAction->rounded[0] = ra[0];
-			newAction->rounded[1] = ra[1];
-			newAction->rounded[2] = ra[2];
-			newAction->rounded[3] = ra[3];
-		}
+	if (!ra.isArray())
+		return Command::AllCorners;
 
-		drawActionHandler.addDrawAction(newAction);
-	}
-	else
-	{
-		auto cs = (float)cornerData;
-		cs = SANITIZED(cs);
-		drawActionHandler.addDrawAction(new ScriptedDrawActions::fillRoundedRect(getRectangleFromVar(area), cs));
-	}
+	int corners = 0;
+
+	if ((bool)ra[0]) corners |= Command::TopLeft;
+	if ((bool)ra[1]) corners |= Command::TopRight;
+	if ((bool)ra[2]) corners |= Command::BottomLeft;
+	if ((bool)ra[3]) corners |= Command::BottomRight;
+
+	return corners;
+}
+
+void ScriptingObjects::GraphicsObject::fillRoundedRectangle(var area, var cornerData)
+{
+	auto isObject = cornerData.isObject();
+	auto cs = isObject ? (float)cornerData["CornerSize"] : (float)cornerData;
+	cs = SANITIZED(cs);
+
+	auto corners = isObject ? getRoundedCorners(cornerData) : (int)DrawActions::Command::AllCorners;
+
+	drawActionHandler.addCommand(DrawActions::Command::fillRoundedRect(getRectangleFromVar(area), cs, corners));
 }
 
 void ScriptingObjects::GraphicsObject::drawRoundedRectangle(var area, var cornerData, float borderSize)
@@ -1906,58 +1908,40 @@ void ScriptingObjects::GraphicsObject::drawRoundedRectangle(var area, var corner
 	auto bs = SANITIZED(borderSize);
 	auto ar = getRectangleFromVar(area);
 
-	if (cornerData.isObject())
-	{
-		auto cs = (float)cornerData["CornerSize"];
-		cs = SANITIZED(cs);
-
-		auto newAction = new ScriptedDrawActions::drawRoundedRectangle(getRectangleFromVar(area), borderSize, cs);
-		auto ra = cornerData["Rounded"];
+	auto isObject = cornerData.isObject();
+	auto cs = isObject ? (float)cornerData["CornerSize"] : (float)cornerData;
+	cs = SANITIZED(cs);
 
-		if (ra.isArray())
-		{
-			newAction->allRounded = false;
-			newAction->rounded[0] = ra[0];
-			newAction->rounded[1] = ra[1];
-			newAction->rounded[2] = ra[2];
-			newAction->rounded[3] = ra[3];
-		}
+	auto corners = isObject ? getRoundedCorners(cornerData) : (int)DrawActions::Command::AllCorners;
 
-		drawActionHandler.addDrawAction(newAction);
-	}
-	else
-	{
-		auto cs = (float)cornerData;
-		cs = SANITIZED(cs);
-		drawActionHandler.addDrawAction(new ScriptedDrawActions::drawRoundedRectangle(ar, bs, cs));
-	}
+	drawActionHandler.addCommand(DrawActions::Command::drawRoundedRect(ar, cs, bs, corners));
 }
 
 void ScriptingObjects::GraphicsObject::drawHorizontalLine(int y, float x1, float x2)
 {
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::drawHorizontalLine(y, SANITIZED(x1), SANITIZED(x2)));
+	drawActionHandler.addCommand(DrawActions::Command::drawHorizontalLine(y, SANITIZED(x1), SANITIZED(x2)));
 }
 
 void ScriptingObjects::GraphicsObject::drawVerticalLine(int x, float y1, float y2)
 {
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::drawVerticalLine(x, SANITIZED(y1), SANITIZED(y2)));
+	drawActionHandler.addCommand(DrawActions::Command::drawVerticalLine(x, SANITIZED(y1), SANITIZED(y2)));
 }
 
 void ScriptingObjects::GraphicsObject::setOpacity(float alphaValue)
 {
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::setOpacity(alphaValue));
+	drawActionHandler.addCommand(DrawActions::Command::setOpacity(alphaValue));
 }
 
 void ScriptingObjects::GraphicsObject::drawLine(float x1, float x2, float y1, float y2, float lineThickness)
 {
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::drawLine(
+	drawActionHandler.addCommand(DrawActions::Command::drawLine(
 		SANITIZED(x1), SANITIZED(y1), SANITIZED(x2), SANITIZED(y2), SANITIZED(lineThickness)));
 }
 
 void ScriptingObjects::GraphicsObject::setColour(var colour)
 {
 	auto c = ScriptingApi::Content::Helpers::getCleanedObjectColour(colour);
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::setColour(c));
+	drawActionHandler.addCommand(DrawActions::Command::setColour(c));
 }
 
 void ScriptingObjects::GraphicsObject::setFont(String fontName, float fontSize)
@@ -1968,7 +1952,7 @@ void ScriptingObjects::GraphicsObject::setFont(String fontName, float fontSize)
 	currentFontName = fontName;
 	currentKerningFactor = 0.0f;
 	currentFontHeight = fontSize;
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::setFont(f));
+	drawActionHandler.addCommand(DrawActions::Command::setFont(), f);
 }
 
 void ScriptingObjects::GraphicsObject::setFontWithSpacing(String fontName, float fontSize, float spacing)
@@ -1981,13 +1965,13 @@ void ScriptingObjects::GraphicsObject::setFontWithSpacing(String fontName, float
 	currentFontName = fontName;
 	currentFontHeight = fontSize;
 	currentKerningFactor = spacing;
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::setFont(f));
+	drawActionHandler.addCommand(DrawActions::Command::setFont(), f);
 }
 
 void ScriptingObjects::GraphicsObject::drawText(String text, var area)
 {
 	Rectangle<float> r = getRectangleFromVar(area);
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::drawText(text, r));
+	drawActionHandler.addCommand(DrawActions::Command::drawText(r, Justification::centred), text);
 }
 
 void ScriptingObjects::GraphicsObject::drawAlignedText(String text, var area, String alignment)
@@ -2000,7 +1984,7 @@ void ScriptingObjects::GraphicsObject::drawAlignedText(String text, var area, St
 	if (re.failed())
 		reportScriptError(re.getErrorMessage());
 
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::drawText(text, r, just));
+	drawActionHandler.addCommand(DrawActions::Command::drawText(r, just), text);
 }
 
 void ScriptingObjects::GraphicsObject::drawAlignedTextShadow(String text, var area, String alignment, var shadowData)
@@ -2131,14 +2115,14 @@ void ScriptingObjects::GraphicsObject::setGradientFill(var gradientData)
 
 void ScriptingObjects::GraphicsObject::drawEllipse(var area, float lineThickness)
 {
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::drawEllipse(getRectangleFromVar(area), lineThickness));
+	drawActionHandler.addCommand(DrawActions::Command::drawEllipse(getRectangleFromVar(area), lineThickness));
 }
 
 
 
 void ScriptingObjects::GraphicsObject::fillEllipse(var area)
 {
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::fillEllipse(getRectangleFromVar(area)));
+	drawActionHandler.addCommand(DrawActions::Command::fillEllipse(getRectangleFromVar(area)));
 }
 
 void ScriptingObjects::GraphicsObject::drawImage(String imageName, var area, int /*xOffset*/, int yOffset)
@@ -2170,12 +2154,12 @@ void ScriptingObjects::GraphicsObject::drawImage(String imageName, var area, int
 	}
 	else
 	{
-		drawActionHandler.addDrawAction(new ScriptedDrawActions::setColour(Colours::grey));
-		drawActionHandler.addDrawAction(new ScriptedDrawActions::fillRect(getRectangleFromVar(area)));
-		drawActionHandler.addDrawAction(new ScriptedDrawActions::setColour(Colours::black));
-		drawActionHandler.addDrawAction(new ScriptedDrawActions::drawRect(getRectangleFromVar(area), 1.0f));
-		drawActionHandler.addDrawAction(new ScriptedDrawActions::setFont(GLOBAL_BOLD_FONT()));
-		drawActionHandler.addDrawAction(new ScriptedDrawActions::drawText("XXX", getRectangleFromVar(area), Justification::centred));
+		drawActionHandler.addCommand(DrawActions::Command::setColour(Colours::grey));
+		drawActionHandler.addCommand(DrawActions::Command::fillRect(getRectangleFromVar(area)));
+		drawActionHandler.addCommand(DrawActions::Command::setColour(Colours::black));
+		drawActionHandler.addCommand(DrawActions::Command::drawRect(getRectangleFromVar(area), 1.0f));
+		drawActionHandler.addCommand(DrawActions::Command::setFont(), GLOBAL_BOLD_FONT());
+		drawActionHandler.addCommand(DrawActions::Command::drawText(getRectangleFromVar(area), Justification::centred), String("XXX"));
 
 		debugError(dynamic_cast<Processor*>(getScriptProcessor()), "Image " + imageName + " not found");
 	}
@@ -2221,7 +2205,7 @@ void ScriptingObjects::GraphicsObject::drawTriangle(var area, float angle, float
 	auto r = getRectangleFromVar(area);
 	p.scaleToFit(r.getX(), r.getY(), r.getWidth(), r.getHeight(), false);
 
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::drawPath(p, PathStrokeType(lineThickness)));
+	drawActionHandler.addCommand(DrawActions::Command::strokePath(PathStrokeType(lineThickness)), p);
 }
 
 void ScriptingObjects::GraphicsObject::fillTriangle(var area, float angle)
@@ -2235,7 +2219,7 @@ void ScriptingObjects::GraphicsObject::fillTriangle(var area, float angle)
 	auto r = getRectangleFromVar(area);
 	p.scaleToFit(r.getX(), r.getY(), r.getWidth(), r.getHeight(), false);
 
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::fillPath(p));
+	drawActionHandler.addCommand(DrawActions::Command::fillPath(), p);
 }
 
 void ScriptingObjects::GraphicsObject::addDropShadowFromAlpha(var colour, int radius)
@@ -2286,7 +2270,7 @@ void ScriptingObjects::GraphicsObject::fillPath(var path, var area)
 			p.scaleToFit(r.getX(), r.getY(), r.getWidth(), r.getHeight(), false);
 		}
 
-		drawActionHandler.addDrawAction(new ScriptedDrawActions::fillPath(p));
+		drawActionHandler.addCommand(DrawActions::Command::fillPath(), p);
 	}
 }
 
@@ -2312,7 +2296,7 @@ void ScriptingObjects::GraphicsObject::drawPath(var path, var area, var strokeTy
 
 		auto s = ApiHelpers::createPathStrokeType(strokeType);
 
-		drawActionHandler.addDrawAction(new ScriptedDrawActions::drawPath(p, s));
+		drawActionHandler.addCommand(DrawActions::Command::strokePath(s), p);
 	}
 }
 
@@ -2322,7 +2306,7 @@ void ScriptingObjects::GraphicsObject::rotate(var angleInRadian, var center)
 	auto air = (float)angleInRadian;
 	auto a = AffineTransform::rotation(SANITIZED(air), c.getX(), c.getY());
 
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::addTransform(a));
+	drawActionHandler.addCommand(DrawActions::Command::addTransform(a));
 }
 
 void ScriptingObjects::GraphicsObject::flip(bool horizontally, var area)
@@ -2341,7 +2325,7 @@ void ScriptingObjects::GraphicsObject::flip(bool horizontally, var area)
                             0.0f, -1.0f, (float)r.getHeight());
     }
     
-    drawActionHandler.addDrawAction(new ScriptedDrawActions::addTransform(a));
+    drawActionHandler.addCommand(DrawActions::Command::addTransform(a));
 }
 
 
@@ -2700,23 +2684,9 @@ bool ScriptingObjects::ScriptedLookAndFeel::callWithGraphics(Graphics& g_, const
 		DrawActions::Handler::Iterator it(&g->getDrawHandler());
 
 		if (c != nullptr)
-		{
 			it.render(g_, c);
-		}
 		else
-		{
-			while (auto action = it.getNextAction())
-			{
-#if PERFETTO
-			dispatch::StringBuilder b;
-			b << "g." << action->getDispatchId() << "()";
-			TRACE_EVENT("drawactions", DYNAMIC_STRING_BUILDER(b));
-#endif
-
-				action->perform(g_);
-			}
-				
-		}
+			it.perform(g_);
         
 		return true;
 	}
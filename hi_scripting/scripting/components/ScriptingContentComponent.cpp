@@ -989,10 +989,7 @@ juce::ScaledImage ScriptContentComponent::ComponentDragInfo::getDragImage(bool r
 	Graphics g(img_);
 	g.addTransform(AffineTransform::scale(sf));
 
-	while (auto a = it.getNextAction())
-	{
-		a->perform(g);
-	}
+	it.perform(g);
 
 	img = ScaledImage(img_, sf);
 
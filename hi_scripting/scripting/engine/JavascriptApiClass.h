@@ -478,6 +478,21 @@ public:
     *   You'll need to call getIndexAndNumArgsForFunction() before calling this. */
 	var callFunction(int index, var *args, int numArgs);
 
+	/** Checks whether the function slot that was resolved with getIndexAndNumArgsForFunction() has the given name.
+	*
+	*   This is a constant time check that is used by the inline caches of the script engine to validate a previously
+	*   resolved slot for another object. */
+	bool hasFunctionAt(int index, int numArgs, const Identifier& id) const noexcept
+	{
+		return isPositiveAndBelow(numArgs, NumMaxArguments) && isPositiveAndBelow(index, NumSlots) && ids[numArgs][index] == id;
+	}
+
+	/** Checks whether the constant at the given index has the given name. */
+	bool hasConstantAt(int index, const Identifier& id) const noexcept
+	{
+		return isPositiveAndBelow(index, numConstants) && constantsToUse[index].id == id;
+	}
+
     /** This returns all function names alphabetically sorted. This is used by the autocomplete popup. */
 	void getAllFunctionNames(Array<Identifier> &ids) const;
     
@@ -342,14 +342,35 @@ var HiseJavascriptEngine::RootObject::FunctionCall::getResult(const Scope& s) co
 
 			if (ConstScriptingObject* c = dynamic_cast<ConstScriptingObject*>(thisObject.getObject()))
 			{
-				c->getIndexAndNumArgsForFunction(dot->child, functionIndex, numArgs);
+				auto& e = functionCache.get(*thisObject.getObject());
+
+				if (c->hasFunctionAt(e.functionIndex, e.numArgs, dot->child))
+				{
+					functionIndex = e.functionIndex;
+					numArgs = e.numArgs;
+
+#if ENABLE_SCRIPTING_SAFE_CHECKS
+					types = e.types;
+#endif
+				}
+				else
+				{
+					c->getIndexAndNumArgsForFunction(dot->child, functionIndex, numArgs);
                 
 #if ENABLE_SCRIPTING_SAFE_CHECKS
-                types = c->getForcedParameterTypes(functionIndex, numArgs);
+					types = c->getForcedParameterTypes(functionIndex, numArgs);
 #endif
 
-				CHECK_CONDITION_WITH_LOCATION(functionIndex != -1, "function not found");
-				CHECK_CONDITION_WITH_LOCATION(numArgs == arguments.size(), "argument amount mismatch: " + String(arguments.size()) + ", Expected: " + String(numArgs));
+					CHECK_CONDITION_WITH_LOCATION(functionIndex != -1, "function not found");
+					CHECK_CONDITION_WITH_LOCATION(numArgs == arguments.size(), "argument amount mismatch: " + String(arguments.size()) + ", Expected: " + String(numArgs));
+
+					e.functionIndex = functionIndex;
+					e.numArgs = numArgs;
+
+#if ENABLE_SCRIPTING_SAFE_CHECKS
+					e.types = types;
+#endif
+				}
 
 				var parameters[5];
 
@@ -254,10 +254,79 @@ DECLARE_ID(length);
 
 #undef DECLARE_ID
 
+/** Per call site caches for property and function lookups.
+
+	A node stores the result of its last lookups together with the dynamic type of the object
+	it was resolved for. The next time it sees an object of the same type it skips the lookup chain
+	and validates the cached slot with a constant time name check instead.
+*/
+namespace InlineCache
+{
+
+/** Caches the index of a property in a NamedValueSet. */
+struct PropertySlot
+{
+	var* get(NamedValueSet& set, const Identifier& id) noexcept
+	{
+		if (!isPositiveAndBelow(index, set.size()) || set.begin()[index].name != id)
+			index = set.indexOf(id);
+
+		return index != -1 ? set.getVarPointerAt(index) : nullptr;
+	}
+
+	int index = -1;
+};
+
+/** Stores up to NumEntries lookup results, keyed by the dynamic type of the object. 
+	
+	The EntryType needs a `type` member and should be invalid when default constructed.
+*/
+template <typename EntryType, int NumEntries=4> struct Polymorphic
+{
+	EntryType& get(const ReferenceCountedObject& obj) noexcept
+	{
+		auto t = &typeid(obj);
+
+		for (auto& e : entries)
+		{
+			if (e.type == t)
+				return e;
+		}
+
+		auto& e = entries[nextEntry];
+		nextEntry = (nextEntry + 1) % NumEntries;
+
+		e = EntryType();
+		e.type = t;
+		return e;
+	}
+
+	EntryType entries[NumEntries];
+	int nextEntry = 0;
+};
+
+}
+
 struct HiseJavascriptEngine::RootObject::DotOperator : public Expression
 {
 	DotOperator(const CodeLocation& l, ExpPtr& p, const Identifier& c) noexcept : Expression(l), parent(p), child(c) {}
 
+	enum class ObjectKind
+	{
+		Unresolved,
+		Constant,
+		FixObject,
+		AssignableDotObject,
+		None
+	};
+
+	struct CacheEntry
+	{
+		const std::type_info* type = nullptr;
+		ObjectKind kind = ObjectKind::Unresolved;
+		int constantIndex = -1;
+	};
+
 	var getResult(const Scope& s) const override
 	{
 		var p(parent->getResult(s));
@@ -272,37 +341,101 @@ struct HiseJavascriptEngine::RootObject::DotOperator : public Expression
 
 		if (DynamicObject* o = p.getDynamicObject())
 		{
-			if (const var* v = getPropertyPointer(o, child))
+			if (const var* v = propertySlot.get(o->getProperties(), child))
 				return *v;
 
 			return o->getProperty(child);
 		}
-			
-		if (ConstScriptingObject* o = dynamic_cast<ConstScriptingObject*>(p.getObject()))
+
+		if (auto obj = p.getObject())
+		{
+			auto& e = objectCache.get(*obj);
+
+			switch (e.kind)
+			{
+			case ObjectKind::Constant:
+			{
+				auto o = dynamic_cast<ConstScriptingObject*>(obj);
+
+				if (o != nullptr && o->hasConstantAt(e.constantIndex, child))
+					return o->getConstantValue(e.constantIndex);
+
+				break;
+			}
+			case ObjectKind::FixObject:
+			{
+				if (auto lb = dynamic_cast<fixobj::ObjectReference*>(obj))
+					return getFixObjectMember(lb);
+
+				break;
+			}
+			case ObjectKind::AssignableDotObject:
+			{
+				if (auto ad = dynamic_cast<AssignableDotObject*>(obj))
+					return ad->getDotProperty(child);
+
+				break;
+			}
+			case ObjectKind::None:
+				return var::undefined();
+			case ObjectKind::Unresolved:
+				break;
+			}
+
+			return resolve(obj, e);
+		}
+
+		return var::undefined();
+	}
+
+	/** Goes through the lookup chain and stores the kind of object in the cache entry. 
+	
+		The constants of a ConstScriptingObject can differ between instances of the same type
+		(eg. the parameter IDs of a module handle), so a missing constant is not cached for these
+		objects and the next evaluation will go through the lookup chain again.
+	*/
+	var resolve(ReferenceCountedObject* obj, CacheEntry& e) const
+	{
+		const bool hasInstanceConstants = dynamic_cast<ConstScriptingObject*>(obj) != nullptr;
+
+		if (hasInstanceConstants)
 		{
+			auto o = static_cast<ConstScriptingObject*>(obj);
 			const int constantIndex = o->getConstantIndex(child);
+
 			if (constantIndex != -1)
 			{
+				e.kind = ObjectKind::Constant;
+				e.constantIndex = constantIndex;
 				return o->getConstantValue(constantIndex);
 			}
 		}
         
-        if(auto lb = dynamic_cast<fixobj::ObjectReference*>(p.getObject()))
+        if(auto lb = dynamic_cast<fixobj::ObjectReference*>(obj))
         {
-            if(auto member = (*lb)[child])
-                return (var)*member;
-            else
-                location.throwError("can't find property " + child.toString());
+			e.kind = ObjectKind::FixObject;
+			return getFixObjectMember(lb);
         }
 
-		if (auto ad = dynamic_cast<AssignableDotObject*>(p.getObject()))
+		if (auto ad = dynamic_cast<AssignableDotObject*>(obj))
 		{
+			e.kind = hasInstanceConstants ? ObjectKind::Unresolved : ObjectKind::AssignableDotObject;
 			return ad->getDotProperty(child);
 		}
 
+		e.kind = hasInstanceConstants ? ObjectKind::Unresolved : ObjectKind::None;
 		return var::undefined();
 	}
 
+	var getFixObjectMember(fixobj::ObjectReference* lb) const
+	{
+		if(auto member = (*lb)[child])
+			return (var)*member;
+		
+		location.throwError("can't find property " + child.toString());
+		RETURN_IF_NO_THROW(var());
+	}
+
 	void assign(const Scope& s, const var& newValue) const override
 	{
         auto v = parent->getResult(s);
@@ -365,6 +498,9 @@ struct HiseJavascriptEngine::RootObject::DotOperator : public Expression
 	
 	ExpPtr parent;
 	Identifier child;
+
+	mutable InlineCache::PropertySlot propertySlot;
+	mutable InlineCache::Polymorphic<CacheEntry> objectCache;
 };
 
 
@@ -472,6 +608,20 @@ struct HiseJavascriptEngine::RootObject::FunctionCall : public Expression
 #if ENABLE_SCRIPTING_SAFE_CHECKS
     mutable VarTypeChecker::ParameterTypes types;
 #endif
+
+	/** The resolved API function slot for the object types that were called through this node. */
+	struct FunctionCacheEntry
+	{
+		const std::type_info* type = nullptr;
+		int functionIndex = -1;
+		int numArgs = -1;
+
+#if ENABLE_SCRIPTING_SAFE_CHECKS
+		VarTypeChecker::ParameterTypes types;
+#endif
+	};
+
+	mutable InlineCache::Polymorphic<FunctionCacheEntry> functionCache;
 };
 
 struct HiseJavascriptEngine::RootObject::NewOperator : public FunctionCall
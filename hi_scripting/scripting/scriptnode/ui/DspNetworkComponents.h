@@ -1048,7 +1048,7 @@ public:
 
 		void timerCallback() override
 		{
-			componentToUpdate->repaint();
+			repaintPooled(componentToUpdate);
 		}
 
 		Component* componentToUpdate;
@@ -56,7 +56,12 @@ void ContainerComponent::Updater::changeListenerCallback(SafeChangeBroadcaster *
 	if(messageLevel == Level::Rebuild)
 		parent.rebuildNodes();
 	if (messageLevel == Level::Repaint)
-		parent.repaint();
+	{
+		if (auto h = getHandler())
+			h->repaintPooled(&parent);
+		else
+			parent.repaint();
+	}
 
 	messageLevel = Level::Nothing;
 }
@@ -1200,7 +1200,7 @@ void ParameterSlider::timerCallback()
             blinkAlpha = jmax(0.0f, blinkAlpha - 0.08f);
         }
         
-		repaint();
+		repaintPooled(this);
 	}
 }
 
@@ -64,10 +64,12 @@ END_JUCE_MODULE_DECLARATION
 
 /** Config: SNEX_ENABLE_SIMD
 
-Enables SIMD processing for consecutive float spans (not functional yet). 
+Enables SIMD processing for consecutive float spans. If this is enabled, the AutoVectorisation
+optimization will be part of the default optimization passes and loops over float spans / dyns will
+be converted to SSE instructions if possible. 
 */
 #ifndef SNEX_ENABLE_SIMD
-#define SNEX_ENABLE_SIMD 0
+#define SNEX_ENABLE_SIMD 1
 #endif
 
 
@@ -105,6 +107,26 @@ Set to 0 to disable SNEX compilation (default on iOS).
 #define SNEX_MIR_BACKEND 1
 #endif
 
+/** Config: SNEX_MIR_OPTIMIZE_LEVEL
+
+The optimization level of the MIR code generator (0 = fast code generation, 1 = register allocation and
+combiner, 2 = GVN and constant propagation, 3 = everything). This is independent of the SNEX optimization passes
+that are applied to the syntax tree before the MIR code is created.
+*/
+#ifndef SNEX_MIR_OPTIMIZE_LEVEL
+#define SNEX_MIR_OPTIMIZE_LEVEL 3
+#endif
+
+/** Config: SNEX_MIR_CODE_CACHE
+
+If enabled, the MIR code that is created from the SNEX code will be stored in a cache directory on the disk
+and reused on the next compilation of the same code (with the same preprocessor definitions and optimization passes).
+This skips the MIR builder, but the machine code is still created on each compilation.
+*/
+#ifndef SNEX_MIR_CODE_CACHE
+#define SNEX_MIR_CODE_CACHE 1
+#endif
+
 /** The SNEX compiler is only available on x64 builds so this preprocessor will allow compiling HISE on ARM withouth the JIT compiler. */
 #ifndef HISE_INCLUDE_SNEX_X64_CODEGEN
 #if JUCE_ARM
@@ -204,7 +226,10 @@ namespace snex
 				static StringArray getDefaultIds()
 				{
 #if SNEX_MIR_BACKEND
-					return { BinaryOpOptimisation, ConstantFolding, DeadCodeElimination };
+					// AsmOptimisation and AutoVectorisation operate on the asmjit code and are not available here
+					return { BinaryOpOptimisation, ConstantFolding, DeadCodeElimination, Inlining, LoopOptimisation };
+#elif SNEX_ENABLE_SIMD
+					return { BinaryOpOptimisation, ConstantFolding, DeadCodeElimination, Inlining, LoopOptimisation, AsmOptimisation, NoSafeChecks, AutoVectorisation };
 #else
 					return { BinaryOpOptimisation, ConstantFolding, DeadCodeElimination, Inlining, LoopOptimisation, AsmOptimisation, NoSafeChecks };
 #endif
@@ -212,7 +237,11 @@ namespace snex
 
 				static StringArray getAllIds()
 				{
+#if !SNEX_MIR_BACKEND && SNEX_ENABLE_SIMD
+					return { BinaryOpOptimisation, ConstantFolding, DeadCodeElimination, Inlining, LoopOptimisation, AsmOptimisation, NoSafeChecks, AutoVectorisation };
+#else
 					return { BinaryOpOptimisation, ConstantFolding, DeadCodeElimination, Inlining, LoopOptimisation, AsmOptimisation, NoSafeChecks };
+#endif
 				}
 			};
 #endif
@@ -325,6 +354,7 @@ namespace snex
 #include "snex_core/snex_jit_NamespaceHandler.h"
 #include "snex_core/snex_jit_BaseScope.h"
 #include "snex_public/snex_jit_GlobalScope.h"
+#include "snex_mir/snex_MirCodeCache.h"
 #include "snex_mir/snex_MirObject.h"
 #include "snex_core/snex_jit_JitCallableObject.h"
 #include "snex_core/snex_jit_JitCompiledFunctionClass.h"
@@ -75,6 +75,15 @@ bool SpanType::isSimd() const
 	return false;
 }
 
+bool SpanType::canBeConvertedToSimd() const
+{
+#if SNEX_ENABLE_SIMD
+	return getElementType() == Types::ID::Float && getNumElements() > 0 && (getNumElements() % 4) == 0;
+#else
+	return false;
+#endif
+}
+
 void SpanType::finaliseAlignment()
 {
 	if (elementType.isComplexType())
@@ -226,7 +235,7 @@ snex::jit::FunctionClass* SpanType::getFunctionClass()
 
 			auto float4Type = handler.getAliasType(NamespacedIdentifier("float4"));
 
-			if (getNumElements() % 4 != 0)
+			if (!canBeConvertedToSimd())
 				return Result::fail("Can't convert to SIMD");
 
 			int numSimdElements = getNumElements() / 4;
@@ -265,7 +274,9 @@ size_t SpanType::getRequiredAlignment() const
 	if (elementSize == 0)
 		return 1;
 
-	if (isSimd())
+	// The vectorised loop uses aligned SSE instructions so it
+	// must match the alignas(16) of the C++ span
+	if (isSimd() || canBeConvertedToSimd())
 	{
 		return 16;
 	}
@@ -177,6 +177,9 @@ struct SpanType : public ArrayTypeBase
 
 	bool isSimd() const;
 
+	/** Returns true if this is a float span with a multiple of 4 elements that can be processed as float4 array. */
+	bool canBeConvertedToSimd() const;
+
 	size_t getElementSize() const;
 
 private:
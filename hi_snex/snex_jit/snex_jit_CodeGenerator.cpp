@@ -503,6 +503,8 @@ AsmCodeGenerator::RegPtr AsmCodeGenerator::emitBinaryOp(OpType op, RegPtr l, Reg
 			FP_OP(cc.mulps, l, r);
 		if (op == JitTokens::minus)
 			FP_OP(cc.subps, l, r);
+		if (op == JitTokens::divide)
+			FP_OP(cc.divps, l, r);
 		if (op == JitTokens::assign_)
 			FP_OP(cc.movaps, l, r);
 	}
@@ -1568,16 +1568,16 @@ bool LoopVectoriser::convertToSimd(BaseCompiler* c, Operations::Loop* l)
 		if (!isFloat)
 			return false;
 
-		auto isUnSimdable = l->getLoopBlock()->forEachRecursive(isUnSimdableOperation, IterationType::AllChildStatements);
+		// an explicit float iterator would clash with the float4 element type
+		if (!l->iterator.typeInfo.isDynamic())
+			return false;
 
-		if (isUnSimdable)
+		if (!isSimdableStatement(c, l, l->getLoopBlock()))
 			return false;
 
 		if (auto asSpan = dynamic_cast<SpanType*>(at))
 		{
-			bool isNonSimdableSpan = (asSpan->getNumElements() % 4) != 0;
-
-			if (isNonSimdableSpan)
+			if (!asSpan->canBeConvertedToSimd())
 				return false;
 
 			changeIteratorTargetToSimd(l);
@@ -1640,30 +1640,90 @@ juce::Result LoopVectoriser::changeIteratorTargetToSimd(Operations::Loop* l)
 	return Result::ok();
 }
 
-bool LoopVectoriser::isUnSimdableOperation(Ptr s)
+bool LoopVectoriser::isSimdableStatement(BaseCompiler* c, Operations::Loop* l, Ptr s)
 {
 	using namespace Operations;
 
-	auto parentLoop = Operations::findParentStatementOfType<Operations::Loop>(s.get());
+	if (auto sb = as<StatementBlock>(s))
+	{
+		for (auto cs : *sb)
+		{
+			if (!isSimdableStatement(c, l, cs))
+				return false;
+		}
 
-	if (auto cf = as<ControlFlowStatement>(s))
 		return true;
+	}
 
-	if (auto cf = as<FunctionCall>(s))
-		return true;
+	if (auto a = as<Assignment>(s))
+	{
+		auto target = as<VariableReference>(a->getSubExpr(1));
 
-	if (auto cf = as<Increment>(s))
-		return true;
+		if (target == nullptr || !(target->id == l->iterator))
+			return false;
+
+		auto op = a->assignmentType;
+
+		if (op != JitTokens::assign_ && op != JitTokens::plus && op != JitTokens::minus &&
+			op != JitTokens::times && op != JitTokens::divide)
+			return false;
+
+		bool usesIterator = false;
+		return isSimdableExpression(c, l, a->getSubExpr(0), usesIterator);
+	}
 
-	if (auto v = as<VariableReference>(s))
+	return false;
+}
+
+bool LoopVectoriser::isSimdableExpression(BaseCompiler* c, Operations::Loop* l, Ptr e, bool& usesIterator)
+{
+	using namespace Operations;
+
+	usesIterator = false;
+
+	if (auto im = as<Immediate>(e))
+		return im->getTypeInfo().getType() == Types::ID::Float;
+
+	if (auto v = as<VariableReference>(e))
+	{
+		if (v->id == l->iterator)
+		{
+			usesIterator = true;
+			return true;
+		}
+
+		v->tryToResolveType(c);
+
+		auto t = v->getTypeInfo();
+		return !t.isDynamic() && t.getType() == Types::ID::Float;
+	}
+
+	if (auto bo = as<BinaryOp>(e))
 	{
-		auto writeType = v->getWriteAccessType();
+		auto op = bo->op;
 
-		if (writeType != JitTokens::void_)
+		if (op != JitTokens::plus && op != JitTokens::minus && op != JitTokens::times && op != JitTokens::divide)
+			return false;
+
+		bool leftUsesIterator = false;
+		bool rightUsesIterator = false;
+
+		if (!isSimdableExpression(c, l, bo->getSubExpr(0), leftUsesIterator) ||
+			!isSimdableExpression(c, l, bo->getSubExpr(1), rightUsesIterator))
+			return false;
+
+		// The binary op takes its type from the left operand and
+		// only the right operand can be broadcasted to a float4
+		if (rightUsesIterator && !leftUsesIterator)
 		{
-			if (!(parentLoop->iterator == v->id))
-				return true;
+			if (op == JitTokens::plus || op == JitTokens::times)
+				bo->swapSubExpressions(0, 1);
+			else
+				return false;
 		}
+
+		usesIterator = leftUsesIterator || rightUsesIterator;
+		return true;
 	}
 
 	return false;
@@ -308,7 +308,14 @@ private:
 
 	Result changeIteratorTargetToSimd(Operations::Loop* l);
 
-	static bool isUnSimdableOperation(Ptr s);
+	/** Checks whether every statement in the loop body is an assignment to the iterator that can be
+		executed with float4 registers. */
+	static bool isSimdableStatement(BaseCompiler* c, Operations::Loop* l, Ptr s);
+
+	/** Checks whether the expression only consists of float immediates, float variables, the iterator and
+		basic arithmetic operators. If the iterator is only used on the right side of a commutative
+		operator, the operands will be swapped so that the float4 register ends up on the left side. */
+	static bool isSimdableExpression(BaseCompiler* c, Operations::Loop* l, Ptr e, bool& usesIterator);
 };
 
 
@@ -324,14 +324,20 @@ MathFunctions::MathFunctions(bool addInlinedFunctions, ComplexType::Ptr blockTyp
 	addInliner("min", Inliners::min);
 	addInliner("range", Inliners::range);
 	addInliner("sign", Inliners::sign);
-	addInliner("map", Inliners::map, Inliner::InlineType::HighLevel);
 	addInliner("fmod", Inliners::fmod);
 	addInliner("sin", Inliners::sin);
+#else
+	// abs(float) and abs(double) are emitted as sign bit clear by the MIR builder
+	addInliner("max", Inliners::max, Inliner::InlineType::HighLevel);
+	addInliner("min", Inliners::min, Inliner::InlineType::HighLevel);
+	addInliner("range", Inliners::range, Inliner::InlineType::HighLevel);
+#endif
+
+	addInliner("map", Inliners::map, Inliner::InlineType::HighLevel);
 	addInliner("wrap", Inliners::wrap, Inliner::InlineType::HighLevel);
 	addInliner("norm", Inliners::norm, Inliner::InlineType::HighLevel);
 	addInliner("sig2mod", Inliners::sig2mod, Inliner::InlineType::HighLevel);
 	addInliner("mod2sig", Inliners::mod2sig, Inliner::InlineType::HighLevel);
-#endif
 
 	for (auto& f : functions)
 	{
@@ -345,6 +351,11 @@ MathFunctions::MathFunctions(bool addInlinedFunctions, ComplexType::Ptr blockTyp
 			});
 		}
 
+#if !SNEX_ASMJIT_BACKEND
+		if (f->id.getIdentifier() == Identifier("abs") && f->returnType == Types::ID::Integer)
+			f->inliner = Inliner::createHighLevelInliner(f->id, Inliners::abs);
+#endif
+
 	}
 }
 
@@ -622,7 +633,12 @@ private:
 
 	String getLiteral(double value)
 	{
-		VariableStorage v(type, var(value));
+		if (type == Types::ID::Float || type == Types::ID::Double || type == Types::ID::Integer)
+		{
+			VariableStorage v(type, var(value));
+			return Types::Helpers::getCppValueString(v);
+		}
+
 		return Types::Helpers::getCppValueString(value);
 	}
 
@@ -810,7 +826,7 @@ juce::Result MathFunctions::Inliners::sign(InlineData* d_)
 
 	return Result::ok();
 }
-
+#endif
 
 juce::Result MathFunctions::Inliners::map(InlineData* b)
 {
@@ -860,6 +876,7 @@ juce::Result MathFunctions::Inliners::wrap(InlineData* b)
 	return c;
 }
 
+#if SNEX_ASMJIT_BACKEND
 juce::Result MathFunctions::Inliners::fmod(InlineData* d_)
 {
 	SETUP_MATH_INLINE("inline fmod");
@@ -976,7 +993,34 @@ juce::Result MathFunctions::Inliners::sin(InlineData* d_)
 
 	return Result::ok();
 }
+#else
+juce::Result MathFunctions::Inliners::abs(InlineData* b)
+{
+	Funky c(b, "v");
+	c << "return v < " << 0.0 << " ? " << 0.0 << " - v : v";
+	return c;
+}
+
+juce::Result MathFunctions::Inliners::max(InlineData* b)
+{
+	Funky c(b, "a, b");
+	c << "return a < b ? b : a";
+	return c;
+}
 
+juce::Result MathFunctions::Inliners::min(InlineData* b)
+{
+	Funky c(b, "a, b");
+	c << "return b < a ? b : a";
+	return c;
+}
+
+juce::Result MathFunctions::Inliners::range(InlineData* b)
+{
+	Funky c(b, "v, lower, upper");
+	c << "return v < lower ? lower : (upper < v ? upper : v)";
+	return c;
+}
 #endif
 
 }
@@ -265,22 +265,29 @@ public:
 		}
 	};
 
+#endif
+
 	struct Inliners
 	{
+		/** With the asmjit backend these are assembly inliners, with MIR they are
+			high level inliners so that the calls can be optimised by the MIR generator. */
 		static Result abs(InlineData* d);
 		static Result max(InlineData* d);
 		static Result min(InlineData* d);
 		static Result range(InlineData* d);
+
+#if SNEX_ASMJIT_BACKEND
 		static Result sign(InlineData* b);
 		static Result fmod(InlineData* b);
 		static Result sin(InlineData* b);
+#endif
+
 		static Result wrap(InlineData* b);
 		static Result map(InlineData* b);;
 		static Result norm(InlineData* b);
 		static Result sig2mod(InlineData* b);
 		static Result mod2sig(InlineData* b);
 	};
-#endif
 
 	MathFunctions(bool addInlinedFunctions, ComplexType::Ptr blockType);;
 };
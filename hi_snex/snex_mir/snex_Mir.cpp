@@ -15,6 +15,7 @@
 #include "snex_MirInstructions.cpp"
 
 #include "snex_MirBuilder.cpp"
+#include "snex_MirCodeCache.cpp"
 
 #include "snex_MirObject.cpp"
 
@@ -130,6 +130,11 @@ ValueTree MirBuilder::getGlobalData()
     return currentState->dataManager.getGlobalData();
 }
 
+bool MirBuilder::containsAbsoluteAddresses() const
+{
+	return currentState->containsAbsoluteAddresses;
+}
+
 String MirBuilder::getMirText() const
 {
 	auto text = currentState->toString(true);
@@ -58,6 +58,9 @@ struct MirBuilder
     void setDataLayout(const Array<ValueTree>& data);
     
     ValueTree getGlobalData();
+
+	/** Returns true if the MIR text contains memory addresses of the current process (so it can't be cached). */
+	bool containsAbsoluteAddresses() const;
     
 private:
 
@@ -0,0 +1,245 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+namespace snex {
+namespace mir {
+using namespace juce;
+
+CriticalSection MirCodeCache::lock;
+File MirCodeCache::cacheDirectory;
+int64 MirCodeCache::maxCacheSize = MirCodeCache::DefaultMaxCacheSize;
+std::atomic<int> MirCodeCache::numHits = { 0 };
+std::atomic<int> MirCodeCache::numMisses = { 0 };
+
+static String createKeyString(const String& preprocessedCode, const jit::GlobalScope& memory, const Array<ValueTree>& dataLayout)
+{
+	String s;
+
+	// Invalidate all entries when any part of the compiler changes
+	s << "MirCodeCache " << MirCodeCache::CodegenVersion << " MIR " << MIR_API_VERSION << "\n";
+	s << "Build " << MirCodeCache::getBuildIdentifier() << "\n";
+	s << "OptimizeLevel " << SNEX_MIR_OPTIMIZE_LEVEL << "\n";
+	s << "Debug " << (memory.isDebugModeEnabled() ? 1 : 0) << "\n";
+	s << "Passes " << memory.getOptimizationPassList().joinIntoString(",") << "\n";
+
+	for (const auto& d : memory.getPreprocessorDefinitions())
+		s << "#define " << d.name << " " << d.value << "\n";
+
+	for (const auto& l : dataLayout)
+		s << l.toXmlString() << "\n";
+
+	s << preprocessedCode;
+
+	return s;
+}
+
+MirCodeCache::Key MirCodeCache::createKey(const String& preprocessedCode, const jit::GlobalScope& memory, const Array<ValueTree>& dataLayout)
+{
+	auto s = createKeyString(preprocessedCode, memory, dataLayout);
+
+	Key k;
+	k.hash = s.hashCode64();
+	k.text = s;
+	return k;
+}
+
+String MirCodeCache::getBuildIdentifier()
+{
+	static const String id = []()
+	{
+		String s;
+
+#if JUCE_MSVC
+		s << "MSVC " << _MSC_FULL_VER;
+#else
+		s << __VERSION__;
+#endif
+
+		s << " " << __DATE__ << " " << __TIME__;
+
+		// The build time of this file doesn't change if only other parts of the compiler are rebuilt,
+		// so add the binary that contains the compiler (this is the plugin file if it's loaded as a plugin)
+		auto binary = File::getSpecialLocation(File::currentExecutableFile);
+
+		if (binary.existsAsFile())
+			s << " " << binary.getFullPathName() << " " << String(binary.getSize()) << " " << String(binary.getLastModificationTime().toMilliseconds());
+
+		return s;
+	}();
+
+	return id;
+}
+
+bool MirCodeCache::load(const Key& key, Entry& e)
+{
+	auto f = getFileForKey(key.hash);
+
+	ValueTree v;
+
+	{
+		ScopedLock sl(lock);
+
+		if (f.existsAsFile())
+		{
+			zstd::ZDefaultCompressor comp;
+
+			if (!comp.expand(f, v).wasOk())
+				v = {};
+			else
+				f.setLastModificationTime(Time::getCurrentTime()); // keep it from being evicted
+		}
+	}
+
+	auto ok = v.isValid() && v["Key"].toString() == key.text && v.getChildWithName("GlobalData").isValid();
+
+	if (ok)
+	{
+		e.code = v["Code"].toString();
+		e.globalData = v.getChildWithName("GlobalData").getChild(0).createCopy();
+		numHits++;
+	}
+	else
+	{
+		numMisses++;
+	}
+
+	return ok;
+}
+
+void MirCodeCache::store(const Key& key, const Entry& e)
+{
+	ValueTree v("MirCodeCache");
+	v.setProperty("Key", key.text, nullptr);
+	v.setProperty("Code", e.code, nullptr);
+
+	ValueTree gd("GlobalData");
+
+	if (e.globalData.isValid())
+		gd.addChild(e.globalData.createCopy(), -1, nullptr);
+
+	v.addChild(gd, -1, nullptr);
+
+	ScopedLock sl(lock);
+
+	auto f = getFileForKey(key.hash);
+
+	if (f.getParentDirectory().createDirectory().wasOk())
+	{
+		zstd::ZDefaultCompressor comp;
+		comp.compress(v, f);
+
+		removeOldEntries();
+	}
+}
+
+void MirCodeCache::setCacheDirectory(const File& newDirectory)
+{
+	ScopedLock sl(lock);
+	cacheDirectory = newDirectory;
+}
+
+void MirCodeCache::setMaxCacheSize(int64 newMaxSize)
+{
+	ScopedLock sl(lock);
+	maxCacheSize = newMaxSize;
+	removeOldEntries();
+}
+
+juce::File MirCodeCache::getCacheDirectory()
+{
+	ScopedLock sl(lock);
+
+	if (cacheDirectory == File())
+		return File::getSpecialLocation(File::tempDirectory).getChildFile("HISE_snex_cache");
+
+	return cacheDirectory;
+}
+
+void MirCodeCache::clear()
+{
+	ScopedLock sl(lock);
+
+	for (auto f : getCacheDirectory().findChildFiles(File::findFiles, false, "*.mircache"))
+		f.deleteFile();
+
+	numHits = 0;
+	numMisses = 0;
+}
+
+juce::String MirCodeCache::getReport()
+{
+	String s;
+	s << "MIR code cache: " << String(numHits.load()) << " hits, " << String(numMisses.load()) << " misses";
+	return s;
+}
+
+juce::File MirCodeCache::getFileForKey(int64 key)
+{
+	return getCacheDirectory().getChildFile(String::toHexString(key)).withFileExtension("mircache");
+}
+
+void MirCodeCache::removeOldEntries()
+{
+	struct FileInfo
+	{
+		File f;
+		int64 size;
+		Time lastUsed;
+	};
+
+	Array<FileInfo> files;
+	int64 totalSize = 0;
+
+	for (auto f : getCacheDirectory().findChildFiles(File::findFiles, false, "*.mircache"))
+	{
+		files.add({ f, f.getSize(), f.getLastModificationTime() });
+		totalSize += files.getLast().size;
+	}
+
+	if (totalSize <= maxCacheSize)
+		return;
+
+	std::sort(files.begin(), files.end(), [](const FileInfo& a, const FileInfo& b) { return a.lastUsed < b.lastUsed; });
+
+	for (const auto& fi : files)
+	{
+		if (totalSize <= maxCacheSize)
+			break;
+
+		if (fi.f.deleteFile())
+			totalSize -= fi.size;
+	}
+}
+
+}
+}
@@ -0,0 +1,121 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#pragma once
+
+namespace snex {
+namespace mir {
+using namespace juce;
+
+/** A persistent cache for the MIR code that is created from the SNEX syntax tree.
+
+	Every compilation of a SNEX object runs the MirBuilder on the syntax tree and creates the MIR text
+	representation of the code. If the same code was compiled before with the same settings, the
+	MIR text is loaded from the disk instead and only the MIR code generator has to run.
+
+	The key for each entry is a hash of the preprocessed code, the preprocessor definitions, the
+	optimization passes, the data layouts, the MIR generator settings and the build identifier. The
+	cached MIR code is platform independent so the CPU features are not part of the key (the machine code
+	is still created on the target machine). Code that contains absolute memory addresses will never be cached.
+
+	The cache directory can be shared by multiple HISE builds, so the build identifier makes sure that
+	a build never picks up code that was created by another version of the SNEX compiler. The full key
+	text is stored in each file and compared on load, so a hash collision can't return the wrong code.
+
+	If the cache directory grows above the maximum size, the least recently used entries are deleted.
+*/
+struct MirCodeCache
+{
+	/** Increase this number whenever the format of the cache files changes. */
+	static constexpr int CodegenVersion = 2;
+
+	static constexpr int64 DefaultMaxCacheSize = 32 * 1024 * 1024;
+
+	/** The key for a cache entry. The hash is used as file name, the text is stored in the file to detect hash collisions. */
+	struct Key
+	{
+		bool isValid() const { return hash != 0; }
+
+		int64 hash = 0;
+		String text;
+	};
+
+	struct Entry
+	{
+		String code;
+		ValueTree globalData;
+	};
+
+	/** Creates the key for the given code and compiler settings. */
+	static Key createKey(const String& preprocessedCode, const jit::GlobalScope& memory, const Array<ValueTree>& dataLayout);
+
+	/** Loads the entry with the given key. Returns false if there is no valid entry. */
+	static bool load(const Key& key, Entry& e);
+
+	/** Writes the entry to the cache directory. */
+	static void store(const Key& key, const Entry& e);
+
+	/** Changes the directory for the cache files. By default it uses a subdirectory in the temp folder. */
+	static void setCacheDirectory(const File& newDirectory);
+
+	static File getCacheDirectory();
+
+	/** Sets the maximum size of all cache files in bytes. */
+	static void setMaxCacheSize(int64 newMaxSize);
+
+	/** Deletes all cache files. */
+	static void clear();
+
+	/** Returns a string with the number of hits and misses since the application was started. */
+	static String getReport();
+
+	/** Returns a string that identifies the compiler binary (compiler version, build time and the executable file). */
+	static String getBuildIdentifier();
+
+private:
+
+	static File getFileForKey(int64 key);
+
+	/** Deletes the least recently used files until the cache fits into the maximum size. */
+	static void removeOldEntries();
+
+	static CriticalSection lock;
+	static File cacheDirectory;
+	static int64 maxCacheSize;
+
+	static std::atomic<int> numHits;
+	static std::atomic<int> numMisses;
+};
+
+}
+}
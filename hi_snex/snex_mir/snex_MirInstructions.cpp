@@ -339,6 +339,10 @@ struct InstructionParsers
 		auto v = state[InstructionPropertyIds::Value];
 		auto id = Types::Helpers::getTypeFromStringValue(v);
 		auto type = TypeConverters::TypeInfo2MirType(TypeInfo(id, false, false));
+
+		if (id == Types::ID::Pointer)
+			state.containsAbsoluteAddresses = true;
+
 		rm.registerCurrentTextOperand(v, type, RegisterType::Value);
 
 		return Result::ok();
@@ -1189,6 +1193,40 @@ struct InstructionParsers
 		return Result::ok();
 	}
 
+	/** Emits Math.abs() for floating point values by clearing the sign bit (so that -0.0 becomes 0.0).
+		MIR has no bitwise operations on float registers, so the value goes through a stack slot
+		and the sign bit is cleared in its upper 32 bits (little endian). */
+	static Result signBitClear(State* state_, bool isDouble)
+	{
+		auto& rm = state_->registerManager;
+
+		MirCodeGenerator cc(state_);
+
+		auto value = rm.loadIntoRegister(0, RegisterType::Value);
+		auto slot = cc.alloca(8);
+		auto bits = cc.deref<int>(slot, isDouble ? 4 : 0);
+
+		if (isDouble)
+			cc.dmov(cc.deref<double>(slot), value);
+		else
+			cc.fmov(cc.deref<float>(slot), value);
+
+		cc.setInlineComment("Math.abs");
+		cc.emit("and", { bits, bits, "0x7fffffff" });
+
+		TextLine l(state_, isDouble ? "dmov" : "fmov");
+
+		if (isDouble)
+			l.addSelfOperand<double>(true);
+		else
+			l.addSelfOperand<float>(true);
+
+		l.addRawOperand(isDouble ? cc.deref<double>(slot) : cc.deref<float>(slot));
+		l.flush();
+
+		return Result::ok();
+	}
+
 	static Result FunctionCall(State* state_)
 	{
 		auto& state = *state_;
@@ -1207,6 +1245,9 @@ struct InstructionParsers
 		auto sig =  TypeConverters::String2FunctionData(fullSig);
 		auto fid = state.functionManager.getIdForComplexTypeOverload(objectType, fullSig);
 
+		if (fid == "Math_abs_ff" || fid == "Math_abs_dd")
+			return signBitClear(state_, fid == "Math_abs_dd");
+
 		if (state.functionManager.hasPrototype(objectType, sig))
 		{
 			auto protoType = state.functionManager.getPrototype(objectType, fullSig);
@@ -304,6 +304,9 @@ snex::jit::FunctionCollectionBase* MirCompiler::compileMirCode(const ValueTree&
 		auto ok = compileMirCode(code);
         
         getFunctionClass()->globalData = b.getGlobalData();
+
+		if (ok != nullptr && cacheKey.isValid() && !b.containsAbsoluteAddresses())
+			MirCodeCache::store(cacheKey, { code, getFunctionClass()->globalData });
         
         return ok;
 	}
@@ -311,6 +314,33 @@ snex::jit::FunctionCollectionBase* MirCompiler::compileMirCode(const ValueTree&
 	return nullptr;
 }
 
+snex::jit::FunctionCollectionBase* MirCompiler::compileCachedMirCode()
+{
+	if (!cacheKey.isValid())
+		return nullptr;
+
+	MirCodeCache::Entry e;
+
+	if (!MirCodeCache::load(cacheKey, e))
+	{
+		memory.logMessage(MirCodeCache::getReport() + " (miss)");
+		return nullptr;
+	}
+
+	auto ok = compileMirCode(e.code);
+
+	if (ok != nullptr)
+	{
+		getFunctionClass()->globalData = e.globalData;
+		memory.logMessage(MirCodeCache::getReport() + " (hit)");
+		return ok;
+	}
+
+	// the cached code is broken, so start again with a fresh MIR context
+	currentFunctionClass = nullptr;
+	return nullptr;
+}
+
 snex::mir::MirFunctionCollection* MirCompiler::getFunctionClass()
 {
 	return dynamic_cast<MirFunctionCollection*>(currentFunctionClass.get());
@@ -398,7 +428,7 @@ snex::jit::FunctionCollectionBase* MirCompiler::compileMirCode(const String& cod
 			getFunctionClass()->modules.add(m);
 			MIR_load_module(ctx, m);
 			MIR_gen_init(ctx);
-			MIR_gen_set_optimize_level(ctx, 3);
+			MIR_gen_set_optimize_level(ctx, SNEX_MIR_OPTIMIZE_LEVEL);
             //MIR_gen_set_debug_file(ctx, 1, dbgfile);
 			MIR_link(ctx, MIR_set_gen_interface, &MirCompiler::resolve);
             
@@ -55,6 +55,12 @@ struct MirCompiler
 	jit::FunctionCollectionBase* compileMirCode(const ValueTree& ast);
 
     void setDataLayout(const Array<ValueTree>& dataTree);
+
+	/** Sets the key for the MIR code cache. If this is set, compileMirCode() will store the MIR code in the cache. */
+	void setCacheKey(const MirCodeCache::Key& k) { cacheKey = k; }
+
+	/** Compiles the MIR code from the cache. Returns nullptr if there is no cache entry for the current key. */
+	jit::FunctionCollectionBase* compileCachedMirCode();
     
 	Result getLastError() const;;
 
@@ -78,6 +84,7 @@ struct MirCompiler
 
     Array<ValueTree> dataLayout;
     String assembly;
+	MirCodeCache::Key cacheKey;
     
 	static Array<StaticFunctionPointer> currentFunctions;
 	static void* currentConsole;
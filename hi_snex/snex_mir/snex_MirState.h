@@ -452,6 +452,8 @@ struct State
 	MIR_context_t ctx;
 	MIR_module_t currentModule = nullptr;
 	ValueTree currentTree;
+
+	bool containsAbsoluteAddresses = false;
 	
 	Array<TextLine> lines;
 
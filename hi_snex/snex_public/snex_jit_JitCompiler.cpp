@@ -221,7 +221,16 @@ JitObject Compiler::compileJitObject(const juce::String& code)
 
 		mc.setDataLayout(layout);
 
+#if SNEX_MIR_CODE_CACHE
+		mc.setCacheKey(mir::MirCodeCache::createKey(preprocessedCode, memory, layout));
+
+		JitObject mirObject(mc.compileCachedMirCode());
+
+		if (!mirObject)
+			mirObject = JitObject(mc.compileMirCode(getAST()));
+#else
 		JitObject mirObject(mc.compileMirCode(getAST()));
+#endif
 
 		cr = mc.getLastError();
 
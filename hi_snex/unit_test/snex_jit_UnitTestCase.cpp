@@ -527,6 +527,94 @@ juce::Result JitFileTestCase::testAfterCompilation(bool dumpBeforeTest /*= false
 	}
 }
 
+double JitFileTestCase::benchmark(double secondsToRun)
+{
+	if (r.failed() || expectedFail.isNotEmpty())
+		return -1.0;
+
+	std::function<void()> f;
+	int numSamplesPerIteration = 1;
+
+	AudioSampleBuffer buffer;
+	ScopedPointer<Types::ProcessDataDyn> d;
+
+	if (nodeToTest != nullptr)
+	{
+		buffer = Helpers::loadFile(inputFile);
+
+		if (buffer.getNumSamples() == 0)
+			return -1.0;
+
+		Types::PrepareSpecs ps;
+		ps.numChannels = buffer.getNumChannels();
+		ps.sampleRate = 44100.0;
+		ps.blockSize = buffer.getNumSamples();
+		ps.voiceIndex = memory.getPolyHandler();
+
+		nodeToTest->prepare(ps);
+		nodeToTest->reset();
+
+		d = new Types::ProcessDataDyn(buffer.getArrayOfWritePointers(), buffer.getNumSamples(), numChannels);
+		d->setEventBuffer(eventBuffer);
+
+		numSamplesPerIteration = buffer.getNumSamples();
+
+		f = [&]()
+		{
+			nodeToTest->process(*d);
+		};
+	}
+	else
+	{
+		if (function.function == nullptr || function.args.size() > 2)
+			return -1.0;
+
+		for (const auto& a : function.args)
+		{
+			auto t = a.typeInfo.getType();
+
+			if (t == Types::ID::Block || t == Types::ID::Dynamic)
+				return -1.0;
+
+			if (t == Types::ID::Pointer)
+				numSamplesPerIteration = jmax(1, inputBuffer.getNumSamples());
+		}
+
+		switch (function.returnType.getType())
+		{
+		case Types::ID::Integer: f = [this]() { call<int>(); }; break;
+		case Types::ID::Float:   f = [this]() { call<float>(); }; break;
+		case Types::ID::Double:  f = [this]() { call<double>(); }; break;
+		default: return -1.0;
+		}
+	}
+
+	PolyHandler::ScopedVoiceSetter svs(*memory.getPolyHandler(), voiceIndex);
+
+	// warm up the caches
+	f();
+
+	int64 numIterations = 0;
+	auto start = Time::getHighResolutionTicks();
+	auto end = start + Time::secondsToHighResolutionTicks(secondsToRun);
+	auto now = start;
+
+	do
+	{
+		// don't query the timer for every call
+		for (int i = 0; i < 32; i++)
+			f();
+
+		numIterations += 32;
+		now = Time::getHighResolutionTicks();
+	}
+	while (now < end);
+
+	auto seconds = Time::highResolutionTicksToSeconds(now - start);
+
+	return seconds * 1e9 / ((double)numIterations * (double)numSamplesPerIteration);
+}
+
 juce::Result JitFileTestCase::test(bool dumpBeforeTest /*= false*/)
 {
 	if (nodeId.isNull() && function.returnType == Types::ID::Dynamic)
@@ -813,7 +901,8 @@ void JitFileTestCase::parseFunctionData()
 			}
 			catch (String& e)
 			{
-				t->expect(false, e);
+				if (t != nullptr)
+					t->expect(false, e);
 			}
 		}
 
@@ -192,6 +192,12 @@ public:
 
 	Result test(bool dumpBeforeTest = false);
 
+	/** Runs the compiled test repeatedly for the given time and returns the average duration in nanoseconds
+		per processed sample (or per function call if the test doesn't process audio).
+
+		Call this after test() was successful. Returns -1.0 if the test can't be benchmarked. */
+	double benchmark(double secondsToRun);
+
 	AudioSampleBuffer getBuffer(bool getProcessed) const
 	{
 		return inputBuffer;// getProcessed ? outputBuffer : inputBuffer;
@@ -758,6 +758,10 @@ public:
 		runTestFiles();
 		testIndexTypes();
 
+#if SNEX_ASMJIT_BACKEND && SNEX_ENABLE_SIMD
+		testLoopVectorisation();
+#endif
+
 		pc.stop();
 	}
 #endif
@@ -1704,6 +1708,73 @@ private:
 		TEST_VECTOR(a *= (b - 80.0f) * s + (a - s + b));
 	}
 
+	void testLoopVectorisation()
+	{
+		beginTest("Testing loop vectorisation");
+
+		auto prevOptimizations = optimizations;
+
+		testLoopVectorisation({});
+		testLoopVectorisation({ OptimizationIds::AutoVectorisation });
+		testLoopVectorisation({ OptimizationIds::AutoVectorisation, OptimizationIds::BinaryOpOptimisation, OptimizationIds::AsmOptimisation });
+
+		optimizations = prevOptimizations;
+
+		// Compares the vectorised dyn loop against the scalar loop. The odd sizes and offsets
+		// will fail the alignment check and use the fallback branch
+		for (auto size : { 4, 16, 64, 7, 33 })
+		{
+			for (auto offset : { 0, 1, 4 })
+			{
+				testLoopVectorisation("for(auto& x: a) x = x * s + 2.0f", size, offset);
+				testLoopVectorisation("for(auto& x: a) x = 0.5f * x - s", size, offset);
+				testLoopVectorisation("for(auto& x: a) x /= s", size, offset);
+				testLoopVectorisation("for(auto& x: a) x = s - x", size, offset);
+				testLoopVectorisation("for(auto& x: a) x += Math.abs(x)", size, offset);
+			}
+		}
+	}
+
+	void testLoopVectorisation(const StringArray& opt)
+	{
+		using T = float;
+
+		optimizations = opt;
+
+		ScopedPointer<HiseJITTestCase<T>> test;
+
+		juce::String sum = "float sum = 0.0f; for(auto& s: data) sum += s; return sum;";
+
+		CREATE_TYPED_TEST("span<float, 16> data = { 1.0f }; float test(float input) { for(auto& s: data) s = s * input + 2.0f; " + sum + " }");
+		EXPECT_TYPED("vectorised span loop", 3.0f, 80.0f);
+
+		CREATE_TYPED_TEST("span<float, 8> data = { 4.0f }; float test(float input) { for(auto& s: data) { s /= input; s = 2.0f * s; } " + sum + " }");
+		EXPECT_TYPED("vectorised span loop with division and swapped operands", 2.0f, 32.0f);
+
+		CREATE_TYPED_TEST("span<float, 8> data = { 1.0f }; float test(float input) { for(auto& s: data) s = input - s; " + sum + " }");
+		EXPECT_TYPED("non commutative operator with iterator on the right side", 3.0f, 16.0f);
+
+		CREATE_TYPED_TEST("span<float, 6> data = { 1.0f }; float test(float input) { for(auto& s: data) s += input; " + sum + " }");
+		EXPECT_TYPED("span loop with non SIMD size", 2.0f, 18.0f);
+
+		CREATE_TYPED_TEST("span<float, 8> data = { 1.0f }; float test(float input) { for(auto& s: data) s = Math.max(s, input); " + sum + " }");
+		EXPECT_TYPED("span loop with function call", 3.0f, 24.0f);
+
+		CREATE_TYPED_TEST("span<float, 8> data = { 1.0f }; float test(float input) { float x = 0.0f; for(auto& s: data) { x += s; s = x; } " + sum + " }");
+		EXPECT_TYPED("span loop with loop-carried dependency", 3.0f, 36.0f);
+	}
+
+	void testLoopVectorisation(const String& line, int size, int offset)
+	{
+		VectorOpTestCase scalar(*this, {}, line);
+		VectorOpTestCase simd(*this, { OptimizationIds::AutoVectorisation }, line);
+
+		scalar.test(3.0f, size, offset, offset);
+		simd.test(3.0f, size, offset, offset);
+
+		expect(scalar == simd, line + " with size " + String(size) + " and offset " + String(offset));
+	}
+
 	void testStaticConst()
 	{
 		beginTest("Testing static const");
@@ -3503,6 +3574,87 @@ private:
 
 static HiseJITUnitTest njut;
 
+/** Measures the throughput of the snex_playground test files with the backend of this build.
+
+	The backend is a compile time option, so run this in a build with SNEX_MIR_BACKEND enabled and one with
+	the asmjit backend and compare the logged numbers. Every file is measured without optimizations and with
+	the default optimizations so you can also see how much the optimization passes gain on each backend.
+*/
+class SnexBackendBenchmark : public UnitTest
+{
+public:
+
+	SnexBackendBenchmark() : UnitTest("SNEX backend benchmark", "snex_benchmark") {}
+
+	void runTest() override
+	{
+#if SNEX_MIR_BACKEND
+		String backend = "MIR";
+#else
+		String backend = "asmjit";
+#endif
+
+		beginTest("Benchmarking test files with the " + backend + " backend");
+
+		auto root = JitFileTestCase::getTestFileDirectory();
+		auto files = root.findChildFiles(File::findFiles, true, "*.h");
+		files.sort();
+
+		double sumUnoptimised = 0.0;
+		double sumOptimised = 0.0;
+		int numBenchmarked = 0;
+
+		for (auto f : files)
+		{
+			auto unoptimised = benchmarkFile(f, {});
+			auto optimised = benchmarkFile(f, OptimizationIds::Helpers::getDefaultIds());
+
+			if (unoptimised < 0.0 || optimised < 0.0)
+				continue;
+
+			String m;
+			m << backend << " " << f.getRelativePathFrom(root).replaceCharacter('\\', '/') << ": ";
+			m << String(unoptimised, 2) << "ns -> " << String(optimised, 2) << "ns per sample";
+			logMessage(m);
+
+			sumUnoptimised += unoptimised;
+			sumOptimised += optimised;
+			numBenchmarked++;
+		}
+
+		expect(numBenchmarked > 0, "No test files were benchmarked");
+
+		if (numBenchmarked > 0)
+		{
+			String m;
+			m << backend << " average of " << String(numBenchmarked) << " files: ";
+			m << String(sumUnoptimised / (double)numBenchmarked, 2) << "ns -> ";
+			m << String(sumOptimised / (double)numBenchmarked, 2) << "ns per sample";
+			logMessage(m);
+		}
+	}
+
+private:
+
+	double benchmarkFile(const File& f, const StringArray& optimizations)
+	{
+		GlobalScope memory;
+
+		for (auto o : optimizations)
+			memory.addOptimization(o);
+
+		JitFileTestCase t(nullptr, memory, f);
+
+		// Only measure the files that pass so that we don't compare broken code
+		if (t.test().failed())
+			return -1.0;
+
+		return t.benchmark(0.02);
+	}
+};
+
+static SnexBackendBenchmark snexBackendBenchmark;
+
 
 #undef CREATE_TEST
 #undef CREATE_TEST_SETUP
@@ -1,11 +1,25 @@
 
 #include "hi_streaming.h"
 
-
+#if HISE_USE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+
+#include "hi_streaming/BatchedDiskReader.cpp"
 #include "hi_streaming/SampleThreadPool.cpp"
+#include "hi_streaming/StreamingBlockCache.cpp"
 #include "hi_streaming/MonolithAudioFormat.cpp"
 #include "hi_streaming/StreamingSampler.cpp"
 #include "hi_streaming/StreamingSamplerSound.cpp"
+#include "hi_streaming/ParallelPreloader.cpp"
 #include "hi_streaming/StreamingSamplerVoice.cpp"
 
 #include "timestretch//time_stretcher.cpp"
@@ -102,16 +102,95 @@ Set this to false to disable the release start feature.
 #define HISE_SAMPLER_ALLOW_RELEASE_START 1
 #endif
 
+/** Config: HISE_NUM_STREAMING_THREADS
+
+The number of threads that are used for disk streaming (including the main loading thread). Increase this
+if you're streaming lots of voices from a fast SSD. Note that the decoding of a compressed monolith and the
+reads from a single sample file are serialised, so the additional threads only help with voices that play
+samples from different files.
+*/
+#ifndef HISE_NUM_STREAMING_THREADS
+#define HISE_NUM_STREAMING_THREADS 2
+#endif
+
+/** Config: HISE_NUM_PRELOAD_THREADS
+
+The number of threads that fill the preload buffers when a sample map is loaded or the preload size changes
+(including the loading thread). Set this to 1 to load the samples one after another.
+*/
+#ifndef HISE_NUM_PRELOAD_THREADS
+#define HISE_NUM_PRELOAD_THREADS 4
+#endif
+
+/** Config: HISE_USE_IO_URING
+
+If this is enabled, the streaming threads will collect the read operations of multiple voices and submit them
+with a single io_uring call. This is only available on Linux and requires a kernel version 5.6 or newer (if the
+ring can't be created at runtime, it will fall back to the default read operations).
+*/
+#ifndef HISE_USE_IO_URING
+#if JUCE_LINUX && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define HISE_USE_IO_URING 1
+#else
+#define HISE_USE_IO_URING 0
+#endif
+#else
+#define HISE_USE_IO_URING 0
+#endif
+#endif
+
+/** Config: HISE_SAMPLE_PREFETCH_MILLISECONDS
+
+The time in milliseconds that a sampler looks ahead for upcoming notes (delayed events from scripts or the notes
+of a MIDI player). The data that the voice will stream after the preload buffer is then loaded into the page cache
+before the note starts, which allows smaller preload sizes. Set this to 0 in order to disable the prefetching.
+*/
+#ifndef HISE_SAMPLE_PREFETCH_MILLISECONDS
+#define HISE_SAMPLE_PREFETCH_MILLISECONDS 250
+#endif
+
+/** Config: HISE_SAMPLER_USE_NOTE_INDEX
+
+If enabled, the sampler looks up the sounds for a note on in an index sorted by key and RR group instead of
+checking every sound of the sample map.
+*/
+#ifndef HISE_SAMPLER_USE_NOTE_INDEX
+#define HISE_SAMPLER_USE_NOTE_INDEX 1
+#endif
+
+/** Config: HISE_STREAMING_BLOCK_CACHE_SIZE
+
+The size in megabytes of the cache that stores decoded blocks of compressed monoliths. The cache is shared
+between all voices and plugin instances of the process, so multiple voices that stream the same sample
+will only decode it once. Set this to 0 in order to disable the cache.
+*/
+#ifndef HISE_STREAMING_BLOCK_CACHE_SIZE
+#define HISE_STREAMING_BLOCK_CACHE_SIZE 32
+#endif
+
+/** Config: HISE_SAMPLER_READ_FROM_MAPPED_MONOLITHS
+
+If enabled, voices that play uncompressed 16 bit monoliths will read the sample data directly from the memory mapped
+file instead of copying it into the streaming buffers. The streaming thread then just loads the upcoming pages into 
+the page cache.
+*/
+#ifndef HISE_SAMPLER_READ_FROM_MAPPED_MONOLITHS
+#define HISE_SAMPLER_READ_FROM_MAPPED_MONOLITHS 1
+#endif
 
 #include "hi_streaming/lockfree_fifo/readerwriterqueue.h"
 #include "hi_streaming/lockfree_fifo/concurrentqueue.h"
 
 #include "timestretch/time_stretcher.h"
 
+#include "hi_streaming/BatchedDiskReader.h"
 #include "hi_streaming/SampleThreadPool.h"
+#include "hi_streaming/StreamingBlockCache.h"
 #include "hi_streaming/MonolithAudioFormat.h"
 #include "hi_streaming/StreamingSampler.h"
 #include "hi_streaming/StreamingSamplerSound.h"
+#include "hi_streaming/ParallelPreloader.h"
 #include "hi_streaming/StreamingSamplerVoice.h"
 
 
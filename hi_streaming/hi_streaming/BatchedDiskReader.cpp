@@ -0,0 +1,559 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+namespace hise { using namespace juce;
+
+static thread_local BatchedDiskReader* currentBatchedDiskReader = nullptr;
+
+#if HISE_USE_IO_URING
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+
+struct BatchedDiskReader::Pimpl
+{
+	Pimpl(int queueDepth, int stagingBufferSize)
+	{
+		io_uring_params p;
+		zerostruct(p);
+
+		ringFd = (int)syscall(__NR_io_uring_setup, (unsigned)queueDepth, &p);
+
+		if (ringFd < 0)
+			return;
+
+		sqRingSize = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+		cqRingSize = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+		sqeSize = p.sq_entries * sizeof(io_uring_sqe);
+
+		const bool singleMmap = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+
+		if (singleMmap)
+			sqRingSize = cqRingSize = jmax(sqRingSize, cqRingSize);
+
+		sqRing = mapRingMemory(sqRingSize, IORING_OFF_SQ_RING);
+		cqRing = singleMmap ? sqRing : mapRingMemory(cqRingSize, IORING_OFF_CQ_RING);
+		sqes = static_cast<io_uring_sqe*>(mapRingMemory(sqeSize, IORING_OFF_SQES));
+
+		if (sqRing == nullptr || cqRing == nullptr || sqes == nullptr)
+		{
+			closeRing();
+			return;
+		}
+
+		auto sq = static_cast<uint8*>(sqRing);
+		sqTail = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+		sqMask = reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+		sqArray = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+
+		auto cq = static_cast<uint8*>(cqRing);
+		cqHead = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+		cqTail = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+		cqMask = reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+		cqes = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+
+		numEntries = p.sq_entries;
+
+		// Register the staging memory so that the kernel doesn't need to map it for every read
+		staging.calloc((size_t)stagingBufferSize);
+		stagingSize = stagingBufferSize;
+
+		iovec v;
+		v.iov_base = staging.get();
+		v.iov_len = (size_t)stagingSize;
+
+		stagingRegistered = syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_BUFFERS, &v, 1) == 0;
+	}
+
+	~Pimpl()
+	{
+		for (const auto& h : fileHandles)
+			::close(h.fd);
+
+		closeRing();
+	}
+
+	void* mapRingMemory(size_t size, int64 offset)
+	{
+		auto ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, (off_t)offset);
+		return ptr != MAP_FAILED ? ptr : nullptr;
+	}
+
+	void closeRing()
+	{
+		if (sqes != nullptr)
+			munmap(sqes, sqeSize);
+
+		if (cqRing != nullptr && cqRing != sqRing)
+			munmap(cqRing, cqRingSize);
+
+		if (sqRing != nullptr)
+			munmap(sqRing, sqRingSize);
+
+		if (ringFd >= 0)
+			::close(ringFd);
+
+		sqes = nullptr;
+		sqRing = nullptr;
+		cqRing = nullptr;
+		ringFd = -1;
+	}
+
+	bool isValid() const noexcept { return ringFd >= 0 && !broken; }
+
+	int getFileHandle(const File& f)
+	{
+		for (const auto& h : fileHandles)
+		{
+			if (h.file == f)
+				return h.fd;
+		}
+
+		auto fd = ::open(f.getFullPathName().toRawUTF8(), O_RDONLY | O_CLOEXEC);
+
+		if (fd >= 0)
+		{
+			struct stat s;
+
+			if (::fstat(fd, &s) == 0)
+				fileHandles.add({ f, fd, s.st_ino, s.st_mtime, s.st_size });
+			else
+			{
+				::close(fd);
+				fd = -1;
+			}
+		}
+
+		return fd;
+	}
+
+	/** Closes the handles of files that were replaced (eg. a monolith that was exported again).
+	
+		This must only be called when there are no pending requests that use the handles. The check
+		is throttled to once a second so that it doesn't add a system call per batch.
+	*/
+	void closeStaleFileHandles()
+	{
+		auto now = Time::getMillisecondCounter();
+
+		if (now - lastHandleCheck < 1000)
+			return;
+
+		lastHandleCheck = now;
+
+		for (int i = 0; i < fileHandles.size(); i++)
+		{
+			const auto& h = fileHandles.getReference(i);
+			struct stat s;
+
+			auto isStale = ::stat(h.file.getFullPathName().toRawUTF8(), &s) != 0 ||
+						   s.st_ino != h.inode ||
+						   s.st_mtime != h.modificationTime ||
+						   s.st_size != h.size;
+
+			if (isStale)
+			{
+				::close(h.fd);
+				fileHandles.remove(i--);
+			}
+		}
+	}
+
+	/** Calls io_uring_enter and returns the result or the negative error code. */
+	int enter(unsigned numToSubmit, unsigned minComplete)
+	{
+		for (;;)
+		{
+			auto result = (int)syscall(__NR_io_uring_enter, ringFd, numToSubmit, minComplete, IORING_ENTER_GETEVENTS, nullptr, 0);
+
+			if (result >= 0)
+				return result;
+
+			if (errno != EINTR)
+				return -errno;
+		}
+	}
+
+	/** Calls onResult for all completions that the kernel has posted and returns the number of completions. */
+	template <typename ResultFunction> unsigned reapCompletions(const ResultFunction& onResult)
+	{
+		auto head = *cqHead;
+		auto availableTail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+		unsigned numReaped = 0;
+
+		while (head != availableTail)
+		{
+			const auto& cqe = cqes[head & *cqMask];
+			onResult((int)cqe.user_data, cqe.res);
+			head++;
+			numReaped++;
+		}
+
+		__atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+		return numReaped;
+	}
+
+	/** Waits for the completions of requests that are still processed by the kernel. 
+	
+		This is used after a failed system call so that the kernel doesn't write into a destination buffer
+		after it was filled by the synchronous fallback. Returns false if the requests didn't complete in time.
+	*/
+	template <typename ResultFunction> bool drainInFlight(unsigned numInFlight, const ResultFunction& onResult)
+	{
+		auto deadline = Time::getMillisecondCounter() + 2000;
+
+		while (numInFlight > 0)
+		{
+			auto numReaped = reapCompletions(onResult);
+			numInFlight -= jmin(numInFlight, numReaped);
+
+			if (numInFlight == 0 || Time::getMillisecondCounter() > deadline)
+				break;
+
+			if (numReaped == 0 && enter(0, 1) < 0)
+				Thread::yield();
+		}
+
+		return numInFlight == 0;
+	}
+
+	/** Submits all requests in chunks of the queue size and calls onResult with the request index and the result
+	    of the read operation. Returns the number of system calls that were used to submit the requests. 
+		
+		If the ring fails, onResult will be called with -1 for all requests. The caller has to ignore the requests
+		that were already completed. */
+	template <typename ResultFunction> int submit(std::vector<Request>& requests, const ResultFunction& onResult)
+	{
+		// The number of attempts if the kernel is temporarily out of resources
+		static constexpr int MaxNumRetries = 64;
+
+		int numCalls = 0;
+		size_t index = 0;
+
+		while (index < requests.size())
+		{
+			auto numThisTime = (unsigned)jmin<size_t>(numEntries, requests.size() - index);
+			auto tail = *sqTail;
+
+			for (unsigned i = 0; i < numThisTime; i++)
+			{
+				const auto& r = requests[index + i];
+				auto slot = tail & *sqMask;
+				auto& sqe = sqes[slot];
+
+				zerostruct(sqe);
+				sqe.opcode = (r.isStaging && stagingRegistered) ? IORING_OP_READ_FIXED : IORING_OP_READ;
+				sqe.fd = r.fileHandle;
+				sqe.off = (uint64)r.byteOffset;
+				sqe.addr = (uint64)(pointer_sized_uint)r.destination;
+				sqe.len = (uint32)r.numBytes;
+				sqe.user_data = (uint64)(index + i);
+
+				sqArray[slot] = slot;
+				tail++;
+			}
+
+			__atomic_store_n(sqTail, tail, __ATOMIC_RELEASE);
+
+			auto numToSubmit = numThisTime;
+			unsigned numCompleted = 0;
+			int numRetries = 0;
+
+			while (numCompleted < numThisTime)
+			{
+				auto numReaped = reapCompletions(onResult);
+
+				if (numReaped > 0)
+				{
+					numCompleted += numReaped;
+					continue;
+				}
+
+				auto result = enter(numToSubmit, 1);
+				numCalls++;
+
+				if ((result == -EAGAIN || result == -EBUSY) && ++numRetries < MaxNumRetries)
+				{
+					Thread::yield();
+					continue;
+				}
+
+				if (result < 0)
+				{
+					// Wait for the requests that were submitted before the error, then stop using the ring
+					// and read the remaining requests synchronously.
+					auto numInFlight = (numThisTime - numToSubmit) - numCompleted;
+					drainInFlight(numInFlight, onResult);
+
+					for (auto i = index; i < requests.size(); i++)
+						onResult((int)i, -1);
+
+					// If the kernel didn't complete the reads in time, it might still access the ring, so it
+					// will only be closed in the destructor.
+					broken = true;
+					return numCalls;
+				}
+
+				numRetries = 0;
+				numToSubmit -= jmin(numToSubmit, (unsigned)result);
+			}
+
+			index += numThisTime;
+		}
+
+		return numCalls;
+	}
+
+	int readSynchronously(int fd, int64 byteOffset, void* destination, int numBytes)
+	{
+		int numRead = 0;
+
+		while (numRead < numBytes)
+		{
+			auto result = ::pread(fd, static_cast<uint8*>(destination) + numRead, (size_t)(numBytes - numRead), (off_t)(byteOffset + numRead));
+
+			if (result < 0 && errno == EINTR)
+				continue;
+
+			if (result <= 0)
+				break;
+
+			numRead += (int)result;
+		}
+
+		return numRead;
+	}
+
+	struct FileHandle
+	{
+		File file;
+		int fd;
+		ino_t inode;
+		time_t modificationTime;
+		off_t size;
+	};
+
+	Array<FileHandle> fileHandles;
+	uint32 lastHandleCheck = 0;
+
+	int ringFd = -1;
+	bool broken = false;
+
+	void* sqRing = nullptr;
+	void* cqRing = nullptr;
+	io_uring_sqe* sqes = nullptr;
+
+	size_t sqRingSize = 0;
+	size_t cqRingSize = 0;
+	size_t sqeSize = 0;
+
+	unsigned* sqTail = nullptr;
+	unsigned* sqMask = nullptr;
+	unsigned* sqArray = nullptr;
+
+	unsigned* cqHead = nullptr;
+	unsigned* cqTail = nullptr;
+	unsigned* cqMask = nullptr;
+	io_uring_cqe* cqes = nullptr;
+
+	unsigned numEntries = 0;
+
+	HeapBlock<uint8> staging;
+	int stagingSize = 0;
+	bool stagingRegistered = false;
+};
+
+#else
+
+struct BatchedDiskReader::Pimpl
+{
+	Pimpl(int, int) {}
+
+	bool isValid() const noexcept { return false; }
+	int getFileHandle(const File&) { return -1; }
+	void closeStaleFileHandles() {}
+
+	template <typename ResultFunction> int submit(std::vector<Request>& requests, const ResultFunction& onResult)
+	{
+		for (int i = 0; i < (int)requests.size(); i++)
+			onResult(i, -1);
+
+		return 0;
+	}
+
+	int readSynchronously(int, int64, void*, int) { return 0; }
+
+	HeapBlock<uint8> staging;
+	int stagingSize = 0;
+};
+
+#endif
+
+BatchedDiskReader::BatchedDiskReader(int queueDepth, int stagingBufferSize):
+	pimpl(new Pimpl(queueDepth, stagingBufferSize))
+{
+	pendingRequests.reserve((size_t)queueDepth);
+}
+
+BatchedDiskReader::~BatchedDiskReader()
+{
+	jassert(pendingRequests.empty());
+	pimpl = nullptr;
+}
+
+BatchedDiskReader::ScopedBatch::ScopedBatch(BatchedDiskReader* r):
+	reader(r),
+	previousReader(currentBatchedDiskReader)
+{
+	if (reader != nullptr && reader->isSupported())
+		currentBatchedDiskReader = reader;
+	else
+		reader = nullptr;
+}
+
+BatchedDiskReader::ScopedBatch::~ScopedBatch()
+{
+	if (reader != nullptr)
+	{
+		currentBatchedDiskReader = previousReader;
+		reader->submitAndWait();
+	}
+}
+
+BatchedDiskReader* BatchedDiskReader::getCurrent()
+{
+	return currentBatchedDiskReader;
+}
+
+bool BatchedDiskReader::isSupported() const noexcept
+{
+	return pimpl->isValid();
+}
+
+bool BatchedDiskReader::addRead(const File& f, int64 byteOffset, void* destination, int numBytes, const CompletionFunction& onCompletion)
+{
+	if (!isSupported() || numBytes <= 0)
+		return false;
+
+	auto fd = getFileHandle(f);
+
+	if (fd < 0)
+		return false;
+
+	auto d = static_cast<uint8*>(destination);
+	auto isStaging = d >= pimpl->staging.get() && d < pimpl->staging.get() + pimpl->stagingSize;
+
+	pendingRequests.push_back({ fd, byteOffset, destination, numBytes, isStaging, false, onCompletion });
+	return true;
+}
+
+void* BatchedDiskReader::allocateStagingMemory(int numBytes)
+{
+	if (!isSupported() || stagingPosition + numBytes > pimpl->stagingSize)
+		return nullptr;
+
+	auto ptr = pimpl->staging.get() + stagingPosition;
+
+	// keep the chunks aligned
+	stagingPosition += (numBytes + 15) & ~15;
+	return ptr;
+}
+
+void BatchedDiskReader::addBatchCompletion(const CompletionFunction& f)
+{
+	batchCompletions.push_back(f);
+}
+
+int BatchedDiskReader::submitAndWait()
+{
+	auto numRequests = (int)pendingRequests.size();
+
+	if (numRequests > 0)
+	{
+		numSubmissions += pimpl->submit(pendingRequests, [this](int index, int result)
+		{
+			if (isPositiveAndBelow(index, (int)pendingRequests.size()))
+			{
+				auto& r = pendingRequests[(size_t)index];
+
+				if (!r.finished)
+					finishRequest(r, result);
+			}
+		});
+
+		numReads += numRequests;
+	}
+
+	for (const auto& f : batchCompletions)
+		f();
+
+	pendingRequests.clear();
+	batchCompletions.clear();
+	stagingPosition = 0;
+
+	pimpl->closeStaleFileHandles();
+
+	return numRequests;
+}
+
+int BatchedDiskReader::getFileHandle(const File& f)
+{
+	return pimpl->getFileHandle(f);
+}
+
+void BatchedDiskReader::finishRequest(Request& r, int numBytesRead)
+{
+	r.finished = true;
+	numBytesRead = jmax(0, numBytesRead);
+
+	// Read the rest after a short read (or if the read operation failed)
+	if (numBytesRead < r.numBytes)
+		numBytesRead += pimpl->readSynchronously(r.fileHandle, r.byteOffset + numBytesRead, static_cast<uint8*>(r.destination) + numBytesRead, r.numBytes - numBytesRead);
+
+	if (numBytesRead < r.numBytes)
+		zeromem(static_cast<uint8*>(r.destination) + numBytesRead, (size_t)(r.numBytes - numBytesRead));
+
+	if (r.onCompletion)
+		r.onCompletion();
+}
+
+} // namespace hise
@@ -0,0 +1,138 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#ifndef BATCHEDDISKREADER_H_INCLUDED
+#define BATCHEDDISKREADER_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** Collects multiple read operations and submits them with a single system call.
+
+	If a batch is active on the current thread (see ScopedBatch), the StreamingSamplerSound::FileReader will
+	defer all reads from uncompressed monoliths into this object instead of reading them directly. When the
+	batch goes out of scope, all reads are submitted at once through io_uring, so the SSD can process them in
+	parallel instead of one blocking read after another.
+
+	This is only available on Linux (see HISE_USE_IO_URING). On all other platforms isSupported() returns false
+	and the streaming threads will read the data directly.
+*/
+class BatchedDiskReader
+{
+public:
+
+	using CompletionFunction = std::function<void()>;
+
+	/** Creates a reader with the given queue depth and the size (in bytes) of the registered staging memory. */
+	BatchedDiskReader(int queueDepth=256, int stagingBufferSize=4 * 1024 * 1024);
+
+	~BatchedDiskReader();
+
+	/** Activates the batch for the current thread and submits all reads when it goes out of scope. */
+	struct ScopedBatch
+	{
+		ScopedBatch(BatchedDiskReader* r);
+		~ScopedBatch();
+
+	private:
+
+		BatchedDiskReader* reader;
+		BatchedDiskReader* previousReader;
+	};
+
+	/** Returns the reader that is active on the current thread (or nullptr if there is no batch). */
+	static BatchedDiskReader* getCurrent();
+
+	/** Returns true if the platform supports batched reads and the ring was initialised successfully. */
+	bool isSupported() const noexcept;
+
+	/** Adds a read operation to the batch.
+
+		The destination must stay valid until the batch was submitted. The completion function will be called
+		after the data has been read (if the read fails or reaches the end of the file, the remaining bytes will be
+		zeroed). Returns false if the read can't be deferred - in this case you have to read the data yourself.
+	*/
+	bool addRead(const File& f, int64 byteOffset, void* destination, int numBytes, const CompletionFunction& onCompletion);
+
+	/** Returns a chunk of the registered staging memory that can be used as read destination or nullptr if the
+		staging memory is exhausted. The memory is valid until the batch was submitted. */
+	void* allocateStagingMemory(int numBytes);
+
+	/** Adds a function that will be called after all reads of this batch have been completed. */
+	void addBatchCompletion(const CompletionFunction& f);
+
+	/** Submits all pending reads, waits for them and calls the completion functions. Returns the number of reads. 
+	
+		After the batch, the file handles of files that have been replaced on disk are closed, so that the next
+		read opens the new file.
+	*/
+	int submitAndWait();
+
+	/** Returns the number of system calls that were used to submit all reads so far. */
+	int64 getNumSubmissions() const noexcept { return numSubmissions; }
+
+	/** Returns the number of read operations that were processed so far. */
+	int64 getNumReads() const noexcept { return numReads; }
+
+private:
+
+	struct Request
+	{
+		int fileHandle;
+		int64 byteOffset;
+		void* destination;
+		int numBytes;
+		bool isStaging;
+		bool finished;
+		CompletionFunction onCompletion;
+	};
+
+	int getFileHandle(const File& f);
+
+	void finishRequest(Request& r, int numBytesRead);
+
+	std::vector<Request> pendingRequests;
+	std::vector<CompletionFunction> batchCompletions;
+
+	int stagingPosition = 0;
+	int64 numSubmissions = 0;
+	int64 numReads = 0;
+
+	struct Pimpl;
+	ScopedPointer<Pimpl> pimpl;
+
+	JUCE_DECLARE_NON_COPYABLE(BatchedDiskReader);
+};
+
+} // namespace hise
+
+#endif  // BATCHEDDISKREADER_H_INCLUDED
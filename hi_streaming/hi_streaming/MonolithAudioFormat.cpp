@@ -278,6 +278,9 @@ void HlacMonolithInfo::fillMetadataInfo(const ValueTree& sampleMap)
 		sampleInfo.push_back(info);
 	}
 
+	uncompressedChannels.clear();
+	cacheKeys.clear();
+
 	for (auto& mf: monolithicFiles)
 	{
         if(mf.getSize() == 0)
@@ -286,6 +289,11 @@ void HlacMonolithInfo::fillMetadataInfo(const ValueTree& sampleMap)
             throw StreamingSamplerSound::LoadingError(mf.getFileName(), "File is corrupt");
         }
 
+		// The old monolith format stores the raw 16 bit data after the first byte
+		hlac::HiseLosslessHeader header(mf);
+		uncompressedChannels.push_back(header.getVersion() < 2 ? (int)header.getNumChannels() : 0);
+		cacheKeys.push_back(StreamingBlockCache::createFileKey(mf));
+
 		ScopedPointer<MemoryMappedAudioFormatReader> reader = hlaf.createMemoryMappedReader(mf);
 
 #if !USE_FALLBACK_READERS_FOR_MONOLITH
@@ -361,6 +369,54 @@ juce::File HlacMonolithInfo::getFile(int channelIndex, int sampleIndex) const
 	return monolithicFiles[fileIndex];
 }
 
+int HlacMonolithInfo::getNumUncompressedChannels(int channelIndex, int sampleIndex) const
+{
+	auto fileIndex = getFileIndex(channelIndex, sampleIndex);
+
+	if (isPositiveAndBelow(fileIndex, uncompressedChannels.size()))
+		return uncompressedChannels[fileIndex];
+
+	return 0;
+}
+
+const uint8* HlacMonolithInfo::getUncompressedData(int channelIndex, int sampleIndex, int64 offset, int64 numSamples, int& numChannelsInFile) const
+{
+	numChannelsInFile = 0;
+
+	if (!isPositiveAndBelow(sampleIndex, sampleInfo.size()))
+		return nullptr;
+
+	auto fileIndex = getFileIndex(channelIndex, sampleIndex);
+
+	auto r = memoryReaders[fileIndex];
+
+	if (r == nullptr || getNumUncompressedChannels(channelIndex, sampleIndex) == 0)
+		return nullptr;
+
+	if (auto data = r->getUncompressedData(sampleInfo[sampleIndex].start + offset, numSamples))
+	{
+		numChannelsInFile = (int)r->numChannels;
+		return data;
+	}
+
+	return nullptr;
+}
+
+bool HlacMonolithInfo::readFromBlockCache(hlac::HiseSampleBuffer& buffer, int startSample, int numSamples, int64 readerPosition, int channelIndex, int sampleIndex)
+{
+	if (!isPositiveAndBelow(sampleIndex, sampleInfo.size()))
+		return false;
+
+	auto fileIndex = getFileIndex(channelIndex, sampleIndex);
+
+	auto r = memoryReaders[fileIndex];
+
+	if (r == nullptr || !r->isCompressed() || !isPositiveAndBelow(fileIndex, cacheKeys.size()))
+		return false;
+
+	return blockCache->read(cacheKeys[fileIndex], *r, buffer, startSample, numSamples, sampleInfo[sampleIndex].start + readerPosition);
+}
+
 juce::AudioFormatReader* HlacMonolithInfo::createUserInterfaceReader(int sampleIndex, int channelIndex)
 {
 	if (isPositiveAndBelow(sampleIndex, sampleInfo.size()))
@@ -147,14 +147,29 @@ public:
 	/** Use this for UI rendering stuff to avoid multithreading issues. */
 	AudioFormatReader* createUserInterfaceReader(int sampleIndex, int channelIndex);
 
+	/** Returns the monolith file that contains the given sample. */
+	File getFile(int channelIndex, int sampleIndex) const;
+
+	/** Returns the amount of channels if the monolith file stores uncompressed 16 bit data or 0 if it needs decoding. */
+	int getNumUncompressedChannels(int channelIndex, int sampleIndex) const;
+
+	/** Returns a pointer to the mapped data of the given sample if it is stored as uncompressed 16 bit data.
+	
+		The data is interleaved, numChannels will be set to the number of channels in the file. Returns nullptr if the
+		file is compressed or not memory mapped. The samples might not be aligned, see 
+		HlacMemoryMappedAudioFormatReader::getUncompressedData().
+	*/
+	const uint8* getUncompressedData(int channelIndex, int sampleIndex, int64 offset, int64 numSamples, int& numChannels) const;
+
+	/** Reads the compressed data through the process-wide block cache. Returns false if the cache can't be used. */
+	bool readFromBlockCache(hlac::HiseSampleBuffer& buffer, int startSample, int numSamples, int64 readerPosition, int channelIndex, int sampleIndex);
+
 	using Ptr = ReferenceCountedObjectPtr<HlacMonolithInfo>;
 
 private:
 
 	int getFileIndex(int channelIndex, int sampleIndex) const;
 
-	File getFile(int channelIndex, int sampleIndex) const;
-
 	struct SampleInfo
 	{
 		double sampleRate;
@@ -174,12 +189,16 @@ private:
 	std::vector<SampleInfo> sampleInfo;
 
 	std::vector<File> monolithicFiles;
+	std::vector<int> uncompressedChannels;
 
 	int numChannels = 0;
 	int numSplitFiles = 0;
 
 	OwnedArray<hlac::HiseLosslessAudioFormatReader> fallbackReaders;
 	OwnedArray<hlac::HlacMemoryMappedAudioFormatReader> memoryReaders;
+
+	SharedResourcePointer<StreamingBlockCache> blockCache;
+	std::vector<uint64> cacheKeys;
 };
 
 
@@ -0,0 +1,219 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+namespace hise { using namespace juce;
+
+class ParallelPreloader::Worker : public Thread
+{
+public:
+
+	Worker(ParallelPreloader& parent_, const ShouldExitFunction& shouldExit_, int index) :
+		Thread("Sample Preloader " + String(index)),
+		parent(parent_),
+		shouldExit(shouldExit_)
+	{}
+
+	void run() override
+	{
+		while (!threadShouldExit() && parent.processNextJob(shouldExit))
+			;
+	}
+
+private:
+
+	ParallelPreloader& parent;
+	const ShouldExitFunction& shouldExit;
+};
+
+int ParallelPreloader::JobSorter::compareElements(const Job& first, const Job& second)
+{
+	auto fileResult = first.file.compare(second.file);
+
+	if (fileResult != 0)
+		return fileResult;
+
+	if (first.offset != second.offset)
+		return first.offset < second.offset ? -1 : 1;
+
+	if (first.sound.get() != second.sound.get())
+		return first.sound.get() < second.sound.get() ? -1 : 1;
+
+	return 0;
+}
+
+ParallelPreloader::ParallelPreloader(int numThreads_):
+	numThreads(jmax(1, numThreads_))
+{
+}
+
+ParallelPreloader::~ParallelPreloader()
+{
+}
+
+void ParallelPreloader::addSound(StreamingSamplerSound* s, int preloadSize)
+{
+	if (s == nullptr)
+		return;
+
+	Job j;
+	j.sound = s;
+	j.preloadSize = preloadSize;
+	j.file = s->getSourceFile().getFullPathName();
+	j.offset = s->getMonolithOffset();
+
+	jobs.add(j);
+}
+
+void ParallelPreloader::sortJobs()
+{
+	JobSorter sorter;
+	jobs.sort(sorter);
+
+	// A sound might be used by multiple samples, so we remove the duplicates
+	// (they are next to each other after sorting)...
+	for (int i = jobs.size() - 1; i > 0; i--)
+	{
+		if (jobs.getReference(i).sound == jobs.getReference(i - 1).sound)
+			jobs.remove(i);
+	}
+
+	// ... and hand out the files round-robin so that the workers don't queue up at the reader of a single file
+	Array<Range<int>> fileRanges;
+
+	for (int i = 0; i < jobs.size();)
+	{
+		int end = i + 1;
+
+		while (end < jobs.size() && jobs.getReference(end).file == jobs.getReference(i).file)
+			end++;
+
+		fileRanges.add({ i, end });
+		i = end;
+	}
+
+	if (fileRanges.size() < 2)
+		return;
+
+	Array<Job> interleaved;
+	interleaved.ensureStorageAllocated(jobs.size());
+
+	for (int offset = 0; interleaved.size() < jobs.size(); offset++)
+	{
+		for (const auto& r : fileRanges)
+		{
+			if (r.getStart() + offset < r.getEnd())
+				interleaved.add(jobs.getReference(r.getStart() + offset));
+		}
+	}
+
+	jobs.swapWith(interleaved);
+}
+
+bool ParallelPreloader::run(const ShouldExitFunction& shouldExit, double& progress, Range<double> progressRange)
+{
+	sortJobs();
+
+	nextJob.store(0);
+	numFinished.store(0);
+	aborted.store(false);
+	firstError = nullptr;
+
+	auto updateProgress = [&]()
+	{
+		auto ratio = (double)numFinished.load() / (double)jmax(1, jobs.size());
+		progress = progressRange.getStart() + ratio * progressRange.getLength();
+	};
+
+	OwnedArray<Worker> workers;
+
+	const int numWorkers = jmin(numThreads, jobs.size()) - 1;
+
+	for (int i = 0; i < numWorkers; i++)
+	{
+		workers.add(new Worker(*this, shouldExit, i + 1));
+		workers.getLast()->startThread(5);
+	}
+
+	while (processNextJob(shouldExit))
+		updateProgress();
+
+	for (auto w : workers)
+	{
+		while (!w->waitForThreadToExit(20))
+			updateProgress();
+	}
+
+	updateProgress();
+
+	return !aborted.load();
+}
+
+bool ParallelPreloader::processNextJob(const ShouldExitFunction& shouldExit)
+{
+	if (aborted.load())
+		return false;
+
+	if (shouldExit && shouldExit())
+	{
+		aborted.store(true);
+		return false;
+	}
+
+	auto index = nextJob.fetch_add(1);
+
+	if (index >= jobs.size())
+		return false;
+
+	auto& j = jobs.getReference(index);
+
+	try
+	{
+		j.sound->setPreloadSize(j.sound->hasActiveState() ? j.preloadSize : 0, true);
+		j.sound->closeFileHandle();
+	}
+	catch (StreamingSamplerSound::LoadingError& l)
+	{
+		ScopedLock sl(errorLock);
+
+		if (firstError == nullptr)
+			firstError = new StreamingSamplerSound::LoadingError(l);
+
+		aborted.store(true);
+		return false;
+	}
+
+	numFinished.fetch_add(1);
+	return true;
+}
+
+} // namespace hise
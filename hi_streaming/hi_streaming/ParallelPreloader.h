@@ -0,0 +1,118 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#ifndef PARALLELPRELOADER_H_INCLUDED
+#define PARALLELPRELOADER_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** Fills the preload buffers of a list of sounds using multiple threads.
+
+	Add all sounds that need to be preloaded with addSound() and then call run() on the loading thread. The sounds
+	are sorted by their position in the file, so that every monolith is read from the start to the end instead of
+	jumping around in the file. All sounds of a monolith are decoded by the same reader (which can only decode one
+	block at a time), so the queue alternates between the files to let the workers decode different files at the
+	same time. The calling thread takes part in the loading and updates the progress value, so nothing else writes
+	to it while the workers are running.
+
+	If a sound fails to load, the remaining sounds will be skipped and getFirstError() returns the error.
+*/
+class ParallelPreloader
+{
+public:
+
+	using ShouldExitFunction = std::function<bool()>;
+
+	/** Creates a preloader. The number of threads includes the calling thread, so 1 will load everything serially. */
+	ParallelPreloader(int numThreads=HISE_NUM_PRELOAD_THREADS);
+
+	~ParallelPreloader();
+
+	/** Adds a sound with the given preload size. If a sound is added multiple times, it will only be loaded once. */
+	void addSound(StreamingSamplerSound* s, int preloadSize);
+
+	/** Returns the number of sounds in the queue. */
+	int getNumSounds() const noexcept { return jobs.size(); }
+
+	/** Loads all sounds and returns when they are done.
+
+		The shouldExit function is checked before every sound, so pass in the threadShouldExit() method of the
+		loading thread to keep the loading cancelable. The progress is scaled to the given range.
+
+		Returns false if the loading was cancelled or a sound failed to load.
+	*/
+	bool run(const ShouldExitFunction& shouldExit, double& progress, Range<double> progressRange={0.0, 1.0});
+
+	/** Returns the error of the first sound that failed to load (or nullptr). */
+	const StreamingSamplerSound::LoadingError* getFirstError() const noexcept { return firstError.get(); }
+
+private:
+
+	struct Job
+	{
+		StreamingSamplerSound::Ptr sound;
+		int preloadSize;
+		String file;
+		int64 offset;
+	};
+
+	struct JobSorter
+	{
+		static int compareElements(const Job& first, const Job& second);
+	};
+
+	class Worker;
+
+	/** Loads the next sound from the queue. Returns false if there are no more sounds to load. */
+	bool processNextJob(const ShouldExitFunction& shouldExit);
+
+	/** Sorts the jobs by file and position, removes duplicates and interleaves the files. */
+	void sortJobs();
+
+	const int numThreads;
+
+	Array<Job> jobs;
+
+	std::atomic<int> nextJob { 0 };
+	std::atomic<int> numFinished { 0 };
+	std::atomic<bool> aborted { false };
+
+	CriticalSection errorLock;
+	ScopedPointer<StreamingSamplerSound::LoadingError> firstError;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParallelPreloader);
+};
+
+} // namespace hise
+
+#endif  // PARALLELPRELOADER_H_INCLUDED
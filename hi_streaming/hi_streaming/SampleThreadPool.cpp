@@ -35,60 +35,389 @@ namespace hise { using namespace juce;
 
 struct SampleThreadPool::Pimpl
 {
-	Pimpl() :
-		jobQueue(8192),
-		currentlyExecutedJob(nullptr),
-		diskUsage(0.0)
-	{};
+	struct QueuedJob
+	{
+		// the heap functions create a max heap, so the earliest deadline must compare as the largest element
+		bool operator<(const QueuedJob& other) const noexcept { return deadline > other.deadline; }
+
+		WeakReference<Job> job;
+		int64 deadline = 0;
+		bool hasDeadline = false;
+		Job::JobStatus status = Job::jobHasFinished;
+	};
+
+	struct WorkerState
+	{
+		std::atomic<double> diskUsage { 0.0 };
+		std::atomic<int> numMissedDeadlines { 0 };
+		std::atomic<bool> idle { false };
+		std::atomic<Job*> currentlyExecutedJob { nullptr };
+		int64 startTime = 0, endTime = 0;
+
+		std::vector<QueuedJob> currentBatch;
+		ScopedPointer<BatchedDiskReader> diskReader;
+	};
+
+	class Worker : public Thread
+	{
+	public:
+
+		Worker(SampleThreadPool& parent_, int workerIndex_) :
+			Thread("Sample Streaming Thread " + String(workerIndex_), HISE_DEFAULT_STACK_SIZE),
+			parent(parent_),
+			workerIndex(workerIndex_)
+		{};
+
+		void run() override
+		{
+			while (!threadShouldExit())
+				parent.pimpl->runNextJob(parent, *this, workerIndex);
+		}
+
+	private:
+
+		SampleThreadPool& parent;
+		const int workerIndex;
+	};
+
+	Pimpl(int numWorkers) :
+		jobQueue(8192)
+	{
+		mainThreadJobs.reserve(8192);
+		workerJobs.reserve(8192);
+
+		for (int i = 0; i < jmax(1, numWorkers); i++)
+		{
+			auto s = workerStates.add(new WorkerState());
+			s->currentBatch.reserve(MaxBatchSize);
+
+			ScopedPointer<BatchedDiskReader> reader = new BatchedDiskReader();
+
+			if (reader->isSupported())
+				s->diskReader = reader.release();
+		}
+	};
 
 	~Pimpl()
 	{
-		if (auto currentJob = currentlyExecutedJob.load())
+		for (auto s : workerStates)
+		{
+			if (auto currentJob = s->currentlyExecutedJob.load())
+				currentJob->signalJobShouldExit();
+		}
+	}
+
+	void wakeUpWorker(SampleThreadPool& p, bool anyWorker)
+	{
+		if (anyWorker)
+		{
+			for (int i = 0; i < workerStates.size(); i++)
+			{
+				if (workerStates[i]->idle.load())
+				{
+					getThread(p, i).notify();
+					return;
+				}
+			}
+
+			// all workers are busy, so signal everybody to pick up the job as soon as possible
+			for (int i = 1; i < workerStates.size(); i++)
+				getThread(p, i).notify();
+		}
+
+		p.notify();
+	}
+
+	Thread& getThread(SampleThreadPool& p, int workerIndex)
+	{
+		if (workerIndex == 0)
+			return p;
+
+		return *workers[workerIndex - 1];
+	}
+
+	/** Moves the jobs from the lockfree queue into the deadline sorted heaps. Must be called with the queueLock. */
+	void drainIncomingJobs()
+	{
+		WeakReference<Job> next;
+
+		while (jobQueue.try_dequeue(next))
+		{
+			if (auto j = next.get())
+			{
+				auto d = j->deadline.load();
+
+				// Jobs without a deadline are due right now
+				pushJob(j, d != 0 ? d : Time::getHighResolutionTicks(), d != 0);
+			}
+		}
+	}
+
+	void pushJob(Job* j, int64 deadline, bool hasDeadline)
+	{
+		auto& heap = j->canRunOnWorkerThread() ? workerJobs : mainThreadJobs;
+		heap.push_back({ j, deadline, hasDeadline, Job::jobHasFinished });
+		std::push_heap(heap.begin(), heap.end());
+	}
+
+	static QueuedJob popJob(std::vector<QueuedJob>& heap)
+	{
+		std::pop_heap(heap.begin(), heap.end());
+		auto j = heap.back();
+		heap.pop_back();
+		return j;
+	}
+
+	/** Picks the most urgent job that the given worker can execute and marks it as running. 
+	
+		Jobs that are currently executed by another worker will stay in the queue. Must be called with the queueLock.
+	*/
+	QueuedJob popMostUrgentJob(bool isMainThread)
+	{
+		QueuedJob result;
+		Array<QueuedJob> busyJobs;
+
+		while (!workerJobs.empty() || (isMainThread && !mainThreadJobs.empty()))
 		{
-			currentJob->signalJobShouldExit();
+			std::vector<QueuedJob>* heap = &workerJobs;
+
+			if (isMainThread && !mainThreadJobs.empty())
+			{
+				if (workerJobs.empty() || workerJobs.front().deadline > mainThreadJobs.front().deadline)
+					heap = &mainThreadJobs;
+			}
+
+			auto next = popJob(*heap);
+
+			if (auto j = next.job.get())
+			{
+				if (j->isRunning())
+				{
+					busyJobs.add(next);
+					continue;
+				}
+
+				j->running.store(true);
+				result = next;
+				break;
+			}
 		}
+
+		for (const auto& b : busyJobs)
+			pushJob(b.job.get(), b.deadline, b.hasDeadline);
+
+		return result;
 	}
 
-	CriticalSection clearLock;
+	void runNextJob(SampleThreadPool& p, Thread& t, int workerIndex)
+	{
+		auto& state = *workerStates[workerIndex];
+		auto& batch = state.currentBatch;
+		bool moreJobsPending;
+
+		batch.clear();
+
+		{
+			ScopedLock sl(queueLock);
+
+			drainIncomingJobs();
+
+			auto next = popMostUrgentJob(workerIndex == 0);
+
+			if (next.job.get() != nullptr)
+			{
+				batch.push_back(next);
+
+				// Collect the most urgent streaming jobs so that their reads can be submitted at once
+				if (state.diskReader != nullptr && next.job->canRunOnWorkerThread())
+				{
+					while (batch.size() < MaxBatchSize)
+					{
+						auto another = popMostUrgentJob(false);
+
+						if (another.job.get() == nullptr)
+							break;
+
+						batch.push_back(another);
+					}
+				}
+			}
+
+			moreJobsPending = !workerJobs.empty();
+		}
+
+		if (batch.empty())
+		{
+			state.idle.store(true);
+			t.wait(500);
+			state.idle.store(false);
+			return;
+		}
+
+		if (moreJobsPending)
+			wakeUpWorker(p, true);
+
+		ScopedReadLock sl(clearLock);
+
+#if ENABLE_CPU_MEASUREMENT
+		const int64 lastEndTime = state.endTime;
+		state.startTime = Time::getHighResolutionTicks();
+#endif
+
+		{
+			BatchedDiskReader::ScopedBatch sb(batch.size() > 1 ? state.diskReader.get() : nullptr);
+
+			for (auto& next : batch)
+			{
+				auto j = next.job.get();
+
+				if (j == nullptr)
+					continue;
 
-	std::atomic<double> diskUsage;
-	int64 startTime, endTime;
+				if (next.hasDeadline && Time::getHighResolutionTicks() > next.deadline)
+					state.numMissedDeadlines++;
+
+				state.currentlyExecutedJob.store(j);
+				j->currentThread.store(&t);
+
+				next.status = j->runJob();
+			}
+		}
+
+		for (auto& next : batch)
+		{
+			auto j = next.job.get();
+
+			if (j == nullptr)
+				continue;
+
+			if (next.status == Job::jobHasFinished)
+			{
+				j->deadline.store(0);
+				j->queued.store(false);
+				j->running.store(false);
+			}
+			else if (next.status == Job::jobNeedsRunningAgain)
+			{
+				ScopedLock ql(queueLock);
+				j->running.store(false);
+				pushJob(j, next.deadline, next.hasDeadline);
+			}
+		}
+
+		state.currentlyExecutedJob.store(nullptr);
+
+#if ENABLE_CPU_MEASUREMENT
+		state.endTime = Time::getHighResolutionTicks();
+
+		const int64 idleTime = state.startTime - lastEndTime;
+		const int64 busyTime = state.endTime - state.startTime;
+
+		state.diskUsage.store((double)busyTime / (double)(idleTime + busyTime));
+#endif
+	}
+
+	static constexpr size_t MaxBatchSize = 32;
+
+	ReadWriteLock clearLock;
+	CriticalSection queueLock;
+
+	// The job queue has a single producer, but the voices can be rendered on multiple threads
+	SpinLock producerLock;
 	moodycamel::ReaderWriterQueue<WeakReference<Job>> jobQueue;
-	std::atomic<Job*> currentlyExecutedJob;
+	std::vector<QueuedJob> mainThreadJobs;
+	std::vector<QueuedJob> workerJobs;
+
+	OwnedArray<WorkerState> workerStates;
+	OwnedArray<Worker> workers;
+
 	static const String errorMessage;
 };
 
-SampleThreadPool::SampleThreadPool() :
+SampleThreadPool::SampleThreadPool(int numWorkers) :
 	Thread("Sample Loading Thread", HISE_DEFAULT_STACK_SIZE),
-	pimpl(new Pimpl())
+	pimpl(new Pimpl(numWorkers))
 {
+	for (int i = 1; i < pimpl->workerStates.size(); i++)
+		pimpl->workers.add(new Pimpl::Worker(*this, i));
 
 	startThread(9);
-	
+
+	for (auto w : pimpl->workers)
+		w->startThread(9);
 }
 
 SampleThreadPool::~SampleThreadPool()
 {
+	for (auto w : pimpl->workers)
+		w->signalThreadShouldExit();
+
+	for (auto w : pimpl->workers)
+		w->stopThread(1000);
+
 	stopThread(1000);
 	pimpl = nullptr;
 }
 
 double SampleThreadPool::getDiskUsage() const noexcept
 {
-	return pimpl->diskUsage.load();
+	double maxUsage = 0.0;
+
+	for (auto s : pimpl->workerStates)
+		maxUsage = jmax(maxUsage, s->diskUsage.load());
+
+	return maxUsage;
+}
+
+double SampleThreadPool::getDiskUsage(int workerIndex) const noexcept
+{
+	if (auto s = pimpl->workerStates[workerIndex])
+		return s->diskUsage.load();
+
+	return 0.0;
+}
+
+int SampleThreadPool::getNumMissedDeadlines(int workerIndex) const noexcept
+{
+	if (auto s = pimpl->workerStates[workerIndex])
+		return s->numMissedDeadlines.load();
+
+	return 0;
+}
+
+int SampleThreadPool::getNumWorkers() const noexcept
+{
+	return pimpl->workerStates.size();
 }
 
 void SampleThreadPool::clearPendingTasks()
 {
-	ScopedLock sl(pimpl->clearLock);
-		
+	ScopedWriteLock sl(pimpl->clearLock);
+	ScopedLock ql(pimpl->queueLock);
+
+	auto clearJob = [](Job* j)
+	{
+		if (j != nullptr)
+		{
+			j->queued.store(false);
+			j->deadline.store(0);
+			j->signalJobShouldExit();
+		}
+	};
+
 	WeakReference<Job> next;
 
 	while (pimpl->jobQueue.try_dequeue(next))
-	{
-		next->queued.store(false);
-		next->signalJobShouldExit();
-	}
+		clearJob(next.get());
+
+	for (auto& qj : pimpl->mainThreadJobs)
+		clearJob(qj.job.get());
+
+	for (auto& qj : pimpl->workerJobs)
+		clearJob(qj.job.get());
+
+	pimpl->mainThreadJobs.clear();
+	pimpl->workerJobs.clear();
 }
 
 void SampleThreadPool::addJob(Job* jobToAdd, bool unused)
@@ -102,84 +431,40 @@ void SampleThreadPool::addJob(Job* jobToAdd, bool unused)
 	}
 #endif
 
-
 	jobToAdd->queued.store(true);
-	pimpl->jobQueue.enqueue(jobToAdd);
 
-	notify();
+	{
+		SpinLock::ScopedLockType sl(pimpl->producerLock);
+		pimpl->jobQueue.enqueue(jobToAdd);
+	}
+
+	pimpl->wakeUpWorker(*this, jobToAdd->canRunOnWorkerThread() && !pimpl->workers.isEmpty());
 }
 
 void SampleThreadPool::run()
 {
 	while (!threadShouldExit())
 	{
-		WeakReference<Job> next;
-
-		if (pimpl->jobQueue.try_dequeue(next))
-		{
-			ScopedLock sl(pimpl->clearLock);
-
-			Job* j = next.get();
-
-#if ENABLE_CPU_MEASUREMENT
-
-			const int64 lastEndTime = pimpl->endTime;
-			pimpl->startTime = Time::getHighResolutionTicks();
-#endif
-
-			if (j != nullptr)
-			{
-				pimpl->currentlyExecutedJob.store(j);
-
-				j->currentThread.store(this);
-
-				j->running.store(true);
-				
-				Job::JobStatus status = j->runJob();
-
-				j->running.store(false);
-
-				if (status == Job::jobHasFinished)
-				{
-					j->queued.store(false);
-				}
-				else if (status == Job::jobNeedsRunningAgain)
-				{
-					pimpl->jobQueue.enqueue(next);
-				}
-
-				pimpl->currentlyExecutedJob.store(nullptr);
-			}
-			else
-			{
-				pimpl->jobQueue.pop();
-			}
-
-#if ENABLE_CPU_MEASUREMENT
-			pimpl->endTime = Time::getHighResolutionTicks();
-
-			const int64 idleTime = pimpl->startTime - lastEndTime;
-			const int64 busyTime = pimpl->endTime - pimpl->startTime;
-
-			pimpl->diskUsage.store((double)busyTime / (double)(idleTime + busyTime));
-#endif
-		}
+		pimpl->runNextJob(*this, *this, 0);
+	}
+}
 
-#if 0 // Set this to true to enable defective threading (for debugging purposes)
-		wait(2500);
-#else
-		else
-		{
-			wait(500);
-		}
-#endif
+const String SampleThreadPool::Pimpl::errorMessage("HDD overflow");
 
 
+void SampleThreadPool::Job::setDeadlineInSamples(double numSamplesUntilDeadline, double samplesPerSecond) noexcept
+{
+	if (samplesPerSecond <= 0.0)
+	{
+		deadline.store(0);
+		return;
 	}
-}
 
-const String SampleThreadPool::Pimpl::errorMessage("HDD overflow");
+	auto secondsUntilDeadline = jmax(0.0, numSamplesUntilDeadline) / samplesPerSecond;
+	auto ticksUntilDeadline = (int64)(secondsUntilDeadline * (double)Time::getHighResolutionTicksPerSecond());
 
+	deadline.store(Time::getHighResolutionTicks() + ticksUntilDeadline);
+}
 
 void SampleThreadPool::Job::resetJob()
 {
@@ -187,6 +472,7 @@ void SampleThreadPool::Job::resetJob()
 	running.store(false);
 	shouldStop.store(false);
 	currentThread.store(nullptr);
+	deadline.store(0);
 }
 
 } // namespace hise
@@ -35,11 +35,19 @@
 
 namespace hise { using namespace juce;
 
+/** The background thread pool that performs all disk streaming operations.
+
+	It consists of the main loading thread (the SampleThreadPool object itself) and a configurable amount of
+	additional worker threads. Every job carries a deadline and the workers will always pick the most urgent job
+	from the queue, so a slow read operation of one voice will not stall the voices that are about to run dry.
+
+	Jobs that can't run in parallel (preloading, unmapping etc) will always be executed by the main loading thread.
+*/
 class SampleThreadPool : public Thread
 {
 public:
 
-	SampleThreadPool();
+	SampleThreadPool(int numWorkers=HISE_NUM_STREAMING_THREADS);
 
 	~SampleThreadPool();
 	
@@ -52,7 +60,8 @@ public:
 			name(name_),
 			queued(false),
 			running(false),
-			shouldStop(false)
+			shouldStop(false),
+			deadline(0)
 		{};
         
         virtual ~Job() { masterReference.clear(); }
@@ -65,6 +74,12 @@ public:
 
 		virtual JobStatus runJob() = 0;
 
+		/** Override this and return true if the job can be executed by any worker of the pool.
+		
+			Jobs that return false will always be executed by the main loading thread.
+		*/
+		virtual bool canRunOnWorkerThread() const { return false; }
+
 		bool shouldExit() const noexcept{ return shouldStop.load(); }
 
 		void signalJobShouldExit() { shouldStop.store(true); }
@@ -73,6 +88,16 @@ public:
 
 		bool isQueued() const noexcept{ return queued.load(); };
 
+		/** Sets the deadline of the job to the time when the given amount of samples will be consumed. 
+		
+			Call this before adding the job to the pool. If no deadline is set, the job will be treated as if
+			it is due when it's added to the pool.
+		*/
+		void setDeadlineInSamples(double numSamplesUntilDeadline, double samplesPerSecond) noexcept;
+
+		/** Returns the deadline in high resolution ticks (or 0 if no deadline is set). */
+		int64 getDeadline() const noexcept { return deadline.load(); }
+
 	protected:
 
 		void resetJob();
@@ -89,12 +114,23 @@ public:
 		std::atomic<bool> running;
 		std::atomic<bool> shouldStop;
 		std::atomic<Thread*> currentThread;
+		std::atomic<int64> deadline;
 
 		const String name;
 	};
 
+	/** Returns the highest disk usage of all workers. */
 	double getDiskUsage() const noexcept;
 
+	/** Returns the disk usage of the given worker (0 is the main loading thread). */
+	double getDiskUsage(int workerIndex) const noexcept;
+
+	/** Returns the number of jobs that the given worker started after their deadline has passed. */
+	int getNumMissedDeadlines(int workerIndex) const noexcept;
+
+	/** Returns the number of workers including the main loading thread. */
+	int getNumWorkers() const noexcept;
+
 	void clearPendingTasks();
 
 	void addJob(Job* jobToAdd, bool unused);
@@ -0,0 +1,290 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+namespace hise { using namespace juce;
+
+double StreamingBlockCache::Statistics::getHitRate() const noexcept
+{
+	const auto numReads = numHits + numMisses;
+	return numReads > 0 ? (double)numHits / (double)numReads : 0.0;
+}
+
+StreamingBlockCache::StreamingBlockCache()
+{
+	setMemoryBudget((size_t)HISE_STREAMING_BLOCK_CACHE_SIZE * 1024 * 1024);
+}
+
+StreamingBlockCache::~StreamingBlockCache()
+{
+	setMemoryBudget(0);
+}
+
+/** Blocks all new reads and waits until the pending ones are finished. */
+struct StreamingBlockCache::ScopedExclusiveAccess
+{
+	ScopedExclusiveAccess(StreamingBlockCache& c) :
+		parent(c),
+		sl(c.resizeLock)
+	{
+		parent.resizing.store(true);
+
+		while (parent.numActiveReads.load() > 0)
+			Thread::yield();
+	}
+
+	~ScopedExclusiveAccess()
+	{
+		parent.resizing.store(false);
+	}
+
+	StreamingBlockCache& parent;
+	const ScopedLock sl;
+};
+
+void StreamingBlockCache::setMemoryBudget(size_t newMemoryBudgetInBytes)
+{
+	ScopedExclusiveAccess sea(*this);
+
+	// Every block holds two channels of 16 bit samples
+	const size_t bytesPerSet = (size_t)BlockSize * 2 * sizeof(int16) * NumWays;
+
+	memoryBudget = newMemoryBudgetInBytes;
+	numSets = (int)(memoryBudget / bytesPerSet);
+	blocks.reset(numSets > 0 ? new Block[numSets * NumWays] : nullptr);
+}
+
+void StreamingBlockCache::clear()
+{
+	ScopedExclusiveAccess sea(*this);
+
+	for (int i = 0; i < numSets * NumWays; i++)
+		blocks[i].key.store(0);
+}
+
+bool StreamingBlockCache::read(uint64 fileKey, hlac::HlacMemoryMappedAudioFormatReader& reader, hlac::HiseSampleBuffer& destination, int startSample, int numSamples, int64 startSampleInFile)
+{
+	if (destination.isFloatingPoint() || !reader.isCompressed() || fileKey == 0)
+		return false;
+
+	if (!enterRead())
+		return false;
+
+	const int numChannels = (int)reader.numChannels;
+
+	while (numSamples > 0)
+	{
+		const int64 blockIndex = startSampleInFile / BlockSize;
+		const int offsetInBlock = (int)(startSampleInFile % BlockSize);
+		const int numThisTime = jmin(numSamples, BlockSize - offsetInBlock);
+		const uint64 blockKey = getBlockKey(fileKey, blockIndex);
+
+		if (copyFromCache(blockKey, destination, startSample, offsetInBlock, numThisTime))
+		{
+			++numHits;
+		}
+		else
+		{
+			++numMisses;
+
+			if (auto b = acquireBlockForWriting(blockKey))
+			{
+				const int64 blockStart = blockIndex * (int64)BlockSize;
+
+				if (b->data.getNumSamples() != BlockSize || b->data.getNumChannels() != numChannels)
+					b->data = hlac::HiseSampleBuffer(false, numChannels, BlockSize);
+
+				b->numSamples = (int)jlimit<int64>(0, BlockSize, reader.lengthInSamples - blockStart);
+				b->isMono = numChannels == 1;
+
+				b->data.clear();
+				reader.readIntoFixedBuffer(b->data, 0, b->numSamples, blockStart);
+
+				copyFromBlock(*b, destination, startSample, offsetInBlock, numThisTime);
+
+				// Publish the block after the data is written
+				b->key.store(blockKey);
+				b->numUsers.store(0);
+			}
+			else
+			{
+				// All blocks of this set are being used right now, so we skip the cache
+				reader.readIntoFixedBuffer(destination, startSample, numThisTime, startSampleInFile);
+			}
+		}
+
+		startSample += numThisTime;
+		startSampleInFile += numThisTime;
+		numSamples -= numThisTime;
+	}
+
+	if (numChannels == 1)
+		destination.setUseOneMap(true);
+
+	exitRead();
+	return true;
+}
+
+StreamingBlockCache::Statistics StreamingBlockCache::getStatistics() const
+{
+	Statistics s;
+
+	s.numHits = numHits.load();
+	s.numMisses = numMisses.load();
+	s.numEvictions = numEvictions.load();
+	s.memoryBudget = memoryBudget;
+	s.numBlocks = numSets * NumWays;
+
+	return s;
+}
+
+void StreamingBlockCache::resetStatistics()
+{
+	numHits.store(0);
+	numMisses.store(0);
+	numEvictions.store(0);
+}
+
+static uint64 mixStreamingCacheKey(uint64 x) noexcept
+{
+	x += 0x9e3779b97f4a7c15ULL;
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+	return x ^ (x >> 31);
+}
+
+uint64 StreamingBlockCache::createFileKey(const File& f)
+{
+	auto key = mixStreamingCacheKey((uint64)f.getFullPathName().hashCode64());
+	key = mixStreamingCacheKey(key ^ (uint64)f.getSize());
+	key = mixStreamingCacheKey(key ^ (uint64)f.getLastModificationTime().toMilliseconds());
+
+	return key != 0 ? key : 1;
+}
+
+uint64 StreamingBlockCache::getBlockKey(uint64 fileKey, int64 blockIndex) noexcept
+{
+	auto key = mixStreamingCacheKey(fileKey ^ mixStreamingCacheKey((uint64)blockIndex));
+	return key != 0 ? key : 1;
+}
+
+bool StreamingBlockCache::copyFromCache(uint64 blockKey, hlac::HiseSampleBuffer& destination, int startSample, int offsetInBlock, int numSamples)
+{
+	auto set = getSet(blockKey);
+
+	for (int i = 0; i < NumWays; i++)
+	{
+		auto& b = set[i];
+
+		if (b.key.load() != blockKey)
+			continue;
+
+		auto numUsers = b.numUsers.load();
+
+		// The block is being rewritten
+		if (numUsers < 0 || !b.numUsers.compare_exchange_strong(numUsers, numUsers + 1))
+			return false;
+
+		// The block might have been replaced before we've acquired it
+		if (b.key.load() != blockKey)
+		{
+			--b.numUsers;
+			return false;
+		}
+
+		copyFromBlock(b, destination, startSample, offsetInBlock, numSamples);
+		b.lastUsed.store(++useCounter);
+
+		--b.numUsers;
+		return true;
+	}
+
+	return false;
+}
+
+StreamingBlockCache::Block* StreamingBlockCache::acquireBlockForWriting(uint64 blockKey)
+{
+	auto set = getSet(blockKey);
+
+	Block* candidate = nullptr;
+
+	for (int i = 0; i < NumWays; i++)
+	{
+		auto& b = set[i];
+
+		if (b.numUsers.load() != 0)
+			continue;
+
+		if (b.key.load() == 0)
+		{
+			candidate = &b;
+			break;
+		}
+
+		if (candidate == nullptr || (int32)(b.lastUsed.load() - candidate->lastUsed.load()) < 0)
+			candidate = &b;
+	}
+
+	if (candidate == nullptr)
+		return nullptr;
+
+	int expected = 0;
+
+	if (!candidate->numUsers.compare_exchange_strong(expected, -1))
+		return nullptr;
+
+	if (candidate->key.exchange(0) != 0)
+		++numEvictions;
+
+	candidate->lastUsed.store(++useCounter);
+	return candidate;
+}
+
+void StreamingBlockCache::copyFromBlock(const Block& b, hlac::HiseSampleBuffer& destination, int startSample, int offsetInBlock, int numSamples)
+{
+	hlac::HiseSampleBuffer::copy(destination, b.data, startSample, offsetInBlock, numSamples);
+}
+
+bool StreamingBlockCache::enterRead() noexcept
+{
+	++numActiveReads;
+
+	if (resizing.load() || numSets == 0)
+	{
+		--numActiveReads;
+		return false;
+	}
+
+	return true;
+}
+
+} // namespace hise
@@ -0,0 +1,156 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#ifndef STREAMINGBLOCKCACHE_H_INCLUDED
+#define STREAMINGBLOCKCACHE_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** A process-wide cache for decoded blocks of compressed monolith files.
+
+	Without this cache, every voice decodes the HLAC data it streams on its own, so ten voices (or ten plugin
+	instances) that play the same sample will read and decode the same blocks ten times. The cache stores the 
+	decoded blocks (keyed by the monolith file and the block position) so that all voices can share them.
+
+	It is organised as a set associative cache with a least-recently-used eviction within each set. The lookup
+	is lock-free: every block has a user counter that is incremented while its data is copied, and a block
+	will only be replaced if nobody is reading it. If all blocks of a set are busy, the data is decoded directly
+	into the streaming buffer.
+
+	Use it through a SharedResourcePointer so that all samplers of the process share the same instance. The
+	memory budget defaults to HISE_STREAMING_BLOCK_CACHE_SIZE megabytes.
+*/
+class StreamingBlockCache
+{
+public:
+
+	/** The amount of samples in each block (this matches the block size of the HLAC codec). */
+	static constexpr int BlockSize = COMPRESSION_BLOCK_SIZE;
+
+	/** The amount of blocks in each set. */
+	static constexpr int NumWays = 8;
+
+	struct Statistics
+	{
+		/** Returns the ratio of blocks that were found in the cache. */
+		double getHitRate() const noexcept;
+
+		int64 numHits = 0;
+		int64 numMisses = 0;
+		int64 numEvictions = 0;
+		size_t memoryBudget = 0;
+		int numBlocks = 0;
+	};
+
+	StreamingBlockCache();
+	~StreamingBlockCache();
+
+	/** Sets the maximum amount of memory (in bytes) that the decoded blocks may use. 
+	
+		This clears the cache and waits until all pending reads are finished. A budget of zero disables the cache.
+	*/
+	void setMemoryBudget(size_t newMemoryBudgetInBytes);
+
+	/** Returns the current memory budget in bytes. */
+	size_t getMemoryBudget() const noexcept { return memoryBudget; }
+
+	/** Removes all cached blocks. */
+	void clear();
+
+	/** Copies the given range of the file into the fixed point buffer.
+
+		Missing blocks are decoded with the reader and added to the cache. Returns false if the cache can't be used
+		for this read operation (it's disabled, the buffer is floating point or the file is not compressed).
+	*/
+	bool read(uint64 fileKey, hlac::HlacMemoryMappedAudioFormatReader& reader, hlac::HiseSampleBuffer& destination, 
+			  int startSample, int numSamples, int64 startSampleInFile);
+
+	/** Returns the hit / miss counters. */
+	Statistics getStatistics() const;
+
+	/** Resets the hit / miss counters. */
+	void resetStatistics();
+
+	/** Creates a key for the given file. The key changes if the file is modified, so a rewritten monolith will not use stale blocks. */
+	static uint64 createFileKey(const File& f);
+
+private:
+
+	struct Block
+	{
+		std::atomic<uint64> key { 0 };
+		std::atomic<int> numUsers { 0 };
+		std::atomic<uint32> lastUsed { 0 };
+
+		hlac::HiseSampleBuffer data;
+		int numSamples = 0;
+		bool isMono = false;
+	};
+
+	static uint64 getBlockKey(uint64 fileKey, int64 blockIndex) noexcept;
+
+	/** Copies the data from a cached block. Returns false if the block is not in the cache. */
+	bool copyFromCache(uint64 blockKey, hlac::HiseSampleBuffer& destination, int startSample, int offsetInBlock, int numSamples);
+
+	/** Returns the least recently used block of the set that can be replaced (with its user counter set to -1). */
+	Block* acquireBlockForWriting(uint64 blockKey);
+
+	static void copyFromBlock(const Block& b, hlac::HiseSampleBuffer& destination, int startSample, int offsetInBlock, int numSamples);
+
+	Block* getSet(uint64 blockKey) const noexcept { return blocks.get() + (int)(blockKey % (uint64)numSets) * NumWays; }
+
+	struct ScopedExclusiveAccess;
+
+	bool enterRead() noexcept;
+	void exitRead() noexcept { --numActiveReads; }
+
+	std::unique_ptr<Block[]> blocks;
+	int numSets = 0;
+	size_t memoryBudget = 0;
+
+	std::atomic<int> numActiveReads { 0 };
+	std::atomic<bool> resizing { false };
+	CriticalSection resizeLock;
+
+	std::atomic<uint32> useCounter { 0 };
+
+	std::atomic<int64> numHits { 0 };
+	std::atomic<int64> numMisses { 0 };
+	std::atomic<int64> numEvictions { 0 };
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StreamingBlockCache);
+};
+
+} // namespace hise
+
+#endif  // STREAMINGBLOCKCACHE_H_INCLUDED
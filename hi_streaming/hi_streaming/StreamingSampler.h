@@ -183,11 +183,11 @@ public:
 
 	AudioFormatManager afm;
 
-	int getNumOpenFileHandles() const { return numOpenFileHandles; }
+	int getNumOpenFileHandles() const { return numOpenFileHandles.load(); }
 
 private:
 
-	int numOpenFileHandles = 0;
+	std::atomic<int> numOpenFileHandles { 0 };
 
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StreamingSamplerSoundPool);
 };
@@ -204,8 +204,22 @@ class DebugLogger;
 */
 struct StereoChannelData
 {
-	hlac::HiseSampleBuffer const* b;
+	/** Returns the amount of samples that can be read after the current position. */
+	int getNumSamplesAvailable() const noexcept
+	{
+		return mappedData != nullptr ? numMappedSamples : b->getNumSamples() - offsetInBuffer;
+	}
+
+	hlac::HiseSampleBuffer const* b = nullptr;
 	int offsetInBuffer = 0;
+
+	/** If this is not nullptr, the voice reads the interleaved 16 bit data directly from a memory mapped monolith. 
+	
+		The samples are little endian and might not be aligned to 2 bytes.
+	*/
+	const uint8* mappedData = nullptr;
+	int numMappedChannels = 0;
+	int numMappedSamples = 0;
 };
 
 // ==================================================================================================================================================
@@ -825,6 +825,53 @@ void StreamingSamplerSound::rebuildCrossfadeBuffer()
     
 void StreamingSamplerSound::wakeSound() const { fileReader.wakeSound(); }
 
+bool StreamingSamplerSound::prefetch(int numSamples) const
+{
+	// Reversed samples are always loaded into the preload buffer
+	if (purged || entireSampleLoaded || isReversed() || numSamples <= 0)
+		return false;
+
+	// The first disk read of a voice starts right after the preload buffer
+	int readerPosition = sampleStart + preloadBuffer.getNumSamples();
+	int endPosition = sampleEnd;
+
+	if (loopEnabled && getLoopLength() != 0)
+		endPosition = jmin(endPosition, loopEnd);
+
+	const int numBeforeEnd = jlimit(0, numSamples, endPosition - readerPosition);
+
+	bool ok = fileReader.touchSampleRange(readerPosition, numBeforeEnd);
+
+	if (loopEnabled && getLoopLength() != 0 && numBeforeEnd < numSamples)
+		ok |= fileReader.touchSampleRange(loopStart, jmin(numSamples - numBeforeEnd, getLoopLength()));
+
+	return ok;
+}
+
+const uint8* StreamingSamplerSound::getMappedSampleData(int& numChannels) const
+{
+	numChannels = 0;
+
+#if HISE_SAMPLER_READ_FROM_MAPPED_MONOLITHS
+	if (purged || entireSampleLoaded || isReversed() || isReleaseStartEnabled() || sampleLength <= 0)
+		return nullptr;
+
+	if (loopEnabled && getLoopLength() != 0)
+		return nullptr;
+
+	return fileReader.getUncompressedMonolithData(sampleStart, sampleLength, numChannels);
+#else
+	return nullptr;
+#endif
+}
+
+bool StreamingSamplerSound::prefetchRange(int startSample, int numSamples) const
+{
+	startSample = jmax(0, startSample);
+	numSamples = jmin(numSamples, sampleLength - startSample);
+
+	return fileReader.touchSampleRange(sampleStart + startSample, numSamples);
+}
 
 bool StreamingSamplerSound::hasEnoughSamplesForBlock(int maxSampleIndexInFile) const
 {
@@ -1032,7 +1079,7 @@ void StreamingSamplerSound::fillInternal(hlac::HiseSampleBuffer &sampleBuffer, i
 	// Read all samples from disk
 	else
 	{
-		fileReader.readFromDisk(sampleBuffer, offsetInBuffer, samplesToCopy, uptime, true);
+		fileReader.readFromDisk(sampleBuffer, offsetInBuffer, samplesToCopy, uptime, true, true);
 	}
 }
 
@@ -1147,6 +1194,51 @@ void StreamingSamplerSound::FileReader::wakeSound()
 }
 
 
+const uint8* StreamingSamplerSound::FileReader::getUncompressedMonolithData(int readerPosition, int numSamples, int& numChannels) const
+{
+	numChannels = 0;
+
+	// The readers of monoliths are never closed, so we don't need to lock here
+	if (!isMonolithic() || !fileHandlesOpen)
+		return nullptr;
+
+	return monolithicInfo->getUncompressedData(monolithicChannelIndex, monolithicIndex, readerPosition, numSamples, numChannels);
+}
+
+bool StreamingSamplerSound::FileReader::touchSampleRange(int readerPosition, int numSamples)
+{
+	// Don't open the file handles from here, this is the job of the main loading thread.
+	if (!fileHandlesOpen || numSamples <= 0)
+		return false;
+
+	ScopedReadLock sl(fileAccessLock);
+
+	if (isMonolithic())
+	{
+		if (auto r = dynamic_cast<hlac::HlacSubSectionReader*>(normalReader.get()))
+			return r->touchSampleRange(readerPosition, numSamples);
+
+		return false;
+	}
+
+	if (memoryReader == nullptr || !fileFormatSupportsMemoryReading)
+		return false;
+
+	auto range = memoryReader->getMappedSection().getIntersectionWith(Range<int64>(readerPosition, readerPosition + numSamples));
+
+	if (range.isEmpty())
+		return false;
+
+	const int bytesPerFrame = jmax(1, (int)memoryReader->numChannels * (int)memoryReader->bitsPerSample / 8);
+	const int64 samplesPerPage = jmax(1, 4096 / bytesPerFrame);
+
+	for (auto i = range.getStart(); i < range.getEnd(); i += samplesPerPage)
+		memoryReader->touchSample(i);
+
+	memoryReader->touchSample(range.getEnd() - 1);
+	return true;
+}
+
 void StreamingSamplerSound::FileReader::openFileHandles(NotificationType notifyPool)
 {
 	if (fileHandlesOpen)
@@ -1234,7 +1326,7 @@ void StreamingSamplerSound::FileReader::closeFileHandles(NotificationType notify
 
 
 
-void StreamingSamplerSound::FileReader::readFromDisk(hlac::HiseSampleBuffer &buffer, int startSample, int numSamples, int readerPosition, bool useMemoryMappedReader)
+void StreamingSamplerSound::FileReader::readFromDisk(hlac::HiseSampleBuffer &buffer, int startSample, int numSamples, int readerPosition, bool useMemoryMappedReader, bool useBlockCache)
 {
 	if (!fileHandlesOpen) openFileHandles(sendNotification);
 
@@ -1265,6 +1357,12 @@ void StreamingSamplerSound::FileReader::readFromDisk(hlac::HiseSampleBuffer &buf
 
 	buffer.clear(startSample, numSamples);
 
+	if (auto batch = BatchedDiskReader::getCurrent())
+	{
+		if (addReadToBatch(*batch, buffer, startSample, numSamples, readerPosition))
+			return;
+	}
+
 	if (!isMonolithic() && useMemoryMappedReader)
 	{
 		if (memoryReader != nullptr && memoryReader->getMappedSection().contains(Range<int64>(readerPosition, readerPosition + numSamples)))
@@ -1282,9 +1380,18 @@ void StreamingSamplerSound::FileReader::readFromDisk(hlac::HiseSampleBuffer &buf
 		ScopedReadLock sl(fileAccessLock);
 
 		if (buffer.isFloatingPoint())
+		{
+			ScopedLock readLock(streamReadLock);
 			normalReader->read(buffer.getFloatBufferForFileReader(), startSample, numSamples, readerPosition, true, true);
+		}
 		else
-			dynamic_cast<hlac::HlacSubSectionReader*>(normalReader.get())->readIntoFixedBuffer(buffer, startSample, numSamples, readerPosition);
+		{
+			const bool readFromCache = useBlockCache && isMonolithic() && 
+				monolithicInfo->readFromBlockCache(buffer, startSample, numSamples, readerPosition, monolithicChannelIndex, monolithicIndex);
+
+			if (!readFromCache)
+				dynamic_cast<hlac::HlacSubSectionReader*>(normalReader.get())->readIntoFixedBuffer(buffer, startSample, numSamples, readerPosition);
+		}
 	}
 	else
 	{
@@ -1298,6 +1405,63 @@ void StreamingSamplerSound::FileReader::readFromDisk(hlac::HiseSampleBuffer &buf
 	}
 }
 
+bool StreamingSamplerSound::FileReader::addReadToBatch(BatchedDiskReader& batch, hlac::HiseSampleBuffer &buffer, int startSample, int numSamples, int readerPosition)
+{
+	if (!isMonolithic() || buffer.isFloatingPoint() || numSamples <= 0)
+		return false;
+
+	const int numFileChannels = monolithicInfo->getNumUncompressedChannels(monolithicChannelIndex, monolithicIndex);
+
+	if (numFileChannels == 0)
+		return false;
+
+	const int bytesPerFrame = numFileChannels * (int)sizeof(int16);
+	const int64 byteOffset = 1 + (getMonolithOffset() + (int64)readerPosition) * bytesPerFrame;
+	const int numBytes = numSamples * bytesPerFrame;
+	const bool isReversedRead = isReversed();
+	auto f = monolithicInfo->getFile(monolithicChannelIndex, monolithicIndex);
+
+	if (numFileChannels == 1)
+	{
+		// Mono data can be read straight into the streaming buffer
+		auto destination = buffer.getWritePointer(0, startSample);
+
+		return batch.addRead(f, byteOffset, destination, numBytes, [&buffer, startSample, numSamples, isReversedRead]()
+		{
+			if (buffer.getNumChannels() == 2)
+				memcpy(buffer.getWritePointer(1, startSample), buffer.getReadPointer(0, startSample), sizeof(int16) * numSamples);
+
+			if (isReversedRead)
+				buffer.reverse(startSample, numSamples);
+		});
+	}
+
+	if (buffer.getNumChannels() != 2)
+		return false;
+
+	// Stereo data is interleaved, so it needs to go through the staging memory
+	auto staging = batch.allocateStagingMemory(numBytes);
+
+	if (staging == nullptr)
+		return false;
+
+	return batch.addRead(f, byteOffset, staging, numBytes, [&buffer, staging, startSample, numSamples, isReversedRead]()
+	{
+		auto src = static_cast<const int16*>(staging);
+		auto l = static_cast<int16*>(buffer.getWritePointer(0, startSample));
+		auto r = static_cast<int16*>(buffer.getWritePointer(1, startSample));
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			l[i] = (int16)ByteOrder::swapIfBigEndian((uint16)src[2 * i]);
+			r[i] = (int16)ByteOrder::swapIfBigEndian((uint16)src[2 * i + 1]);
+		}
+
+		if (isReversedRead)
+			buffer.reverse(startSample, numSamples);
+	});
+}
+
 float getAbsoluteValue(float input)
 {
     return input > 0.0f ? input : input * -1.0f;
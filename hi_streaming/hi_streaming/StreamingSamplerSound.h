@@ -275,6 +275,9 @@ public:
 
 	int64 getMonolithOffset() const { return fileReader.getMonolithOffset(); }
 	int64 getMonolithLength() const { return fileReader.getMonolithLength(); }
+
+	/** Returns the file that contains the sample data (for monolithic samples this is the monolith file). */
+	File getSourceFile() const { return fileReader.getSourceFile(); }
 	double getMonolithSampleRate() const { return fileReader.getMonolithSampleRate(); }
 
 	// ==============================================================================================================================================
@@ -307,6 +310,25 @@ public:
 	*/
 	void wakeSound() const;
 
+	/** Loads the data that a voice will stream after the preload buffer into the page cache.
+	*
+	*	This is called by the sample prefetcher on a background thread before the note is started so that the first
+	*	read operation of the voice does not hit the disk. It only touches memory mapped data (monoliths or files that
+	*	are currently opened), so it will not allocate or open file handles. Returns false if nothing could be prefetched.
+	*/
+	bool prefetch(int numSamples) const;
+
+	/** Returns a pointer to the interleaved 16 bit data at the sample start if voices can read it from the mapped file.
+	*
+	*	This is only possible for uncompressed monoliths that are not reversed, looped or use a release start. The pointer
+	*	stays valid as long as the sound exists. Returns nullptr if the data must be streamed. The samples are little
+	*	endian and might not be aligned to 2 bytes.
+	*/
+	const uint8* getMappedSampleData(int& numChannels) const;
+
+	/** Loads the given range of the sample into the page cache (the position is relative to the sample start). */
+	bool prefetchRange(int startSample, int numSamples) const;
+
 	/** Checks if the file is mapped and has enough samples.
 	*
 	*	Call this before you call fillSampleBuffer() to check if the audio file has enough samples.
@@ -378,8 +400,12 @@ private:
 		/** Returns the best reader for the file. If a memorymapped reader can be used, it will return a MemoryMappedAudioFormatReader. */
 		AudioFormatReader *getReader();
 
-		/** Encapsulates all reading operations. It will use the best available reader type and opens the file handle if it is not open yet. */
-		void readFromDisk(hlac::HiseSampleBuffer &buffer, int startSample, int numSamples, int readerPosition, bool useMemoryMappedReader);
+		/** Encapsulates all reading operations. It will use the best available reader type and opens the file handle if it is not open yet. 
+		
+			If useBlockCache is true, compressed monoliths will be decoded through the StreamingBlockCache (use this only
+			for the streaming reads, the preload buffers are already shared between the voices).
+		*/
+		void readFromDisk(hlac::HiseSampleBuffer &buffer, int startSample, int numSamples, int readerPosition, bool useMemoryMappedReader, bool useBlockCache=false);
 
 		/** Call this method if you want to close the file handle. If voices are playing, it won't close it. */
 		void closeFileHandles(NotificationType notifyPool = sendNotification);
@@ -411,6 +437,14 @@ private:
 			return 0;
 		}
 
+		File getSourceFile() const
+		{
+			if (monolithicInfo != nullptr)
+				return monolithicInfo->getFile(monolithicChannelIndex, monolithicIndex);
+
+			return loadedFile;
+		}
+
 		int64 getMonolithLength() const
 		{
 			if (monolithicInfo != nullptr)
@@ -438,6 +472,12 @@ private:
 
 		void wakeSound();
 
+		/** Touches the memory mapped data for the given range. */
+		bool touchSampleRange(int readerPosition, int numSamples);
+
+		/** Returns the mapped data of an uncompressed monolith at the given position (or nullptr). */
+		const uint8* getUncompressedMonolithData(int readerPosition, int numSamples, int& numChannels) const;
+
 		float calculatePeakValue();
 
 		AudioFormatReader* createMonolithicReaderForPreview();
@@ -455,6 +495,9 @@ private:
 
 	private:
 
+		/** Defers the read operation into the batch if the sample is stored in an uncompressed monolith. */
+		bool addReadToBatch(BatchedDiskReader& batch, hlac::HiseSampleBuffer &buffer, int startSample, int numSamples, int readerPosition);
+
 		bool reversed = false;
 
 		StreamingSamplerSoundPool *pool;
@@ -466,6 +509,9 @@ private:
 
 		ReadWriteLock fileAccessLock;
 
+		// The stream of a normal reader keeps its read position, so two workers must not read from it at the same time
+		CriticalSection streamReadLock;
+
 		bool stereo = true;
 
 		bool isReading;
@@ -125,6 +125,12 @@ void SampleLoader::startNote(StreamingSamplerSound const *s, int startTime)
 
 	entireSampleIsLoaded = s->isEntireSampleLoaded();
 
+	// The voice buffers must have the same format as the mapped data
+	if (!entireSampleIsLoaded && !b1.isFloatingPoint())
+		mappedData = s->getMappedSampleData(numMappedChannels);
+	else
+		mappedData = nullptr;
+
 	if (!entireSampleIsLoaded)
 	{
 		// The other buffer will be filled on the next free thread pool slot
@@ -188,6 +194,7 @@ NotificationType SampleLoader::waitForTimestretchSeek(StreamingSamplerVoice* v)
 void SampleLoader::clearLoader()
 {
 	sound = nullptr;
+	mappedData = nullptr;
 	diskUsage = 0.0f;
 	cancelled = true;
 	resetJob();
@@ -216,6 +223,9 @@ void SampleLoader::setStreamingBufferDataType(bool shouldBeFloat)
 
 StereoChannelData SampleLoader::fillVoiceBuffer(hlac::HiseSampleBuffer &voiceBuffer, double numSamples) const
 {
+	if (mappedData != nullptr)
+		return fillFromMappedData(voiceBuffer, numSamples);
+
 	auto localReadBuffer = readBuffer.get();
 	auto localWriteBuffer = writeBuffer.get();
 
@@ -350,6 +360,67 @@ StereoChannelData SampleLoader::fillVoiceBuffer(hlac::HiseSampleBuffer &voiceBuf
 	}
 }
 
+/** Reads the 16 bit samples of a memory mapped monolith. 
+
+	The data starts right after the monolith header, so it might not be aligned to 2 bytes and 
+	can't be accessed through an int16 pointer.
+*/
+struct MappedInt16Data
+{
+	int16 operator[](int index) const noexcept
+	{
+		return (int16)ByteOrder::littleEndianShort(data + (size_t)index * sizeof(int16));
+	}
+
+	MappedInt16Data operator+(int offset) const noexcept
+	{
+		return { data + (size_t)offset * sizeof(int16) };
+	}
+
+	const uint8* data;
+};
+
+StereoChannelData SampleLoader::fillFromMappedData(hlac::HiseSampleBuffer &voiceBuffer, double numSamples) const
+{
+	// The position in the sample is the same as the voice uptime
+	const int index = jmax(0, (int)(lastSwapPosition + readIndexDouble));
+	const int numToRead = (int)numSamples + 2; // the interpolation needs the next sample
+	const int sampleLength = sound.get()->getSampleLength();
+
+	StereoChannelData returnData;
+
+	if (index + numToRead <= sampleLength)
+	{
+		returnData.mappedData = mappedData + (size_t)index * (size_t)numMappedChannels * sizeof(int16);
+		returnData.numMappedChannels = numMappedChannels;
+		returnData.numMappedSamples = sampleLength - index - 1;
+		return returnData;
+	}
+
+	// We're at the end of the sample, so we copy the rest into the voice buffer and pad it with silence
+	// (the next sample of the monolith starts right after this one).
+	voiceBuffer.clearNormalisation({});
+	voiceBuffer.setUseOneMap(false);
+	voiceBuffer.clear();
+
+	const int numToCopy = jlimit(0, voiceBuffer.getNumSamples(), sampleLength - index);
+	MappedInt16Data src = { mappedData + (size_t)index * (size_t)numMappedChannels * sizeof(int16) };
+	const int rightOffset = numMappedChannels - 1;
+
+	auto l = static_cast<int16*>(voiceBuffer.getWritePointer(0, 0));
+	auto r = static_cast<int16*>(voiceBuffer.getWritePointer(1, 0));
+
+	for (int i = 0; i < numToCopy; i++)
+	{
+		l[i] = src[i * numMappedChannels];
+		r[i] = src[i * numMappedChannels + rightOffset];
+	}
+
+	returnData.b = &voiceBuffer;
+	returnData.offsetInBuffer = 0;
+	return returnData;
+}
+
 bool SampleLoader::advanceReadIndex(double uptime)
 {
 #if HISE_SAMPLER_ALLOW_RELEASE_START
@@ -424,6 +495,9 @@ bool SampleLoader::requestNewData()
 		return true;
 	}
 
+	// The new data must be ready before the voice reaches the end of the current read buffer
+	setDeadlineInSamples((double)readBuffer.get()->getNumSamples() - readIndexDouble, sourceSamplesPerSecond);
+
 #if KILL_VOICES_WHEN_STREAMING_IS_BLOCKED
 	if (this->isQueued() && !isWaitingForTimestretchSeek())
 	{
@@ -487,6 +561,17 @@ SampleThreadPoolJob::JobStatus SampleLoader::runJob()
 
 	fillInactiveBuffer();
 
+	// If the read operations were deferred into a batch, the buffer is not ready until the batch was submitted
+	if (auto batch = BatchedDiskReader::getCurrent())
+		batch->addBatchCompletion([this, readStart]() { finishFillOperation(readStart); });
+	else
+		finishFillOperation(readStart);
+
+	return SampleThreadPoolJob::JobStatus::jobHasFinished;
+}
+
+void SampleLoader::finishFillOperation(double readStart)
+{
 	writeBufferIsBeingFilled = false;
 
 	const double readStop = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks());
@@ -495,8 +580,6 @@ SampleThreadPoolJob::JobStatus SampleLoader::runJob()
 	const float diskUsageThisTime = jmax<float>(diskUsage.get(), (float)(readTime / timeSinceLastCall));
 	diskUsage = diskUsageThisTime;
 	lastCallToRequestData = readStart;
-
-	return SampleThreadPoolJob::JobStatus::jobHasFinished;
 }
 
 size_t SampleLoader::getActualStreamingBufferSize() const
@@ -510,6 +593,13 @@ void SampleLoader::fillInactiveBuffer()
 
 	if (localSound == nullptr) return;
 
+	if (mappedData != nullptr)
+	{
+		// The voice reads the mapped data directly, so we just make sure that the next pages are loaded
+		localSound->prefetchRange(positionInSampleFile, getNumSamplesForStreamingBuffers());
+		return;
+	}
+
 	if (localSound != nullptr)
 	{
 		if (localSound->hasEnoughSamplesForBlock(positionInSampleFile + getNumSamplesForStreamingBuffers()))
@@ -637,10 +727,6 @@ void StreamingSamplerVoice::startNote(int /*midiNoteNumber*/,
 
 	if (sound != nullptr && sound->getSampleLength() > 0)
 	{
-		loader.startNote(sound, sampleStartModValue);
-
-		jassert(sound != nullptr);
-		
 		voiceUptime = (double)sampleStartModValue;
 
 		// You have to call setPitchFactor() before startNote().
@@ -654,6 +740,10 @@ void StreamingSamplerVoice::startNote(int /*midiNoteNumber*/,
 
 		constUptimeDelta = uptimeDelta;
 
+		// Set this before starting the loader so that the first request has a proper deadline
+		loader.setSourceSamplesPerSecond(uptimeDelta * getSampleRate());
+		loader.startNote(sound, sampleStartModValue);
+
 #if HISE_SAMPLER_ALLOW_RELEASE_START
 		jumpToReleaseOnNextRender = false;
 		releaseFadeDuration = 0;
@@ -721,7 +811,7 @@ static int unalignedCalls = 0;
 
 #define USE_CUBIC_INTERPOLATION 0 // not there yet, need to fetch more samples to get 4 values...
 
-template <typename SignalType, bool isFloat> void interpolateMonoSamples(const SignalType* inL, const SignalType* unusedIn, const float* pitchData, float* outL, float* unusedOut, int startSample, double indexInBuffer, double uptimeDelta, int numSamples)
+template <typename SignalType, bool isFloat, typename PointerType=const SignalType*> void interpolateMonoSamples(PointerType inL, PointerType unusedIn, const float* pitchData, float* outL, float* unusedOut, int startSample, double indexInBuffer, double uptimeDelta, int numSamples)
 {
 	ignoreUnused(unusedIn, unusedOut);
 
@@ -788,7 +878,7 @@ template <typename SignalType, bool isFloat> void interpolateMonoSamples(const S
 	}
 }
 
-template <typename SignalType, bool isFloat> void interpolateStereoSamples(const SignalType* inL, const SignalType* inR, const float* pitchData, float* outL, float* outR, int startSample, double indexInBuffer, double uptimeDelta, int numSamples, int maxIndexInBuffer)
+template <typename SignalType, bool isFloat, int Stride=1, typename PointerType=const SignalType*> void interpolateStereoSamples(PointerType inL, PointerType inR, const float* pitchData, float* outL, float* outR, int startSample, double indexInBuffer, double uptimeDelta, int numSamples, int maxIndexInBuffer)
 {
 	constexpr float gainFactor = isFloat ? 1.0f : (1.0f / (float)INT16_MAX);
 
@@ -807,16 +897,16 @@ template <typename SignalType, bool isFloat> void interpolateStereoSamples(const
 
 			const float alpha = indexInBufferFloat - (float)pos;
 
-			auto l1 = (float)inL[pos];
-			auto l2 = (float)inL[pos+1];
-			auto r1 = (float)inR[pos];
-			auto r2 = (float)inR[pos + 1];
+			auto l1 = (float)inL[pos * Stride];
+			auto l2 = (float)inL[(pos + 1) * Stride];
+			auto r1 = (float)inR[pos * Stride];
+			auto r2 = (float)inR[(pos + 1) * Stride];
 
 #if USE_CUBIC_INTERPOLATION
-			auto l0 = (float)(pos > 0 ? inL[pos - 1] : 0);
-			auto l3 = (float)inL[pos + 2];
-			auto r0 = (float)(pos > 0 ? inR[pos - 1] : 0);
-			auto r3 = (float)inR[pos + 2];
+			auto l0 = (float)(pos > 0 ? inL[(pos - 1) * Stride] : 0);
+			auto l3 = (float)inL[(pos + 2) * Stride];
+			auto r0 = (float)(pos > 0 ? inR[(pos - 1) * Stride] : 0);
+			auto r3 = (float)inR[(pos + 2) * Stride];
 
 			float l = Interpolator::interpolateCubic(l0, l1, l2, l3, alpha);
 			float r = Interpolator::interpolateCubic(r0, r1, r2, r3, alpha);
@@ -849,16 +939,16 @@ template <typename SignalType, bool isFloat> void interpolateStereoSamples(const
 			const int pos = int(indexInBufferFloat);
 			const float alpha = indexInBufferFloat - (float)pos;
 			
-			auto l1 = (float)inL[pos];
-			auto l2 = (float)inL[pos + 1];
-			auto r1 = (float)inR[pos];
-			auto r2 = (float)inR[pos + 1];
+			auto l1 = (float)inL[pos * Stride];
+			auto l2 = (float)inL[(pos + 1) * Stride];
+			auto r1 = (float)inR[pos * Stride];
+			auto r2 = (float)inR[(pos + 1) * Stride];
 			
 #if USE_CUBIC_INTERPOLATION
-			auto l0 = (float)(pos > 0 ? inL[pos - 1] : 0);
-			auto l3 = (float)inL[pos + 2];
-			auto r0 = (float)(pos > 0 ? inR[pos - 1] : 0);
-			auto r3 = (float)inR[pos + 2];
+			auto l0 = (float)(pos > 0 ? inL[(pos - 1) * Stride] : 0);
+			auto l3 = (float)inL[(pos + 2) * Stride];
+			auto r0 = (float)(pos > 0 ? inR[(pos - 1) * Stride] : 0);
+			auto r3 = (float)inR[(pos + 2) * Stride];
 
 			float l = Interpolator::interpolateCubic(l0, l1, l2, l3, alpha);
 			float r = Interpolator::interpolateCubic(r0, r1, r2, r3, alpha);
@@ -882,6 +972,23 @@ void StreamingSamplerVoice::interpolateFromStereoData(int startSample, float* ou
 {
 	double indexInBuffer = startAlpha;
 
+	if (data.mappedData != nullptr)
+	{
+		MappedInt16Data mapped = { data.mappedData };
+
+		if (data.numMappedChannels == 2)
+		{
+			interpolateStereoSamples<int16, false, 2, MappedInt16Data>(mapped, mapped + 1, pitchDataToUse, outL, outR, startSample, indexInBuffer, thisUptimeDelta, numSamplesToCalculate, indexInBuffer + samplesAvailable);
+		}
+		else
+		{
+			interpolateMonoSamples<int16, false, MappedInt16Data>(mapped, {}, pitchDataToUse, outL, nullptr, startSample, indexInBuffer, thisUptimeDelta, numSamplesToCalculate);
+			memcpy(outR, outL, sizeof(float) * numSamplesToCalculate);
+		}
+
+		return;
+	}
+
 	if (data.b->isFloatingPoint())
 	{
 		const float* const inL = static_cast<const float*>(data.b->getReadPointer(0, data.offsetInBuffer));
@@ -917,7 +1024,7 @@ void StreamingSamplerVoice::interpolateFromStereoData(int startSample, float* ou
 			{
 				data.b->convertToFloatWithNormalisation(d, 1, data.offsetInBuffer, numSamplesThisTime);
 
-				interpolateMonoSamples<float, true>(inL_f, nullptr, pitchDataToUse, outL, nullptr, startSample, indexInBuffer, thisUptimeDelta, numSamplesToCalculate);
+				interpolateMonoSamples<float, true, const float*>(inL_f, nullptr, pitchDataToUse, outL, nullptr, startSample, indexInBuffer, thisUptimeDelta, numSamplesToCalculate);
 
 				memcpy(outR, outL, sizeof(float) * numSamplesToCalculate);
 			}
@@ -1078,7 +1185,7 @@ void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int
 		}
 #endif
 		
-		auto samplesAvailable = data.b->getNumSamples() - data.offsetInBuffer;
+		auto samplesAvailable = data.getNumSamplesAvailable();
 
 		const int startFixed = startSample;
 		const int numSamplesFixed = numSamples;
@@ -70,12 +70,24 @@ public:
 	*/
 	JobStatus runJob() override;
 
+	/** The sample loaders can be executed by any streaming worker. */
+	bool canRunOnWorkerThread() const override { return true; }
+
+	/** Sets the amount of samples of the loaded sound that are consumed per second.
+	
+		This is used to calculate the deadline for the next read operation.
+	*/
+	void setSourceSamplesPerSecond(double newSamplesPerSecond) noexcept { sourceSamplesPerSecond = newSamplesPerSecond; }
+
 	size_t getActualStreamingBufferSize() const;
 
 	void setStreamingBufferDataType(bool shouldBeFloat);
 
 	StereoChannelData fillVoiceBuffer(hlac::HiseSampleBuffer &voiceBuffer, double numSamples) const;
 
+	/** Returns true if the voice reads the sample data directly from a memory mapped monolith. */
+	bool isReadingFromMappedData() const noexcept { return mappedData != nullptr; }
+
 	/** Advances the read index and returns `false` if the streaming thread is blocked. */
 	bool advanceReadIndex(double uptime);
 
@@ -191,6 +203,10 @@ private:
 	bool swapBuffers();
 
 	void fillInactiveBuffer();
+	void finishFillOperation(double readStart);
+
+	StereoChannelData fillFromMappedData(hlac::HiseSampleBuffer &voiceBuffer, double numSamples) const;
+
 	void refreshBufferSizes();
 	// ============================================================================================ member variables
 
@@ -232,11 +248,17 @@ private:
 	Atomic<hlac::HiseSampleBuffer const *> readBuffer;
 	Atomic<hlac::HiseSampleBuffer *> writeBuffer;
 
+	// If the sound is an uncompressed monolith, this points to the mapped data at the sample start
+	const uint8* mappedData = nullptr;
+	int numMappedChannels = 0;
+
 	// variables for disk usage measurement
 
 	Atomic<float> diskUsage;
 	double lastCallToRequestData;
 
+	double sourceSamplesPerSecond = 0.0;
+
 	// just a pointer to the used pool
 	SampleThreadPool *backgroundPool;
 
@@ -20,24 +20,31 @@ namespace gin {
 
 void multiThreadedFor(int start, int end, int interval, juce::ThreadPool* threadPool, std::function<void(int idx)> callback)
 {
-	if (threadPool == nullptr)
+	if (threadPool == nullptr || threadPool->getNumThreads() == 0)
 	{
 		for (int i = start; i < end; i += interval)
 			callback(i);
 	}
 	else
 	{
-		int num = threadPool->getNumThreads();
+		// The calling thread takes the last slice instead of just waiting for the pool
+		int numJobs = threadPool->getNumThreads();
+		int num = numJobs + 1;
+
+		auto runSlice = [&callback, start, end, interval, num](int i)
+		{
+			for (int j = start + interval * i; j < end; j += interval * num)
+				callback(j);
+		};
 
 		juce::WaitableEvent wait;
-		juce::Atomic<int> threadsRunning(num);
+		juce::Atomic<int> threadsRunning(numJobs);
 
-		for (int i = 0; i < num; i++)
+		for (int i = 0; i < numJobs; i++)
 		{
-			threadPool->addJob([i, &callback, &wait, &threadsRunning, start, end, interval, num]
+			threadPool->addJob([i, &runSlice, &wait, &threadsRunning]
 				{
-					for (int j = start + interval * i; j < end; j += interval * num)
-						callback(j);
+					runSlice(i);
 
 					int stillRunning = --threadsRunning;
 					if (stillRunning == 0)
@@ -45,6 +52,8 @@ void multiThreadedFor(int start, int end, int interval, juce::ThreadPool* thread
 				});
 		}
 
+		runSlice(numJobs);
+
 		wait.wait();
 	}
 }
@@ -95,68 +104,57 @@ inline T2 convert (const T1& in)
 template <class T>
 void applyVignette (juce::Image& img, float amountIn, float radiusIn, float fallOff, juce::ThreadPool* threadPool)
 {
-	jassertfalse;
-
-#if 0
     const int w = img.getWidth();
     const int h = img.getHeight();
     threadPool = (w >= 256 || h >= 256) ? threadPool : nullptr;
 
-    double outA = w * 0.5 * radiusIn;
-    double outB = h * 0.5 * radiusIn;
+    const float outA = w * 0.5f * radiusIn;
+    const float outB = h * 0.5f * radiusIn;
 
-    double inA = outA * fallOff;
-    double inB = outB * fallOff;
+    if (outA <= 0.0f || outB <= 0.0f)
+        return;
 
-    double cx = w * 0.5;
-    double cy = h * 0.5;
+    // The inner ellipse has the same aspect ratio as the outer ellipse, so the position
+    // between the two along the ray from the centre is just a function of the normalised
+    // distance d, where the outer ellipse is at d = 1 and the inner ellipse at d = fallOff
+    const float inner = juce::jlimit (0.0f, 1.0f, fallOff);
+    const float fadeScale = inner < 1.0f ? 1.0f / (1.0f - inner) : 0.0f;
 
-    double amount = 1.0 - amountIn;
+    const float cx = w * 0.5f;
+    const float cy = h * 0.5f;
+    const float invA = 1.0f / outA;
+    const float invB = 1.0f / outB;
 
     juce::Image::BitmapData data (img, juce::Image::BitmapData::readWrite);
 
-    Ellipse<double> outE { outA, outB };
-    Ellipse<double> inE  { inA,  inB  };
-
     multiThreadedFor (0, h, 1, threadPool, [&] (int y)
     {
         uint8_t* p = data.getLinePointer (y);
 
-        double dy = y - cy;
+        const float dy = ((float)y - cy) * invB;
+        const float dy2 = dy * dy;
 
         for (int x = 0; x < w; x++)
         {
-            double dx = x - cx;
+            const float dx = ((float)x - cx) * invA;
+            const float d = std::sqrt (dx * dx + dy2);
 
-            bool outside = outE.isPointOutside ({dx, dy});
-            bool inside  = inE.isPointInside ({dx, dy});
+            float position;
 
-            T* s = (T*)p;
-
-            if (outside)
-            {
-                uint8_t r = toByte (0.5 + (s->getRed() * amount));
-                uint8_t g = toByte (0.5 + (s->getGreen() * amount));
-                uint8_t b = toByte (0.5 + (s->getBlue() * amount));
-                uint8_t a = s->getAlpha();
+            if (fadeScale == 0.0f)
+                position = d >= 1.0f ? 1.0f : 0.0f;
+            else
+                position = juce::jlimit (0.0f, 1.0f, (d - inner) * fadeScale);
 
-                s->setARGB (a, r, g, b);
-            }
-            else if (! inside)
+            if (position > 0.0f)
             {
-                double angle = std::atan2 (dy, dx);
-
-                auto p1 = outE.pointAtAngle (angle);
-                auto p2 = inE.pointAtAngle (angle);
+                T* s = (T*)p;
 
-                auto l1 = juce::Line<double> ({dx,dy}, p2);
-                auto l2 = juce::Line<double> (p1, p2);
+                const float factor = 1.0f - amountIn * position;
 
-                double factor = 1.0 - (amountIn * juce::jlimit (0.0, 1.0, l1.getLength() / l2.getLength()));
-
-                uint8_t r = toByte (0.5 + (s->getRed()   * factor));
-                uint8_t g = toByte (0.5 + (s->getGreen() * factor));
-                uint8_t b = toByte (0.5 + (s->getBlue()  * factor));
+                uint8_t r = toByte (0.5f + (s->getRed()   * factor));
+                uint8_t g = toByte (0.5f + (s->getGreen() * factor));
+                uint8_t b = toByte (0.5f + (s->getBlue()  * factor));
                 uint8_t a = s->getAlpha();
 
                 s->setARGB (a, r, g, b);
@@ -165,7 +163,6 @@ void applyVignette (juce::Image& img, float amountIn, float radiusIn, float fall
             p += data.pixelStride;
         }
     });
-#endif
 }
 
 void applyVignette (juce::Image& img, float amountIn, float radiusIn, float fallOff, juce::ThreadPool* threadPool)
@@ -390,6 +387,12 @@ void applyGamma (juce::Image& img, float gamma, juce::ThreadPool* threadPool)
 
     juce::Image::BitmapData data (img, juce::Image::BitmapData::readWrite);
 
+    // there are only 256 possible input values, so we don't need to call pow() for every pixel
+    uint8_t gammaTable[256];
+
+    for (int i = 0; i < 256; i++)
+        gammaTable[i] = toByte (std::pow (i / 255.0, gamma) * 255.0 + 0.5);
+
     multiThreadedFor(0, h, 1, threadPool, [&] (int y)
     {
         uint8_t* p = data.getLinePointer (y);
@@ -403,9 +406,9 @@ void applyGamma (juce::Image& img, float gamma, juce::ThreadPool* threadPool)
             uint8_t b = s->getBlue();
             uint8_t a = s->getAlpha();
 
-            uint8_t ro = toByte (std::pow (r / 255.0, gamma) * 255.0 + 0.5);
-            uint8_t go = toByte (std::pow (g / 255.0, gamma) * 255.0 + 0.5);
-            uint8_t bo = toByte (std::pow (b / 255.0, gamma) * 255.0 + 0.5);
+            uint8_t ro = gammaTable[r];
+            uint8_t go = gammaTable[g];
+            uint8_t bo = gammaTable[b];
 
             s->setARGB (a, ro, go, bo);
 
@@ -774,6 +777,13 @@ void applyGradientMap (juce::Image& img, const juce::ColourGradient& gradient, j
 
     juce::Image::BitmapData data (img, juce::Image::BitmapData::readWrite);
 
+    // The sum of the weighted channels can't exceed 3 * 255, so we look up the
+    // gradient colour for each possible value once instead of for every pixel
+    juce::Colour colourTable[3 * 256];
+
+    for (int i = 0; i < 3 * 256; i++)
+        colourTable[i] = gradient.getColourAtPosition (float (i) / 256.0f);
+
     multiThreadedFor (0, h, 1, threadPool, [&] (int y)
                            {
                                uint8_t* p = data.getLinePointer (y);
@@ -791,9 +801,7 @@ void applyGradientMap (juce::Image& img, const juce::ColourGradient& gradient, j
                                    uint8_t go = toByte (g * 0.59 + 0.5);
                                    uint8_t bo = toByte (b * 0.11 + 0.5);
 
-                                   float proportion = float (ro + go + bo) / 256.0f;
-
-                                   auto c = gradient.getColourAtPosition (proportion);
+                                   const auto& c = colourTable[ro + go + bo];
 
                                    s->setARGB (a,
                                                c.getRed(),
@@ -9,6 +9,15 @@
 
 namespace gin {
 
+//==============================================================================
+/** Runs a for loop split between the threads of the pool and the calling thread.
+
+    for (int i = 0; i < 10; i++) becomes multiThreadedFor (0, 10, 1, threadPool, [&] (int i) {});
+    Make sure each iteration of the loop is independant. If the pool is nullptr, the loop
+    runs on the calling thread.
+ */
+void multiThreadedFor (int start, int end, int interval, juce::ThreadPool* threadPool, std::function<void(int idx)> callback);
+
 //==============================================================================
 /** Apply vignette
  *
@@ -62,7 +71,7 @@ void applyHueSaturationLightness (juce::Image& img, float hue, float saturation,
  *
  \param radius from 2 to 254
  */
-void applyStackBlur (juce::Image& img, int radius);
+void applyStackBlur (juce::Image& img, int radius, juce::ThreadPool* threadPool = nullptr);
 
 /** A very high quality image resize using a bank of sinc
  *  function-based fractional delay filters */
@@ -5,6 +5,10 @@
 
  ==============================================================================*/
 
+#if GIN_USE_SSE
+ #include <emmintrin.h>
+#endif
+
 namespace gin {
 
 static unsigned short const stackblur_mul[255] =
@@ -444,261 +448,238 @@ static void applyStackBlurRGB (juce::Image& img, unsigned int radius)
     }
 }
 
-static void applyStackBlurARGB (juce::Image& img, unsigned int radius)
-{
-    const unsigned int w = (unsigned int)img.getWidth();
-    const unsigned int h = (unsigned int)img.getHeight();
+/** Blurs one line of ARGB pixels in place.
 
-    juce::Image::BitmapData data (img, juce::Image::BitmapData::readWrite);
+    The step is the distance between two pixels in bytes, so the same function
+    is used for the rows and the columns. The stack must have space for
+    (radius * 2 + 1) pixels.
+*/
+static void applyStackBlurLineARGB (unsigned char* line, unsigned int len, size_t step, unsigned int radius, unsigned char* stack)
+{
+    const unsigned int lm = len - 1;
+    const unsigned int div = (radius * 2) + 1;
+    const unsigned int mul_sum = stackblur_mul[radius];
+    const unsigned char shr_sum = stackblur_shr[radius];
 
-    radius = juce::jlimit (2u, 254u, radius);
+    unsigned char* src_ptr = line;
+    unsigned char* dst_ptr = line;
+    unsigned char* stack_ptr = nullptr;
 
-    unsigned char    stack[(254 * 2 + 1) * 4];
+    unsigned int i, x, sp, xp, stack_start;
 
-    unsigned int x, y, xp, yp, i, sp, stack_start;
+#if GIN_USE_SSE
 
-    unsigned char* stack_ptr = nullptr;
-    unsigned char* src_ptr = nullptr;
-    unsigned char* dst_ptr = nullptr;
+    // The four channels of a pixel are processed in the 32 bit lanes of one register.
+    // The sums never exceed 32 bit (the multiplication tables are designed for this),
+    // but the multiplication before the shift needs 64 bit, so it's split into the
+    // even and odd lanes.
 
-    unsigned long sum_r, sum_g, sum_b, sum_a, sum_in_r, sum_in_g, sum_in_b, sum_in_a,
-    sum_out_r, sum_out_g, sum_out_b, sum_out_a;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i mul = _mm_set1_epi32 ((int)mul_sum);
+    const __m128i shr = _mm_cvtsi32_si128 (shr_sum);
 
-    unsigned int wm = w - 1;
-    unsigned int hm = h - 1;
-    unsigned int w4 = (unsigned int) data.lineStride;
-    unsigned int div = (unsigned int)(radius * 2) + 1;
-    unsigned int mul_sum = stackblur_mul[radius];
-    unsigned char shr_sum = stackblur_shr[radius];
+    auto load = [zero] (const unsigned char* ptr)
+    {
+        int v;
+        memcpy (&v, ptr, 4);
+        return _mm_unpacklo_epi16 (_mm_unpacklo_epi8 (_mm_cvtsi32_si128 (v), zero), zero);
+    };
 
-    for (y = 0; y < h; ++y)
+    auto store = [] (unsigned char* ptr, __m128i v)
     {
-        sum_r = sum_g = sum_b = sum_a =
-        sum_in_r = sum_in_g = sum_in_b = sum_in_a =
-        sum_out_r = sum_out_g = sum_out_b = sum_out_a = 0;
+        v = _mm_packs_epi32 (v, v);
+        int packed = _mm_cvtsi128_si32 (_mm_packus_epi16 (v, v));
+        memcpy (ptr, &packed, 4);
+    };
 
-        src_ptr = data.getLinePointer (int (y));
+    __m128i sum = zero, sum_in = zero, sum_out = zero;
 
-        for (i = 0; i <= radius; ++i)
-        {
-            stack_ptr    = &stack[4 * i];
-            stack_ptr[0] = src_ptr[0];
-            stack_ptr[1] = src_ptr[1];
-            stack_ptr[2] = src_ptr[2];
-            stack_ptr[3] = src_ptr[3];
-            sum_r += src_ptr[0] * (i + 1);
-            sum_g += src_ptr[1] * (i + 1);
-            sum_b += src_ptr[2] * (i + 1);
-            sum_a += src_ptr[3] * (i + 1);
-            sum_out_r += src_ptr[0];
-            sum_out_g += src_ptr[1];
-            sum_out_b += src_ptr[2];
-            sum_out_a += src_ptr[3];
-        }
+    for (i = 0; i <= radius; ++i)
+    {
+        memcpy (stack + 4 * i, src_ptr, 4);
+        auto v = load (src_ptr);
+        sum     = _mm_add_epi32 (sum, _mm_madd_epi16 (v, _mm_set1_epi32 ((int)(i + 1))));
+        sum_out = _mm_add_epi32 (sum_out, v);
+    }
 
-        for (i = 1; i <= radius; ++i)
-        {
-            if (i <= wm)
-                src_ptr += 4;
+    for (i = 1; i <= radius; ++i)
+    {
+        if (i <= lm)
+            src_ptr += step;
 
-            stack_ptr = &stack[4 * (i + radius)];
-            stack_ptr[0] = src_ptr[0];
-            stack_ptr[1] = src_ptr[1];
-            stack_ptr[2] = src_ptr[2];
-            stack_ptr[3] = src_ptr[3];
-            sum_r += src_ptr[0] * (radius + 1 - i);
-            sum_g += src_ptr[1] * (radius + 1 - i);
-            sum_b += src_ptr[2] * (radius + 1 - i);
-            sum_a += src_ptr[3] * (radius + 1 - i);
-            sum_in_r += src_ptr[0];
-            sum_in_g += src_ptr[1];
-            sum_in_b += src_ptr[2];
-            sum_in_a += src_ptr[3];
-        }
+        memcpy (stack + 4 * (i + radius), src_ptr, 4);
+        auto v = load (src_ptr);
+        sum    = _mm_add_epi32 (sum, _mm_madd_epi16 (v, _mm_set1_epi32 ((int)(radius + 1 - i))));
+        sum_in = _mm_add_epi32 (sum_in, v);
+    }
 
-        sp = radius;
-        xp = radius;
-        if (xp > wm)
-            xp = wm;
+    sp = radius;
+    xp = juce::jmin (radius, lm);
+    src_ptr = line + step * xp;
 
-        src_ptr = data.getLinePointer (int (y)) + (unsigned int)data.pixelStride * xp;
-        dst_ptr = data.getLinePointer (int (y));
+    for (x = 0; x < len; ++x)
+    {
+        auto even = _mm_srl_epi64 (_mm_mul_epu32 (sum, mul), shr);
+        auto odd  = _mm_srl_epi64 (_mm_mul_epu32 (_mm_srli_epi64 (sum, 32), mul), shr);
+        store (dst_ptr, _mm_or_si128 (even, _mm_slli_epi64 (odd, 32)));
+        dst_ptr += step;
 
-        for (x = 0; x < w; ++x)
-        {
-            dst_ptr[0] = (unsigned char)((sum_r * mul_sum) >> shr_sum);
-            dst_ptr[1] = (unsigned char)((sum_g * mul_sum) >> shr_sum);
-            dst_ptr[2] = (unsigned char)((sum_b * mul_sum) >> shr_sum);
-            dst_ptr[3] = (unsigned char)((sum_a * mul_sum) >> shr_sum);
-            dst_ptr += 4;
+        sum = _mm_sub_epi32 (sum, sum_out);
 
-            sum_r -= sum_out_r;
-            sum_g -= sum_out_g;
-            sum_b -= sum_out_b;
-            sum_a -= sum_out_a;
+        stack_start = sp + div - radius;
 
-            stack_start = sp + div - radius;
+        if (stack_start >= div)
+            stack_start -= div;
 
-            if (stack_start >= div)
-                stack_start -= div;
+        stack_ptr = stack + 4 * stack_start;
+        sum_out = _mm_sub_epi32 (sum_out, load (stack_ptr));
 
-            stack_ptr = &stack[4 * stack_start];
+        if (xp < lm)
+        {
+            src_ptr += step;
+            ++xp;
+        }
 
-            sum_out_r -= stack_ptr[0];
-            sum_out_g -= stack_ptr[1];
-            sum_out_b -= stack_ptr[2];
-            sum_out_a -= stack_ptr[3];
+        memcpy (stack_ptr, src_ptr, 4);
+        sum_in = _mm_add_epi32 (sum_in, load (src_ptr));
+        sum    = _mm_add_epi32 (sum, sum_in);
 
-            if (xp < wm)
-            {
-                src_ptr += 4;
-                ++xp;
-            }
+        ++sp;
+        if (sp >= div)
+            sp = 0;
 
-            stack_ptr[0] = src_ptr[0];
-            stack_ptr[1] = src_ptr[1];
-            stack_ptr[2] = src_ptr[2];
-            stack_ptr[3] = src_ptr[3];
+        auto v = load (stack + 4 * sp);
+        sum_out = _mm_add_epi32 (sum_out, v);
+        sum_in  = _mm_sub_epi32 (sum_in, v);
+    }
 
-            sum_in_r += src_ptr[0];
-            sum_in_g += src_ptr[1];
-            sum_in_b += src_ptr[2];
-            sum_in_a += src_ptr[3];
-            sum_r    += sum_in_r;
-            sum_g    += sum_in_g;
-            sum_b    += sum_in_b;
-            sum_a    += sum_in_a;
+#else
 
-            ++sp;
-            if (sp >= div)
-                sp = 0;
+    uint32_t sum[4] = { 0, 0, 0, 0 };
+    uint32_t sum_in[4] = { 0, 0, 0, 0 };
+    uint32_t sum_out[4] = { 0, 0, 0, 0 };
 
-            stack_ptr = &stack[sp*4];
+    for (i = 0; i <= radius; ++i)
+    {
+        stack_ptr = stack + 4 * i;
 
-            sum_out_r += stack_ptr[0];
-            sum_out_g += stack_ptr[1];
-            sum_out_b += stack_ptr[2];
-            sum_out_a += stack_ptr[3];
-            sum_in_r  -= stack_ptr[0];
-            sum_in_g  -= stack_ptr[1];
-            sum_in_b  -= stack_ptr[2];
-            sum_in_a  -= stack_ptr[3];
+        for (int c = 0; c < 4; c++)
+        {
+            stack_ptr[c] = src_ptr[c];
+            sum[c] += src_ptr[c] * (i + 1);
+            sum_out[c] += src_ptr[c];
         }
     }
 
-    for (x = 0; x < w; ++x)
+    for (i = 1; i <= radius; ++i)
     {
-        sum_r =    sum_g =    sum_b =    sum_a =
-        sum_in_r = sum_in_g = sum_in_b = sum_in_a =
-        sum_out_r = sum_out_g = sum_out_b = sum_out_a = 0;
+        if (i <= lm)
+            src_ptr += step;
 
-        src_ptr = data.getLinePointer (0) + (unsigned int)data.pixelStride * x;
+        stack_ptr = stack + 4 * (i + radius);
 
-        for (i = 0; i <= radius; ++i)
+        for (int c = 0; c < 4; c++)
         {
-            stack_ptr    = &stack[i * 4];
-            stack_ptr[0] = src_ptr[0];
-            stack_ptr[1] = src_ptr[1];
-            stack_ptr[2] = src_ptr[2];
-            stack_ptr[3] = src_ptr[3];
-            sum_r           += src_ptr[0] * (i + 1);
-            sum_g           += src_ptr[1] * (i + 1);
-            sum_b           += src_ptr[2] * (i + 1);
-            sum_a           += src_ptr[3] * (i + 1);
-            sum_out_r       += src_ptr[0];
-            sum_out_g       += src_ptr[1];
-            sum_out_b       += src_ptr[2];
-            sum_out_a       += src_ptr[3];
+            stack_ptr[c] = src_ptr[c];
+            sum[c] += src_ptr[c] * (radius + 1 - i);
+            sum_in[c] += src_ptr[c];
         }
+    }
 
-        for (i = 1; i <= radius; ++i)
+    sp = radius;
+    xp = juce::jmin (radius, lm);
+    src_ptr = line + step * xp;
+
+    for (x = 0; x < len; ++x)
+    {
+        for (int c = 0; c < 4; c++)
         {
-            if (i <= hm)
-                src_ptr += w4;
+            dst_ptr[c] = (unsigned char)(((uint64_t)sum[c] * mul_sum) >> shr_sum);
+            sum[c] -= sum_out[c];
+        }
 
-            stack_ptr = &stack[4 * (i + radius)];
-            stack_ptr[0] = src_ptr[0];
-            stack_ptr[1] = src_ptr[1];
-            stack_ptr[2] = src_ptr[2];
-            stack_ptr[3] = src_ptr[3];
-            sum_r += src_ptr[0] * (radius + 1 - i);
-            sum_g += src_ptr[1] * (radius + 1 - i);
-            sum_b += src_ptr[2] * (radius + 1 - i);
-            sum_a += src_ptr[3] * (radius + 1 - i);
-            sum_in_r += src_ptr[0];
-            sum_in_g += src_ptr[1];
-            sum_in_b += src_ptr[2];
-            sum_in_a += src_ptr[3];
+        dst_ptr += step;
+
+        stack_start = sp + div - radius;
+
+        if (stack_start >= div)
+            stack_start -= div;
+
+        stack_ptr = stack + 4 * stack_start;
+
+        if (xp < lm)
+        {
+            src_ptr += step;
+            ++xp;
         }
 
-        sp = radius;
-        yp = radius;
-        if (yp > hm)
-            yp = hm;
+        for (int c = 0; c < 4; c++)
+        {
+            sum_out[c] -= stack_ptr[c];
+            stack_ptr[c] = src_ptr[c];
+            sum_in[c] += src_ptr[c];
+            sum[c] += sum_in[c];
+        }
 
-        src_ptr = data.getLinePointer (int (yp)) + (unsigned int)data.pixelStride * x;
-        dst_ptr = data.getLinePointer (0) + (unsigned int)data.pixelStride * x;
+        ++sp;
+        if (sp >= div)
+            sp = 0;
 
-        for (y = 0; y < h; ++y)
+        stack_ptr = stack + 4 * sp;
+
+        for (int c = 0; c < 4; c++)
         {
-            dst_ptr[0] = (unsigned char)((sum_r * mul_sum) >> shr_sum);
-            dst_ptr[1] = (unsigned char)((sum_g * mul_sum) >> shr_sum);
-            dst_ptr[2] = (unsigned char)((sum_b * mul_sum) >> shr_sum);
-            dst_ptr[3] = (unsigned char)((sum_a * mul_sum) >> shr_sum);
-            dst_ptr += w4;
+            sum_out[c] += stack_ptr[c];
+            sum_in[c] -= stack_ptr[c];
+        }
+    }
 
-            sum_r -= sum_out_r;
-            sum_g -= sum_out_g;
-            sum_b -= sum_out_b;
-            sum_a -= sum_out_a;
+#endif
+}
 
-            stack_start = sp + div - radius;
-            if (stack_start >= div)
-                stack_start -= div;
+static void applyStackBlurARGB (juce::Image& img, unsigned int radius, juce::ThreadPool* threadPool)
+{
+    const unsigned int w = (unsigned int)img.getWidth();
+    const unsigned int h = (unsigned int)img.getHeight();
 
-            stack_ptr = &stack[4 * stack_start];
+    if (w == 0 || h == 0)
+        return;
 
-            sum_out_r -= stack_ptr[0];
-            sum_out_g -= stack_ptr[1];
-            sum_out_b -= stack_ptr[2];
-            sum_out_a -= stack_ptr[3];
+    threadPool = (w >= 256 || h >= 256) ? threadPool : nullptr;
 
-            if (yp < hm)
-            {
-                src_ptr += w4;
-                ++yp;
-            }
+    juce::Image::BitmapData data (img, juce::Image::BitmapData::readWrite);
 
-            stack_ptr[0] = src_ptr[0];
-            stack_ptr[1] = src_ptr[1];
-            stack_ptr[2] = src_ptr[2];
-            stack_ptr[3] = src_ptr[3];
+    radius = juce::jlimit (2u, 254u, radius);
 
-            sum_in_r += src_ptr[0];
-            sum_in_g += src_ptr[1];
-            sum_in_b += src_ptr[2];
-            sum_in_a += src_ptr[3];
-            sum_r    += sum_in_r;
-            sum_g    += sum_in_g;
-            sum_b    += sum_in_b;
-            sum_a    += sum_in_a;
+    const size_t pixelStride = (size_t)data.pixelStride;
+    const size_t lineStride = (size_t)data.lineStride;
 
-            ++sp;
-            if (sp >= div)
-                sp = 0;
+    // Every line is independent, so we can split the two passes between the threads.
+    // The lines are grouped in chunks so that the threads don't write to the same
+    // cache lines in the vertical pass.
+    constexpr unsigned int ChunkSize = 16;
 
-            stack_ptr = &stack[sp * 4];
+    multiThreadedFor (0, (int)((h + ChunkSize - 1) / ChunkSize), 1, threadPool, [&] (int chunk)
+    {
+        unsigned char stack[(254 * 2 + 1) * 4];
 
-            sum_out_r += stack_ptr[0];
-            sum_out_g += stack_ptr[1];
-            sum_out_b += stack_ptr[2];
-            sum_out_a += stack_ptr[3];
-            sum_in_r  -= stack_ptr[0];
-            sum_in_g  -= stack_ptr[1];
-            sum_in_b  -= stack_ptr[2];
-            sum_in_a  -= stack_ptr[3];
-        }
-    }
+        const auto start = (unsigned int)chunk * ChunkSize;
+        const auto end = juce::jmin (h, start + ChunkSize);
+
+        for (auto y = start; y < end; ++y)
+            applyStackBlurLineARGB (data.getLinePointer (int (y)), w, pixelStride, radius, stack);
+    });
+
+    multiThreadedFor (0, (int)((w + ChunkSize - 1) / ChunkSize), 1, threadPool, [&] (int chunk)
+    {
+        unsigned char stack[(254 * 2 + 1) * 4];
+
+        const auto start = (unsigned int)chunk * ChunkSize;
+        const auto end = juce::jmin (w, start + ChunkSize);
+
+        for (auto x = start; x < end; ++x)
+            applyStackBlurLineARGB (data.getLinePointer (0) + pixelStride * x, h, lineStride, radius, stack);
+    });
 }
 
 // The Stack Blur Algorithm was invented by Mario Klingemann,
@@ -711,9 +692,9 @@ static void applyStackBlurARGB (juce::Image& img, unsigned int radius)
 // C++ implemenation base from:
 // https://gist.github.com/benjamin9999/3809142
 // http://www.antigrain.com/__code/include/agg_blur.h.html
-void applyStackBlur (juce::Image& img, int radius)
+void applyStackBlur (juce::Image& img, int radius, juce::ThreadPool* threadPool)
 {
-    if (img.getFormat() == juce::Image::ARGB)          applyStackBlurARGB (img, (unsigned int)radius);
+    if (img.getFormat() == juce::Image::ARGB)          applyStackBlurARGB (img, (unsigned int)radius, threadPool);
     if (img.getFormat() == juce::Image::RGB)           applyStackBlurRGB (img, (unsigned int)radius);
     if (img.getFormat() == juce::Image::SingleChannel) applyStackBlurBW (img, (unsigned int)radius);
 }
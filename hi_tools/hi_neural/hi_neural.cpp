@@ -297,6 +297,313 @@ private:
 	Array<LayerInfo> layers;
 };
 
+/** Processes a stack of dense layers and activations for multiple input frames at once.
+ *
+ *  The activations are stored with the batch as the innermost dimension so that each dense layer
+ *	becomes a matrix-matrix product that is computed with SIMD operations along the batch.
+ */
+struct DenseBatchProcessor
+{
+	DenseBatchProcessor() = default;
+
+	enum class LayerType
+	{
+		Linear,
+		Tanh,
+		ReLU,
+		Sigmoid,
+		numLayerTypes
+	};
+
+	struct Layer
+	{
+		LayerType type = LayerType::Linear;
+		int numInputs = 0;
+		int numOutputs = 0;
+
+		// weights[o * numInputs + i]
+		HeapBlock<float> weights;
+		HeapBlock<float> bias;
+	};
+
+	/** Checks whether all layers of the model can be processed as a batch. */
+	static bool canProcess(const PytorchParser::ModelPtr& model)
+	{
+		if(model == nullptr || model->layers.empty())
+			return false;
+
+		for(auto l: model->layers)
+		{
+			if(getLayerType(l) == LayerType::numLayerTypes)
+				return false;
+		}
+
+		return true;
+	}
+
+	/** Copies the weights from the model. Call this whenever the weights have changed. */
+	void init(const PytorchParser::ModelPtr& model)
+	{
+		layers.clear();
+		numInputs = 0;
+		numOutputs = 0;
+		maxWidth = 0;
+		stateless = canProcess(model);
+
+		if(!stateless)
+			return;
+
+		for(auto l: model->layers)
+		{
+			auto nl = new Layer();
+			nl->type = getLayerType(l);
+			nl->numInputs = l->in_size;
+			nl->numOutputs = l->out_size;
+
+			if(auto d = dynamic_cast<RTNeural::Dense<float>*>(l))
+			{
+				nl->weights.calloc(nl->numInputs * nl->numOutputs);
+				nl->bias.calloc(nl->numOutputs);
+
+				for(int o = 0; o < nl->numOutputs; o++)
+				{
+					nl->bias[o] = d->getBias(o);
+
+					for(int i = 0; i < nl->numInputs; i++)
+						nl->weights[o * nl->numInputs + i] = d->getWeight(o, i);
+				}
+			}
+
+			maxWidth = jmax(maxWidth, nl->numInputs, nl->numOutputs);
+			layers.add(nl);
+		}
+
+		numInputs = layers.getFirst()->numInputs;
+		numOutputs = layers.getLast()->numOutputs;
+
+		prepare(maxBatchSize);
+	}
+
+	void prepare(int newMaxBatchSize)
+	{
+		maxBatchSize = jmax(0, newMaxBatchSize);
+
+		auto numElements = (size_t)(maxWidth * maxBatchSize);
+
+		for(auto& b: buffers)
+			b.calloc(numElements);
+	}
+
+	bool isActive() const { return !layers.isEmpty() && maxBatchSize > 0; }
+
+	/** Returns the result of canProcess() for the model that was passed into init(). */
+	bool isStateless() const { return stateless; }
+
+	void process(const float* input, float* output, int numItems)
+	{
+		jassert(isActive());
+
+		while(numItems > 0)
+		{
+			auto numThisTime = jmin(numItems, maxBatchSize);
+
+			processChunk(input, output, numThisTime);
+
+			input += numThisTime * numInputs;
+			output += numThisTime * numOutputs;
+			numItems -= numThisTime;
+		}
+	}
+
+private:
+
+	static LayerType getLayerType(RTNeural::Layer<float>* l)
+	{
+		auto t = PytorchIds::Helpers::getTypeIdAndIsActivation(l).first;
+
+		if(t == PytorchIds::Linear)
+			return LayerType::Linear;
+		if(t == PytorchIds::Tanh)
+			return LayerType::Tanh;
+		if(t == PytorchIds::ReLU)
+			return LayerType::ReLU;
+		if(t == PytorchIds::Sigmoid)
+			return LayerType::Sigmoid;
+
+		return LayerType::numLayerTypes;
+	}
+
+	void processChunk(const float* input, float* output, int numItems)
+	{
+		auto src = buffers[0].get();
+		auto dst = buffers[1].get();
+
+		// transpose the input frames so that the batch is the innermost dimension
+		for(int b = 0; b < numItems; b++)
+		{
+			for(int i = 0; i < numInputs; i++)
+				src[i * numItems + b] = input[b * numInputs + i];
+		}
+
+		for(auto l: layers)
+		{
+			auto numElements = l->numOutputs * numItems;
+
+			switch(l->type)
+			{
+			case LayerType::Linear:
+			{
+				for(int o = 0; o < l->numOutputs; o++)
+				{
+					auto row = dst + o * numItems;
+					auto w = l->weights + o * l->numInputs;
+
+					FloatVectorOperations::fill(row, l->bias[o], numItems);
+
+					for(int i = 0; i < l->numInputs; i++)
+						FloatVectorOperations::addWithMultiply(row, src + i * numItems, w[i], numItems);
+				}
+
+				std::swap(src, dst);
+				break;
+			}
+			case LayerType::Tanh:
+				for(int i = 0; i < numElements; i++)
+					src[i] = std::tanh(src[i]);
+				break;
+			case LayerType::ReLU:
+				FloatVectorOperations::max(src, src, 0.0f, numElements);
+				break;
+			case LayerType::Sigmoid:
+				for(int i = 0; i < numElements; i++)
+					src[i] = 1.0f / (1.0f + std::exp(-src[i]));
+				break;
+			case LayerType::numLayerTypes:
+				jassertfalse;
+				break;
+			}
+		}
+
+		for(int b = 0; b < numItems; b++)
+		{
+			for(int o = 0; o < numOutputs; o++)
+				output[b * numOutputs + o] = src[o * numItems + b];
+		}
+	}
+
+	OwnedArray<Layer> layers;
+	HeapBlock<float> buffers[2];
+
+	int numInputs = 0;
+	int numOutputs = 0;
+	int maxWidth = 0;
+	int maxBatchSize = 0;
+	bool stateless = false;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DenseBatchProcessor);
+};
+
+/** Processes a block of consecutive frames through a dynamic RTNeural model.
+ *
+ *  Instead of running every sample through all layers, this runs the entire block through one layer
+ *	before moving on to the next layer. This keeps the weights of the current layer in the cache and
+ *	is still correct for recurrent and convolutional layers as their state only depends on the previous
+ *	frames of the same layer.
+ */
+struct LayerMajorProcessor
+{
+	LayerMajorProcessor() = default;
+
+	void prepare(const PytorchParser::ModelPtr& model, int newMaxBlockSize)
+	{
+		maxBlockSize = jmax(0, newMaxBlockSize);
+		maxStride = 0;
+
+		if(model == nullptr || model->layers.empty())
+		{
+			maxBlockSize = 0;
+			return;
+		}
+
+		for(auto l: model->layers)
+			maxStride = jmax(maxStride, getStride(l->in_size), getStride(l->out_size));
+
+		auto numElements = (size_t)(maxStride * maxBlockSize);
+
+		for(auto& b: buffers)
+			b.assign(numElements, 0.0f);
+	}
+
+	bool isActive() const { return maxBlockSize > 0; }
+
+	void process(const PytorchParser::ModelPtr& model, const float* input, float* output, int numFrames)
+	{
+		jassert(isActive());
+
+		auto numInputs = model->getInSize();
+		auto numOutputs = model->getOutSize();
+
+		while(numFrames > 0)
+		{
+			auto numThisTime = jmin(numFrames, maxBlockSize);
+
+			processChunk(model, input, output, numThisTime);
+
+			input += numThisTime * numInputs;
+			output += numThisTime * numOutputs;
+			numFrames -= numThisTime;
+		}
+	}
+
+private:
+
+	// the frames are aligned to the SIMD width so that each layer gets aligned data
+	static int getStride(int numElements)
+	{
+		constexpr int v_size = (int)xsimd::batch<float>::size;
+		return RTNeural::ceil_div(numElements, v_size) * v_size;
+	}
+
+	void processChunk(const PytorchParser::ModelPtr& model, const float* input, float* output, int numFrames)
+	{
+		auto src = buffers[0].data();
+		auto dst = buffers[1].data();
+
+		auto numInputs = model->getInSize();
+		auto numOutputs = model->getOutSize();
+
+		auto inStride = getStride(numInputs);
+
+		for(int t = 0; t < numFrames; t++)
+			FloatVectorOperations::copy(src + t * inStride, input + t * numInputs, numInputs);
+
+		for(auto l: model->layers)
+		{
+			auto si = getStride(l->in_size);
+			auto so = getStride(l->out_size);
+
+			for(int t = 0; t < numFrames; t++)
+				l->forward(src + t * si, dst + t * so);
+
+			std::swap(src, dst);
+		}
+
+		auto outStride = getStride(numOutputs);
+
+		for(int t = 0; t < numFrames; t++)
+			FloatVectorOperations::copy(output + t * numOutputs, src + t * outStride, numOutputs);
+	}
+
+	using vec_type = std::vector<float, xsimd::aligned_allocator<float>>;
+
+	vec_type buffers[2];
+
+	int maxStride = 0;
+	int maxBlockSize = 0;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LayerMajorProcessor);
+};
+
 struct EmptyModel: public NeuralNetwork::ModelBase
 {
 	ModelBase* clone() { return new EmptyModel(); }
@@ -320,6 +627,7 @@ struct TensorFlowModel: public NeuralNetwork::ModelBase
 		numInputs = model->getInSize();
 		numOutputs = model->getOutSize();
 		model->reset();
+		batchProcessor.init(model);
 	}
 
 	TensorFlowModel(const var& obj)
@@ -331,6 +639,7 @@ struct TensorFlowModel: public NeuralNetwork::ModelBase
 		numInputs = model->getInSize();
 		numOutputs = model->getOutSize();
 		model->reset();
+		batchProcessor.init(model);
 	}
 
 	ModelBase* clone() { return new TensorFlowModel(modelData); }
@@ -351,6 +660,34 @@ struct TensorFlowModel: public NeuralNetwork::ModelBase
 		memcpy(output, model->getOutputs(), sizeof(float) * numOutputs);
 	}
 
+	bool isStateless() const final { return batchProcessor.isStateless(); }
+
+	void prepareBatch(int maxBatchSize) final
+	{
+		batchProcessor.prepare(maxBatchSize);
+	}
+
+	void processBatch(const float* input, float* output, int numItems) final
+	{
+		if(batchProcessor.isActive())
+			batchProcessor.process(input, output, numItems);
+		else
+			ModelBase::processBatch(input, output, numItems);
+	}
+
+	void prepareBlock(int maxBlockSize) final
+	{
+		blockProcessor.prepare(model, maxBlockSize);
+	}
+
+	void processBlock(const float* input, float* output, int numFrames) final
+	{
+		if(blockProcessor.isActive())
+			blockProcessor.process(model, input, output, numFrames);
+		else
+			ModelBase::processBlock(input, output, numFrames);
+	}
+
 	int getNumInputs() const final { return numInputs; }
 	int getNumOutputs() const final { return numOutputs; }
 
@@ -358,6 +695,8 @@ struct TensorFlowModel: public NeuralNetwork::ModelBase
 	int numOutputs = 0;
 
 	PytorchParser::ModelPtr model;
+	DenseBatchProcessor batchProcessor;
+	LayerMajorProcessor blockProcessor;
 
 	nlohmann::json modelData;
 };
@@ -384,7 +723,9 @@ struct DynamicModel: public NeuralNetwork::ModelBase
 	Result loadWeightsInternal(const nlohmann::json& weights_)
 	{
 		weights = weights_;
-		return p.loadWeights(model, weights);
+		auto ok = p.loadWeights(model, weights);
+		batchProcessor.init(model);
+		return ok;
 	}
 
 	Result loadWeights(const String& jsonData) final
@@ -403,6 +744,34 @@ struct DynamicModel: public NeuralNetwork::ModelBase
 		memcpy(output, model->getOutputs(), sizeof(float) * numOutputs);
 	}
 
+	bool isStateless() const final { return batchProcessor.isStateless(); }
+
+	void prepareBatch(int maxBatchSize) final
+	{
+		batchProcessor.prepare(maxBatchSize);
+	}
+
+	void processBatch(const float* input, float* output, int numItems) final
+	{
+		if(batchProcessor.isActive())
+			batchProcessor.process(input, output, numItems);
+		else
+			ModelBase::processBatch(input, output, numItems);
+	}
+
+	void prepareBlock(int maxBlockSize) final
+	{
+		blockProcessor.prepare(model, maxBlockSize);
+	}
+
+	void processBlock(const float* input, float* output, int numFrames) final
+	{
+		if(blockProcessor.isActive())
+			blockProcessor.process(model, input, output, numFrames);
+		else
+			ModelBase::processBlock(input, output, numFrames);
+	}
+
 	int getNumInputs() const final { return numInputs; }
 	int getNumOutputs() const final { return numOutputs; }
 
@@ -410,6 +779,8 @@ struct DynamicModel: public NeuralNetwork::ModelBase
 
 	PytorchParser p;
 	PytorchParser::ModelPtr model;
+	DenseBatchProcessor batchProcessor;
+	LayerMajorProcessor blockProcessor;
 
 	int numInputs = 0;
 	int numOutputs = 0;
@@ -467,6 +838,12 @@ NeuralNetwork::Ptr NeuralNetwork::clone(int numNetworks)
     
     for(int i = 0; i < numNetworks; i++)
         nn->currentModels.add(currentModels.getFirst()->clone());
+
+    if(maxBatchSize > 0)
+        nn->prepareBatch(maxBatchSize);
+
+    if(maxBlockSize > 0)
+        nn->prepareBlock(maxBlockSize);
     
     return nn;
 }
@@ -534,6 +911,12 @@ struct NAMModel: public NeuralNetwork::ModelBase
 		*output = obj.forward(*input);
 	};
 
+	void processBlock(const float* input, float* output, int numFrames) final
+	{
+		for(int i = 0; i < numFrames; i++)
+			output[i] = obj.forward(input[i]);
+	}
+
 	int getNumInputs() const final
 	{
 		return 1;
@@ -592,10 +975,7 @@ Result NeuralNetwork::loadNAMModel(const var& jsonData)
 		return r;
 	}
 
-	{
-		SimpleReadWriteLock::ScopedMultiWriteLock sl(lock);
-		currentModels.swapWith(nm);
-	}
+	swapModels(nm);
 	
 	return Result::ok();
 }
@@ -607,10 +987,7 @@ void NeuralNetwork::clearModel()
 	for(int i = 0; i < getNumNetworks(); i++)
 		nm.add(new EmptyModel());
 
-	{
-		SimpleReadWriteLock::ScopedMultiWriteLock sl(lock);
-		currentModels.swapWith(nm);
-	}
+	swapModels(nm);
 }
 
 Result NeuralNetwork::build(const var& modelJSON)
@@ -629,10 +1006,7 @@ Result NeuralNetwork::build(const var& modelJSON)
 		return r;
 	}
 
-	{
-		SimpleReadWriteLock::ScopedMultiWriteLock sl(lock);
-		currentModels.swapWith(nm);
-	}
+	swapModels(nm);
 	
 	return Result::ok();
 }
@@ -688,10 +1062,7 @@ void NeuralNetwork::setNumNetworks(int numNetworks, bool forceClone)
 			newModels.getLast()->reset();
 		}
 
-		{
-			SimpleReadWriteLock::ScopedMultiWriteLock sl(lock);
-			newModels.swapWith(currentModels);
-		}
+		swapModels(newModels);
 	}
 }
 
@@ -729,6 +1100,91 @@ void NeuralNetwork::process(int networkIndex, const float* input, float* output)
 	}
 }
 
+void NeuralNetwork::processBatch(int firstNetworkIndex, int numItems, const float* input, float* output)
+{
+	if(auto sl = SimpleReadWriteLock::ScopedTryReadLock(lock))
+	{
+		// Every clone has its own batch buffers, so voices that are rendered in parallel
+		// can process their batches at the same time.
+		auto m = currentModels[firstNetworkIndex];
+
+		if(m == nullptr)
+			return;
+
+		if(m->isStateless())
+		{
+			m->processBatch(input, output, numItems);
+			return;
+		}
+
+		auto numIn = m->getNumInputs();
+		auto numOut = m->getNumOutputs();
+
+		for(int i = 0; i < numItems; i++)
+		{
+			if(auto cm = currentModels[firstNetworkIndex + i])
+				cm->process(input + i * numIn, output + i * numOut);
+		}
+	}
+}
+
+void NeuralNetwork::prepareBatch(int newMaxBatchSize)
+{
+	SimpleReadWriteLock::ScopedMultiWriteLock sl(lock);
+
+	maxBatchSize = newMaxBatchSize;
+
+	for(auto m: currentModels)
+		m->prepareBatch(maxBatchSize);
+}
+
+void NeuralNetwork::processBlock(int networkIndex, const float* input, float* output, int numFrames)
+{
+	if(auto sl = SimpleReadWriteLock::ScopedTryReadLock(lock))
+	{
+		if(auto cm = currentModels[networkIndex])
+			cm->processBlock(input, output, numFrames);
+	}
+}
+
+void NeuralNetwork::prepareBlock(int newMaxBlockSize)
+{
+	SimpleReadWriteLock::ScopedMultiWriteLock sl(lock);
+
+	maxBlockSize = newMaxBlockSize;
+
+	for(auto m: currentModels)
+		m->prepareBlock(maxBlockSize);
+}
+
+bool NeuralNetwork::isStateless() const
+{
+	SimpleReadWriteLock::ScopedReadLock sl(lock);
+
+	if(auto first = currentModels.getFirst())
+		return first->isStateless();
+
+	return false;
+}
+
+void NeuralNetwork::swapModels(OwnedArray<ModelBase>& newModels)
+{
+	if(maxBatchSize > 0)
+	{
+		for(auto m: newModels)
+			m->prepareBatch(maxBatchSize);
+	}
+
+	if(maxBlockSize > 0)
+	{
+		for(auto m: newModels)
+			m->prepareBlock(maxBlockSize);
+	}
+
+	SimpleReadWriteLock::ScopedMultiWriteLock sl(lock);
+	currentModels.swapWith(newModels);
+}
+
 Result NeuralNetwork::loadTensorFlowModel(const var& jsonData)
 {
 	OwnedArray<ModelBase> nt;
@@ -739,10 +1195,7 @@ Result NeuralNetwork::loadTensorFlowModel(const var& jsonData)
 		nt.add(nt.getFirst()->clone());
 		
 
-	{
-		SimpleReadWriteLock::ScopedMultiWriteLock sl(lock);
-		currentModels.swapWith(nt);
-	}
+	swapModels(nt);
 	
 	return Result::ok();
 }
@@ -921,4 +1374,284 @@ String NeuralNetwork::CppBuilder::createCppModel() const
 
 
 
+#if HI_RUN_UNIT_TESTS
+
+struct NeuralNetworkBlockProcessingTest: public UnitTest
+{
+	NeuralNetworkBlockProcessingTest():
+	  UnitTest("Testing neural network block processing", "neural")
+	{}
+
+	void runTest() override
+	{
+		testNAMModel();
+		testPytorchModel();
+		testRecurrentModel();
+		testBatchProcessing();
+	}
+
+	void testBatchProcessing()
+	{
+		beginTest("Testing batch processing of stateless networks");
+
+		auto nn = createNetwork();
+		expect(nn->loadPytorchModel(createDenseModel()).wasOk(), "load Pytorch model");
+		expect(nn->isStateless(), "dense model is stateless");
+
+		nn->prepareBatch(BlockSize);
+
+		constexpr int NumThreads = 2;
+		constexpr int NumSamples = BlockSize * 64;
+
+		AudioSampleBuffer input(NumThreads, NumSamples);
+		AudioSampleBuffer perSample(NumThreads, NumSamples);
+		AudioSampleBuffer batch(NumThreads, NumSamples);
+
+		for(int c = 0; c < NumThreads; c++)
+		{
+			for(int i = 0; i < NumSamples; i++)
+			{
+				input.setSample(c, i, r.nextFloat() * 2.0f - 1.0f);
+				nn->process(c, input.getReadPointer(c, i), perSample.getWritePointer(c, i));
+			}
+		}
+
+		// Both threads use the batch buffers of their own network clone
+		OwnedArray<Thread> threads;
+
+		for(int c = 0; c < NumThreads; c++)
+		{
+			struct BatchThread: public Thread
+			{
+				BatchThread(NeuralNetwork& nn_, int index_, const float* in_, float* out_):
+				  Thread("Batch " + String(index_)),
+				  nn(nn_),
+				  index(index_),
+				  in(in_),
+				  out(out_)
+				{}
+
+				void run() override
+				{
+					for(int i = 0; i < NumSamples; i += BlockSize)
+						nn.processBatch(index, BlockSize, in + i, out + i);
+				}
+
+				NeuralNetwork& nn;
+				const int index;
+				const float* in;
+				float* out;
+			};
+
+			threads.add(new BatchThread(*nn, c, input.getReadPointer(c), batch.getWritePointer(c)));
+		}
+
+		for(auto t: threads)
+			t->startThread();
+
+		for(auto t: threads)
+			t->waitForThreadToExit(-1);
+
+		for(int c = 0; c < NumThreads; c++)
+		{
+			float maxError = 0.0f;
+
+			for(int i = 0; i < NumSamples; i++)
+				maxError = jmax(maxError, std::abs(perSample.getSample(c, i) - batch.getSample(c, i)));
+
+			expect(maxError < 1e-5f, "batch processing doesn't match per-sample processing: " + String(maxError));
+		}
+	}
+
+	void testNAMModel()
+	{
+		beginTest("Testing NAM model");
+
+		// the standard NAM wavenet architecture has 13802 parameters
+		Array<var> weights;
+
+		for(int i = 0; i < 13802; i++)
+			weights.add(r.nextFloat() * 0.2f - 0.1f);
+
+		auto obj = new DynamicObject();
+		obj->setProperty("weights", var(weights));
+
+		auto nn = createNetwork();
+		expect(nn->loadNAMModel(var(obj)).wasOk(), "load NAM model");
+
+		compareAndBenchmark(*nn, "NAM");
+	}
+
+	void testPytorchModel()
+	{
+		beginTest("Testing Pytorch model");
+
+		auto nn = createNetwork();
+		expect(nn->loadPytorchModel(createDenseModel()).wasOk(), "load Pytorch model");
+
+		compareAndBenchmark(*nn, "Pytorch");
+	}
+
+	void testRecurrentModel()
+	{
+		beginTest("Testing recurrent model");
+
+		auto nn = createNetwork();
+		expect(nn->loadTensorFlowModel(createRecurrentModel()).wasOk(), "load TensorFlow model");
+		expect(!nn->isStateless(), "recurrent model is not stateless");
+
+		// the state of the recurrent layers must carry over from one block to the next
+		compareAndBenchmark(*nn, "GRU + LSTM");
+	}
+
+	/** Creates a RTNeural JSON model with a GRU and a LSTM layer that feed into a dense output layer. */
+	var createRecurrentModel()
+	{
+		constexpr int NumUnits = 8;
+
+		auto createLayer = [](const String& type, int numOutputs, const Array<var>& weights)
+		{
+			auto obj = new DynamicObject();
+			obj->setProperty("type", type);
+			obj->setProperty("activation", "");
+			obj->setProperty("shape", var(Array<var>({ var(), var(), numOutputs })));
+			obj->setProperty("weights", var(weights));
+			return var(obj);
+		};
+
+		Array<var> gruBias = { createMatrix(1, 3 * NumUnits)[0], createMatrix(1, 3 * NumUnits)[0] };
+
+		Array<var> layers;
+
+		layers.add(createLayer("gru", NumUnits, { createMatrix(1, 3 * NumUnits), createMatrix(NumUnits, 3 * NumUnits), var(gruBias) }));
+		layers.add(createLayer("lstm", NumUnits, { createMatrix(NumUnits, 4 * NumUnits), createMatrix(NumUnits, 4 * NumUnits), createMatrix(1, 4 * NumUnits)[0] }));
+		layers.add(createLayer("dense", 1, { createMatrix(NumUnits, 1), createMatrix(1, 1)[0] }));
+
+		auto obj = new DynamicObject();
+		obj->setProperty("in_shape", var(Array<var>({ var(), var(), 1 })));
+		obj->setProperty("layers", var(layers));
+
+		return var(obj);
+	}
+
+	var createMatrix(int numRows, int numColumns)
+	{
+		Array<var> rows;
+
+		for(int i = 0; i < numRows; i++)
+		{
+			Array<var> row;
+
+			for(int j = 0; j < numColumns; j++)
+				row.add(r.nextFloat() - 0.5f);
+
+			rows.add(var(row));
+		}
+
+		return var(rows);
+	}
+
+	var createDenseModel()
+	{
+		String layers;
+		layers << "Sequential(\n";
+		layers << "  (0): Linear(in_features=1, out_features=32, bias=True)\n";
+		layers << "  (1): Tanh()\n";
+		layers << "  (2): Linear(in_features=32, out_features=32, bias=True)\n";
+		layers << "  (3): Tanh()\n";
+		layers << "  (4): Linear(in_features=32, out_features=1, bias=True)\n";
+		layers << ")\n";
+
+		auto weights = new DynamicObject();
+
+		addDenseWeights(weights, "0", 1, 32);
+		addDenseWeights(weights, "2", 32, 32);
+		addDenseWeights(weights, "4", 32, 1);
+
+		auto obj = new DynamicObject();
+		obj->setProperty("layers", layers);
+		obj->setProperty("weights", var(weights));
+
+		return var(obj);
+	}
+
+	void addDenseWeights(DynamicObject* obj, const String& name, int numInputs, int numOutputs)
+	{
+		Array<var> w, b;
+
+		for(int o = 0; o < numOutputs; o++)
+		{
+			Array<var> row;
+
+			for(int i = 0; i < numInputs; i++)
+				row.add(r.nextFloat() - 0.5f);
+
+			w.add(var(row));
+			b.add(r.nextFloat() - 0.5f);
+		}
+
+		obj->setProperty(Identifier(name + ".weight"), var(w));
+		obj->setProperty(Identifier(name + ".bias"), var(b));
+	}
+
+	NeuralNetwork::Ptr createNetwork()
+	{
+		NeuralNetwork::Ptr nn = new NeuralNetwork(Identifier("test"), &factory);
+		nn->setNumNetworks(2, true);
+		nn->prepareBlock(BlockSize);
+		return nn;
+	}
+
+	void compareAndBenchmark(NeuralNetwork& nn, const String& name)
+	{
+		constexpr int NumSamples = 44100;
+
+		AudioSampleBuffer input(1, NumSamples);
+		AudioSampleBuffer perSample(1, NumSamples);
+		AudioSampleBuffer block(1, NumSamples);
+
+		for(int i = 0; i < NumSamples; i++)
+			input.setSample(0, i, r.nextFloat() * 2.0f - 1.0f);
+
+		nn.reset(-1);
+
+		auto start = Time::getMillisecondCounterHiRes();
+
+		for(int i = 0; i < NumSamples; i++)
+			nn.process(0, input.getReadPointer(0, i), perSample.getWritePointer(0, i));
+
+		auto perSampleTime = Time::getMillisecondCounterHiRes() - start;
+
+		start = Time::getMillisecondCounterHiRes();
+
+		for(int i = 0; i < NumSamples; i += BlockSize)
+		{
+			auto numThisTime = jmin(BlockSize, NumSamples - i);
+			nn.processBlock(1, input.getReadPointer(0, i), block.getWritePointer(0, i), numThisTime);
+		}
+
+		auto blockTime = Time::getMillisecondCounterHiRes() - start;
+
+		float maxError = 0.0f;
+
+		for(int i = 0; i < NumSamples; i++)
+			maxError = jmax(maxError, std::abs(perSample.getSample(0, i) - block.getSample(0, i)));
+
+		expect(maxError < 1e-5f, name + ": block processing doesn't match per-sample processing: " + String(maxError));
+
+		String msg;
+		msg << name << ": per sample: " << String(perSampleTime, 2) << "ms, block: " << String(blockTime, 2) << "ms";
+		logMessage(msg);
+	}
+
+	static constexpr int BlockSize = 512;
+
+	NeuralNetwork::Factory factory;
+	Random r;
+};
+
+static NeuralNetworkBlockProcessingTest neuralBlockTest;
+
+#endif
+
 }
@@ -81,6 +81,44 @@ struct NeuralNetwork: public ReferenceCountedObject,
 		virtual int getNumOutputs() const = 0;
 		virtual ModelBase* clone() = 0;
 		virtual Result loadWeights(const String& jsonData) = 0;
+
+		/** Override this and return true if the model has no internal state (eg. only dense layers and activations).
+		 *  In this case all clones compute the same function and can be processed as a single batch.
+		 */
+		virtual bool isStateless() const { return false; }
+
+		/** Allocates the buffers for batch processing. This is not called on the audio thread. */
+		virtual void prepareBatch(int maxBatchSize) {}
+
+		/** Processes multiple input frames at once. This is only called for stateless models.
+		 *
+		 *  The data is expected as `numItems` consecutive frames with `getNumInputs()` / `getNumOutputs()` elements.
+		 *  The default implementation just calls process() for each item.
+		 */
+		virtual void processBatch(const float* input, float* output, int numItems)
+		{
+			auto numIn = getNumInputs();
+			auto numOut = getNumOutputs();
+
+			for(int i = 0; i < numItems; i++)
+				process(input + i * numIn, output + i * numOut);
+		}
+
+		/** Allocates the buffers for block processing. This is not called on the audio thread. */
+		virtual void prepareBlock(int maxBlockSize) {}
+
+		/** Processes `numFrames` consecutive frames of a signal and keeps the internal state of the model.
+		 *
+		 *  The result must be the same as calling process() for each frame. The default implementation does exactly that.
+		 */
+		virtual void processBlock(const float* input, float* output, int numFrames)
+		{
+			auto numIn = getNumInputs();
+			auto numOut = getNumOutputs();
+
+			for(int i = 0; i < numFrames; i++)
+				process(input + i * numIn, output + i * numOut);
+		}
         
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ModelBase);
 	};
@@ -165,6 +203,36 @@ struct NeuralNetwork: public ReferenceCountedObject,
 	int getNumOutputs() const;
 	void reset(int networkIndex=-1);
 	void process(int networkIndex, const float* input, float* output);
+
+	/** Processes multiple networks at once.
+	 *
+	 *  The input and output data must contain `numItems` consecutive frames. If the network is stateless, all items are
+	 *	computed in a single matrix-matrix pass with the buffers of the clone at `firstNetworkIndex` (so you can pass in
+	 *	more items than there are network clones, eg. all samples of an audio block). Otherwise the item `i` will be
+	 *	processed by the network clone with the index `firstNetworkIndex + i`.
+	 *
+	 *	This can be called from multiple threads at the same time as long as they use different network indexes.
+	 *
+	 *	Make sure to call prepareBatch() with the maximum amount of items before calling this method.
+	 */
+	void processBatch(int firstNetworkIndex, int numItems, const float* input, float* output);
+
+	/** Allocates the buffers for processBatch(). */
+	void prepareBatch(int maxBatchSize);
+
+	/** Processes a block of `numFrames` consecutive frames with the given network.
+	 *
+	 *	This has the same result as calling process() for each frame, but it avoids the per-sample overhead and
+	 *	lets the model process the block layer by layer. Call prepareBlock() with the maximum block size before.
+	 */
+	void processBlock(int networkIndex, const float* input, float* output, int numFrames);
+
+	/** Allocates the buffers for processBlock() for all network clones. */
+	void prepareBlock(int maxBlockSize);
+
+	/** Returns true if the network has no internal state and can be processed in batches. */
+	bool isStateless() const;
+
 	void clearModel();
 
 	/* Loads a model with trained weights from Tensorflow. */
@@ -202,8 +270,14 @@ struct NeuralNetwork: public ReferenceCountedObject,
 	ProcessingContext context;
 
 private:
+
+	/** Replaces the current models and prepares the batch buffers of the new models. */
+	void swapModels(OwnedArray<ModelBase>& newModels);
 	
     Factory* factory = nullptr;
+
+	int maxBatchSize = 0;
+	int maxBlockSize = 0;
     
 	mutable hise::SimpleReadWriteLock lock;
 
@@ -1362,7 +1362,125 @@ PooledUIUpdater::PooledUIUpdater():
 	pendingHandlers(8192)
 {
 	suspendTimer(false);
-	startTimer(30);
+	startTimer(FrameIntervalMs);
+}
+
+void PooledUIUpdater::repaintPooled(Component* c)
+{
+	repaintPooled(c, {});
+}
+
+void PooledUIUpdater::repaintPooled(Component* c, Rectangle<int> area)
+{
+	JUCE_ASSERT_MESSAGE_THREAD;
+
+	if (c == nullptr)
+		return;
+
+#if HISE_HEADLESS
+	c->repaint(area.isEmpty() ? c->getLocalBounds() : area);
+#else
+
+	// there will be no frame to flush the region
+	if (isSuspended())
+	{
+		c->repaint(area.isEmpty() ? c->getLocalBounds() : area);
+		return;
+	}
+
+	stats.numRepaintRequests++;
+
+	for (auto& d : dirtyRegions)
+	{
+		if (d.component.getComponent() == c)
+		{
+			// an empty area marks the entire component
+			if (!d.area.isEmpty())
+				d.area = area.isEmpty() ? Rectangle<int>() : d.area.getUnion(area);
+
+			return;
+		}
+	}
+
+	dirtyRegions.add({ Component::SafePointer<Component>(c), area });
+#endif
+}
+
+void PooledUIUpdater::flushDirtyRegions()
+{
+	if (dirtyRegions.isEmpty())
+		return;
+
+	struct Window
+	{
+		Component* topLevel;
+		RectangleList<int> area;
+	};
+
+	Array<Window> windows;
+
+	for (const auto& d : dirtyRegions)
+	{
+		auto c = d.component.getComponent();
+
+		if (c == nullptr || !c->isShowing())
+			continue;
+
+		auto area = d.area.isEmpty() ? c->getLocalBounds() : d.area.getIntersection(c->getLocalBounds());
+
+		// Walk up to the top level component the same way Component::repaint() does,
+		// so that cached component images along the way are invalidated.
+		while (!area.isEmpty())
+		{
+			if (auto ci = c->getCachedComponentImage())
+			{
+				if (!ci->invalidate(area))
+					area = {};
+			}
+
+			auto p = c->getParentComponent();
+
+			if (p == nullptr || area.isEmpty())
+				break;
+
+			area = p->getLocalArea(c, area).getIntersection(p->getLocalBounds());
+			c = p;
+		}
+
+		if (area.isEmpty())
+			continue;
+
+		bool found = false;
+
+		for (auto& w : windows)
+		{
+			if (w.topLevel == c)
+			{
+				w.area.add(area);
+				found = true;
+				break;
+			}
+		}
+
+		if (!found)
+			windows.add({ c, RectangleList<int>(area) });
+	}
+
+	dirtyRegions.clearQuick();
+
+	for (auto& w : windows)
+	{
+		w.area.consolidate();
+
+		if (w.area.getNumRectangles() > MaxDirtyRectanglesPerWindow)
+			w.area = RectangleList<int>(w.area.getBounds());
+
+		for (auto r : w.area)
+		{
+			w.topLevel->repaint(r);
+			stats.numRepaintedAreas++;
+		}
+	}
 }
 
 PooledUIUpdater::Listener::~Listener()
@@ -1380,6 +1498,14 @@ PooledUIUpdater::SimpleTimer::~SimpleTimer()
 	stop();
 }
 
+void PooledUIUpdater::SimpleTimer::repaintPooled(Component* c)
+{
+	if (auto u = updater.get())
+		u->repaintPooled(c);
+	else
+		c->repaint();
+}
+
 void PooledUIUpdater::SimpleTimer::start()
 {
 	startOrStop(true);
@@ -1445,6 +1571,8 @@ void PooledUIUpdater::timerCallback()
 
 	TRACE_DISPATCH("UI Timer callback");
 
+	auto frameStart = Time::getMillisecondCounterHiRes();
+
 	{
 		ScopedLock sl(simpleTimers.getLock());
 
@@ -1462,21 +1590,41 @@ void PooledUIUpdater::timerCallback()
 		}
 	}
 
+	// Collect the pending messages first so that messages that are sent
+	// during the dispatch will be deferred to the next frame.
 	WeakReference<Broadcaster> b;
 
 	while (pendingHandlers.pop(b))
+		currentFrame.add(b);
+
+	for (auto& cb : currentFrame)
 	{
-		if (b.get() != nullptr)
+		if (cb.get() != nullptr)
 		{
-			b->pending = false;
+			cb->pending = false;
+			stats.numBroadcasts++;
 
-			for (auto l : b->pooledListeners)
+			for (auto l : cb->pooledListeners)
 			{
 				if (l != nullptr)
-					l->handlePooledMessage(b);
+					l->handlePooledMessage(cb);
 			}
 		}
 	}
+
+	currentFrame.clearQuick();
+
+	flushDirtyRegions();
+
+	auto frameDuration = Time::getMillisecondCounterHiRes() - frameStart;
+
+	stats.numFrames++;
+	stats.lastFrameDuration = frameDuration;
+	stats.maxFrameDuration = jmax(stats.maxFrameDuration, frameDuration);
+	stats.totalFrameDuration += frameDuration;
+
+	if (frameDuration > frameBudget)
+		stats.numBudgetOverruns++;
 }
 
 ComplexDataUIUpdaterBase::EventListener::~EventListener()
@@ -499,13 +499,61 @@ private:
 /** Coallescates timer updates.
 	@ingroup event_handling
 	
+	All pending broadcasts are collected and dispatched once per frame. Messages that are sent while
+	the frame is dispatched will be handled in the next frame. Listeners that need to repaint a
+	component can use repaintPooled() so that the dirty areas of all updates are merged per top level
+	window and painted in one go at the end of the frame.
 */
 class PooledUIUpdater : public SuspendableTimer
 {
 public:
 
+	/** The interval between two frames in milliseconds. */
+	static constexpr int FrameIntervalMs = 30;
+
+	/** If a window has more dirty rectangles than this, it will repaint their bounding box instead. */
+	static constexpr int MaxDirtyRectanglesPerWindow = 16;
+
+	/** The timing statistics of the frame updates. All durations are in milliseconds. 
+	
+		The frame duration covers the timer callbacks, the broadcasts and the collection of the dirty regions.
+		The painting itself happens later when the OS asks the windows to repaint, so it is not included.
+	*/
+	struct FrameStatistics
+	{
+		double getAverageFrameDuration() const { return numFrames > 0 ? totalFrameDuration / (double)numFrames : 0.0; }
+
+		int numFrames = 0;
+		int numBudgetOverruns = 0;
+		int numBroadcasts = 0;
+		int numRepaintRequests = 0;
+		int numRepaintedAreas = 0;
+
+		double lastFrameDuration = 0.0;
+		double maxFrameDuration = 0.0;
+		double totalFrameDuration = 0.0;
+	};
+
 	PooledUIUpdater();
 
+	/** Marks the given component as dirty and repaints it at the end of the current frame. 
+	
+		Call this from the message thread instead of Component::repaint() if the repaint is caused by a pooled update.
+	*/
+	void repaintPooled(Component* c);
+
+	/** Marks the area of the given component as dirty and repaints it at the end of the current frame. */
+	void repaintPooled(Component* c, Rectangle<int> area);
+
+	/** Sets the time that the updates of a single frame may take before it is counted as budget overrun. */
+	void setFrameBudget(double milliseconds) { frameBudget = milliseconds; }
+
+	double getFrameBudget() const { return frameBudget; }
+
+	const FrameStatistics& getFrameStatistics() const { return stats; }
+
+	void resetFrameStatistics() { stats = {}; }
+
 	class Broadcaster;
 
 	class Listener
@@ -536,6 +584,11 @@ public:
 
 		virtual void timerCallback() = 0;
 
+	protected:
+
+		/** Repaints the component at the end of the current frame (or immediately if there is no updater). */
+		void repaintPooled(Component* c);
+
 	private:
 
 		void startOrStop(bool shouldStart);
@@ -561,6 +614,8 @@ public:
 
 		bool isHandlerInitialised() const;;
 
+		PooledUIUpdater* getHandler() const { return handler.get(); }
+
 		bool pending = false;
 
 	private:
@@ -579,9 +634,24 @@ public:
 
 private:
 
+	struct DirtyRegion
+	{
+		Component::SafePointer<Component> component;
+		Rectangle<int> area;
+	};
+
+	void flushDirtyRegions();
+
 	Array<WeakReference<SimpleTimer>, CriticalSection> simpleTimers;
 	LockfreeQueue<WeakReference<Broadcaster>> pendingHandlers;
 
+	Array<WeakReference<Broadcaster>> currentFrame;
+	Array<DirtyRegion> dirtyRegions;
+
+	// the updates share the message thread with the repaint, so they get half of the frame
+	double frameBudget = (double)FrameIntervalMs * 0.5;
+	FrameStatistics stats;
+
 	JUCE_DECLARE_WEAK_REFERENCEABLE(PooledUIUpdater);
 };
 
@@ -138,7 +138,67 @@ PostGraphicsRenderer::Data::WithoutAlphaConverter::~WithoutAlphaConverter()
 	}
 }
 
-PostGraphicsRenderer::PostGraphicsRenderer(DataStack& stackTouse, Image& image, float scaleFactor_) :
+PostGraphicsRenderer::WorkerPool::WorkerPool():
+	ThreadPool(jlimit(1, 7, SystemStats::getNumCpus() - 1))
+{}
+
+bool PostGraphicsRenderer::ResultCache::restore(Image& img) const
+{
+	if (!valid || img.getWidth() != width || img.getHeight() != height || img.getFormat() != format)
+		return false;
+
+	Image::BitmapData d(img, Image::BitmapData::readWrite);
+
+	auto numBytesPerLine = (size_t)(d.width * d.pixelStride);
+	auto src = static_cast<const uint8*>(input.getData());
+
+	for (int y = 0; y < d.height; y++)
+	{
+		if (memcmp(d.getLinePointer(y), src + y * numBytesPerLine, numBytesPerLine) != 0)
+			return false;
+	}
+
+	src = static_cast<const uint8*>(output.getData());
+
+	for (int y = 0; y < d.height; y++)
+		memcpy(d.getLinePointer(y), src + y * numBytesPerLine, numBytesPerLine);
+
+	return true;
+}
+
+void PostGraphicsRenderer::ResultCache::setInput(const Image& img)
+{
+	valid = false;
+	width = img.getWidth();
+	height = img.getHeight();
+	format = img.getFormat();
+
+	copyToBlock(img, input);
+}
+
+void PostGraphicsRenderer::ResultCache::setOutput(const Image& img)
+{
+	jassert(img.getWidth() == width && img.getHeight() == height);
+
+	copyToBlock(img, output);
+	valid = true;
+}
+
+void PostGraphicsRenderer::ResultCache::copyToBlock(const Image& img, MemoryBlock& mb)
+{
+	Image::BitmapData d(img, Image::BitmapData::readOnly);
+
+	auto numBytesPerLine = (size_t)(d.width * d.pixelStride);
+
+	mb.setSize(numBytesPerLine * d.height);
+	auto dst = static_cast<uint8*>(mb.getData());
+
+	for (int y = 0; y < d.height; y++)
+		memcpy(dst + y * numBytesPerLine, d.getLinePointer(y), numBytesPerLine);
+}
+
+PostGraphicsRenderer::PostGraphicsRenderer(DataStack& stackTouse, Image& image, float scaleFactor_, ThreadPool* workerPool_) :
+	workerPool(workerPool_),
 	img(image),
 	bd(image, Image::BitmapData::readWrite),
 	stack(stackTouse),
@@ -157,7 +217,7 @@ void PostGraphicsRenderer::reserveStackOperations(int numOperationsToAllocate)
 
 void PostGraphicsRenderer::desaturate()
 {
-	for (int y = 0; y < bd.height; y++)
+	gin::multiThreadedFor(0, bd.height, 1, getWorkerPoolForImage(), [this](int y)
 	{
 		for (int x = 0; x < bd.width; x++)
 		{
@@ -168,7 +228,7 @@ void PostGraphicsRenderer::desaturate()
 			*p.g = sum;
 			*p.b = sum;
 		}
-	}
+	});
 }
 
 void PostGraphicsRenderer::applyMask(const Path& path, bool invert /*= false*/, bool scale)
@@ -200,7 +260,7 @@ void PostGraphicsRenderer::applyMask(const Path& path, bool invert /*= false*/,
 
 	Image::BitmapData pathData(bf.pathImage, Image::BitmapData::readOnly);
 
-	for (int y = 0; y < bd.height; y++)
+	gin::multiThreadedFor(0, bd.height, 1, getWorkerPoolForImage(), [&](int y)
 	{
 		for (int x = 0; x < bd.width; x++)
 		{
@@ -216,15 +276,28 @@ void PostGraphicsRenderer::applyMask(const Path& path, bool invert /*= false*/,
 			*p.b = (uint8)jlimit(0, 255, (int)((float)*p.b * alpha));
 			*p.a = (uint8)jlimit(0, 255, (int)((float)*p.a * alpha));
 		}
-	}
+	});
 }
 
 void PostGraphicsRenderer::addNoise(float noiseAmount)
 {
-	Random r;
+	// Every row gets its own generator so that they can be processed in parallel. The seeds are
+	// scrambled because the state of the LCG in Random would be affine in the row index otherwise.
+	auto seed = (uint64)Random::getSystemRandom().nextInt64();
 
-	for (int y = 0; y < bd.height; y++)
+	auto getSeedForRow = [seed](int y)
 	{
+		// splitmix64
+		auto z = (seed ^ (uint64)y) + 0x9e3779b97f4a7c15ull;
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+		return (int64)(z ^ (z >> 31));
+	};
+
+	gin::multiThreadedFor(0, bd.height, 1, getWorkerPoolForImage(), [&](int y)
+	{
+		Random r(getSeedForRow(y));
+
 		for (int x = 0; x < bd.width; x++)
 		{
 			Pixel p(bd.getPixelPointer(x, y));
@@ -237,7 +310,7 @@ void PostGraphicsRenderer::addNoise(float noiseAmount)
 			*p.g = (uint8)jlimit(0, 255, (int)*p.g + delta);
 			*p.b = (uint8)jlimit(0, 255, (int)*p.b + delta);
 		}
-	}
+	});
 }
 
 void PostGraphicsRenderer::gaussianBlur(int blur)
@@ -263,7 +336,7 @@ void PostGraphicsRenderer::stackBlur(int blur)
 	{
 		auto f = img.rescaled(img.getWidth() / DownsamplingFactor, img.getHeight() / DownsamplingFactor, Graphics::ResamplingQuality::lowResamplingQuality);
 
-		gin::applyStackBlurARGB(f, blur / DownsamplingFactor);
+		gin::applyStackBlur(f, blur / DownsamplingFactor, workerPool);
 
 		juce::Image::BitmapData srcData(f, juce::Image::BitmapData::readOnly);
 		juce::Image::BitmapData dstData(img, juce::Image::BitmapData::writeOnly);
@@ -292,7 +365,7 @@ void PostGraphicsRenderer::stackBlur(int blur)
 	}
 	else
 	{
-		gin::applyStackBlur(img, blur);
+		gin::applyStackBlur(img, blur, workerPool);
 	}
 
 	
@@ -300,17 +373,17 @@ void PostGraphicsRenderer::stackBlur(int blur)
 
 void PostGraphicsRenderer::applyHSL(float h, float s, float l)
 {
-	gin::applyHueSaturationLightness(img, h, s, l);
+	gin::applyHueSaturationLightness(img, h, s, l, workerPool);
 }
 
 void PostGraphicsRenderer::applyGamma(float g)
 {
-	gin::applyGamma(img, g);
+	gin::applyGamma(img, g, workerPool);
 }
 
 void PostGraphicsRenderer::applyGradientMap(ColourGradient g)
 {
-	gin::applyGradientMap(img, g.getColour(0), g.getColour(1));
+	gin::applyGradientMap(img, g.getColour(0), g.getColour(1), workerPool);
 }
 
 void PostGraphicsRenderer::applySharpness(int delta)
@@ -318,23 +391,28 @@ void PostGraphicsRenderer::applySharpness(int delta)
 	if (delta > 0)
 	{
 		for (int i = 0; i < delta; i++)
-			gin::applySharpen(img);
+			gin::applySharpen(img, workerPool);
 	}
 	else
 	{
 		for (int i = 0; i < -delta; i++)
-			gin::applySoften(img);
+			gin::applySoften(img, workerPool);
 	}
 }
 
 void PostGraphicsRenderer::applySepia()
 {
-	gin::applySepia(img);
+	gin::applySepia(img, workerPool);
 }
 
 void PostGraphicsRenderer::applyVignette(float amount, float radius, float falloff)
 {
-	gin::applyVignette(img, amount, radius, falloff);
+	gin::applyVignette(img, amount, radius, falloff, workerPool);
+}
+
+ThreadPool* PostGraphicsRenderer::getWorkerPoolForImage() const
+{
+	return (bd.width >= 256 || bd.height >= 256) ? workerPool : nullptr;
 }
 
 hise::PostGraphicsRenderer::Data& PostGraphicsRenderer::getNextData()
@@ -390,7 +468,7 @@ void ComponentWithPostGraphicsRenderer::paint(Graphics& g)
 
 	paintBeforeEffect(g2);
 
-	PostGraphicsRenderer r(stack, img);
+	PostGraphicsRenderer r(stack, img, 1.0f, workerPool);
 	r.reserveStackOperations(numOps);
 	applyPostEffect(r);
 
@@ -407,4 +485,153 @@ void ComponentWithPostGraphicsRenderer::setNumOperations(int numOperations)
 	numOps = numOperations;
 }
 
+#if HI_RUN_UNIT_TESTS
+
+struct PostGraphicsRendererTestBase : public UnitTest
+{
+	PostGraphicsRendererTestBase(const String& name, const String& category):
+	  UnitTest(name, category)
+	{}
+
+	using EffectFunction = std::function<void(PostGraphicsRenderer&)>;
+
+	/** Runs all effects with and without the worker pool and compares the results. */
+	void testAllEffects(const Array<Point<int>>& sizes, bool logTimes)
+	{
+		SharedResourcePointer<PostGraphicsRenderer::WorkerPool> workerPool;
+
+		for (auto s : sizes)
+		{
+			beginTest("Post effects with " + String(s.x) + "x" + String(s.y) + " pixels");
+
+			compareAndBenchmark(*workerPool, s, logTimes, "stackBlur", [](PostGraphicsRenderer& r) { r.stackBlur(20); });
+			compareAndBenchmark(*workerPool, s, logTimes, "desaturate", [](PostGraphicsRenderer& r) { r.desaturate(); });
+			compareAndBenchmark(*workerPool, s, logTimes, "applyHSL", [](PostGraphicsRenderer& r) { r.applyHSL(30.0f, 120.0f, 10.0f); });
+			compareAndBenchmark(*workerPool, s, logTimes, "applyGamma", [](PostGraphicsRenderer& r) { r.applyGamma(2.2f); });
+			compareAndBenchmark(*workerPool, s, logTimes, "applyGradientMap", [](PostGraphicsRenderer& r) { r.applyGradientMap(ColourGradient(Colours::red, 0.0f, 0.0f, Colours::blue, 1.0f, 1.0f, false)); });
+			compareAndBenchmark(*workerPool, s, logTimes, "applySepia", [](PostGraphicsRenderer& r) { r.applySepia(); });
+			compareAndBenchmark(*workerPool, s, logTimes, "applyVignette", [](PostGraphicsRenderer& r) { r.applyVignette(0.5f, 0.8f, 0.5f); });
+		}
+	}
+
+	Image createTestImage(Point<int> size)
+	{
+		Image img(Image::ARGB, size.x, size.y, false);
+		Image::BitmapData d(img, Image::BitmapData::writeOnly);
+
+		for (int y = 0; y < size.y; y++)
+		{
+			auto line = d.getLinePointer(y);
+
+			for (int x = 0; x < size.x * d.pixelStride; x++)
+				line[x] = (uint8)r.nextInt(256);
+		}
+
+		return img;
+	}
+
+	static bool isEqual(const Image& a, const Image& b)
+	{
+		Image::BitmapData da(a, Image::BitmapData::readOnly);
+		Image::BitmapData db(b, Image::BitmapData::readOnly);
+
+		for (int y = 0; y < da.height; y++)
+		{
+			if (memcmp(da.getLinePointer(y), db.getLinePointer(y), (size_t)(da.width * da.pixelStride)) != 0)
+				return false;
+		}
+
+		return true;
+	}
+
+	void compareAndBenchmark(ThreadPool& workerPool, Point<int> size, bool logTimes, const String& name, const EffectFunction& f)
+	{
+		auto source = createTestImage(size);
+		auto serial = source.createCopy();
+		auto parallel = source.createCopy();
+
+		PostGraphicsRenderer::DataStack stack;
+
+		auto start = Time::getMillisecondCounterHiRes();
+
+		{
+			PostGraphicsRenderer pgr(stack, serial);
+			f(pgr);
+		}
+
+		auto serialTime = Time::getMillisecondCounterHiRes() - start;
+
+		start = Time::getMillisecondCounterHiRes();
+
+		{
+			PostGraphicsRenderer pgr(stack, parallel, 1.0f, &workerPool);
+			f(pgr);
+		}
+
+		auto parallelTime = Time::getMillisecondCounterHiRes() - start;
+
+		expect(isEqual(serial, parallel), name + ": multithreaded result doesn't match");
+
+		if (logTimes)
+		{
+			String msg;
+			msg << name << ": single thread: " << String(serialTime, 2) << "ms, " << String(workerPool.getNumThreads() + 1) << " threads: " << String(parallelTime, 2) << "ms";
+			logMessage(msg);
+		}
+	}
+
+	Random r = Random(42);
+};
+
+struct PostGraphicsRendererTest : public PostGraphicsRendererTestBase
+{
+	PostGraphicsRendererTest():
+	  PostGraphicsRendererTestBase("Testing post graphics effects", "ui")
+	{}
+
+	void runTest() override
+	{
+		testAllEffects({ Point<int>(200, 100), Point<int>(333, 77) }, false);
+
+		beginTest("Result cache");
+
+		auto img = createTestImage({ 300, 200 });
+		auto processed = img.createCopy();
+
+		PostGraphicsRenderer::ResultCache cache;
+		expect(!cache.restore(img), "empty cache restored the image");
+
+		cache.setInput(img);
+		gin::applyGamma(processed, 2.2f);
+		cache.setOutput(processed);
+
+		auto copy = img.createCopy();
+		expect(cache.restore(copy), "cache didn't restore the same input");
+		expect(isEqual(copy, processed), "restored image doesn't match the result");
+
+		copy = img.createCopy();
+		copy.setPixelAt(150, 100, Colours::red);
+		expect(!cache.restore(copy), "cache restored a different input");
+	}
+};
+
+/** Measures the effects with and without the worker pool. This is too slow for the normal test run. */
+struct PostGraphicsRendererBenchmark : public PostGraphicsRendererTestBase
+{
+	PostGraphicsRendererBenchmark():
+	  PostGraphicsRendererTestBase("Post graphics effects benchmark", "ui_benchmark")
+	{}
+
+	void runTest() override
+	{
+		// Twice the size of common panels to simulate a retina display
+		testAllEffects({ Point<int>(600, 200), Point<int>(1200, 800), Point<int>(2400, 1600) }, true);
+	}
+};
+
+static PostGraphicsRendererTest postGraphicsRendererTest;
+static PostGraphicsRendererBenchmark postGraphicsRendererBenchmark;
+
+#endif
+
 }
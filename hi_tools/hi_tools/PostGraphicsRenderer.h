@@ -50,9 +50,51 @@ using namespace juce;
 	Since some of these operations will involve using buffers, it uses an internal
 	stack system that fetches the correct internal data for each required operation
 	to avoid reallocating.
+
+	If you pass in a WorkerPool, the effects will be split into multiple rows that
+	are processed in parallel (for images above 256 pixels).
 */
 struct PostGraphicsRenderer
 {
+	/** The thread pool that is shared between all renderers. The thread that applies
+		the effects takes part in the processing, so it uses one thread less than the
+		number of CPU cores. Keep a SharedResourcePointer to this around in the object
+		that owns the renderer so that the threads are not recreated for every frame.
+	*/
+	struct WorkerPool : public ThreadPool
+	{
+		WorkerPool();
+	};
+
+	/** Keeps a copy of the image before and after the effects were applied.
+
+		If the effects are applied to an image with the same content again (eg. if the
+		component is repainted without changing its draw calls), the result can be
+		copied instead of running the effects again.
+	*/
+	struct ResultCache
+	{
+		/** Copies the cached result into the image if it matches the last input. */
+		bool restore(Image& img) const;
+
+		/** Call this with the image before the effects are applied. */
+		void setInput(const Image& img);
+
+		/** Call this with the image after the effects are applied. */
+		void setOutput(const Image& img);
+
+	private:
+
+		static void copyToBlock(const Image& img, MemoryBlock& mb);
+
+		MemoryBlock input;
+		MemoryBlock output;
+		int width = 0;
+		int height = 0;
+		Image::PixelFormat format = Image::UnknownFormat;
+		bool valid = false;
+	};
+
 	/** This object will hold all internal buffers required for an operation. */
 	struct Data
 	{
@@ -99,7 +141,7 @@ struct PostGraphicsRenderer
 
 	using DataStack = OwnedArray<Data>;
 
-	PostGraphicsRenderer(DataStack& stackTouse, Image& image, float scaleFactor=1.0f);
+	PostGraphicsRenderer(DataStack& stackTouse, Image& image, float scaleFactor=1.0f, ThreadPool* workerPool=nullptr);
 
 	void reserveStackOperations(int numOperationsToAllocate);
 
@@ -144,6 +186,10 @@ private:
 
 	Data& getNextData();
 
+	/** Returns the worker pool if the image is big enough to be worth the overhead. */
+	ThreadPool* getWorkerPoolForImage() const;
+
+	ThreadPool* workerPool = nullptr;
 	DataStack& stack;
 	int stackIndex = 0;
 	Image::BitmapData bd;
@@ -185,6 +231,7 @@ private:
 	int numOps = 0;
 	Image img;
 	PostGraphicsRenderer::DataStack stack;
+	SharedResourcePointer<PostGraphicsRenderer::WorkerPool> workerPool;
 };
 
 }
\ No newline at end of file
@@ -181,6 +181,10 @@ public:
 		print("");
 		print("run_unit_tests");
 		print("Runs the unit tests. In order for this to work, HISE must be built with the CI configuration");
+		print("");
+		print("run_benchmarks");
+		print("Runs the benchmarks (all unit tests with a category that ends with _benchmark) and logs the timings.");
+		print("Use a release build with the CI configuration for meaningful numbers");
 
 		exit(0);
 	}
@@ -745,7 +749,18 @@ public:
             // If you're working on a unit test, just add the "Current" category
             // and then uncomment this line.
             if(UnitTest::getTestsInCategory("Current").isEmpty())
-                runner.runAllTests();
+            {
+                // the benchmarks take too long and don't check anything, use run_benchmarks instead
+                Array<UnitTest*> tests;
+
+                for (auto t : UnitTest::getAllTests())
+                {
+                    if (!t->getCategory().endsWith("_benchmark"))
+                        tests.add(t);
+                }
+
+                runner.runTests(tests);
+            }
             else
                 runner.runTestsInCategory("Current");
 
@@ -766,6 +781,28 @@ public:
 #else
 			std::cout << "You need to build HISE with the CI configuration in order to run the unit tests";
 			exit(1);
+#endif
+		}
+		else if (commandLine.startsWith("run_benchmarks"))
+		{
+#if HI_RUN_UNIT_TESTS
+			UnitTestRunner runner;
+
+			Array<UnitTest*> tests;
+
+			for (auto t : UnitTest::getAllTests())
+			{
+				if (t->getCategory().endsWith("_benchmark"))
+					tests.add(t);
+			}
+
+			runner.runTests(tests);
+
+			quit();
+			return;
+#else
+			std::cout << "You need to build HISE with the CI configuration in order to run the benchmarks";
+			exit(1);
 #endif
 		}
 		else if (commandLine.startsWith("set_version"))
@@ -813,6 +813,122 @@ void CodecTest::testHiseSampleBufferClearing()
 
 static CodecTest codecTest;
 
+class SIMDUnpackTest : public UnitTest
+{
+public:
+
+	using InstructionSet = BitCompressors::SIMD::InstructionSet;
+
+	SIMDUnpackTest() :
+		UnitTest("Testing vectorized unpacking")
+	{}
+
+	void runTest() override
+	{
+		BitCompressors::Collection collection;
+
+		for (int i = 0; i < (int)InstructionSet::numInstructionSets; i++)
+		{
+			auto s = (InstructionSet)i;
+
+			if (s == InstructionSet::Scalar)
+				continue;
+
+			if (!BitCompressors::SIMD::isSupported(s))
+			{
+				logMessage(BitCompressors::SIMD::getName(s) + " is not supported, skipping");
+				continue;
+			}
+
+			beginTest("Testing unpacking with " + BitCompressors::SIMD::getName(s));
+
+			for (int bitRate = 1; bitRate <= 16; bitRate++)
+				testUnpacking(s, collection.getSuitableCompressorForBitRate((uint8)bitRate));
+
+			beginTest("Testing int16 to float conversion with " + BitCompressors::SIMD::getName(s));
+
+			testFloatConversion(s);
+		}
+
+		BitCompressors::SIMD::setInstructionSet(InstructionSet::numInstructionSets);
+	}
+
+	static void fillWithRandomValues(Random& r, int16* data, int numValues, int bitDepth)
+	{
+		const int max = bitDepth > 1 ? (1 << (bitDepth - 1)) - 1 : 1;
+		const int min = bitDepth > 1 ? -max : 0;
+
+		for (int i = 0; i < numValues; i++)
+			data[i] = (int16)r.nextInt(Range<int>(min, max + 1));
+	}
+
+	void testUnpacking(InstructionSet s, BitCompressors::Base* compressor)
+	{
+		Random r;
+
+		const int bitDepth = compressor->getAllowedBitRange();
+
+		for (auto numValues : { 1, 7, 8, 9, 15, 16, 17, 31, 63, 64, 65, 127, 1000, 4093, 4096 })
+		{
+			HeapBlock<int16> data(numValues);
+			HeapBlock<int16> scalarResult(numValues, true);
+			HeapBlock<int16> simdResult(numValues, true);
+			HeapBlock<uint8> compressed(jmax(1, compressor->getByteAmount(numValues)), true);
+
+			fillWithRandomValues(r, data, numValues, bitDepth);
+
+			compressor->compress(compressed, data, numValues);
+
+			BitCompressors::SIMD::setInstructionSet(InstructionSet::Scalar);
+			compressor->decompress(scalarResult, compressed, numValues);
+
+			BitCompressors::SIMD::setInstructionSet(s);
+			compressor->decompress(simdResult, compressed, numValues);
+
+			const String info = String(bitDepth) + " bit with " + String(numValues) + " values";
+
+			expect(memcmp(scalarResult, simdResult, sizeof(int16) * numValues) == 0, "Mismatch to scalar path: " + info);
+
+			expect(memcmp(data, simdResult, sizeof(int16) * numValues) == 0, "Mismatch to original data: " + info);
+		}
+	}
+
+	void testFloatConversion(InstructionSet s)
+	{
+		Random r;
+
+		for (auto numValues : { 1, 7, 8, 15, 16, 17, 33, 1000, 4096 })
+		{
+			// use an odd offset to check unaligned access
+			HeapBlock<int16> data(numValues + 1);
+			HeapBlock<float> expected(numValues + 1, true);
+			HeapBlock<float> actual(numValues + 1, true);
+
+			fillWithRandomValues(r, data, numValues + 1, 16);
+
+			const float divisor = (float)INT16_MAX * 8.0f;
+
+			BitCompressors::SIMD::setInstructionSet(InstructionSet::Scalar);
+			BitCompressors::SIMD::int16ToFloat(data + 1, expected + 1, numValues);
+
+			BitCompressors::SIMD::setInstructionSet(s);
+			BitCompressors::SIMD::int16ToFloat(data + 1, actual + 1, numValues);
+
+			expect(memcmp(expected, actual, sizeof(float) * (numValues + 1)) == 0, "Conversion mismatch with " + String(numValues) + " values");
+
+			BitCompressors::SIMD::setInstructionSet(InstructionSet::Scalar);
+			BitCompressors::SIMD::int16ToFloatWithDivisor(data + 1, expected + 1, numValues, divisor);
+
+			BitCompressors::SIMD::setInstructionSet(s);
+			BitCompressors::SIMD::int16ToFloatWithDivisor(data + 1, actual + 1, numValues, divisor);
+
+			expect(memcmp(expected, actual, sizeof(float) * (numValues + 1)) == 0, "Normalised conversion mismatch with " + String(numValues) + " values");
+		}
+	}
+};
+
+static SIMDUnpackTest simdUnpackTest;
+
 class FormatTest : public UnitTest
 {
 public:
@@ -37,7 +37,7 @@ void printHelp()
 	Logger::writeToLog("Usage: hlac_tool [MODE] [INPUT] [OUTPUT]");
 	Logger::writeToLog("");
 	Logger::writeToLog("modes: 'encode' / 'decode'");
-	Logger::writeToLog("test-modes: 'unit_test' / 'test_directory', 'memory_map_directory'");
+	Logger::writeToLog("test-modes: 'unit_test' / 'test_directory', 'memory_map_directory', 'benchmark'");
 	Logger::writeToLog("(put '_' before filename to skip samples)");
 	Logger::setCurrentLogger(nullptr);
 }
@@ -97,6 +97,91 @@ void testMemoryMapPerformance(Array<File>& files)
 	}
 }
 
+void benchmarkDecoding()
+{
+	using InstructionSet = BitCompressors::SIMD::InstructionSet;
+
+	const int numValues = COMPRESSION_BLOCK_SIZE;
+	const int numIterations = 5000;
+
+	BitCompressors::Collection collection;
+	Random r;
+
+	HeapBlock<int16> input(numValues);
+	HeapBlock<int16> output(numValues);
+	HeapBlock<float> floatOutput(numValues);
+	HeapBlock<uint8> compressed(numValues * sizeof(int16));
+
+	Array<InstructionSet> instructionSets;
+	String header = "Bits";
+
+	for (int i = 0; i < (int)InstructionSet::numInstructionSets; i++)
+	{
+		if (BitCompressors::SIMD::isSupported((InstructionSet)i))
+		{
+			instructionSets.add((InstructionSet)i);
+			header << "\t" << BitCompressors::SIMD::getName((InstructionSet)i);
+		}
+	}
+
+	auto getMegaSamplesPerSecond = [&](double start)
+	{
+		auto seconds = (Time::getMillisecondCounterHiRes() - start) / 1000.0;
+		return String((double)numValues * (double)numIterations / seconds / 1000000.0, 1);
+	};
+
+	Logger::writeToLog("Unpacking speed in million samples per second");
+	Logger::writeToLog(header);
+
+	for (int bitRate : { 1, 2, 4, 6, 8, 10, 12, 14, 16 })
+	{
+		auto compressor = collection.getSuitableCompressorForBitRate((uint8)bitRate);
+
+		const int max = bitRate > 1 ? (1 << (bitRate - 1)) - 1 : 1;
+		const int min = bitRate > 1 ? -max : 0;
+
+		for (int i = 0; i < numValues; i++)
+			input[i] = (int16)r.nextInt(Range<int>(min, max + 1));
+
+		compressor->compress(compressed, input, numValues);
+
+		String line;
+		line << bitRate;
+
+		for (auto s : instructionSets)
+		{
+			BitCompressors::SIMD::setInstructionSet(s);
+
+			auto start = Time::getMillisecondCounterHiRes();
+
+			for (int i = 0; i < numIterations; i++)
+				compressor->decompress(output, compressed, numValues);
+
+			line << "\t" << getMegaSamplesPerSecond(start);
+		}
+
+		Logger::writeToLog(line);
+	}
+
+	String line = "float";
+
+	for (auto s : instructionSets)
+	{
+		BitCompressors::SIMD::setInstructionSet(s);
+
+		auto start = Time::getMillisecondCounterHiRes();
+
+		for (int i = 0; i < numIterations; i++)
+			CompressionHelpers::fastInt16ToFloat(input, floatOutput, numValues);
+
+		line << "\t" << getMegaSamplesPerSecond(start);
+	}
+
+	Logger::writeToLog(line);
+
+	BitCompressors::SIMD::setInstructionSet(InstructionSet::numInstructionSets);
+}
+
 int decode(File input, File output)
 {
 
@@ -245,6 +330,13 @@ int main(int argc, char **argv)
 	}
 
 
+	if (mode == "benchmark")
+	{
+		benchmarkDecoding();
+		Logger::setCurrentLogger(nullptr);
+		return 0;
+	}
+
 	if (mode == "memory_map_directory")
 	{
 		File root(argv[2]);